@@ -0,0 +1,297 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Micro-benchmark of the time and measurement updates of the square-root UKF
+ * filters built on simulation/utilities/ukfCore.h.  The filter sources define
+ * functions of the same name, so the filter is selected at compile time with
+ * one of BENCH_INERTIAL_UKF, BENCH_SUNLINE_UKF, BENCH_SUNLINE_SUKF,
+ * BENCH_HEADING_SUKF, BENCH_RELATIVE_OD_UKF or BENCH_PIXEL_LINE_BIAS_UKF, and
+ * the build creates one executable per filter.  Build with
+ * -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchInertialUKF [number of updates]
+ *
+ * The filter is initialized like its Reset method and processes consistent,
+ * noise free measurements.  It is reinitialized every BENCH_RESET_UPDATES
+ * updates such that every run times the same work.  The program prints the
+ * time per update (time and measurement update) and returns a non-zero exit
+ * code if the estimate is not finite.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "simulation/utilities/linearAlgebra.h"
+#include "simulation/utilities/ukfUtilities.h"
+
+#if defined(BENCH_INERTIAL_UKF)
+#include "attDetermination/InertialUKF/inertialUKF.h"
+typedef InertialUKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "inertialUKF"
+#define BENCH_N_STATES AKF_N_STATES
+#define BENCH_TIME_STEP 0.5
+#elif defined(BENCH_SUNLINE_UKF)
+#include "attDetermination/sunlineUKF/sunlineUKF.h"
+typedef SunlineUKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "sunlineUKF"
+#define BENCH_N_STATES SKF_N_STATES
+#define BENCH_TIME_STEP 0.5
+#elif defined(BENCH_SUNLINE_SUKF)
+#include "attDetermination/sunlineSuKF/sunlineSuKF.h"
+typedef SunlineSuKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "sunlineSuKF"
+#define BENCH_N_STATES SKF_N_STATES_SWITCH
+#define BENCH_TIME_STEP 0.5
+#elif defined(BENCH_HEADING_SUKF)
+#include "attDetermination/headingSuKF/headingSuKF.h"
+typedef HeadingSuKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "headingSuKF"
+#define BENCH_N_STATES HEAD_N_STATES_SWITCH
+#define BENCH_TIME_STEP 0.5
+#elif defined(BENCH_RELATIVE_OD_UKF)
+#include "opticalNavigation/relativeODuKF/relativeODuKF.h"
+typedef RelODuKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "relativeODuKF"
+#define BENCH_N_STATES ODUKF_N_STATES
+#define BENCH_TIME_STEP 1.0
+#elif defined(BENCH_PIXEL_LINE_BIAS_UKF)
+#include "opticalNavigation/pixelLineBiasUKF/pixelLineBiasUKF.h"
+typedef PixelLineBiasUKFConfig BenchConfig;
+#define BENCH_FILTER_NAME "pixelLineBiasUKF"
+#define BENCH_N_STATES PIXLINE_N_STATES
+#define BENCH_TIME_STEP 1.0
+#else
+#error "Define the benchmarked filter, e.g. -DBENCH_INERTIAL_UKF"
+#endif
+
+#define BENCH_RESET_UPDATES 20
+
+static BenchConfig benchInitial;
+static BenchConfig benchFilter;
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+/* Sets the diagonal of the n x n matrix mat, zeroing the other elements */
+static void setDiagonal(double *mat, int n, const double *diag)
+{
+    int i;
+    mSetZero(mat, n, n);
+    for (i = 0; i < n; i++) {
+        mat[i*n + i] = diag[i];
+    }
+}
+
+/* Computes the sigma point weights and the covariance and process noise square roots like the Reset methods */
+static void initializeFilter(BenchConfig *configData)
+{
+    int i;
+    int n = BENCH_N_STATES;
+    double tempMatrix[BENCH_N_STATES*BENCH_N_STATES];
+
+    configData->numStates = n;
+    configData->countHalfSPs = n;
+    configData->alpha = 0.02;
+    configData->beta = 2.0;
+    configData->kappa = 0.0;
+    configData->timeTag = 0.0;
+    configData->lambdaVal = configData->alpha*configData->alpha*(n + configData->kappa) - n;
+    configData->gamma = sqrt(n + configData->lambdaVal);
+    configData->wM[0] = configData->lambdaVal/(n + configData->lambdaVal);
+    configData->wC[0] = configData->lambdaVal/(n + configData->lambdaVal)
+                        + (1 - configData->alpha*configData->alpha + configData->beta);
+    for (i = 1; i < 2*n + 1; i++) {
+        configData->wM[i] = 1.0/2.0*1.0/(n + configData->lambdaVal);
+        configData->wC[i] = configData->wM[i];
+    }
+    mCopy(configData->covar, n, n, configData->sBar);
+    ukfCholDecomp(configData->sBar, n, n, tempMatrix);
+    mCopy(tempMatrix, n, n, configData->sBar);
+    ukfCholDecomp(configData->qNoise, n, n, configData->sQnoise);
+    mTranspose(configData->sQnoise, n, n, configData->sQnoise);
+}
+
+#if defined(BENCH_SUNLINE_UKF) || defined(BENCH_SUNLINE_SUKF)
+/* Eight coarse sun sensors on the faces of a pyramid and the measured cosines of the sun direction */
+static void setCoarseSunSensors(BenchConfig *configData, double sunHeading[3])
+{
+    int i;
+    double angle;
+    configData->numCSSTotal = MAX_N_CSS_MEAS;
+    for (i = 0; i < MAX_N_CSS_MEAS; i++) {
+        angle = 2.0*M_PI*i/MAX_N_CSS_MEAS;
+        v3Set(0.7071*cos(angle), 0.7071*sin(angle), i % 2 ? 0.7071 : -0.7071, &(configData->cssNHat_B[i*3]));
+        configData->CBias[i] = 1.0;
+        configData->cssSensorInBuffer.CosValue[i] = fmax(v3Dot(&(configData->cssNHat_B[i*3]), sunHeading), 0.0);
+    }
+    configData->sensorUseThresh = 0.0;
+    configData->qObsVal = 0.001;
+}
+#endif
+
+/* Sets the initial state, covariance, noise and the measurements of the benchmarked filter */
+static void setupFilter(BenchConfig *configData)
+{
+#if defined(BENCH_INERTIAL_UKF)
+    double covar[AKF_N_STATES] = {0.04, 0.04, 0.04, 0.004, 0.004, 0.004};
+    double noise[AKF_N_STATES] = {0.0017*0.0017, 0.0017*0.0017, 0.0017*0.0017,
+                                  0.00017*0.00017, 0.00017*0.00017, 0.00017*0.00017};
+    double stNoise[3] = {0.00017*0.00017, 0.00017*0.00017, 0.00017*0.00017};
+    v3Set(0.1, 0.2, -0.3, configData->state);
+    setDiagonal(configData->covar, AKF_N_STATES, covar);
+    setDiagonal(configData->qNoise, AKF_N_STATES, noise);
+    setDiagonal(configData->STDatasStruct.STMessages[0].noise, 3, stNoise);
+    configData->STDatasStruct.numST = 1;
+    v3Set(0.12, 0.18, -0.31, configData->stSensorIn[0].MRP_BdyInrtl);
+#elif defined(BENCH_SUNLINE_UKF)
+    double covar[SKF_N_STATES] = {0.4, 0.4, 0.4, 0.04, 0.04, 0.04};
+    double noise[SKF_N_STATES] = {0.01*0.01, 0.01*0.01, 0.01*0.01, 0.001*0.001, 0.001*0.001, 0.001*0.001};
+    double sunHeading[3] = {0.3, 0.4, 0.8660254};
+    v3Set(1.0, 0.0, 0.0, configData->state);
+    setDiagonal(configData->covar, SKF_N_STATES, covar);
+    setDiagonal(configData->qNoise, SKF_N_STATES, noise);
+    setCoarseSunSensors(configData, sunHeading);
+#elif defined(BENCH_SUNLINE_SUKF)
+    double covar[SKF_N_STATES_SWITCH] = {1.0, 1.0, 1.0, 0.02, 0.02, 1.0e-4};
+    double noise[SKF_N_STATES_SWITCH] = {0.001*0.001, 0.001*0.001, 0.001*0.001, 0.001*0.001, 0.001*0.001,
+                                         0.0000002*0.0000002};
+    double sunHeading[3] = {0.3, 0.4, 0.8660254};
+    v3Set(0.0, 0.0, 1.0, configData->state);
+    configData->state[5] = 1.0;
+    v3Set(1.0, 0.0, 0.0, configData->bVec_B);
+    setDiagonal(configData->covar, SKF_N_STATES_SWITCH, covar);
+    setDiagonal(configData->qNoise, SKF_N_STATES_SWITCH, noise);
+    setCoarseSunSensors(configData, sunHeading);
+    configData->qObsVal = 0.002;
+#elif defined(BENCH_HEADING_SUKF)
+    double covar[HEAD_N_STATES_SWITCH] = {0.1, 0.1, 0.1, 0.01, 0.01};
+    double noise[HEAD_N_STATES_SWITCH] = {0.01*0.01, 0.01*0.01, 0.01*0.01, 0.001*0.001, 0.001*0.001};
+    double measNoise[OPNAV_MEAS] = {10.0, 10.0, 10.0};
+    v3Set(0.0, 0.0, 1.0, configData->state);
+    v3Set(1.0, 0.0, 0.0, configData->bVec_B);
+    setDiagonal(configData->covar, HEAD_N_STATES_SWITCH, covar);
+    setDiagonal(configData->qNoise, HEAD_N_STATES_SWITCH, noise);
+    v3Set(-300.0, -400.0, -866.0254, configData->opnavInBuffer.r_BN_B);
+    setDiagonal(configData->opnavInBuffer.covar_B, OPNAV_MEAS, measNoise);
+    configData->rNorm = v3Norm(configData->opnavInBuffer.r_BN_B);
+    configData->noiseSF = 1.0;
+#elif defined(BENCH_RELATIVE_OD_UKF)
+    /* Mars orbit, in km like the filter after its Reset */
+    double covar[ODUKF_N_STATES] = {1000.0, 1000.0, 1000.0, 5.0, 5.0, 5.0};
+    double noise[ODUKF_N_STATES] = {1.0e-16, 1.0e-16, 1.0e-16, 1.0e-14, 1.0e-14, 1.0e-14};
+    double measNoise[ODUKF_N_MEAS] = {10.0, 10.0, 10.0};
+    configData->planetId = 2;
+    configData->numObs = ODUKF_N_MEAS;
+    configData->noiseSF = 1.0;
+    v3Set(3200.0, 100.0, 40.0, configData->state);
+    v3Set(0.0, 3.6, 0.2, &(configData->state[3]));
+    setDiagonal(configData->covar, ODUKF_N_STATES, covar);
+    setDiagonal(configData->qNoise, ODUKF_N_STATES, noise);
+    v3Set(3205.0, 98.0, 41.0, configData->opNavInMsg.r_BN_N);
+    setDiagonal(configData->opNavInMsg.covar_N, ODUKF_N_MEAS, measNoise);
+#elif defined(BENCH_PIXEL_LINE_BIAS_UKF)
+    /* Mars orbit, in km like the filter after its Reset, seen by a camera aligned with the inertial frame */
+    double covar[PIXLINE_N_STATES] = {1000.0, 1000.0, 1000.0, 5.0, 5.0, 5.0, 2.0, 2.0, 3.0};
+    double noise[PIXLINE_N_STATES] = {1.0e-16, 1.0e-16, 1.0e-16, 1.0e-14, 1.0e-14, 1.0e-14, 1.0e-6, 1.0e-6, 1.0e-6};
+    double measNoise[3] = {1.0, 1.0, 1.0};
+    int j;
+    configData->planetId = 2;
+    configData->numObs = PIXLINE_N_MEAS;
+    v3Set(100.0, 200.0, -8000.0, configData->state);
+    v3Set(2.3, 0.0, 0.0, &(configData->state[3]));
+    setDiagonal(configData->covar, PIXLINE_N_STATES, covar);
+    setDiagonal(configData->qNoise, PIXLINE_N_STATES, noise);
+    configData->cameraSpecs.fieldOfView = 0.35;
+    configData->cameraSpecs.resolution[0] = 512;
+    configData->cameraSpecs.resolution[1] = 512;
+    configData->cirlcesInMsg.planetIds[0] = 2;
+    setDiagonal(configData->cirlcesInMsg.uncertainty, 3, measNoise);
+    /* the measured circle is the one the measurement model predicts for the slightly offset true state */
+    configData->countHalfSPs = PIXLINE_N_STATES;
+    for (j = 0; j < 2*PIXLINE_N_STATES + 1; j++) {
+        vCopy(configData->state, PIXLINE_DYN_STATES, &(configData->SP[j*PIXLINE_N_STATES]));
+        configData->SP[j*PIXLINE_N_STATES] += 5.0;
+    }
+    pixelLineBiasUKFMeasModel(configData);
+    configData->cirlcesInMsg.circlesCenters[0] = configData->yMeas[0];
+    configData->cirlcesInMsg.circlesCenters[1] = configData->yMeas[1];
+    configData->cirlcesInMsg.circlesRadii[0] = configData->yMeas[2];
+#endif
+    initializeFilter(configData);
+}
+
+/* Runs one time update to updateTime and one measurement update */
+static void updateFilter(BenchConfig *configData, double updateTime)
+{
+#if defined(BENCH_INERTIAL_UKF)
+    inertialUKFTimeUpdate(configData, updateTime);
+    inertialUKFMeasUpdate(configData, 0);
+#elif defined(BENCH_SUNLINE_UKF)
+    sunlineUKFTimeUpdate(configData, updateTime);
+    sunlineUKFMeasUpdate(configData, updateTime);
+#elif defined(BENCH_SUNLINE_SUKF)
+    sunlineSuKFTimeUpdate(configData, updateTime);
+    sunlineSuKFMeasUpdate(configData, updateTime);
+#elif defined(BENCH_HEADING_SUKF)
+    headingSuKFTimeUpdate(configData, updateTime);
+    headingSuKFMeasUpdate(configData, updateTime);
+#elif defined(BENCH_RELATIVE_OD_UKF)
+    relODuKFTimeUpdate(configData, updateTime);
+    relODuKFMeasUpdate(configData);
+#elif defined(BENCH_PIXEL_LINE_BIAS_UKF)
+    pixelLineBiasUKFTimeUpdate(configData, updateTime);
+    pixelLineBiasUKFMeasUpdate(configData);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    long numUpdates = argc > 1 ? atol(argv[1]) : 200000;
+    long k;
+    int i;
+    int finite = 1;
+    struct timespec start, stop;
+
+    setupFilter(&benchInitial);
+    benchInitial.bskLogger = _BSKLogger();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (k = 0; k < numUpdates; k++) {
+        if (k % BENCH_RESET_UPDATES == 0) {
+            memcpy(&benchFilter, &benchInitial, sizeof(BenchConfig));
+        }
+        updateFilter(&benchFilter, (k % BENCH_RESET_UPDATES + 1)*BENCH_TIME_STEP);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    printf("%-18s %d states %10ld updates %10.3f us/update   state", BENCH_FILTER_NAME, BENCH_N_STATES,
+           numUpdates, 1.0e6*elapsedSeconds(&start, &stop)/numUpdates);
+    for (i = 0; i < BENCH_N_STATES; i++) {
+        printf(" % .6e", benchFilter.state[i]);
+        finite = finite && isfinite(benchFilter.state[i]);
+    }
+    printf("\n");
+    _BSKLogger_d(benchInitial.bskLogger);
+    return(finite ? 0 : 1);
+}
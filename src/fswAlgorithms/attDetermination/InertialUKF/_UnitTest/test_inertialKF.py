@@ -170,6 +170,26 @@ def test_FilterMethods():
         testFailCount += 1
         testMessages.append("Failed to caputre wheel acceleration in inertialStateProp")
 
+    # The batched propagation of states stored as columns must match the single state propagation
+    batchInput = numpy.array([[1., 0., 0., 0.1, 0.1, 0.1],
+                              [0.1, -0.2, 0.3, 0.01, -0.02, 0.03],
+                              [-0.4, 0.5, 0.1, -0.1, 0.2, 0.05]])
+    numPoints = batchInput.shape[0]
+    stateColumns = inertialUKF.new_doubleArray(6*numPoints)
+    for i in range(6):
+        for j in range(numPoints):
+            inertialUKF.doubleArray_setitem(stateColumns, i*numPoints + j, batchInput[j, i])
+    inertialUKF.inertialStatePropBatch(moduleConfig, stateColumns, numPoints, 0.5)
+    for j in range(numPoints):
+        for i in range(6):
+            inertialUKF.doubleArray_setitem(state, i, batchInput[j, i])
+        inertialUKF.inertialStateProp(moduleConfig, state, 0.5)
+        for i in range(6):
+            if abs(inertialUKF.doubleArray_getitem(state, i)
+                   - inertialUKF.doubleArray_getitem(stateColumns, i*numPoints + j)) > accuracy:
+                testFailCount += 1
+                testMessages.append("Failed to match inertialStateProp in inertialStatePropBatch")
+
     setupFilterData(moduleConfig)
     vehicleConfigOut = inertialUKF.VehicleConfigFswMsg()
     inputMessageSize = vehicleConfigOut.getStructSize()
@@ -20,11 +20,15 @@
 #include <string.h>
 #include <math.h>
 #include "attDetermination/InertialUKF/inertialUKF.h"
-#include "attDetermination/_GeneralModuleFiles/ukfUtilities.h"
+#include "simulation/utilities/ukfUtilities.h"
 #include "simulation/utilities/linearAlgebra.h"
 #include "simulation/utilities/rigidBodyKinematics.h"
 #include "simFswInterfaceMessages/macroDefinitions.h"
 
+#define UKF_CORE_N_STATES AKF_N_STATES
+#define UKF_CORE_N_MEAS 3
+#include "simulation/utilities/ukfCore.h"
+
 /*! This method creates the two moduel output messages.
  @return void
  @param configData The configuration data associated with the CSS WLS estimator
@@ -360,32 +364,21 @@ void Update_inertialUKF(InertialUKFConfig *configData, uint64_t callTime,
     return;
 }
 
-/*! This method propagates a inertial state vector forward in time.  Note 
-    that the calling parameter is updated in place to save on data copies.
+/*! This method computes the body rate change over dt caused by the reaction
+    wheel torques.  The wheel accelerations are taken from the difference of the
+    last two wheel speed measurements.
 	@return void
     @param configData The configuration data associated with this module
-    @param stateInOut The state that is propagated
     @param dt Time step (s)
+    @param deltaOmega Body rate change over the time step (r/s)
 */
-void inertialStateProp(InertialUKFConfig *configData, double *stateInOut, double dt)
+static void inertialRWRateChange(InertialUKFConfig *configData, double dt, double deltaOmega[3])
 {
-
-    double sigmaDot[3];
-    double BMatrix[3][3];
     double torqueTotal[3];
     double wheelAccel;
     double torqueSingle[3];
-    double angAccelTotal[3];
     int i;
-    
-    /*! - Convert the state derivative (body rate) to sigmaDot and propagate
-          the attitude MRPs*/
-    BmatMRP(stateInOut, BMatrix);
-    m33Scale(0.25, BMatrix, BMatrix);
-    m33MultV3(BMatrix, &(stateInOut[3]), sigmaDot);
-    v3Scale(dt, sigmaDot, sigmaDot);
-    v3Add(stateInOut, sigmaDot, stateInOut);
-    
+
     /*! - Assemble the total torque from the reaction wheels to get the forcing
      function from any wheels present*/
     v3SetZero(torqueTotal);
@@ -401,10 +394,98 @@ void inertialStateProp(InertialUKFConfig *configData, double *stateInOut, double
         v3Scale(wheelAccel, &(configData->rwConfigParams.GsMatrix_B[i*3]), torqueSingle);
         v3Subtract(torqueTotal, torqueSingle, torqueTotal);
     }
-    /*! - Get the angular acceleration and propagate the state forward (euler prop)*/
-    m33MultV3(configData->IInv, torqueTotal, angAccelTotal);
-    v3Scale(dt, angAccelTotal, angAccelTotal);
-    v3Add(&(stateInOut[3]), angAccelTotal, &(stateInOut[3]));
+    /*! - Get the angular acceleration and scale it by the time step*/
+    m33MultV3(configData->IInv, torqueTotal, deltaOmega);
+    v3Scale(dt, deltaOmega, deltaOmega);
+}
+
+/*! This method propagates a inertial state vector forward in time.  Note 
+    that the calling parameter is updated in place to save on data copies.
+	@return void
+    @param configData The configuration data associated with this module
+    @param stateInOut The state that is propagated
+    @param dt Time step (s)
+*/
+void inertialStateProp(InertialUKFConfig *configData, double *stateInOut, double dt)
+{
+
+    double sigmaDot[3];
+    double BMatrix[3][3];
+    double deltaOmega[3];
+    
+    /*! - Convert the state derivative (body rate) to sigmaDot and propagate
+          the attitude MRPs*/
+    BmatMRP(stateInOut, BMatrix);
+    m33Scale(0.25, BMatrix, BMatrix);
+    m33MultV3(BMatrix, &(stateInOut[3]), sigmaDot);
+    v3Scale(dt, sigmaDot, sigmaDot);
+    v3Add(stateInOut, sigmaDot, stateInOut);
+    
+    /*! - Get the rate change from the reaction wheel torques and propagate the
+          state forward (euler prop)*/
+    inertialRWRateChange(configData, dt, deltaOmega);
+    v3Add(&(stateInOut[3]), deltaOmega, &(stateInOut[3]));
+	return;
+}
+
+/*! This method propagates a set of inertial state vectors forward in time in one
+    pass.  The states are stored as the columns of the 6 x numPoints row-major
+    matrix stateColumns (element [k*numPoints + j] is state k of point j), so that
+    each step is a contiguous loop over all points.  The results are identical to
+    calling inertialStateProp on each point.
+	@return void
+    @param configData The configuration data associated with this module
+    @param stateColumns The states that are propagated, updated in place
+    @param numPoints Number of states (columns) to propagate
+    @param dt Time step (s)
+*/
+void inertialStatePropBatch(InertialUKFConfig *configData, double *stateColumns,
+                            int numPoints, double dt)
+{
+    double deltaOmega[3];
+    double *s1, *s2, *s3, *w1, *w2, *w3;
+    double q1, q2, q3, sigSq;
+    double B[3][3];
+    double sigmaDot[3];
+    int j;
+
+    s1 = &stateColumns[0*numPoints];
+    s2 = &stateColumns[1*numPoints];
+    s3 = &stateColumns[2*numPoints];
+    w1 = &stateColumns[3*numPoints];
+    w2 = &stateColumns[4*numPoints];
+    w3 = &stateColumns[5*numPoints];
+
+    /*! - The reaction wheel forcing does not depend on the state, compute it once*/
+    inertialRWRateChange(configData, dt, deltaOmega);
+
+    /*! - Convert the body rates to sigmaDot with the MRP B matrix and propagate the
+          attitude and rates of every point (same operations as inertialStateProp)*/
+    for (j = 0; j < numPoints; j++)
+    {
+        q1 = s1[j];
+        q2 = s2[j];
+        q3 = s3[j];
+        sigSq = q1 * q1 + q2 * q2 + q3 * q3;
+        B[0][0] = 0.25 * (1 - sigSq + 2 * q1 * q1);
+        B[0][1] = 0.25 * (2 * (q1 * q2 - q3));
+        B[0][2] = 0.25 * (2 * (q1 * q3 + q2));
+        B[1][0] = 0.25 * (2 * (q2 * q1 + q3));
+        B[1][1] = 0.25 * (1 - sigSq + 2 * q2 * q2);
+        B[1][2] = 0.25 * (2 * (q2 * q3 - q1));
+        B[2][0] = 0.25 * (2 * (q3 * q1 - q2));
+        B[2][1] = 0.25 * (2 * (q3 * q2 + q1));
+        B[2][2] = 0.25 * (1 - sigSq + 2 * q3 * q3);
+        sigmaDot[0] = 0.0 + B[0][0] * w1[j] + B[0][1] * w2[j] + B[0][2] * w3[j];
+        sigmaDot[1] = 0.0 + B[1][0] * w1[j] + B[1][1] * w2[j] + B[1][2] * w3[j];
+        sigmaDot[2] = 0.0 + B[2][0] * w1[j] + B[2][1] * w2[j] + B[2][2] * w3[j];
+        s1[j] = q1 + sigmaDot[0] * dt;
+        s2[j] = q2 + sigmaDot[1] * dt;
+        s3[j] = q3 + sigmaDot[2] * dt;
+        w1[j] = w1[j] + deltaOmega[0];
+        w2[j] = w2[j] + deltaOmega[1];
+        w3[j] = w3[j] + deltaOmega[2];
+    }
 	return;
 }
 
@@ -417,13 +498,9 @@ void inertialStateProp(InertialUKFConfig *configData, double *stateInOut, double
 */
 int inertialUKFTimeUpdate(InertialUKFConfig *configData, double updateTime)
 {
-	int i, Index, k;
-	double sBarT[AKF_N_STATES*AKF_N_STATES];
-	double xComp[AKF_N_STATES], AT[(2 * AKF_N_STATES + AKF_N_STATES)*AKF_N_STATES];
-	double aRow[AKF_N_STATES], rAT[AKF_N_STATES*AKF_N_STATES], xErr[AKF_N_STATES]; 
-	double sBarUp[AKF_N_STATES*AKF_N_STATES];
-	double *spPtr;
+	int k;
     double procNoise[AKF_N_STATES*AKF_N_STATES];
+    double spColumns[AKF_N_STATES*UKF_CORE_N_SIGMA];
     int32_t badUpdate=0;
     
 	configData->dt = updateTime - configData->timeTag;
@@ -431,94 +508,31 @@ int inertialUKFTimeUpdate(InertialUKFConfig *configData, double updateTime)
     mCopy(configData->sBar, configData->numStates, configData->numStates, configData->sBarPrev);
     mCopy(configData->covar, configData->numStates, configData->numStates, configData->covarPrev);
     
-    mSetZero(rAT, AKF_N_STATES, AKF_N_STATES);
     mCopy(configData->sQnoise, AKF_N_STATES, AKF_N_STATES, procNoise);
-    /*! - Copy over the current state estimate into the 0th Sigma point and propagate by dt*/
-	vCopy(configData->state, configData->numStates,
-		&(configData->SP[0 * configData->numStates + 0]));
-	inertialStateProp(configData, &(configData->SP[0]),
-        configData->dt);
-    /*! - Scale that Sigma point by the appopriate scaling factor (Wm[0])*/
-	vScale(configData->wM[0], &(configData->SP[0]),
-        configData->numStates, configData->xBar);
-    /*! - Get the transpose of the sBar matrix because it is easier to extract Rows vs columns*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               sBarT);
-    /*! - For each Sigma point, apply sBar-based error, propagate forward, and scale by Wm just like 0th.
-          Note that we perform +/- sigma points simultaneously in loop to save loop values.*/
-	for (i = 0; i<configData->countHalfSPs; i++)
-	{
-        /*! - Adding covariance columns from sigma points*/
-		Index = i + 1;
-		spPtr = &(configData->SP[Index* (int) configData->numStates]);
-		vCopy(&sBarT[i* (int) configData->numStates], configData->numStates, spPtr);
-		vScale(configData->gamma, spPtr, configData->numStates, spPtr);
-		vAdd(spPtr, configData->numStates, configData->state, spPtr);
-		inertialStateProp(configData, spPtr, configData->dt);
-		vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-		vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-		/*! - Subtracting covariance columns from sigma points*/
-		Index = i + 1 + (int) configData->countHalfSPs;
-        spPtr = &(configData->SP[Index* (int) configData->numStates]);
-        vCopy(&sBarT[i* (int) configData->numStates], configData->numStates, spPtr);
-        vScale(-configData->gamma, spPtr, configData->numStates, spPtr);
-        vAdd(spPtr, configData->numStates, configData->state, spPtr);
-        inertialStateProp(configData, spPtr, configData->dt);
-        vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-        vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-	}
-    /*! - Zero the AT matrix prior to assembly*/
-    mSetZero(AT, (2 * configData->countHalfSPs + configData->numStates),
-        configData->countHalfSPs);
-	/*! - Assemble the AT matrix.  Note that this matrix is the internals of 
-          the qr decomposition call in the source design documentation.  It is 
-          the inside of equation 20 in that document*/
-	for (i = 0; i<2 * configData->countHalfSPs; i++)
-	{
-        vScale(-1.0, configData->xBar, configData->numStates, aRow);
-        vAdd(aRow, configData->numStates,
-             &(configData->SP[(i+1)* (int) configData->numStates]), aRow);
-        /*Check sign of wC to know if the sqrt will fail*/
-        if (configData->wC[i+1]<=0){
-            inertialUKFCleanUpdate(configData);
-            return -1;}
-        vScale(sqrt(configData->wC[i+1]), aRow, configData->numStates, aRow);
-		memcpy((void *)&AT[i* (int) configData->numStates], (void *)aRow,
-			configData->numStates*sizeof(double));
-        
-	}
+    /*! - Spread the sigma points about the current state using the columns of sBar and
+          propagate each of them forward by dt*/
+    ukfCoreSigmaPointColumns(configData->state, configData->sBar, configData->gamma, spColumns);
+    inertialStatePropBatch(configData, spColumns, UKF_CORE_N_SIGMA, configData->dt);
+    ukfCoreSigmaPointRows(spColumns, configData->SP);
+    /*! - Compute the weighted mean of the propagated sigma points*/
+    ukfCoreStateMean(configData->SP, configData->wM, configData->xBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 1) < 0){
+        inertialUKFCleanUpdate(configData);
+        return(-1);}
    /*! - Scale sQNoise matrix depending on the dt*/
     for (k=0;k<3;k++){
         procNoise[k*AKF_N_STATES+k] *= configData->dt*configData->dt/2;
         procNoise[(k+3)*AKF_N_STATES+(k+3)] *= configData->dt;
     }
-    /*! - Pop the sQNoise matrix on to the end of AT prior to getting QR decomposition*/
-	memcpy(&AT[2 * configData->countHalfSPs*configData->numStates],
-		procNoise, configData->numStates*configData->numStates
-        *sizeof(double));
-    /*! - QR decomposition (only R computed!) of the AT matrix provides the new sBar matrix*/
-    ukfQRDJustR(AT, 2 * configData->countHalfSPs + configData->numStates,
-                configData->countHalfSPs, rAT);
-
-    mCopy(rAT, configData->numStates, configData->numStates, sBarT);
-    mTranspose(sBarT, configData->numStates, configData->numStates,
-        configData->sBar);
-    
-    /*! - Shift the sBar matrix over by the xBar vector using the appropriate weight 
-          like in equation 21 in design document.*/
-    vScale(-1.0, configData->xBar, configData->numStates, xErr);
-    vAdd(xErr, configData->numStates, &configData->SP[0], xErr);
-    badUpdate += ukfCholDownDate(configData->sBar, xErr, configData->wC[0],
-        configData->numStates, sBarUp);
-
-    
-    /*! - Save current sBar matrix, covariance, and state estimate off for further use*/
-    mCopy(sBarUp, configData->numStates, configData->numStates, configData->sBar);
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-        configData->covar);
-	mMultM(configData->sBar, configData->numStates, configData->numStates,
-        configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    /*! - QR decomposition of the weighted sigma point spread and process noise provides the
+          new sBar matrix, which is then shifted by the 0th sigma point (equations 20 and 21
+          in design document)*/
+    badUpdate = ukfCoreStateSqrt(configData->SP, configData->xBar, configData->wC, procNoise,
+                                 configData->sBar);
+    
+    /*! - Save current covariance and state estimate off for further use*/
+    ukfCoreCovar(configData->sBar, configData->covar);
     vCopy(&(configData->SP[0]), configData->numStates, configData->state);
 	
     if (badUpdate<0){
@@ -661,14 +675,8 @@ void inertialUKFAggGyrData(InertialUKFConfig *configData, double prevTime,
  */
 int inertialUKFMeasUpdate(InertialUKFConfig *configData, int currentST)
 {
-    uint32_t i;
-    double yBar[3], syInv[3*3];
-    double kMat[AKF_N_STATES*3];
-    double xHat[AKF_N_STATES], Ucol[AKF_N_STATES], sBarT[AKF_N_STATES*AKF_N_STATES], tempYVec[3];
-    double AT[(2 * AKF_N_STATES + 3)*3], qChol[3*3];
-    double rAT[3*3], syT[3*3];
-    double sy[3*3];
-    double updMat[3*3], pXY[AKF_N_STATES*3], Umat[AKF_N_STATES*3];
+    double yBar[3], qChol[3*3], sy[3*3];
+    double pXY[AKF_N_STATES*3];
     int32_t badUpdate=0;
     
     vCopy(configData->state, configData->numStates, configData->statePrev);
@@ -677,115 +685,34 @@ int inertialUKFMeasUpdate(InertialUKFConfig *configData, int currentST)
     /*! - Compute the valid observations and the measurement model for all observations*/
     inertialUKFMeasModel(configData, currentST);
 
-    mSetZero(rAT, 3, 3);
     /*! - Compute the value for the yBar parameter (note that this is equation 23 in the
           time update section of the reference document*/
-    vSetZero(yBar, configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2+1; i++)
-    {
-        vCopy(&(configData->yMeas[i*configData->numObs]), configData->numObs,
-              tempYVec);
-        vScale(configData->wM[i], tempYVec, configData->numObs, tempYVec);
-        vAdd(yBar, configData->numObs, tempYVec, yBar);
-    }
-    
-    /*! - Populate the matrix that we perform the QR decomposition on in the measurement 
-          update section of the code.  This is based on the differenence between the yBar 
-          parameter and the calculated measurement models.  Equation 24 in driving doc. */
-    mSetZero(AT, configData->countHalfSPs*2+configData->numObs,
-        configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[(i+1)*configData->numObs]), tempYVec);
-        if (configData->wC[i+1]<0){return -1;}
-        vScale(sqrt(configData->wC[i+1]), tempYVec, configData->numObs, tempYVec);
-        memcpy(&(AT[i*configData->numObs]), tempYVec,
-               configData->numObs*sizeof(double));
-    }
+    ukfCoreMeasMean(configData->yMeas, configData->wM, (int32_t) configData->numObs, yBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 0) < 0){return(-1);}
     
     /*! - This is the square-root of the Rk matrix which we treat as the Cholesky
         decomposition of the observation variance matrix constructed for our number 
         of observations*/
     badUpdate += ukfCholDecomp(configData->STDatasStruct.STMessages[currentST].noise, configData->numObs, configData->numObs, qChol);
-    memcpy(&(AT[2*configData->countHalfSPs*configData->numObs]),
-           qChol, configData->numObs*configData->numObs*sizeof(double));
-    /*! - Perform QR decomposition (only R again) of the above matrix to obtain the 
-          current Sy matrix*/
-    ukfQRDJustR(AT, 2*configData->countHalfSPs+configData->numObs,
-                configData->numObs, rAT);
-
-    mCopy(rAT, configData->numObs, configData->numObs, syT);
-    mTranspose(syT, configData->numObs, configData->numObs, sy);
-    /*! - Shift the matrix over by the difference between the 0th SP-based measurement 
-          model and the yBar matrix (cholesky down-date again)*/
-    vScale(-1.0, yBar, configData->numObs, tempYVec);
-    vAdd(tempYVec, configData->numObs, &(configData->yMeas[0]), tempYVec);
-    badUpdate += ukfCholDownDate(sy, tempYVec, configData->wC[0],
-                    configData->numObs, updMat);
-
-    /*! - Shifted matrix represents the Sy matrix */
-    mCopy(updMat, configData->numObs, configData->numObs, sy);
-    mTranspose(sy, configData->numObs, configData->numObs, syT);
+    /*! - QR decomposition of the measurement model spread and the noise, shifted by the
+          0th sigma point, gives the current Sy matrix (equations 24 and 25 in driving doc)*/
+    badUpdate += ukfCoreMeasSqrt(configData->yMeas, yBar, configData->wC, qChol, 1.0,
+                                 (int32_t) configData->numObs, sy);
 
     /*! - Construct the Pxy matrix (equation 26) which multiplies the Sigma-point cloud 
           by the measurement model cloud (weighted) to get the total Pxy matrix*/
-    mSetZero(pXY, configData->numStates, configData->numObs);
-    for(i=0; i<2*configData->countHalfSPs+1; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[i*configData->numObs]), tempYVec);
-        vSubtract(&(configData->SP[i*configData->numStates]), configData->numStates,
-                  configData->xBar, xHat);
-        vScale(configData->wC[i], xHat, configData->numStates, xHat);
-        mMultM(xHat, configData->numStates, 1, tempYVec, 1, configData->numObs,
-            kMat);
-        mAdd(pXY, configData->numStates, configData->numObs, kMat, pXY);
-    }
+    ukfCoreCrossCovar(configData->SP, configData->xBar, configData->yMeas, yBar,
+                      configData->wC, (int32_t) configData->numObs, pXY);
 
-    /*! - Then we need to invert the SyT*Sy matrix to get the Kalman gain factor.  Since
-          The Sy matrix is lower triangular, we can do a back-sub inversion instead of 
-          a full matrix inversion.  That is the ukfUInv and ukfLInv calls below.  Once that 
-          multiplication is done (equation 27), we have the Kalman Gain.*/
-    badUpdate += ukfUInv(syT, configData->numObs, configData->numObs, syInv);
-    
-    mMultM(pXY, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    badUpdate += ukfLInv(sy, configData->numObs, configData->numObs, syInv);
-    mMultM(kMat, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    
-    
-    /*! - Difference the yBar and the observations to get the observed error and 
-          multiply by the Kalman Gain to get the state update.  Add the state update 
-          to the state to get the updated state value (equation 27).*/
-    vSubtract(configData->obs, configData->numObs, yBar, tempYVec);
-    mMultM(kMat, configData->numStates, configData->numObs, tempYVec,
-        configData->numObs, 1, xHat);
-    vAdd(configData->state, configData->numStates, xHat, configData->state);
-    /*! - Compute the updated matrix U from equation 28.  Note that I then transpose it 
-         so that I can extract "columns" from adjacent memory*/
-    mMultM(kMat, configData->numStates, configData->numObs, sy,
-           configData->numObs, configData->numObs, Umat);
-    mTranspose(Umat, configData->numStates, configData->numObs, Umat);
-    /*! - For each column in the update matrix, perform a cholesky down-date on it to 
-          get the total shifted S matrix (called sBar in internal parameters*/
-    for(i=0; i<configData->numObs; i++)
-    {
-        vCopy(&(Umat[i*configData->numStates]), configData->numStates, Ucol);
-        badUpdate += ukfCholDownDate(configData->sBar, Ucol, -1.0, configData->numStates, sBarT);
-        mCopy(sBarT, configData->numStates, configData->numStates,
-            configData->sBar);
-    }
+    /*! - Compute the Kalman gain (equation 27) using triangular back-substitution on Sy,
+          apply the innovation to the state and down-date sBar with each column of the
+          update matrix U from equation 28*/
+    badUpdate += ukfCoreMeasUpdate(pXY, sy, configData->obs, yBar, (int32_t) configData->numObs,
+                                   configData->state, configData->sBar);
 
     /*! - Compute equivalent covariance based on updated sBar matrix*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               configData->covar);
-    mMultM(configData->sBar, configData->numStates, configData->numStates,
-           configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    ukfCoreCovar(configData->sBar, configData->covar);
     
     if (badUpdate<0){
         inertialUKFCleanUpdate(configData);
@@ -147,6 +147,8 @@ extern "C" {
     int inertialUKFMeasUpdate(InertialUKFConfig *configData, int currentST);
     void inertialUKFCleanUpdate(InertialUKFConfig *configData);
 	void inertialStateProp(InertialUKFConfig *configData, double *stateInOut, double dt);
+    void inertialStatePropBatch(InertialUKFConfig *configData, double *stateColumns,
+                                int numPoints, double dt);
     void inertialUKFMeasModel(InertialUKFConfig *configData, int currentST);
     
 #ifdef __cplusplus
@@ -19,7 +19,7 @@
 %module inertialUKF
 %{
    #include "inertialUKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -35,7 +35,7 @@ STRUCTASLIST(LowPassFilterData)
 STRUCTASLIST(AccPktDataFswMsg)
 STRUCTASLIST(STMessage)
 %include "inertialUKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/inertialFilterFswMsg.h"
 %include "../../fswMessages/stAttFswMsg.h"
 %include "../../fswMessages/vehicleConfigFswMsg.h"
@@ -18,10 +18,14 @@
  */
 
 #include "attDetermination/headingSuKF/headingSuKF.h"
-#include "attDetermination/_GeneralModuleFiles/ukfUtilities.h"
+#include "simulation/utilities/ukfUtilities.h"
 #include "simulation/utilities/linearAlgebra.h"
 #include "simulation/utilities/rigidBodyKinematics.h"
 #include "simFswInterfaceMessages/macroDefinitions.h"
+
+#define UKF_CORE_N_STATES HEAD_N_STATES_SWITCH
+#define UKF_CORE_N_MEAS OPNAV_MEAS
+#include "simulation/utilities/ukfCore.h"
 #include <string.h>
 #include <math.h>
 
@@ -285,6 +289,88 @@ void headingStateProp(double *stateInOut, double *b_Vec, double dt)
 	return;
 }
 
+/*! This method propagates a set of heading state vectors forward in time in one
+    pass.  The states are stored as the columns of the 5 x numPoints row-major
+    matrix stateColumns (element [k*numPoints + j] is state k of point j), so that
+    each step is a contiguous loop over all points and the S-frame DCM of every point
+    is built without branching.  The results are identical to calling headingStateProp
+    on each point.
+	@return void
+    @param stateColumns The states that are propagated, updated in place
+    @param numPoints Number of states (columns) to propagate
+    @param b_Vec b vector
+    @param dt time step (s)
+*/
+void headingStatePropBatch(double *stateColumns, int numPoints, double *b_Vec, double dt)
+{
+    double *d1, *d2, *d3, *w2, *w3;
+    double d[3], s1[3], s2[3], s3[3], omega_BN_B[3], omegaCrossd[3];
+    double dcm_BS[3][3];
+    double normVal, normInv;
+    int useIdentity;
+    int i, j;
+
+    d1 = &stateColumns[0*numPoints];
+    d2 = &stateColumns[1*numPoints];
+    d3 = &stateColumns[2*numPoints];
+    w2 = &stateColumns[3*numPoints];
+    w3 = &stateColumns[4*numPoints];
+
+    for (j = 0; j < numPoints; j++)
+    {
+        d[0] = d1[j];
+        d[1] = d2[j];
+        d[2] = d3[j];
+        /*! - Build the S-frame basis from the heading and the b vector*/
+        normVal = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s1[i] = normVal > 1e-30 ? d[i] * normInv : 0.0;
+        }
+        s2[0] = d[1] * b_Vec[2] - d[2] * b_Vec[1];
+        s2[1] = d[2] * b_Vec[0] - d[0] * b_Vec[2];
+        s2[2] = d[0] * b_Vec[1] - d[1] * b_Vec[0];
+        normVal = sqrt(s2[0] * s2[0] + s2[1] * s2[1] + s2[2] * s2[2]);
+        useIdentity = normVal < 1E-5;
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s2[i] = s2[i] * normInv;
+        }
+        s3[0] = d[1] * s2[2] - d[2] * s2[1];
+        s3[1] = d[2] * s2[0] - d[0] * s2[2];
+        s3[2] = d[0] * s2[1] - d[1] * s2[0];
+        normVal = sqrt(s3[0] * s3[0] + s3[1] * s3[1] + s3[2] * s3[2]);
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s3[i] = normVal > 1e-30 ? s3[i] * normInv : 0.0;
+        }
+        /*! - The DCM columns are the S-frame axes, or identity if the heading is
+              aligned with the b vector*/
+        for (i = 0; i < 3; i++)
+        {
+            dcm_BS[i][0] = useIdentity ? (i == 0 ? 1.0 : 0.0) : s1[i];
+            dcm_BS[i][1] = useIdentity ? (i == 1 ? 1.0 : 0.0) : s2[i];
+            dcm_BS[i][2] = useIdentity ? (i == 2 ? 1.0 : 0.0) : s3[i];
+            omega_BN_B[i] = 0.0 + dcm_BS[i][0] * 0.0 + dcm_BS[i][1] * -w2[j] + dcm_BS[i][2] * -w3[j];
+        }
+        /*! - Multiply omega cross d by dt and add to state to propagate*/
+        omegaCrossd[0] = omega_BN_B[1] * d[2] - omega_BN_B[2] * d[1];
+        omegaCrossd[1] = omega_BN_B[2] * d[0] - omega_BN_B[0] * d[2];
+        omegaCrossd[2] = omega_BN_B[0] * d[1] - omega_BN_B[1] * d[0];
+        for (i = 0; i < 3; i++)
+        {
+            d[i] = d[i] + omegaCrossd[i] * -dt;
+        }
+        d1[j] = d[0];
+        d2[j] = d[1];
+        d3[j] = d[2];
+    }
+	return;
+}
+
 /*! This method performs the time update for the heading kalman filter.
      It propagates the sigma points forward in time and then gets the current 
 	 covariance and state estimates.
@@ -294,88 +380,25 @@ void headingStateProp(double *stateInOut, double *b_Vec, double dt)
 */
 void headingSuKFTimeUpdate(HeadingSuKFConfig *configData, double updateTime)
 {
-	int i, Index;
-	double sBarT[HEAD_N_STATES_SWITCH*HEAD_N_STATES_SWITCH];
-	double xComp[HEAD_N_STATES_SWITCH], AT[(2 * HEAD_N_STATES_SWITCH + HEAD_N_STATES_SWITCH)*HEAD_N_STATES_SWITCH];
-	double aRow[HEAD_N_STATES_SWITCH], rAT[HEAD_N_STATES_SWITCH*HEAD_N_STATES_SWITCH], xErr[HEAD_N_STATES_SWITCH];
-	double sBarUp[HEAD_N_STATES_SWITCH*HEAD_N_STATES_SWITCH];
-	double *spPtr;
+    double spColumns[HEAD_N_STATES_SWITCH*UKF_CORE_N_SIGMA];
 
     configData->dt = updateTime - configData->timeTag;
     
-    /*! - Copy over the current state estimate into the 0th Sigma point and propagate by dt*/
-	vCopy(configData->state, (size_t) configData->numStates,
-		&(configData->SP[0 * configData->numStates + 0]));
-	headingStateProp(&(configData->SP[0 * configData->numStates + 0]), configData->bVec_B, configData->dt);
-    /*! - Scale that Sigma point by the appopriate scaling factor (Wm[0])*/
-	vScale(configData->wM[0], &(configData->SP[0 * configData->numStates + 0]),
-        (size_t) configData->numStates, configData->xBar);
-    /*! - Get the transpose of the sBar matrix because it is easier to extract Rows vs columns*/
-    mTranspose(configData->sBar, (size_t) configData->numStates, (size_t) configData->numStates,
-               sBarT);
-    /*! - For each Sigma point, apply sBar-based error, propagate forward, and scale by Wm just like 0th.
-          Note that we perform +/- sigma points simultaneously in loop to save loop values.*/
-	for (i = 0; i<configData->countHalfSPs; i++)
-	{
-		Index = i + 1;
-		spPtr = &(configData->SP[Index*configData->numStates]);
-		vCopy(&sBarT[i*configData->numStates], (size_t) configData->numStates, spPtr);
-		vScale(configData->gamma, spPtr, (size_t) configData->numStates, spPtr);
-		vAdd(spPtr, (size_t) configData->numStates, configData->state, spPtr);
-		headingStateProp(spPtr, configData->bVec_B, configData->dt);
-		vScale(configData->wM[Index], spPtr, (size_t) configData->numStates, xComp);
-		vAdd(xComp, (size_t) configData->numStates, configData->xBar, configData->xBar);
-		
-		Index = i + 1 + configData->countHalfSPs;
-        spPtr = &(configData->SP[Index*configData->numStates]);
-        vCopy(&sBarT[i*configData->numStates], (size_t) configData->numStates, spPtr);
-        vScale(-configData->gamma, spPtr, (size_t) configData->numStates, spPtr);
-        vAdd(spPtr, (size_t) configData->numStates, configData->state, spPtr);
-        headingStateProp(spPtr, configData->bVec_B, configData->dt);
-        vScale(configData->wM[Index], spPtr, (size_t) configData->numStates, xComp);
-        vAdd(xComp, (size_t) configData->numStates, configData->xBar, configData->xBar);
-	}
-    /*! - Zero the AT matrix prior to assembly*/
-    mSetZero(AT, (2 * (size_t) configData->countHalfSPs + (size_t) configData->numStates),
-        (size_t) configData->countHalfSPs);
-	/*! - Assemble the AT matrix.  Note that this matrix is the internals of 
-          the qr decomposition call in the source design documentation.  It is 
-          the inside of equation 20 in that document*/
-	for (i = 0; i<2 * configData->countHalfSPs; i++)
-	{
-		
-        vScale(-1.0, configData->xBar, (size_t) configData->numStates, aRow);
-        vAdd(aRow, (size_t) configData->numStates,
-             &(configData->SP[(i+1)*configData->numStates]), aRow);
-        vScale(sqrt(configData->wC[i+1]), aRow, (size_t) configData->numStates, aRow);
-		memcpy((void *)&AT[i*configData->numStates], (void *)aRow,
-			(size_t) configData->numStates*sizeof(double));
-	}
-    /*! - Pop the sQNoise matrix on to the end of AT prior to getting QR decomposition*/
-	memcpy(&AT[2 * configData->countHalfSPs*configData->numStates],
-		configData->sQnoise, (size_t) configData->numStates* (size_t) configData->numStates
-        *sizeof(double));
-    /*! - QR decomposition (only R computed!) of the AT matrix provides the new sBar matrix*/
-    ukfQRDJustR(AT, 2 * configData->countHalfSPs + configData->numStates,
-                configData->countHalfSPs, rAT);
-    mCopy(rAT, (size_t) configData->numStates, (size_t) configData->numStates, sBarT);
-    mTranspose(sBarT, (size_t) configData->numStates, (size_t) configData->numStates,
-        configData->sBar);
-    
-    /*! - Shift the sBar matrix over by the xBar vector using the appropriate weight 
-          like in equation 21 in design document.*/
-    vScale(-1.0, configData->xBar, (size_t) configData->numStates, xErr);
-    vAdd(xErr, (size_t) configData->numStates, &configData->SP[0], xErr);
-    ukfCholDownDate(configData->sBar, xErr, configData->wC[0],
-        configData->numStates, sBarUp);
-    
-    /*! - Save current sBar matrix, covariance, and state estimate off for further use*/
-    mCopy(sBarUp, (size_t) configData->numStates, (size_t) configData->numStates, configData->sBar);
-    mTranspose(configData->sBar, (size_t) configData->numStates, (size_t) configData->numStates,
-        configData->covar);
-	mMultM(configData->sBar, (size_t) configData->numStates, (size_t) configData->numStates,
-        configData->covar, (size_t) configData->numStates, (size_t) configData->numStates,
-           configData->covar);
+    /*! - Spread the sigma points about the current state using the columns of sBar and
+          propagate each of them forward by dt*/
+    ukfCoreSigmaPointColumns(configData->state, configData->sBar, configData->gamma, spColumns);
+    headingStatePropBatch(spColumns, UKF_CORE_N_SIGMA, configData->bVec_B, configData->dt);
+    ukfCoreSigmaPointRows(spColumns, configData->SP);
+    /*! - Compute the weighted mean of the propagated sigma points*/
+    ukfCoreStateMean(configData->SP, configData->wM, configData->xBar);
+    /*! - QR decomposition of the weighted sigma point spread and process noise provides the
+          new sBar matrix, which is then shifted by the 0th sigma point (equations 20 and 21
+          in design document)*/
+    ukfCoreStateSqrt(configData->SP, configData->xBar, configData->wC, configData->sQnoise,
+                     configData->sBar);
+    
+    /*! - Save current covariance and state estimate off for further use*/
+    ukfCoreCovar(configData->sBar, configData->covar);
     vCopy(&(configData->SP[0]), (size_t) configData->numStates, configData->state );
 	
 	configData->timeTag = updateTime;
@@ -418,43 +441,15 @@ void headingSuKFMeasModel(HeadingSuKFConfig *configData)
  */
 void headingSuKFMeasUpdate(HeadingSuKFConfig *configData, double updateTime)
 {
-    uint32_t i;
-    double yBar[OPNAV_MEAS], syInv[OPNAV_MEAS*OPNAV_MEAS];
-    double kMat[HEAD_N_STATES_SWITCH*OPNAV_MEAS];
-    double xHat[HEAD_N_STATES_SWITCH], sBarT[HEAD_N_STATES_SWITCH*HEAD_N_STATES_SWITCH], tempYVec[OPNAV_MEAS];
-    double AT[(2 * HEAD_N_STATES_SWITCH + OPNAV_MEAS)*OPNAV_MEAS], qChol[OPNAV_MEAS*OPNAV_MEAS];
-    double rAT[OPNAV_MEAS*OPNAV_MEAS], syT[OPNAV_MEAS*OPNAV_MEAS];
-    double sy[OPNAV_MEAS*OPNAV_MEAS];
-    double updMat[OPNAV_MEAS*OPNAV_MEAS], pXY[HEAD_N_STATES_SWITCH*OPNAV_MEAS];
+    double yBar[OPNAV_MEAS], qChol[OPNAV_MEAS*OPNAV_MEAS];
+    double sy[OPNAV_MEAS*OPNAV_MEAS], pXY[HEAD_N_STATES_SWITCH*OPNAV_MEAS];
         
     /*! - Compute the valid observations and the measurement model for all observations*/
     headingSuKFMeasModel(configData);
     
     /*! - Compute the value for the yBar parameter (note that this is equation 23 in the 
           time update section of the reference document*/
-    vSetZero(yBar, OPNAV_MEAS);
-    for(i=0; i<configData->countHalfSPs*2+1; i++)
-    {
-        vCopy(&(configData->yMeas[i*OPNAV_MEAS]), OPNAV_MEAS,
-              tempYVec);
-        vScale(configData->wM[i], tempYVec, OPNAV_MEAS, tempYVec);
-        vAdd(yBar, OPNAV_MEAS, tempYVec, yBar);
-    }
-    
-    /*! - Populate the matrix that we perform the QR decomposition on in the measurement 
-          update section of the code.  This is based on the differenence between the yBar 
-          parameter and the calculated measurement models.  Equation 24 in driving doc. */
-    mSetZero(AT, (size_t) configData->countHalfSPs*2+OPNAV_MEAS,
-        OPNAV_MEAS);
-    for(i=0; i<configData->countHalfSPs*2; i++)
-    {
-        vScale(-1.0, yBar, OPNAV_MEAS, tempYVec);
-        vAdd(tempYVec, OPNAV_MEAS,
-             &(configData->yMeas[(i+1)*OPNAV_MEAS]), tempYVec);
-        vScale(sqrt(configData->wC[i+1]), tempYVec, OPNAV_MEAS, tempYVec);
-        memcpy(&(AT[i*OPNAV_MEAS]), tempYVec,
-               OPNAV_MEAS*sizeof(double));
-    }
+    ukfCoreMeasMean(configData->yMeas, configData->wM, OPNAV_MEAS, yBar);
     
     /*! - This is the square-root of the Rk matrix which we treat as the Cholesky
         decomposition of the observation variance matrix constructed for our number 
@@ -462,80 +457,23 @@ void headingSuKFMeasUpdate(HeadingSuKFConfig *configData, double updateTime)
     mCopy(configData->opnavInBuffer.covar_B, OPNAV_MEAS, OPNAV_MEAS, configData->qObs);
     mScale(1/(configData->rNorm*configData->rNorm), configData->qObs, OPNAV_MEAS,OPNAV_MEAS, configData->qObs);
     ukfCholDecomp(configData->qObs, OPNAV_MEAS, OPNAV_MEAS, qChol);
-    memcpy(&(AT[2*configData->countHalfSPs*OPNAV_MEAS]),
-           qChol, OPNAV_MEAS*OPNAV_MEAS*sizeof(double));
-    mScale(configData->noiseSF , AT, 2*configData->countHalfSPs, OPNAV_MEAS, AT);
-    /*! - Perform QR decomposition (only R again) of the above matrix to obtain the 
-          current Sy matrix*/
-    ukfQRDJustR(AT, 2*configData->countHalfSPs+OPNAV_MEAS,
-                OPNAV_MEAS, rAT);
-    mCopy(rAT, OPNAV_MEAS, OPNAV_MEAS, syT);
-    mTranspose(syT, OPNAV_MEAS, OPNAV_MEAS, sy);
-    /*! - Shift the matrix over by the difference between the 0th SP-based measurement 
-          model and the yBar matrix (cholesky down-date again)*/
-    vScale(-1.0, yBar, OPNAV_MEAS, tempYVec);
-    vAdd(tempYVec, OPNAV_MEAS, &(configData->yMeas[0]), tempYVec);
-    ukfCholDownDate(sy, tempYVec, configData->wC[0],
-                    OPNAV_MEAS, updMat);
-    /*! - Shifted matrix represents the Sy matrix */
-    mCopy(updMat, OPNAV_MEAS, OPNAV_MEAS, sy);
-    mTranspose(sy, OPNAV_MEAS, OPNAV_MEAS, syT);
+    /*! - QR decomposition of the noiseSF-scaled measurement model spread and the noise,
+          shifted by the 0th sigma point, gives the current Sy matrix (equations 24 and 25)*/
+    ukfCoreMeasSqrt(configData->yMeas, yBar, configData->wC, qChol, configData->noiseSF,
+                    OPNAV_MEAS, sy);
 
     /*! - Construct the Pxy matrix (equation 26) which multiplies the Sigma-point cloud 
           by the measurement model cloud (weighted) to get the total Pxy matrix*/
-    mSetZero(pXY, (size_t) configData->numStates, OPNAV_MEAS);
-    for(i=0; i<2*configData->countHalfSPs+1; i++)
-    {
-        vScale(-1.0, yBar, OPNAV_MEAS, tempYVec);
-        vAdd(tempYVec, OPNAV_MEAS,
-             &(configData->yMeas[i*OPNAV_MEAS]), tempYVec);
-        vSubtract(&(configData->SP[i* (size_t) configData->numStates]), (size_t) configData->numStates,
-                  configData->xBar, xHat);
-        vScale(configData->wC[i], xHat, (size_t) configData->numStates, xHat);
-        mMultM(xHat, (size_t) configData->numStates, 1, tempYVec, 1, OPNAV_MEAS,
-            kMat);
-        mAdd(pXY, (size_t) configData->numStates, OPNAV_MEAS, kMat, pXY);
-    }
+    ukfCoreCrossCovar(configData->SP, configData->xBar, configData->yMeas, yBar,
+                      configData->wC, OPNAV_MEAS, pXY);
 
-    /*! - Then we need to invert the SyT*Sy matrix to get the Kalman gain factor.  Since
-          The Sy matrix is lower triangular, we can do a back-sub inversion instead of 
-          a full matrix inversion.  That is the ukfUInv and ukfLInv calls below.  Once that 
-          multiplication is done (equation 27), we have the Kalman Gain.*/
-    ukfUInv(syT, OPNAV_MEAS, OPNAV_MEAS, syInv);
-    mMultM(pXY, (size_t) configData->numStates, OPNAV_MEAS, syInv,
-           OPNAV_MEAS, OPNAV_MEAS, kMat);
-    ukfLInv(sy, OPNAV_MEAS, OPNAV_MEAS, syInv);
-    mMultM(kMat, (size_t) configData->numStates, OPNAV_MEAS, syInv,
-           OPNAV_MEAS, OPNAV_MEAS, kMat);
-    
-    
-    /*! - Difference the yBar and the observations to get the observed error and 
-          multiply by the Kalman Gain to get the state update.  Add the state update 
-          to the state to get the updated state value (equation 27).*/
-    vSubtract(configData->obs, OPNAV_MEAS, yBar, tempYVec);
-    mMultM(kMat, (size_t) configData->numStates, OPNAV_MEAS, tempYVec,
-        OPNAV_MEAS, 1, xHat);
-    vAdd(configData->state, (size_t) configData->numStates, xHat, configData->state);
-    /*! - Compute the updated matrix U from equation 28.  Note that I then transpose it 
-         so that I can extract "columns" from adjacent memory*/
-    mMultM(kMat, (size_t) configData->numStates, OPNAV_MEAS, sy,
-           OPNAV_MEAS, OPNAV_MEAS, pXY);
-    mTranspose(pXY, (size_t) configData->numStates, OPNAV_MEAS, pXY);
-    /*! - For each column in the update matrix, perform a cholesky down-date on it to 
-          get the total shifted S matrix (called sBar in internal parameters*/
-    for(i=0; i<OPNAV_MEAS; i++)
-    {
-        vCopy(&(pXY[i* (size_t) configData->numStates]), (size_t) configData->numStates, tempYVec);
-        ukfCholDownDate(configData->sBar, tempYVec, -1.0, configData->numStates, sBarT);
-        mCopy(sBarT, (size_t) configData->numStates, (size_t) configData->numStates,
-            configData->sBar);
-    }
+    /*! - Compute the Kalman gain (equation 27) using triangular back-substitution on Sy,
+          apply the innovation to the state and down-date sBar with each column of the
+          update matrix U from equation 28*/
+    ukfCoreMeasUpdate(pXY, sy, configData->obs, yBar, OPNAV_MEAS,
+                      configData->state, configData->sBar);
     /*! - Compute equivalent covariance based on updated sBar matrix*/
-    mTranspose(configData->sBar, (size_t) configData->numStates, (size_t) configData->numStates,
-               configData->covar);
-    mMultM(configData->sBar, (size_t) configData->numStates, (size_t) configData->numStates,
-           configData->covar, (size_t) configData->numStates, (size_t) configData->numStates,
-           configData->covar);
+    ukfCoreCovar(configData->sBar, configData->covar);
 }
 
 
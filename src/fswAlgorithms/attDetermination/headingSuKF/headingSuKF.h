@@ -104,6 +104,7 @@ extern "C" {
 	void headingSuKFTimeUpdate(HeadingSuKFConfig *configData, double updateTime);
     void headingSuKFMeasUpdate(HeadingSuKFConfig *configData, double updateTime);
 	void headingStateProp(double *stateInOut,  double *b_vec, double dt);
+    void headingStatePropBatch(double *stateColumns, int numPoints, double *b_Vec, double dt);
     void headingSuKFMeasModel(HeadingSuKFConfig *configData);
     void headingSuKFComputeDCM_BS(double heading[HEAD_N_STATES], double bVec[HEAD_N_STATES], double *dcm);
     void headingSuKFSwitch(double *bVec_B, double *states, double *covar);
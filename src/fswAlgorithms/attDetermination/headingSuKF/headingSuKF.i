@@ -19,7 +19,7 @@
 %module headingSuKF
 %{
    #include "headingSuKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -37,7 +37,7 @@ GEN_SIZEOF(OpNavFswMsg);
 GEN_SIZEOF(CameraConfigMsg)
 GEN_SIZEOF(HeadingSuKFConfig);
 %include "headingSuKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/vehicleConfigFswMsg.h"
 %include "../../fswMessages/headingFilterFswMsg.h"
 %include "../../fswMessages/opNavFswMsg.h"
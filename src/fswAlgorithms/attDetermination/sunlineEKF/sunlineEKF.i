@@ -19,7 +19,7 @@
 %module sunlineEKF
 %{
    #include "sunlineEKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -34,7 +34,7 @@
 GEN_SIZEOF(SunlineFilterFswMsg);
 GEN_SIZEOF(CSSConfigFswMsg);
 GEN_SIZEOF(sunlineEKFConfig);
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/sunlineFilterFswMsg.h"
 %include "../../fswMessages/cssConfigFswMsg.h"
 %include "sunlineEKF.h"
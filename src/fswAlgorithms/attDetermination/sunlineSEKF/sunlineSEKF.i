@@ -19,7 +19,7 @@
 %module sunlineSEKF
 %{
    #include "sunlineSEKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -36,7 +36,7 @@ GEN_SIZEOF(CSSConfigFswMsg)
 GEN_SIZEOF(SunlineFilterFswMsg);
 GEN_SIZEOF(sunlineSEKFConfig);
 GEN_SIZEOF(VehicleConfigFswMsg);
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/cssConfigFswMsg.h"
 %include "../../fswMessages/vehicleConfigFswMsg.h"
 %include "../../fswMessages/sunlineFilterFswMsg.h"
@@ -217,6 +217,29 @@ def SwitchMethods():
             testFailCount += 1
             testMessages.append("Frame switch failure \n")
 
+    ###################################################################################
+    ## Test the batched state propagation against the single state propagation
+    ###################################################################################
+
+    batchInput = numpy.array([[2, 1, 0.75, 0.1, 0.4, 0.],
+                              [0., 2., 0., 0.3, -0.2, 0.],
+                              [-0.5, 0.2, 0.8, -0.1, 0.05, 0.]])
+    numPoints = batchInput.shape[0]
+    stateColumns = sunlineSuKF.new_doubleArray(numStates*numPoints)
+    for i in range(numStates):
+        for j in range(numPoints):
+            sunlineSuKF.doubleArray_setitem(stateColumns, i*numPoints + j, batchInput[j, i])
+    sunlineSuKF.sunlineStatePropBatch(stateColumns, numPoints, bvec1, 0.5)
+    for j in range(numPoints):
+        for i in range(numStates):
+            sunlineSuKF.doubleArray_setitem(states, i, batchInput[j, i])
+        sunlineSuKF.sunlineStateProp(states, bvec1, 0.5)
+        for i in range(numStates):
+            if abs(sunlineSuKF.doubleArray_getitem(states, i)
+                   - sunlineSuKF.doubleArray_getitem(stateColumns, i*numPoints + j)) > 1.0E-10:
+                testFailCount += 1
+                testMessages.append("Batched state propagation failure \n")
+
 
     # print out success message if no error were found
     if testFailCount == 0:
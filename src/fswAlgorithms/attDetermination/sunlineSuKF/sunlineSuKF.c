@@ -18,10 +18,14 @@
  */
 
 #include "attDetermination/sunlineSuKF/sunlineSuKF.h"
-#include "attDetermination/_GeneralModuleFiles/ukfUtilities.h"
+#include "simulation/utilities/ukfUtilities.h"
 #include "simulation/utilities/linearAlgebra.h"
 #include "simulation/utilities/rigidBodyKinematics.h"
 #include "simFswInterfaceMessages/macroDefinitions.h"
+
+#define UKF_CORE_N_STATES SKF_N_STATES_SWITCH
+#define UKF_CORE_N_MEAS MAX_N_CSS_MEAS
+#include "simulation/utilities/ukfCore.h"
 #include <string.h>
 #include <math.h>
 
@@ -314,6 +318,94 @@ void sunlineStateProp(double *stateInOut, double *b_Vec, double dt)
 	return;
 }
 
+/*! This method propagates a set of sunline state vectors forward in time in one
+    pass.  The states are stored as the columns of the 6 x numPoints row-major
+    matrix stateColumns (element [k*numPoints + j] is state k of point j), so that
+    each step is a contiguous loop over all points and the S-frame DCM of every point
+    is built without branching.  The results are identical to calling sunlineStateProp
+    on each point.
+	@return void
+    @param stateColumns The states that are propagated, updated in place
+    @param numPoints Number of states (columns) to propagate
+    @param b_Vec b vector
+    @param dt time step (s)
+*/
+void sunlineStatePropBatch(double *stateColumns, int numPoints, double *b_Vec, double dt)
+{
+    double *d1, *d2, *d3, *w2, *w3;
+    double d[3], s1[3], s2[3], s3[3], omega_BN_B[3], omegaCrossd[3];
+    double dcm_BS[3][3];
+    double normVal, normInv;
+    int useIdentity;
+    int i, j;
+
+    d1 = &stateColumns[0*numPoints];
+    d2 = &stateColumns[1*numPoints];
+    d3 = &stateColumns[2*numPoints];
+    w2 = &stateColumns[3*numPoints];
+    w3 = &stateColumns[4*numPoints];
+
+    for (j = 0; j < numPoints; j++)
+    {
+        d[0] = d1[j];
+        d[1] = d2[j];
+        d[2] = d3[j];
+        /*! - Build the S-frame basis from the heading and the b vector*/
+        normVal = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s1[i] = normVal > 1e-30 ? d[i] * normInv : 0.0;
+        }
+        s2[0] = d[1] * b_Vec[2] - d[2] * b_Vec[1];
+        s2[1] = d[2] * b_Vec[0] - d[0] * b_Vec[2];
+        s2[2] = d[0] * b_Vec[1] - d[1] * b_Vec[0];
+        normVal = sqrt(s2[0] * s2[0] + s2[1] * s2[1] + s2[2] * s2[2]);
+        useIdentity = normVal < 1E-5;
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s2[i] = s2[i] * normInv;
+        }
+        s3[0] = d[1] * s2[2] - d[2] * s2[1];
+        s3[1] = d[2] * s2[0] - d[0] * s2[2];
+        s3[2] = d[0] * s2[1] - d[1] * s2[0];
+        normVal = sqrt(s3[0] * s3[0] + s3[1] * s3[1] + s3[2] * s3[2]);
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            s3[i] = normVal > 1e-30 ? s3[i] * normInv : 0.0;
+        }
+        /*! - The DCM columns are the S-frame axes, or identity if the heading is
+              aligned with the b vector*/
+        for (i = 0; i < 3; i++)
+        {
+            dcm_BS[i][0] = useIdentity ? (i == 0 ? 1.0 : 0.0) : s1[i];
+            dcm_BS[i][1] = useIdentity ? (i == 1 ? 1.0 : 0.0) : s2[i];
+            dcm_BS[i][2] = useIdentity ? (i == 2 ? 1.0 : 0.0) : s3[i];
+            omega_BN_B[i] = 0.0 + dcm_BS[i][0] * 0.0 + dcm_BS[i][1] * -w2[j] + dcm_BS[i][2] * -w3[j];
+        }
+        /*! - Multiply omega cross d by dt and add to state to propagate and renormalized*/
+        omegaCrossd[0] = omega_BN_B[1] * d[2] - omega_BN_B[2] * d[1];
+        omegaCrossd[1] = omega_BN_B[2] * d[0] - omega_BN_B[0] * d[2];
+        omegaCrossd[2] = omega_BN_B[0] * d[1] - omega_BN_B[1] * d[0];
+        for (i = 0; i < 3; i++)
+        {
+            d[i] = d[i] + omegaCrossd[i] * -dt;
+        }
+        normVal = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        normInv = 1. / normVal;
+        for (i = 0; i < 3; i++)
+        {
+            d[i] = normVal > 1e-30 ? d[i] * normInv : 0.0;
+        }
+        d1[j] = d[0];
+        d2[j] = d[1];
+        d3[j] = d[2];
+    }
+	return;
+}
+
 /*! This method performs the time update for the sunline kalman filter.
      It propagates the sigma points forward in time and then gets the current 
 	 covariance and state estimates.
@@ -323,14 +415,9 @@ void sunlineStateProp(double *stateInOut, double *b_Vec, double dt)
 */
 int sunlineSuKFTimeUpdate(SunlineSuKFConfig *configData, double updateTime)
 {
-    int64_t i;
-    int Index, badUpdate;
-	double sBarT[SKF_N_STATES_SWITCH*SKF_N_STATES_SWITCH];
-	double xComp[SKF_N_STATES_SWITCH], AT[(2 * SKF_N_STATES_SWITCH + SKF_N_STATES_SWITCH)*SKF_N_STATES_SWITCH];
-	double aRow[SKF_N_STATES_SWITCH], rAT[SKF_N_STATES_SWITCH*SKF_N_STATES_SWITCH], xErr[SKF_N_STATES_SWITCH]; 
-	double sBarUp[SKF_N_STATES_SWITCH*SKF_N_STATES_SWITCH];
-	double *spPtr;
+    int badUpdate;
     double procNoise[SKF_N_STATES_SWITCH*SKF_N_STATES_SWITCH];
+    double spColumns[SKF_N_STATES_SWITCH*UKF_CORE_N_SIGMA];
     badUpdate = 0;
     
     vCopy(configData->state, configData->numStates, configData->statePrev);
@@ -338,82 +425,23 @@ int sunlineSuKFTimeUpdate(SunlineSuKFConfig *configData, double updateTime)
     mCopy(configData->covar, configData->numStates, configData->numStates, configData->covarPrev);
     configData->dt = updateTime - configData->timeTag;
     mCopy(configData->sQnoise, SKF_N_STATES_SWITCH, SKF_N_STATES_SWITCH, procNoise);
-    /*! - Copy over the current state estimate into the 0th Sigma point and propagate by dt*/
-	vCopy(configData->state, configData->numStates,
-		&(configData->SP[0 * configData->numStates + 0]));
-	mSetZero(rAT, configData->countHalfSPs, configData->countHalfSPs);
-	sunlineStateProp(&(configData->SP[0]), configData->bVec_B, configData->dt);
-    /*! - Scale that Sigma point by the appopriate scaling factor (Wm[0])*/
-	vScale(configData->wM[0], &(configData->SP[0]),
-        configData->numStates, configData->xBar);
-    /*! - Get the transpose of the sBar matrix because it is easier to extract Rows vs columns*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               sBarT);
-    /*! - For each Sigma point, apply sBar-based error, propagate forward, and scale by Wm just like 0th.
-          Note that we perform +/- sigma points simultaneously in loop to save loop values.*/
-	for (i = 0; i<configData->countHalfSPs; i++)
-	{
-		Index = i + 1;
-		spPtr = &(configData->SP[Index*(int)configData->numStates]);
-		vCopy(&sBarT[i*(int)configData->numStates], configData->numStates, spPtr);
-		vScale(configData->gamma, spPtr, configData->numStates, spPtr);
-		vAdd(spPtr, configData->numStates, configData->state, spPtr);
-		sunlineStateProp(spPtr, configData->bVec_B, configData->dt);
-		vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-		vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-		
-		Index = i + 1 + (int) configData->countHalfSPs;
-        spPtr = &(configData->SP[Index*(int)configData->numStates]);
-        vCopy(&sBarT[i*(int) configData->numStates], configData->numStates, spPtr);
-        vScale(-configData->gamma, spPtr, configData->numStates, spPtr);
-        vAdd(spPtr, configData->numStates, configData->state, spPtr);
-        sunlineStateProp(spPtr, configData->bVec_B, configData->dt);
-        vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-        vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-	}
-    /*! - Zero the AT matrix prior to assembly*/
-    mSetZero(AT, (2 * configData->countHalfSPs + configData->numStates),
-        configData->countHalfSPs);
-	/*! - Assemble the AT matrix.  Note that this matrix is the internals of 
-          the qr decomposition call in the source design documentation.  It is 
-          the inside of equation 20 in that document*/
-	for (i = 0; i<2 * configData->countHalfSPs; i++)
-	{
-		
-        vScale(-1.0, configData->xBar, configData->numStates, aRow);
-        vAdd(aRow, configData->numStates,
-             &(configData->SP[(i+1)*(int) configData->numStates]), aRow);
-        if (configData->wC[i+1] <0){return -1;}
-        vScale(sqrt(configData->wC[i+1]), aRow, configData->numStates, aRow);
-		memcpy((void *)&AT[i*(int) configData->numStates], (void *)aRow,
-			configData->numStates*sizeof(double));
-	}
-    
-    /*! - Pop the sQNoise matrix on to the end of AT prior to getting QR decomposition*/
-	memcpy(&AT[2 * configData->countHalfSPs*configData->numStates],
-		procNoise, configData->numStates*configData->numStates
-        *sizeof(double));
-    /*! - QR decomposition (only R computed!) of the AT matrix provides the new sBar matrix*/
-    ukfQRDJustR(AT, 2 * configData->countHalfSPs + configData->numStates,
-                configData->countHalfSPs, rAT);
-    mCopy(rAT, configData->numStates, configData->numStates, sBarT);
-    mTranspose(sBarT, configData->numStates, configData->numStates,
-        configData->sBar);
-    
-    /*! - Shift the sBar matrix over by the xBar vector using the appropriate weight 
-          like in equation 21 in design document.*/
-    vScale(-1.0, configData->xBar, configData->numStates, xErr);
-    vAdd(xErr, configData->numStates, &configData->SP[0], xErr);
-    badUpdate += ukfCholDownDate(configData->sBar, xErr, configData->wC[0],
-        configData->numStates, sBarUp);
-    
-    /*! - Save current sBar matrix, covariance, and state estimate off for further use*/
-    mCopy(sBarUp, configData->numStates, configData->numStates, configData->sBar);
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-        configData->covar);
-	mMultM(configData->sBar, configData->numStates, configData->numStates,
-        configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    /*! - Spread the sigma points about the current state using the columns of sBar and
+          propagate each of them forward by dt*/
+    ukfCoreSigmaPointColumns(configData->state, configData->sBar, configData->gamma, spColumns);
+    sunlineStatePropBatch(spColumns, UKF_CORE_N_SIGMA, configData->bVec_B, configData->dt);
+    ukfCoreSigmaPointRows(spColumns, configData->SP);
+    /*! - Compute the weighted mean of the propagated sigma points*/
+    ukfCoreStateMean(configData->SP, configData->wM, configData->xBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 0) < 0){return -1;}
+    /*! - QR decomposition of the weighted sigma point spread and process noise provides the
+          new sBar matrix, which is then shifted by the 0th sigma point (equations 20 and 21
+          in design document)*/
+    badUpdate += ukfCoreStateSqrt(configData->SP, configData->xBar, configData->wC, procNoise,
+                                  configData->sBar);
+    
+    /*! - Save current covariance and state estimate off for further use*/
+    ukfCoreCovar(configData->sBar, configData->covar);
     vCopy(&(configData->SP[0]), configData->numStates, configData->state );
 	
 	configData->timeTag = updateTime;
@@ -507,15 +535,9 @@ void sunlineSuKFMeasModel(SunlineSuKFConfig *configData)
  */
 int sunlineSuKFMeasUpdate(SunlineSuKFConfig *configData, double updateTime)
 {
-    uint32_t i;
     int32_t badUpdate;
-    double yBar[MAX_N_CSS_MEAS], syInv[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS];
-    double kMat[SKF_N_STATES_SWITCH*MAX_N_CSS_MEAS];
-    double xHat[SKF_N_STATES_SWITCH], sBarT[SKF_N_STATES_SWITCH*SKF_N_STATES_SWITCH], tempYVec[MAX_N_CSS_MEAS];
-    double AT[(2 * SKF_N_STATES_SWITCH + MAX_N_CSS_MEAS)*MAX_N_CSS_MEAS], qChol[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS];
-    double rAT[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS], syT[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS];
-    double sy[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS], Ucol[SKF_N_STATES_SWITCH];
-    double updMat[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS], pXY[SKF_N_STATES_SWITCH*MAX_N_CSS_MEAS], Umat[SKF_N_STATES_SWITCH*MAX_N_CSS_MEAS];
+    double yBar[MAX_N_CSS_MEAS], qChol[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS];
+    double sy[MAX_N_CSS_MEAS*MAX_N_CSS_MEAS], pXY[SKF_N_STATES_SWITCH*MAX_N_CSS_MEAS];
     badUpdate = 0;
     
     vCopy(configData->state, configData->numStates, configData->statePrev);
@@ -527,30 +549,9 @@ int sunlineSuKFMeasUpdate(SunlineSuKFConfig *configData, double updateTime)
     
     /*! - Compute the value for the yBar parameter (note that this is equation 23 in the 
           time update section of the reference document*/
-    vSetZero(yBar, configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2+1; i++)
-    {
-        vCopy(&(configData->yMeas[i*configData->numObs]), configData->numObs,
-              tempYVec);
-        vScale(configData->wM[i], tempYVec, configData->numObs, tempYVec);
-        vAdd(yBar, configData->numObs, tempYVec, yBar);
-    }
-    
-    /*! - Populate the matrix that we perform the QR decomposition on in the measurement 
-          update section of the code.  This is based on the differenence between the yBar 
-          parameter and the calculated measurement models.  Equation 24 in driving doc. */
-    mSetZero(AT, configData->countHalfSPs*2+configData->numObs,
-        configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[(i+1)*configData->numObs]), tempYVec);
-        if (configData->wC[i+1] <0){return -1;}
-        vScale(sqrt(configData->wC[i+1]), tempYVec, configData->numObs, tempYVec);
-        memcpy(&(AT[i*configData->numObs]), tempYVec,
-               configData->numObs*sizeof(double));
-    }
+    ukfCoreMeasMean(configData->yMeas, configData->wM, (int32_t) configData->numObs, yBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 0) < 0){return -1;}
     
     /*! - This is the square-root of the Rk matrix which we treat as the Cholesky
         decomposition of the observation variance matrix constructed for our number 
@@ -560,80 +561,23 @@ int sunlineSuKFMeasUpdate(SunlineSuKFConfig *configData, double updateTime)
     mScale(configData->qObsVal, configData->qObs, configData->numObs,
            configData->numObs, configData->qObs);
     ukfCholDecomp(configData->qObs, configData->numObs, configData->numObs, qChol);
-    memcpy(&(AT[2*configData->countHalfSPs*configData->numObs]),
-           qChol, configData->numObs*configData->numObs*sizeof(double));
-    /*! - Perform QR decomposition (only R again) of the above matrix to obtain the 
-          current Sy matrix*/
-    ukfQRDJustR(AT, 2*configData->countHalfSPs+configData->numObs,
-                configData->numObs, rAT);
-    mCopy(rAT, configData->numObs, configData->numObs, syT);
-    mTranspose(syT, configData->numObs, configData->numObs, sy);
-    /*! - Shift the matrix over by the difference between the 0th SP-based measurement 
-          model and the yBar matrix (cholesky down-date again)*/
-    vScale(-1.0, yBar, configData->numObs, tempYVec);
-    vAdd(tempYVec, configData->numObs, &(configData->yMeas[0]), tempYVec);
-    badUpdate += ukfCholDownDate(sy, tempYVec, configData->wC[0],
-                    configData->numObs, updMat);
-    /*! - Shifted matrix represents the Sy matrix */
-    mCopy(updMat, configData->numObs, configData->numObs, sy);
-    mTranspose(sy, configData->numObs, configData->numObs, syT);
+    /*! - QR decomposition of the measurement model spread and the noise, shifted by the
+          0th sigma point, gives the current Sy matrix (equations 24 and 25 in driving doc)*/
+    badUpdate += ukfCoreMeasSqrt(configData->yMeas, yBar, configData->wC, qChol, 1.0,
+                                 (int32_t) configData->numObs, sy);
 
     /*! - Construct the Pxy matrix (equation 26) which multiplies the Sigma-point cloud 
           by the measurement model cloud (weighted) to get the total Pxy matrix*/
-    mSetZero(pXY, configData->numStates, configData->numObs);
-    for(i=0; i<2*configData->countHalfSPs+1; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[i*configData->numObs]), tempYVec);
-        vSubtract(&(configData->SP[i*configData->numStates]), configData->numStates,
-                  configData->xBar, xHat);
-        vScale(configData->wC[i], xHat, configData->numStates, xHat);
-        mMultM(xHat, configData->numStates, 1, tempYVec, 1, configData->numObs,
-            kMat);
-        mAdd(pXY, configData->numStates, configData->numObs, kMat, pXY);
-    }
+    ukfCoreCrossCovar(configData->SP, configData->xBar, configData->yMeas, yBar,
+                      configData->wC, (int32_t) configData->numObs, pXY);
 
-    /*! - Then we need to invert the SyT*Sy matrix to get the Kalman gain factor.  Since
-          The Sy matrix is lower triangular, we can do a back-sub inversion instead of 
-          a full matrix inversion.  That is the ukfUInv and ukfLInv calls below.  Once that 
-          multiplication is done (equation 27), we have the Kalman Gain.*/
-    badUpdate += ukfUInv(syT, configData->numObs, configData->numObs, syInv);
-    
-    mMultM(pXY, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    badUpdate += ukfLInv(sy, configData->numObs, configData->numObs, syInv);
-    mMultM(kMat, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    
-    
-    /*! - Difference the yBar and the observations to get the observed error and 
-          multiply by the Kalman Gain to get the state update.  Add the state update 
-          to the state to get the updated state value (equation 27).*/
-    vSubtract(configData->obs, configData->numObs, yBar, tempYVec);
-    mMultM(kMat, configData->numStates, configData->numObs, tempYVec,
-        configData->numObs, 1, xHat);
-    vAdd(configData->state, configData->numStates, xHat, configData->state);
-    /*! - Compute the updated matrix U from equation 28.  Note that I then transpose it 
-         so that I can extract "columns" from adjacent memory*/
-    mMultM(kMat, configData->numStates, configData->numObs, sy,
-           configData->numObs, configData->numObs, Umat);
-    mTranspose(Umat, configData->numStates, configData->numObs, Umat);
-    /*! - For each column in the update matrix, perform a cholesky down-date on it to
-     get the total shifted S matrix (called sBar in internal parameters*/
-    for(i=0; i<configData->numObs; i++)
-    {
-        vCopy(&(Umat[i*configData->numStates]), configData->numStates, Ucol);
-        badUpdate += ukfCholDownDate(configData->sBar, Ucol, -1.0, configData->numStates, sBarT);
-        mCopy(sBarT, configData->numStates, configData->numStates,
-              configData->sBar);
-    }
+    /*! - Compute the Kalman gain (equation 27) using triangular back-substitution on Sy,
+          apply the innovation to the state and down-date sBar with each column of the
+          update matrix U from equation 28*/
+    badUpdate += ukfCoreMeasUpdate(pXY, sy, configData->obs, yBar, (int32_t) configData->numObs,
+                                   configData->state, configData->sBar);
     /*! - Compute equivalent covariance based on updated sBar matrix*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               configData->covar);
-    mMultM(configData->sBar, configData->numStates, configData->numStates,
-           configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    ukfCoreCovar(configData->sBar, configData->covar);
     
     if (badUpdate<0){
         sunlineSuKFCleanUpdate(configData);
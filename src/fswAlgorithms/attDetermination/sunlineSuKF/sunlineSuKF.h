@@ -121,6 +121,7 @@ extern "C" {
 	int sunlineSuKFTimeUpdate(SunlineSuKFConfig *configData, double updateTime);
     int sunlineSuKFMeasUpdate(SunlineSuKFConfig *configData, double updateTime);
 	void sunlineStateProp(double *stateInOut,  double *b_vec, double dt);
+    void sunlineStatePropBatch(double *stateColumns, int numPoints, double *b_Vec, double dt);
     void sunlineSuKFMeasModel(SunlineSuKFConfig *configData);
     void sunlineSuKFComputeDCM_BS(double sunheading[SKF_N_STATES_HALF], double bVec[SKF_N_STATES_HALF], double *dcm);
     void sunlineSuKFSwitch(double *bVec_B, double *states, double *covar);
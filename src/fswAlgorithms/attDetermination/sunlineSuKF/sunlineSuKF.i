@@ -19,7 +19,7 @@
 %module sunlineSuKF
 %{
    #include "sunlineSuKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -37,7 +37,7 @@ GEN_SIZEOF(VehicleConfigFswMsg);
 GEN_SIZEOF(CSSConfigFswMsg);
 GEN_SIZEOF(SunlineSuKFConfig);
 %include "sunlineSuKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/vehicleConfigFswMsg.h"
 %include "../../fswMessages/sunlineFilterFswMsg.h"
 %include "../../fswMessages/cssConfigFswMsg.h"
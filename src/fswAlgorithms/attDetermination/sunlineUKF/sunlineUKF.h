@@ -99,6 +99,7 @@ extern "C" {
 	void sunlineUKFTimeUpdate(SunlineUKFConfig *configData, double updateTime);
     void sunlineUKFMeasUpdate(SunlineUKFConfig *configData, double updateTime);
 	void sunlineStateProp(double *stateInOut, double dt);
+    void sunlineStatePropBatch(double *stateColumns, int numPoints, double dt);
     void sunlineUKFMeasModel(SunlineUKFConfig *configData);
     
 #ifdef __cplusplus
@@ -19,7 +19,7 @@
 %module sunlineUKF
 %{
    #include "sunlineUKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -35,7 +35,7 @@ GEN_SIZEOF(SunlineFilterFswMsg);
 GEN_SIZEOF(CSSConfigFswMsg);
 GEN_SIZEOF(SunlineUKFConfig);
 %include "sunlineUKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/sunlineFilterFswMsg.h"
 %include "../../fswMessages/cssConfigFswMsg.h"
 
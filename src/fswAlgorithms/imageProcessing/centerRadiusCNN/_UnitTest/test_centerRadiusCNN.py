@@ -175,6 +175,59 @@ def cnnTest(show_plots, image, saveImage):
     return [testFailCount, ''.join(testMessages)]
 
 
+def runCnn(imageFilenames, batchSize=1, numThreads=0):
+    """Run the CNN on a single image, or on a list of images with one image per update, and return the circles"""
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    unitTestSim.TotalSim.terminateSimulation()
+
+    testProcessRate = macros.sec2nano(0.5)
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    moduleConfig = centerRadiusCNN.CenterRadiusCNN()
+    moduleConfig.ModelTag = "cnn"
+    unitTestSim.AddModelToTask(unitTaskName, moduleConfig)
+    moduleConfig.opnavCirclesOutMsgName = "circles"
+    moduleConfig.pathToNetwork = path + "/../CAD.onnx"
+    moduleConfig.pixelNoise = [5,5,5]
+    if len(imageFilenames) == 1:
+        moduleConfig.filename = imageFilenames[0]
+    else:
+        moduleConfig.imageFilenames = imageFilenames
+        moduleConfig.batchSize = batchSize
+        moduleConfig.numThreads = numThreads
+
+    unitTestSim.TotalSim.logThisMessage(moduleConfig.opnavCirclesOutMsgName, testProcessRate)
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(testProcessRate*max(len(imageFilenames) - 1, 1))
+    unitTestSim.ExecuteSimulation()
+
+    centers = unitTestSim.pullMessageLogData(moduleConfig.opnavCirclesOutMsgName + ".circlesCenters", list(range(10*2)))
+    radii = unitTestSim.pullMessageLogData(moduleConfig.opnavCirclesOutMsgName + ".circlesRadii", list(range(10)))
+    return np.column_stack((centers[:, 1:3], radii[:, 1]))
+
+
+@pytest.mark.skipif(importErr, reason= reasonErr)
+@pytest.mark.parametrize("batchSize, numThreads", [(1, 0), (3, 0), (3, 2), (2, 1)])
+def test_batchedImages(show_plots, batchSize, numThreads):
+    """
+    Unit test of the listed images evaluated by batches. Each update outputs the circle of the next listed image,
+    which must match the circle found when the image is evaluated on its own, whatever the batch size and the
+    number of inference threads.
+
+    """
+    images = [path + '/' + image for image in ["mars.jpg", "mars2.jpg", "mars3.jpg"]]
+    singleCircles = np.vstack([runCnn([image])[-1, :] for image in images])
+    batchCircles = runCnn(images, batchSize, numThreads)
+
+    assert batchCircles.shape == singleCircles.shape, "one circle message per listed image expected"
+    np.testing.assert_allclose(batchCircles, singleCircles, rtol=0.0, atol=1e-2,
+                               err_msg="batched circles differ from the single image circles")
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
@@ -25,6 +25,7 @@
 
 /* modify the path to reflect the new module names */
 #include <string.h>
+#include <algorithm>
 #include "centerRadiusCNN.h"
 #include <opencv2/dnn/dnn.hpp>
 
@@ -39,6 +40,10 @@ CenterRadiusCNN::CenterRadiusCNN()
         this->pixelNoise[i] = 5;
     }
     this->pathToNetwork = "./position_net2_trained_11-14.onnx";
+    this->batchSize = 1;
+    this->numThreads = 0;
+    this->frameIndex = 0;
+    this->batchStart = 0;
 }
 
 /*! Selfinit performs the first stage of initialization for this module.
@@ -56,7 +61,11 @@ void CenterRadiusCNN::SelfInit()
     this->positionNet2 = cv::dnn::readNetFromONNX(this->pathToNetwork);
     this->positionNet2.setPreferableBackend(cv::dnn::DNN_BACKEND_DEFAULT);
     this->positionNet2.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-    
+    /*! - Set the inference thread count, this is an OpenCV wide setting */
+    if (this->numThreads > 0){
+        cv::setNumThreads(this->numThreads);
+    }
+
     /*! - Create output message for module */
     this->opnavCirclesOutMsgID = SystemMessaging::GetInstance()->CreateNewMessage(this->opnavCirclesOutMsgName,sizeof(CirclesOpNavMsg),this->OutputBufferCount,"CirclesOpNavMsg",moduleID);
 }
@@ -87,9 +96,117 @@ CenterRadiusCNN::~CenterRadiusCNN()
  */
 void CenterRadiusCNN::Reset(uint64_t CurrentSimNanos)
 {
+    /*! - Restart the listed images from the first one */
+    this->frameIndex = 0;
+    this->batchStart = 0;
+    this->batchPredictions.clear();
+    this->batchImageSizes.clear();
     return;
 }
 
+/*! This method evaluates the CNN on a set of images of identical size with a single forward pass.
+ @return void
+ @param images The images to evaluate
+ @param predictions The center and radius predicted for each image
+ */
+void CenterRadiusCNN::evaluateImages(std::vector<cv::Mat> &images, std::vector<cv::Vec3f> &predictions)
+{
+    cv::Size blobSize(images[0].rows, images[0].cols);
+    cv::Mat imgBlob = cv::dnn::blobFromImages(images, 1.0/255.0, blobSize, cv::Scalar(0,0,0), true);
+
+    this->positionNet2.setInput(imgBlob);
+    cv::Mat output = this->positionNet2.forward();
+    predictions.resize(images.size());
+    for (int i=0; i<(int) images.size(); i++){
+        predictions[i] = cv::Vec3f(output.at<float>(i,0), output.at<float>(i,1), output.at<float>(i,2));
+    }
+}
+
+/*! This method reads up to batchSize listed images starting at firstFrame and evaluates them together.
+ The batch stops early at an image of a different size or at an unreadable image.
+ @return void
+ @param firstFrame Index of the first listed image of the batch
+ */
+void CenterRadiusCNN::evaluateBatch(size_t firstFrame)
+{
+    std::vector<cv::Mat> images;
+    std::vector<cv::Mat> singleImage(1);
+    std::vector<cv::Vec3f> singlePrediction;
+    cv::Mat imageCV;
+    size_t lastFrame = std::min(firstFrame + (size_t) std::max(this->batchSize, 1), this->imageFilenames.size());
+
+    this->batchStart = firstFrame;
+    this->batchPredictions.clear();
+    this->batchImageSizes.clear();
+    for (size_t i=firstFrame; i<lastFrame; i++){
+        imageCV = cv::imread(this->imageFilenames[i], cv::IMREAD_COLOR);
+        if (imageCV.empty()){
+            if (images.empty()){
+                /*! - An unreadable image makes a batch of its own without a prediction */
+                bskLogger.bskLog(BSK_WARNING, "CenterRadiusCNN could not read the image %s", this->imageFilenames[i].c_str());
+                this->batchImageSizes.push_back(cv::Size());
+                this->batchPredictions.push_back(cv::Vec3f());
+                return;
+            }
+            break;
+        }
+        if (!images.empty() && imageCV.size() != images[0].size()){
+            break;
+        }
+        images.push_back(imageCV);
+        this->batchImageSizes.push_back(imageCV.size());
+    }
+
+    try {
+        this->evaluateImages(images, this->batchPredictions);
+    }
+    catch (const cv::Exception &e) {
+        /*! - Networks exported with a fixed batch dimension only accept one image per pass */
+        if (images.size() == 1){
+            throw;
+        }
+        bskLogger.bskLog(BSK_WARNING, "CenterRadiusCNN network does not accept batches, falling back to batchSize 1");
+        this->batchSize = 1;
+        this->batchPredictions.resize(images.size());
+        for (size_t i=0; i<images.size(); i++){
+            singleImage[0] = images[i];
+            this->evaluateImages(singleImage, singlePrediction);
+            this->batchPredictions[i] = singlePrediction[0];
+        }
+    }
+}
+
+/*! This method writes the circle message for one prediction, only validating it if a circle was found.
+ @return void
+ @param prediction The predicted center and radius in pixels
+ @param rows Number of rows of the evaluated image
+ @param cols Number of columns of the evaluated image
+ @param CurrentSimNanos The clock time at which the message is written (nanoseconds)
+ */
+void CenterRadiusCNN::writeCircles(const cv::Vec3f &prediction, int rows, int cols, uint64_t CurrentSimNanos)
+{
+    CirclesOpNavMsg circleBuffer;
+    float x_pred = prediction[0]; // Neural net outputs floats
+    float y_pred = prediction[1];
+    float rad_pred = prediction[2];
+
+    memset(&circleBuffer, 0x0, sizeof(CirclesOpNavMsg));
+    /*!- If no circles are found do not validate the image as a measurement */
+    if (x_pred != rows/2 && y_pred != cols/2 && rad_pred != cols/4){
+        circleBuffer.valid = 1;
+        circleBuffer.cameraID = 1;
+        circleBuffer.planetIds[0] = 2;
+        circleBuffer.circlesCenters[0] = (double)x_pred; // Recasting to double, as per the message definition
+        circleBuffer.circlesCenters[1] = (double)y_pred;
+        circleBuffer.circlesRadii[0] = (double)rad_pred;
+        for (int j=0; j<3; j++){
+            circleBuffer.uncertainty[j+3*j] = this->pixelNoise[j];
+        }
+    }
+
+    SystemMessaging::GetInstance()->WriteMessage(this->opnavCirclesOutMsgID, CurrentSimNanos, sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t *>(&circleBuffer), this->moduleID);
+}
+
 /*! This module reads an OpNav image and extracts circle information from its content using OpenCV's HoughCircle Transform. It performs a greyscale, a bur, and a threshold on the image to facilitate circle-finding. 
  @return void
  @param CurrentSimNanos The clock time at which the function was called (nanoseconds)
@@ -100,6 +217,9 @@ void CenterRadiusCNN::UpdateState(uint64_t CurrentSimNanos)
     CameraImageMsg imageBuffer;
     CirclesOpNavMsg circleBuffer;
     cv::Mat imageCV, blurred;
+    std::vector<cv::Mat> images(1);
+    std::vector<cv::Vec3f> predictions;
+    size_t batchFrame;
     filenamePre = "PreprocessedImage_" + std::to_string(CurrentSimNanos*1E-9) + ".jpg";
 
     /*! - Load in the trained CNN model*/
@@ -118,10 +238,39 @@ void CenterRadiusCNN::UpdateState(uint64_t CurrentSimNanos)
     if (!this->filename.empty()){
         imageCV = imread(this->filename, cv::IMREAD_COLOR);
     }
+    else if (!this->imageFilenames.empty()){
+        /*! - Listed images are evaluated by batches, each update outputs the prediction of the next image */
+        if (this->frameIndex >= this->batchStart + this->batchPredictions.size() && this->frameIndex < this->imageFilenames.size()){
+            this->evaluateBatch(this->frameIndex);
+        }
+        batchFrame = this->frameIndex - this->batchStart;
+        this->frameIndex++;
+        if (batchFrame < this->batchPredictions.size() && this->batchImageSizes[batchFrame].area() > 0){
+            this->writeCircles(this->batchPredictions[batchFrame], this->batchImageSizes[batchFrame].height,
+                               this->batchImageSizes[batchFrame].width, CurrentSimNanos);
+        }
+        else{
+            SystemMessaging::GetInstance()->WriteMessage(this->opnavCirclesOutMsgID, CurrentSimNanos, sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t *>(&circleBuffer), this->moduleID);
+        }
+        return;
+    }
     else if(imageBuffer.valid == 1 && imageBuffer.timeTag >= CurrentSimNanos){
-        /*! - Recast image pointer to CV type*/
-        std::vector<unsigned char> vectorBuffer((char*)imageBuffer.imagePointer, (char*)imageBuffer.imagePointer + imageBuffer.imageBufferLength);
-        imageCV = cv::imdecode(vectorBuffer, cv::IMREAD_COLOR);
+        /*! - Recast image pointer to CV type. Raw frames are read in place, encoded ones are decoded without a copy*/
+        if (imageBuffer.imageFormat == IMAGE_FORMAT_RAW){
+            imageCV = cv::Mat(imageBuffer.imageHeight, imageBuffer.imageWidth, CV_8UC(imageBuffer.imageType),
+                              imageBuffer.imagePointer, (size_t) imageBuffer.imageStep);
+            /*! - The network takes 3 channel images, convert other raw frames the way imdecode does */
+            if (imageCV.channels() == 1){
+                cvtColor(imageCV, imageCV, cv::COLOR_GRAY2BGR);
+            }
+            else if (imageCV.channels() == 4){
+                cvtColor(imageCV, imageCV, cv::COLOR_BGRA2BGR);
+            }
+        }
+        else{
+            cv::Mat encodedBuffer(1, imageBuffer.imageBufferLength, CV_8UC1, imageBuffer.imagePointer);
+            imageCV = cv::imdecode(encodedBuffer, cv::IMREAD_COLOR);
+        }
         if (this->saveImages == 1){
             cv::imwrite(filenamePre, imageCV);
         }
@@ -132,29 +281,9 @@ void CenterRadiusCNN::UpdateState(uint64_t CurrentSimNanos)
         return;
     }
     /*!-  evaluate CNN on image */
-    cv::Mat img_blob = cv::dnn::blobFromImage(imageCV, 1.0/255.0, cv::Size(imageCV.rows,imageCV.cols), cv::Scalar(0,0,0), true);
-
-    positionNet2.setInput(img_blob);
-    cv::Mat output = positionNet2.forward();
-    float x_pred = output.at<float>(0,0); // Neural net outputs floats
-    float y_pred = output.at<float>(0,1);
-    float rad_pred = output.at<float>(0,2);
-    
-    /*!- If no circles are found do not validate the image as a measurement */
-    if (x_pred != imageCV.rows/2 && y_pred != imageCV.cols/2 && rad_pred != imageCV.cols/4){
-        circleBuffer.valid = 1;
-        circleBuffer.cameraID = 1;
-        circleBuffer.planetIds[0] = 2;
-        circleBuffer.circlesCenters[0] = (double)x_pred; // Recasting to double, as per the message definition
-        circleBuffer.circlesCenters[1] = (double)y_pred;
-        circleBuffer.circlesRadii[0] = (double)rad_pred;
-        for (int j=0; j<3; j++){
-            circleBuffer.uncertainty[j+3*j] = this->pixelNoise[j];
-        }
-    }
+    images[0] = imageCV;
+    this->evaluateImages(images, predictions);
+    this->writeCircles(predictions[0], imageCV.rows, imageCV.cols, CurrentSimNanos);
 
-    SystemMessaging::GetInstance()->WriteMessage(this->opnavCirclesOutMsgID, CurrentSimNanos, sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t *>(&circleBuffer), this->moduleID);
-    
     return;
 }
-
@@ -21,6 +21,7 @@
 #define _IMAGE_PROC_CNN_H_
 
 #include <stdint.h>
+#include <vector>
 #include <Eigen/Dense>
 #include "architecture/messaging/system_messaging.h"
 #include "opencv2/opencv.hpp"
@@ -31,6 +32,7 @@
 #include "../simulation/simFswInterfaceMessages/circlesOpNavMsg.h"
 #include "../simulation/_GeneralModuleFiles/sys_model.h"
 #include "../simulation/utilities/avsEigenMRP.h"
+#include "../simulation/utilities/bskLogging.h"
 
 /*! @brief The CNN based center radius visual tracking module. */
 class CenterRadiusCNN: public SysModel {
@@ -42,7 +44,12 @@ public:
     void SelfInit();
     void CrossInit();
     void Reset(uint64_t CurrentSimNanos);
-    
+
+private:
+    void evaluateBatch(size_t firstFrame);
+    void evaluateImages(std::vector<cv::Mat> &images, std::vector<cv::Vec3f> &predictions);
+    void writeCircles(const cv::Vec3f &prediction, int rows, int cols, uint64_t CurrentSimNanos);
+
 public:
     std::string filename;                //!< Filename for module to read an image directly
     std::string opnavCirclesOutMsgName;  //!< The name of the CirclesOpnavMsg output message
@@ -52,12 +59,20 @@ public:
     /* OpenCV specific arguments needed for HoughCircle finding*/
     int32_t saveImages;                  //!< [-] 1 to save images to file for debugging
     double pixelNoise[3];                 //!< [-] Pixel Noise for the estimate
+    std::vector<std::string> imageFilenames; //!< Ordered list of images for offline runs, one image is used per update
+    int32_t batchSize;                   //!< [-] Number of listed images evaluated in one forward pass of the CNN
+    int32_t numThreads;                  //!< [-] Number of threads used by OpenCV for the inference, 0 keeps the default
+    BSKLogger bskLogger;                 //!< -- BSK Logging
 
 private:
     uint64_t OutputBufferCount;          //!< [-] Count on the number of output message buffers
     int32_t opnavCirclesOutMsgID;        //!< ID for the outgoing message
     int32_t imageInMsgID;                //!< ID for the outgoing message
     cv::dnn::Net positionNet2;           //!< Network for evaluation of centers
+    size_t frameIndex;                   //!< [-] Index of the next listed image to output
+    size_t batchStart;                   //!< [-] Index of the first listed image of the evaluated batch
+    std::vector<cv::Vec3f> batchPredictions; //!< [-] Center and radius predictions of the evaluated batch
+    std::vector<cv::Size> batchImageSizes;   //!< [-] Image sizes of the evaluated batch, empty if unreadable
 };
 
 
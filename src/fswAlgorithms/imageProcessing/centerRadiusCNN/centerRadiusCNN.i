@@ -26,6 +26,10 @@ from Basilisk.simulation.swig_common_model import *
 %}
 %include "stdint.i"
 %include "std_string.i"
+%include "std_vector.i"
+namespace std {
+    %template(StringVector) vector<string>;
+}
 %include "swig_conly_data.i"
 %include "sys_model.h"
 %include "centerRadiusCNN.h"
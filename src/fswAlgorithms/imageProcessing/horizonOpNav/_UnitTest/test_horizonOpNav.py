@@ -140,6 +140,39 @@ def horizonOpNav_methods():
         testFailCount += 1
         testMessages.append("BackSub Failure " + "\n")
 
+    ###################################################################################
+    ## Testing the row by row QR update
+    ###################################################################################
+    RAdd = horizonOpNav.new_doubleArray(3 * 3)
+    QTrhsAdd = horizonOpNav.new_doubleArray(3)
+    rowIn = horizonOpNav.new_doubleArray(3)
+    for j in range(3 * 3):
+        horizonOpNav.doubleArray_setitem(RAdd, j, 0)
+    for j in range(3):
+        horizonOpNav.doubleArray_setitem(QTrhsAdd, j, 0)
+    for i in range(numStates):
+        for j in range(3):
+            horizonOpNav.doubleArray_setitem(rowIn, j, float(Hinput[i, j]))
+        horizonOpNav.QRAddRow(rowIn, 1.0, RAdd, QTrhsAdd)
+
+    RAddOut = []
+    for j in range(3 * 3):
+        RAddOut.append(horizonOpNav.doubleArray_getitem(RAdd, j))
+    QTrhsAddOut = []
+    for j in range(3):
+        QTrhsAddOut.append(horizonOpNav.doubleArray_getitem(QTrhsAdd, j))
+
+    errorNorm1 = np.linalg.norm(Rpy - np.array(RAddOut).reshape(3, 3))
+    errorNorm2 = np.linalg.norm(np.dot(Qpy.T, np.ones(numStates)) - np.array(QTrhsAddOut))
+    if (errorNorm1 > 1.0E-10):
+        print(errorNorm1, "QR row update")
+        testFailCount += 1
+        testMessages.append("QR row update Failure in R" + "\n")
+    if (errorNorm2 > 1.0E-10):
+        print(errorNorm2, "QR row update")
+        testFailCount += 1
+        testMessages.append("QR row update Failure in Q^T.1" + "\n")
+
     return [testFailCount, ''.join(testMessages)]
 
 ###################################################################################
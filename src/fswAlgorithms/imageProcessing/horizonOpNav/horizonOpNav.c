@@ -19,7 +19,6 @@
 
 #include <math.h>
 #include <string.h>
-#include <stdlib.h>
 #include "horizonOpNav.h"
 
 
@@ -121,6 +120,9 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
     int32_t numPoints;
     double sigma_pix;
     numPoints = limbIn.numLimbPoints;
+    if (numPoints > MAX_LIMB_PNTS){
+        numPoints = MAX_LIMB_PNTS;
+    }
     sigma_pix = configData->noiseSF*cameraSpecs.resolution[0]/(numPoints);
     
     /*! Build DCMs */
@@ -134,13 +136,10 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
     /*! - Find pixel size using camera specs */
     double d_x, d_y, u_p, v_p, tranf[3][3], alpha;
     double R_s[3][3], s[3], J[3];
+    double *H;
     int i;
-    double *H, *s_bar, *R_yInv;
-    H = malloc(MAX_LIMB_PNTS*3*sizeof(double)); /*! Matrix of all the limb points*/
-    s_bar = malloc(MAX_LIMB_PNTS*3*sizeof(double)); /*! variables for covariance */
-    R_yInv = malloc(MAX_LIMB_PNTS*MAX_LIMB_PNTS*sizeof(double));
+    H = configData->limbDirections; /*! Matrix of all the limb points, kept in the module workspace */
     
-    vSetZero(H, MAX_LIMB_PNTS*3);
     /* To do: replace alpha by a skew read from the camera message */
     alpha = 0;
     double pX, pY;
@@ -160,12 +159,18 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
     /*! Rotate R_s with B eq (52) in Journal*/
     m33MultM33(B, R_s, R_s);
     m33MultM33t(R_s, B, R_s);
-    mSetZero(R_yInv, numPoints, numPoints);
 
+    /*! Need to solve Hn = 1, for n. If we performa  QR decomp on H, the problem becomes:
+     Rn = Q^T.1*/
+    double R_decomp[3*3], jTemp[3];
+    double RHS_vec[3], n[3], IminusOuter[3][3], outer[3][3], sNorm;
+    double scaleFactor, nNorm2; /*! Useful scalars for the rest of the implementation */
+    vSetZero(R_decomp, 3*3);
+    v3SetZero(RHS_vec);
 
-    /*! Create the H matrix. This is the stacked vector of all the limb points eq (33) in Engineering Note attached*/
-    for (i=0; i<numPoints && i<MAX_LIMB_PNTS;i++){
-        v3SetZero(s);
+    /*! Create the H matrix. This is the stacked vector of all the limb points eq (33) in Engineering Note attached.
+     Each row is folded into R and Q^T.1 as soon as it is computed, so Q is never formed */
+    for (i=0; i<numPoints;i++){
         /*! - Put the pixel data in s (not s currently)*/
         s[0] = limbIn.limbPoints[2*i];
         s[1] = limbIn.limbPoints[2*i + 1];
@@ -174,55 +179,36 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
         m33MultV3(tranf, s, s);
         /*! - Rotate the Vector in the inertial frame*/
         m33MultV3(B, s, s);
-        /*! - We now have s_bar in the Journal Paper, store to later compute J for uncertainty*/
-        v3Copy(s, &s_bar[3*i]);
-        v3Normalize(s, s);
-        v3Copy(s, &H[i*3]);
+        /*! - We now have s_bar in the Journal Paper, store its norm and direction to later compute J for uncertainty*/
+        configData->limbNorms[i] = v3Norm(s);
+        v3Normalize(s, &H[3*i]);
+        /*! - QR update with a copy of the new row of H */
+        v3Copy(&H[3*i], s);
+        QRAddRow(s, 1.0, R_decomp, RHS_vec);
     }
-
-    /*! Need to solve Hn = 1, for n. If we performa  QR decomp on H, the problem becomes:
-     Rn = Q^T.1*/
-    /*! Perform the QR decompostion of H, this will */
-    double R_decomp[3*3], jTemp[3];
-    double RHS_vec[3], n[3], IminusOuter[3][3], outer[3][3], sNorm;
-    double scaleFactor, nNorm2, sbarPrime[3]; /*! Useful scalars for the rest of the implementation */
-    double *Q_decomp, *ones;
-    Q_decomp = malloc(MAX_LIMB_PNTS*3*sizeof(double));
-    ones = malloc(MAX_LIMB_PNTS*sizeof(double));
-    
-    /*! - QR decomp */
-    QRDecomp(H, numPoints, Q_decomp, R_decomp);
     /*! Backsub to get n */
-    v3SetZero(RHS_vec);
-    vSetOnes(ones, numPoints);
-    mtMultV(Q_decomp, numPoints, 3, ones, RHS_vec);
     BackSub(R_decomp, RHS_vec, 3, n);
 
-    /*! - With all the s_bar terms, and n, we can compute J eq(50) in journal, and get uncertainty */
+    /*! - With all the s_bar terms, and n, we can compute J eq(50) in journal, and get uncertainty.
+     The weights R_yInv are diagonal, so H^T.R_yInv.H is accumulated one limb point at a time */
+    double Pn[3][3];
+    double F[3][3];
+    m33SetZero(Pn);
     for (i=0; i<numPoints;i++){
-        v3SetZero(J);
-        sNorm = v3Norm(&s_bar[3*i]);
+        sNorm = configData->limbNorms[i];
         m33SetIdentity(IminusOuter);
         /*! - Equation 31 in Journal*/
-        v3Normalize(&s_bar[3*i], sbarPrime);
-        v3OuterProduct(sbarPrime, sbarPrime, outer);
+        v3OuterProduct(&H[3*i], &H[3*i], outer);
         m33Subtract(IminusOuter, outer, IminusOuter);
         /*! - Rotate the Vector in the inertial frame*/
         v3tMultM33(n, IminusOuter, J);
         v3Scale(1/sNorm, J, J);
         v3tMultM33(J, R_s, jTemp);
-        R_yInv[numPoints*i+i] = 1/v3Dot(jTemp, J);
+        m33Scale(1/v3Dot(jTemp, J), outer, outer);
+        m33Add(Pn, outer, Pn);
     }
     
-    /*! - Covar from least squares - probably the most computationally expensive segment*/
-    double Pn[3][3];
-    double F[3][3];
-    double* Rtemp;
-    Rtemp = malloc(MAX_LIMB_PNTS*3*sizeof(double));
-    
-    m33SetIdentity(Pn);
-    mMultM(R_yInv, numPoints, numPoints, H, numPoints, 3, Rtemp);
-    mtMultM(H, numPoints, 3, Rtemp, numPoints, 3, Pn);
+    /*! - Covar from least squares */
     m33Inverse(Pn, Pn);
     
     /*! - Compute Scale factor now that n is computed */
@@ -265,14 +251,6 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
     WriteMessage(configData->stateOutMsgID, callTime, sizeof(OpNavFswMsg),
                  &opNavMsgOut, moduleID);
 
-    /* free allocated memory */
-    free(H);
-    free(s_bar);
-    free(R_yInv);
-    free(Rtemp);
-    free(ones);
-    free(Q_decomp);
-
     return;
 }
 
@@ -286,38 +264,72 @@ void Update_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64
  */
 void QRDecomp(double *inMat, int32_t nRow, double *Q , double *R)
 {
-    int32_t i, j;
-    double *sourceMatT, *QT;
-    double* proj;
-    proj = malloc(nRow*sizeof(double));
-    sourceMatT = malloc(MAX_LIMB_PNTS*3*sizeof(double));
-    QT = malloc(MAX_LIMB_PNTS*3*sizeof(double));
+    int32_t i, j, k;
+    double dot;
 
-    mSetZero(Q, nRow, 3);
-    mSetZero(sourceMatT, 3, MAX_LIMB_PNTS);
-    mSetZero(QT, 3, MAX_LIMB_PNTS);
     mSetZero(R, 3, 3);
-    mTranspose(inMat, nRow, 3, sourceMatT);
-    
+    /*! - Modified Gram-Schmidt on the columns, working directly in the row-major Q */
     for (i = 0; i<3; i++){
-        vSetZero(proj, nRow);
-        vCopy(&sourceMatT[i*nRow], nRow, &QT[i*nRow]);
+        for (k = 0; k<nRow; k++){
+            Q[k*3+i] = inMat[k*3+i];
+        }
         for (j = 0; j<i; j++)
         {
-            R[j*3+i] = vDot(&QT[i*nRow], nRow, &QT[j*nRow]);
-            vScale(-R[j*3+i], &QT[j*nRow], nRow, proj);
-            vAdd(&QT[i*nRow], nRow, proj, &QT[i*nRow]);
+            dot = 0.0;
+            for (k = 0; k<nRow; k++){
+                dot += Q[k*3+i] * Q[k*3+j];
+            }
+            R[j*3+i] = dot;
+            for (k = 0; k<nRow; k++){
+                Q[k*3+i] += Q[k*3+j] * -dot;
+            }
+        }
+        dot = 0.0;
+        for (k = 0; k<nRow; k++){
+            dot += Q[k*3+i] * Q[k*3+i];
+        }
+        R[i*3+i] = sqrt(dot);
+        for (k = 0; k<nRow; k++){
+            Q[k*3+i] = Q[k*3+i] * (1/R[i*3+i]);
         }
-        R[i*3+i] = vNorm(&QT[i*nRow], nRow);
-        vScale(1/R[i*3+i], &QT[i*nRow], nRow,  &QT[i*nRow]);
     }
-    mTranspose(QT, 3, nRow, Q);
 
-    /* free allocated memory */
-    free(proj);
-    free(sourceMatT);
-    free(QT);
-    
+    return;
+}
+
+/*! This adds one row to a QR decomposition of a n x 3 matrix using Givens rotations, without storing Q. After
+ all the rows of H and right-hand-side entries of V have been added, R and Q^T.V are the ones found by QRDecomp
+ (R with a positive diagonal) and Rn = Q^T.V can be solved with BackSub. R and QTrhs must be zeroed before the first row.
+ @return void
+ @param row   The new row of the matrix (3), it is overwritten
+ @param rhs   The right-hand-side entry associated with the row
+ @param R     The upper triangular R matrix (3 x 3), updated in place
+ @param QTrhs The Q^T.V vector (3), updated in place
+ */
+void QRAddRow(double *row, double rhs, double *R, double *QTrhs)
+{
+    int32_t i, j;
+    double c, s, r, temp;
+
+    for (i = 0; i<3; i++){
+        if (row[i] == 0.0){
+            continue;
+        }
+        /*! - Rotation zeroing the i-th entry of the row against the diagonal of R */
+        r = sqrt(R[i*3+i]*R[i*3+i] + row[i]*row[i]);
+        c = R[i*3+i]/r;
+        s = row[i]/r;
+        R[i*3+i] = r;
+        for (j = i+1; j<3; j++){
+            temp = R[i*3+j];
+            R[i*3+j] = c*temp + s*row[j];
+            row[j] = c*row[j] - s*temp;
+        }
+        temp = QTrhs[i];
+        QTrhs[i] = c*temp + s*rhs;
+        rhs = c*rhs - s*temp;
+    }
+
     return;
 }
 
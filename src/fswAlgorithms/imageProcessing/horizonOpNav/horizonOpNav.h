@@ -44,6 +44,8 @@ typedef struct {
     int32_t attInMsgID;    //!< [-] The ID associated with the outgoing message
     int32_t limbInMsgID;    //!< [-] The ID associated with the incoming circle message
     int32_t cameraConfigMsgID;  //!< [-] The ID associated with the incoming camera config message
+    double limbDirections[3*MAX_LIMB_PNTS]; //!< [-] Workspace: unit directions of the limb points, the rows of H
+    double limbNorms[MAX_LIMB_PNTS];  //!< [-] Workspace: norm of each limb direction before normalization
     BSKLogger *bskLogger;                             //!< BSK Logging
 }HorizonOpNavData;
 
@@ -57,6 +59,7 @@ extern "C" {
         uint64_t moduleID);
     void Reset_horizonOpNav(HorizonOpNavData *configData, uint64_t callTime, uint64_t moduleID);
     void QRDecomp(double *inMat, int32_t nRow, double *Q , double *R);
+    void QRAddRow(double *row, double rhs, double *R, double *QTrhs);
     void BackSub(double *R, double *inVec, int32_t nRow, double *n);
     
 #ifdef __cplusplus
@@ -195,6 +195,90 @@ def houghCirclesTest(show_plots, image, blur, maxCircles , minDist , minRad, can
     return [testFailCount, ''.join(testMessages)]
 
 
+@pytest.mark.skipif(importErr, reason= reasonErr)
+@pytest.mark.parametrize("usePrior", [False, True])
+def test_roiTracking(show_plots, usePrior):
+    """
+    Unit test for the region of interest mode of Hough Circles. The Mars image is processed over several updates,
+    either around the circle tracked in the previous image or around a circles prior message. The circle found in
+    the region of interest must match the circle found in the full image.
+    """
+    [testResults, testMessage] = roiTrackingTest(show_plots, usePrior)
+    assert testResults < 1, testMessage
+
+
+def roiTrackingTest(show_plots, usePrior):
+    testFailCount = 0
+    testMessages = []
+
+    # Reference circle found in the full image
+    fullValid, fullCenters, fullRadii = runRoiSim(0, False)
+    valid, centers, radii = runRoiSim(1, usePrior)
+
+    if show_plots:
+        print(fullCenters[0, 1:], fullRadii[0, 1:], centers[:, 1:], radii[:, 1:])
+
+    for k in range(len(valid[:, 0])):
+        if valid[k, 1] != 1:
+            testFailCount += 1
+            testMessages.append("ROI tracking lost the circle at update " + str(k) + ". ")
+        if np.any(np.abs(centers[k, 1:] - fullCenters[0, 1:]) > 2) or np.abs(radii[k, 1] - fullRadii[0, 1]) > 2:
+            testFailCount += 1
+            testMessages.append("ROI circle differs from the full image circle at update " + str(k) + ". ")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+def runRoiSim(roiMode, usePrior):
+    imagePath = path + '/mars.png'
+    input_image = Image.open(imagePath)
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProcessRate = macros.sec2nano(0.5)
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    moduleConfig = houghCircles.HoughCircles()
+    moduleConfig.ModelTag = "houghCircles"
+    unitTestSim.AddModelToTask(unitTaskName, moduleConfig)
+    moduleConfig.imageInMsgName = "sample_image"
+    moduleConfig.opnavCirclesOutMsgName = "circles"
+    moduleConfig.filename = imagePath
+    moduleConfig.expectedCircles = 1
+    moduleConfig.cannyThresh = 200
+    moduleConfig.voteThresh = 20
+    moduleConfig.houghMinDist = 50
+    moduleConfig.houghMinRadius = 20
+    moduleConfig.blurrSize = 5
+    moduleConfig.houghMaxRadius = int(input_image.size[0]/1.25)
+    moduleConfig.roiMode = roiMode
+    moduleConfig.roiMargin = 20
+
+    inputMessageData = houghCircles.CameraImageMsg()
+    inputMessageData.timeTag = int(1E9)
+    inputMessageData.cameraID = 1
+    unitTestSupport.setMessage(unitTestSim.TotalSim, unitProcessName, moduleConfig.imageInMsgName, inputMessageData)
+    if usePrior:
+        moduleConfig.circlesPriorInMsgName = "circles_prior"
+        priorMessageData = houghCircles.CirclesOpNavMsg()
+        priorMessageData.valid = 1
+        priorMessageData.circlesCenters = [250, 260]
+        priorMessageData.circlesRadii = [110]
+        unitTestSupport.setMessage(unitTestSim.TotalSim, unitProcessName, moduleConfig.circlesPriorInMsgName,
+                                   priorMessageData)
+
+    unitTestSim.TotalSim.logThisMessage(moduleConfig.opnavCirclesOutMsgName, testProcessRate)
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(2.0))
+    unitTestSim.ExecuteSimulation()
+
+    valid = unitTestSim.pullMessageLogData(moduleConfig.opnavCirclesOutMsgName + ".valid", list(range(1)))
+    centers = unitTestSim.pullMessageLogData(moduleConfig.opnavCirclesOutMsgName + ".circlesCenters", list(range(2)))
+    radii = unitTestSim.pullMessageLogData(moduleConfig.opnavCirclesOutMsgName + ".circlesRadii", list(range(1)))
+    return valid, centers, radii
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
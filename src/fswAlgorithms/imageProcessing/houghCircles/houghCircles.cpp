@@ -46,6 +46,10 @@ HoughCircles::HoughCircles()
     this->houghMinDist = 50;
     this->houghMinRadius = 0;
     this->houghMaxRadius = 0; // Maximum circle radius. If <= 0, uses the maximum image dimension. If < 0, returns centers without finding the radius
+    this->circlesPriorInMsgName = "";
+    this->roiMode = 0;
+    this->roiMargin = 20;
+    this->trackValid = 0;
 }
 
 /*! Selfinit performs the first stage of initialization for this module.
@@ -67,6 +71,10 @@ void HoughCircles::CrossInit()
 {
     /*! - Get the image data message ID*/
     this->imageInMsgID = SystemMessaging::GetInstance()->subscribeToMessage(this->imageInMsgName,sizeof(CameraImageMsg), moduleID);
+    /*! - Get the optional circles prior message ID*/
+    if(this->circlesPriorInMsgName != ""){
+        this->circlesPriorInMsgID = SystemMessaging::GetInstance()->subscribeToMessage(this->circlesPriorInMsgName,sizeof(CirclesOpNavMsg), moduleID);
+    }
 }
 
 /*! This is the destructor */
@@ -82,9 +90,93 @@ HoughCircles::~HoughCircles()
  */
 void HoughCircles::Reset(uint64_t CurrentSimNanos)
 {
+    /*! - Forget the tracked circles, the next image is processed in full */
+    this->trackValid = 0;
     return;
 }
 
+/*! This method finds the circles in a window of the image. It performs a greyscale, a threshold and a blur on the window
+ before the HoughCircle Transform, and returns the circles in full image pixels.
+ @return void
+ @param imageCV The full image
+ @param window The processed window of the image
+ @param circles The circles found as x, y, radius and votes
+ */
+void HoughCircles::findCircles(const cv::Mat &imageCV, const cv::Rect &window, std::vector<cv::Vec4f> &circles)
+{
+    cv::Mat greyImage, blurred;
+
+    /*! - Greyscale the window, single channel raw frames are copied as the threshold is applied in place */
+    if (imageCV.channels() == 1){
+        imageCV(window).copyTo(greyImage);
+    }
+    else{
+        cv::cvtColor( imageCV(window), greyImage, cv::COLOR_BGR2GRAY);
+    }
+    cv::threshold(greyImage, greyImage, 15, 255, cv::THRESH_BINARY_INV);
+    cv::blur(greyImage, blurred, cv::Size(this->blurrSize,this->blurrSize) );
+
+    /*! - Apply the Hough Transform to find the circles*/
+    cv::HoughCircles( blurred, circles, cv::HOUGH_GRADIENT, this->dpValue, this->houghMinDist, this->cannyThresh,this->voteThresh, this->houghMinRadius, this->houghMaxRadius );
+    /*! - Shift the centers back to full image pixels */
+    for (size_t i = 0; i < circles.size(); i++){
+        circles[i][0] += window.x;
+        circles[i][1] += window.y;
+    }
+}
+
+/*! This method computes the smallest window of the image containing a set of circles grown by a margin.
+ @return cv::Rect
+ @param centers The circle centers as x, y pairs in pixels
+ @param radii The circle radii in pixels
+ @param numCircles The number of circles
+ @param fullFrame The full image the window is clipped to
+ @param margin [px] The margin added around the circles
+ */
+cv::Rect HoughCircles::circlesWindow(const double *centers, const double *radii, int numCircles, const cv::Rect &fullFrame, int32_t margin)
+{
+    cv::Rect window;
+    for (int i = 0; i < numCircles; i++){
+        double extent = radii[i] + margin;
+        cv::Rect box(cv::Point(cvFloor(centers[2*i] - extent), cvFloor(centers[2*i+1] - extent)),
+                     cv::Point(cvCeil(centers[2*i] + extent) + 1, cvCeil(centers[2*i+1] + extent) + 1));
+        window = (i == 0) ? box : (window | box);
+    }
+    return window & fullFrame;
+}
+
+/*! This method picks the window to process: around the circles prior if one is provided and valid, else around the
+ circles tracked in the last image, else the full image.
+ @return cv::Rect
+ @param fullFrame The full image
+ */
+cv::Rect HoughCircles::predictWindow(const cv::Rect &fullFrame)
+{
+    CirclesOpNavMsg priorBuffer;
+    SingleMessageHeader localHeader;
+    cv::Rect window = fullFrame;
+    int numCircles = 0;
+
+    if (this->circlesPriorInMsgName != ""){
+        memset(&priorBuffer, 0x0, sizeof(CirclesOpNavMsg));
+        SystemMessaging::GetInstance()->ReadMessage(this->circlesPriorInMsgID, &localHeader,
+                                                    sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t*>(&priorBuffer), this->moduleID);
+        while (numCircles < MAX_CIRCLE_NUM && priorBuffer.circlesRadii[numCircles] > 0){
+            numCircles++;
+        }
+    }
+    if (numCircles > 0 && priorBuffer.valid == 1){
+        window = this->circlesWindow(priorBuffer.circlesCenters, priorBuffer.circlesRadii, numCircles, fullFrame, this->roiMargin);
+    }
+    else if (this->trackValid == 1){
+        window = this->trackWindow & fullFrame;
+    }
+    if (window.area() == 0){
+        window = fullFrame;
+    }
+    return window;
+}
+
 /*! This module reads an OpNav image and extracts circle information from its content using OpenCV's HoughCircle Transform. It performs a greyscale, a bur, and a threshold on the image to facilitate circle-finding. 
  @return void
  @param CurrentSimNanos The clock time at which the function was called (nanoseconds)
@@ -97,8 +189,11 @@ void HoughCircles::UpdateState(uint64_t CurrentSimNanos)
     memset(&imageBuffer, 0x0, sizeof(CameraImageMsg));
     memset(&circleBuffer, 0x0, sizeof(CirclesOpNavMsg));
     
-    cv::Mat imageCV, blurred;
+    cv::Mat imageCV;
+    cv::Rect fullFrame, window, circleBox;
+    std::vector<cv::Vec4f> circles;
     int circlesFound=0;
+    bool circlesInWindow;
     if (this->saveDir != ""){
         dirName = this->saveDir + std::to_string(CurrentSimNanos*1E-9) + ".jpg";
     }
@@ -116,9 +211,15 @@ void HoughCircles::UpdateState(uint64_t CurrentSimNanos)
         imageCV = cv::imread(this->filename, cv::IMREAD_COLOR);
     }
     else if(imageBuffer.valid == 1 && imageBuffer.timeTag >= CurrentSimNanos){
-        /*! - Recast image pointer to CV type*/
-        std::vector<unsigned char> vectorBuffer((char*)imageBuffer.imagePointer, (char*)imageBuffer.imagePointer + imageBuffer.imageBufferLength);
-        imageCV = cv::imdecode(vectorBuffer, cv::IMREAD_COLOR);
+        /*! - Recast image pointer to CV type. Raw frames are read in place, encoded ones are decoded without a copy*/
+        if (imageBuffer.imageFormat == IMAGE_FORMAT_RAW){
+            imageCV = cv::Mat(imageBuffer.imageHeight, imageBuffer.imageWidth, CV_8UC(imageBuffer.imageType),
+                              imageBuffer.imagePointer, (size_t) imageBuffer.imageStep);
+        }
+        else{
+            cv::Mat encodedBuffer(1, imageBuffer.imageBufferLength, CV_8UC1, imageBuffer.imagePointer);
+            imageCV = cv::imdecode(encodedBuffer, cv::IMREAD_COLOR);
+        }
         if (this->saveImages == 1){
             cv::imwrite(this->saveDir, imageCV);
         }
@@ -128,13 +229,26 @@ void HoughCircles::UpdateState(uint64_t CurrentSimNanos)
         SystemMessaging::GetInstance()->WriteMessage(this->opnavCirclesOutMsgID, CurrentSimNanos, sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t *>(&circleBuffer), this->moduleID);
         return;}
 
-    cv::cvtColor( imageCV, imageCV, cv::COLOR_BGR2GRAY);
-    cv::threshold(imageCV, imageCV, 15, 255, cv::THRESH_BINARY_INV);
-    cv::blur(imageCV, blurred, cv::Size(this->blurrSize,this->blurrSize) );
-    
-    std::vector<cv::Vec4f> circles;
-    /*! - Apply the Hough Transform to find the circles*/
-    cv::HoughCircles( blurred, circles, cv::HOUGH_GRADIENT, this->dpValue, this->houghMinDist, this->cannyThresh,this->voteThresh, this->houghMinRadius, this->houghMaxRadius );
+    /*! - Only process the region of interest around the predicted circles in ROI mode */
+    fullFrame = cv::Rect(0, 0, imageCV.cols, imageCV.rows);
+    window = fullFrame;
+    if (this->roiMode == 1){
+        window = this->predictWindow(fullFrame);
+    }
+    this->findCircles(imageCV, window, circles);
+    if (window != fullFrame){
+        /*! - Fall back to the full image if the circles were lost or cut by the region of interest */
+        circlesInWindow = !circles.empty();
+        for (int i = 0; i < this->expectedCircles && i < (int) circles.size(); i++){
+            double center[2] = {circles[i][0], circles[i][1]};
+            double radius = circles[i][2];
+            circleBox = this->circlesWindow(center, &radius, 1, fullFrame, 0);
+            circlesInWindow = circlesInWindow && (circleBox & window) == circleBox;
+        }
+        if (!circlesInWindow){
+            this->findCircles(imageCV, fullFrame, circles);
+        }
+    }
 
     circleBuffer.timeTag = this->sensorTimeTag;
     circleBuffer.cameraID = imageBuffer.cameraID;
@@ -153,6 +267,11 @@ void HoughCircles::UpdateState(uint64_t CurrentSimNanos)
         circleBuffer.valid = 1;
         circleBuffer.planetIds[0] = 2;
     }
+    /*! - Track the found circles for the region of interest of the next image */
+    this->trackValid = circlesFound > 0 ? 1 : 0;
+    if (this->trackValid == 1){
+        this->trackWindow = this->circlesWindow(circleBuffer.circlesCenters, circleBuffer.circlesRadii, circlesFound, fullFrame, this->roiMargin);
+    }
     
     SystemMessaging::GetInstance()->WriteMessage(this->opnavCirclesOutMsgID, CurrentSimNanos, sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t *>(&circleBuffer), this->moduleID);
 
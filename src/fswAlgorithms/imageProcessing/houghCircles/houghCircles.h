@@ -46,12 +46,18 @@ public:
     void SelfInit();
     void CrossInit();
     void Reset(uint64_t CurrentSimNanos);
-    
+
+private:
+    void findCircles(const cv::Mat &imageCV, const cv::Rect &window, std::vector<cv::Vec4f> &circles);
+    cv::Rect circlesWindow(const double *centers, const double *radii, int numCircles, const cv::Rect &fullFrame, int32_t margin);
+    cv::Rect predictWindow(const cv::Rect &fullFrame);
+
 public:
     std::string filename;                //!< Filename for module to read an image directly
     std::string opnavCirclesOutMsgName;  //!< The name of the CirclesOpnavMsg output message
     std::string imageInMsgName;          //!< The name of the ImageFswMsg output message
     std::string saveDir;                //!< The name of the directory to save images
+    std::string circlesPriorInMsgName;  //!< The name of the optional CirclesOpNavMsg used to place the region of interest
     uint64_t sensorTimeTag;              //!< [ns] Current time tag for sensor out
     /* OpenCV specific arguments needed for HoughCircle finding*/
     int32_t blurrSize;                   //!< [px] Size of the blurring box in pixels
@@ -64,11 +70,16 @@ public:
     double noiseSF;                      //!< [-] Scale Factor for noise control
     int32_t expectedCircles;             //!< [-] Number of expected circles to be found
     int32_t saveImages;                  //!< [-] 1 to save images to file for debugging
+    int32_t roiMode;                     //!< [-] 1 to only process a region of interest around the tracked circles
+    int32_t roiMargin;                   //!< [px] Margin added around the tracked circles to form the region of interest
     BSKLogger bskLogger;                //!< -- BSK Logging
 private:
     uint64_t OutputBufferCount;          //!< [-] Count on the number of output message buffers
     int32_t opnavCirclesOutMsgID;        //!< ID for the outgoing message
     int32_t imageInMsgID;                //!< ID for the outgoing message
+    int32_t circlesPriorInMsgID;         //!< ID for the circles prior message
+    cv::Rect trackWindow;                //!< [px] Region of interest around the last detected circles
+    int32_t trackValid;                  //!< [-] 1 if circles were detected in the last image
 };
 
 
@@ -204,6 +204,83 @@ def limbFindingTest(show_plots, image, blur, cannyLow, cannyHigh, saveImage):
     return [testFailCount, ''.join(testMessages)]
 
 
+@pytest.mark.skipif(importErr, reason= reasonErr)
+@pytest.mark.parametrize("image, blur, cannyLow, cannyHigh", [
+                        ("MarsBright.jpg",    1,    100,       200),
+                        ("moons.jpg",         3,    200,       300)
+    ])
+def test_roiTracking(show_plots, image, blur, cannyLow, cannyHigh):
+    """
+    Unit test for the region of interest mode of Limb Finding. The image is processed over several updates around
+    the limb tracked in the previous image. The limb found in the region of interest must match the limb found in the
+    full image.
+    """
+    [testResults, testMessage] = roiTrackingTest(show_plots, image, blur, cannyLow, cannyHigh)
+    assert testResults < 1, testMessage
+
+
+def roiTrackingTest(show_plots, image, blur, cannyLow, cannyHigh):
+    testFailCount = 0
+    testMessages = []
+
+    # Reference limb found in the full image
+    fullValid, fullPoints, fullNumPoints = runRoiSim(0, image, blur, cannyLow, cannyHigh)
+    valid, points, numPoints = runRoiSim(1, image, blur, cannyLow, cannyHigh)
+
+    if show_plots:
+        print(fullNumPoints[0, 1], numPoints[:, 1])
+
+    for k in range(len(valid[:, 0])):
+        if valid[k, 1] != fullValid[0, 1]:
+            testFailCount += 1
+            testMessages.append("ROI tracking lost the limb at update " + str(k) + " processing " + image + ". ")
+        if np.abs(numPoints[k, 1] - fullNumPoints[0, 1]) > 10:
+            testFailCount += 1
+            testMessages.append("ROI limb differs from the full image limb at update " + str(k) + " processing " + image + ". ")
+        if np.any(np.abs(points[k, 1:3] - fullPoints[0, 1:3]) > 2):
+            testFailCount += 1
+            testMessages.append("ROI limb points differ from the full image at update " + str(k) + " processing " + image + ". ")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+def runRoiSim(roiMode, image, blur, cannyLow, cannyHigh):
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProcessRate = macros.sec2nano(0.5)
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    moduleConfig = limbFinding.LimbFinding()
+    moduleConfig.ModelTag = "limbFind"
+    unitTestSim.AddModelToTask(unitTaskName, moduleConfig)
+    moduleConfig.imageInMsgName = "sample_image"
+    moduleConfig.opnavLimbOutMsgName = "limbPoints"
+    moduleConfig.filename = path + '/' + image
+    moduleConfig.cannyThreshHigh = cannyHigh
+    moduleConfig.cannyThreshLow = cannyLow
+    moduleConfig.blurrSize = blur
+    moduleConfig.roiMode = roiMode
+    moduleConfig.roiMargin = 20
+
+    inputMessageData = limbFinding.CameraImageMsg()
+    inputMessageData.timeTag = int(1E9)
+    inputMessageData.cameraID = 1
+    unitTestSupport.setMessage(unitTestSim.TotalSim, unitProcessName, moduleConfig.imageInMsgName, inputMessageData)
+
+    unitTestSim.TotalSim.logThisMessage(moduleConfig.opnavLimbOutMsgName, testProcessRate)
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(2.0))
+    unitTestSim.ExecuteSimulation()
+
+    valid = unitTestSim.pullMessageLogData(moduleConfig.opnavLimbOutMsgName + ".valid", list(range(1)))
+    points = unitTestSim.pullMessageLogData(moduleConfig.opnavLimbOutMsgName + ".limbPoints", list(range(2*1000)))
+    numPoints = unitTestSim.pullMessageLogData(moduleConfig.opnavLimbOutMsgName + ".numLimbPoints", list(range(1)))
+    return valid, points, numPoints
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
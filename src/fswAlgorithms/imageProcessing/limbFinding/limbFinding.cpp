@@ -41,6 +41,10 @@ LimbFinding::LimbFinding()
     this->cannyThreshLow = 100;
     this->OutputBufferCount = 2;
     this->limbNumThresh = 50;
+    this->circlesPriorInMsgName = "";
+    this->roiMode = 0;
+    this->roiMargin = 20;
+    this->trackValid = 0;
 
 }
 
@@ -67,6 +71,10 @@ void LimbFinding::CrossInit()
 {
     /*! - Get the image data message ID*/
     this->imageInMsgID = SystemMessaging::GetInstance()->subscribeToMessage(this->imageInMsgName,sizeof(CameraImageMsg), moduleID);
+    /*! - Get the optional circles prior message ID*/
+    if(this->circlesPriorInMsgName != ""){
+        this->circlesPriorInMsgID = SystemMessaging::GetInstance()->subscribeToMessage(this->circlesPriorInMsgName,sizeof(CirclesOpNavMsg), moduleID);
+    }
 }
 
 /*! This is the destructor */
@@ -82,9 +90,96 @@ LimbFinding::~LimbFinding()
  */
 void LimbFinding::Reset(uint64_t CurrentSimNanos)
 {
+    /*! - Forget the tracked limb, the next image is processed in full */
+    this->trackValid = 0;
     return;
 }
 
+/*! This method finds the limb points in a window of the image. It performs a greyscale and a blur on the window before
+ the Canny Transform, and returns the points in full image pixels. No points are returned if there are fewer than
+ limbNumThresh of them.
+ @return void
+ @param imageCV The full image
+ @param window The processed window of the image
+ @param locations The limb points found
+ */
+void LimbFinding::findLimb(const cv::Mat &imageCV, const cv::Rect &window, std::vector<cv::Point2i> &locations)
+{
+    cv::Mat greyImage, blurred, edgeImage;
+
+    locations.clear();
+    /*! - Greyscale the image, single channel raw frames are used as they are */
+    if (imageCV.channels() == 1){
+        greyImage = imageCV(window);
+    }
+    else{
+        cv::cvtColor( imageCV(window), greyImage, cv::COLOR_BGR2GRAY);
+    }
+    /*! - Lightly blur it */
+    cv::GaussianBlur(greyImage, blurred, cv::Size(this->blurrSize,this->blurrSize), 1);
+    /*! - Apply the Canny Transform to find the limbPoints*/
+    cv::Canny(blurred, edgeImage, this->cannyThreshLow, this->cannyThreshHigh,  3, true);
+    if (cv::countNonZero(edgeImage)>this->limbNumThresh){
+        cv::findNonZero(edgeImage, locations);
+        /*! - Shift the points back to full image pixels */
+        for (size_t i = 0; i < locations.size(); i++){
+            locations[i] += window.tl();
+        }
+    }
+}
+
+/*! This method checks that the limb found in a window is not cut by the window edges that lie inside the image.
+ @return bool
+ @param locations The limb points found
+ @param window The processed window of the image
+ @param fullFrame The full image
+ */
+bool LimbFinding::limbInWindow(const std::vector<cv::Point2i> &locations, const cv::Rect &window, const cv::Rect &fullFrame)
+{
+    /* Edges within this many pixels of a window edge are considered cut by the window */
+    const int edgeBand = 2;
+    for (size_t i = 0; i < locations.size(); i++){
+        if ((window.x > 0 && locations[i].x < window.x + edgeBand)
+            || (window.y > 0 && locations[i].y < window.y + edgeBand)
+            || (window.br().x < fullFrame.width && locations[i].x >= window.br().x - edgeBand)
+            || (window.br().y < fullFrame.height && locations[i].y >= window.br().y - edgeBand)){
+            return false;
+        }
+    }
+    return !locations.empty();
+}
+
+/*! This method picks the window to process: around the first circle of the prior if one is provided and valid, else
+ around the limb tracked in the last image, else the full image.
+ @return cv::Rect
+ @param fullFrame The full image
+ */
+cv::Rect LimbFinding::predictWindow(const cv::Rect &fullFrame)
+{
+    CirclesOpNavMsg priorBuffer;
+    SingleMessageHeader localHeader;
+    cv::Rect window = fullFrame;
+    double extent;
+
+    memset(&priorBuffer, 0x0, sizeof(CirclesOpNavMsg));
+    if (this->circlesPriorInMsgName != ""){
+        SystemMessaging::GetInstance()->ReadMessage(this->circlesPriorInMsgID, &localHeader,
+                                                    sizeof(CirclesOpNavMsg), reinterpret_cast<uint8_t*>(&priorBuffer), this->moduleID);
+    }
+    if (priorBuffer.valid == 1 && priorBuffer.circlesRadii[0] > 0){
+        extent = priorBuffer.circlesRadii[0] + this->roiMargin;
+        window = cv::Rect(cv::Point(cvFloor(priorBuffer.circlesCenters[0] - extent), cvFloor(priorBuffer.circlesCenters[1] - extent)),
+                          cv::Point(cvCeil(priorBuffer.circlesCenters[0] + extent) + 1, cvCeil(priorBuffer.circlesCenters[1] + extent) + 1)) & fullFrame;
+    }
+    else if (this->trackValid == 1){
+        window = this->trackWindow & fullFrame;
+    }
+    if (window.area() == 0){
+        window = fullFrame;
+    }
+    return window;
+}
+
 /*! This module reads an OpNav image and extracts limb points from its content using OpenCV's Canny Transform. It performs a greyscale, and blur on the image to facilitate edge-detection.
  @return void
  @param CurrentSimNanos The clock time at which the function was called (nanoseconds)
@@ -97,7 +192,9 @@ void LimbFinding::UpdateState(uint64_t CurrentSimNanos)
     memset(&imageBuffer, 0x0, sizeof(CameraImageMsg));
     memset(&limbMsg, 0x0, sizeof(LimbOpNavMsg));
 
-    cv::Mat imageCV, blurred, edgeImage;
+    cv::Mat imageCV;
+    cv::Rect fullFrame, window, limbBox;
+    std::vector<cv::Point2i> locations;
     if (this->saveDir != ""){
         dirName = this->saveDir + std::to_string(CurrentSimNanos*1E-9) + ".jpg";
     }
@@ -116,9 +213,15 @@ void LimbFinding::UpdateState(uint64_t CurrentSimNanos)
         imageCV = imread(this->filename, cv::IMREAD_COLOR);
     }
     else if(imageBuffer.valid == 1 && imageBuffer.timeTag >= CurrentSimNanos){
-        /*! - Recast image pointer to CV type*/
-        std::vector<unsigned char> vectorBuffer((char*)imageBuffer.imagePointer, (char*)imageBuffer.imagePointer + imageBuffer.imageBufferLength);
-        imageCV = cv::imdecode(vectorBuffer, cv::IMREAD_COLOR);
+        /*! - Recast image pointer to CV type. Raw frames are read in place, encoded ones are decoded without a copy*/
+        if (imageBuffer.imageFormat == IMAGE_FORMAT_RAW){
+            imageCV = cv::Mat(imageBuffer.imageHeight, imageBuffer.imageWidth, CV_8UC(imageBuffer.imageType),
+                              imageBuffer.imagePointer, (size_t) imageBuffer.imageStep);
+        }
+        else{
+            cv::Mat encodedBuffer(1, imageBuffer.imageBufferLength, CV_8UC1, imageBuffer.imagePointer);
+            imageCV = cv::imdecode(encodedBuffer, cv::IMREAD_COLOR);
+        }
         if (this->saveImages == 1){
             cv::imwrite(dirName, imageCV);
         }
@@ -127,15 +230,19 @@ void LimbFinding::UpdateState(uint64_t CurrentSimNanos)
         /*! - If no image is present, write zeros in message */
         SystemMessaging::GetInstance()->WriteMessage(this->opnavLimbOutMsgID, CurrentSimNanos, sizeof(LimbOpNavMsg), reinterpret_cast<uint8_t *>(&limbMsg), this->moduleID);
         return;}
-    /*! - Greyscale the image */
-    cv::cvtColor( imageCV, imageCV, cv::COLOR_BGR2GRAY);
-    /*! - Lightly blur it */
-    cv::GaussianBlur(imageCV, blurred, cv::Size(this->blurrSize,this->blurrSize), 1);
-    /*! - Apply the Canny Transform to find the limbPoints*/
-    cv::Canny(blurred, edgeImage, this->cannyThreshLow, this->cannyThreshHigh,  3, true);
-    if (cv::countNonZero(edgeImage)>this->limbNumThresh){
-        std::vector<cv::Point2i> locations;
-        cv::findNonZero(edgeImage, locations);
+    /*! - Only process the region of interest around the predicted limb in ROI mode */
+    fullFrame = cv::Rect(0, 0, imageCV.cols, imageCV.rows);
+    window = fullFrame;
+    if (this->roiMode == 1){
+        window = this->predictWindow(fullFrame);
+    }
+    this->findLimb(imageCV, window, locations);
+    if (window != fullFrame && !this->limbInWindow(locations, window, fullFrame)){
+        /*! - Fall back to the full image if the limb was lost or cut by the region of interest */
+        this->findLimb(imageCV, fullFrame, locations);
+    }
+    this->trackValid = 0;
+    if (!locations.empty()){
         limbMsg.numLimbPoints =0;
         for(size_t i = 0; i<locations.size() && i<MAX_LIMB_PNTS; i++ )
         {
@@ -146,6 +253,11 @@ void LimbFinding::UpdateState(uint64_t CurrentSimNanos)
         }
         limbMsg.valid = 1;
         limbMsg.planetIds = 2;
+        /*! - Track the found limb for the region of interest of the next image */
+        limbBox = cv::boundingRect(locations);
+        this->trackWindow = cv::Rect(limbBox.x - this->roiMargin, limbBox.y - this->roiMargin,
+                                     limbBox.width + 2*this->roiMargin, limbBox.height + 2*this->roiMargin) & fullFrame;
+        this->trackValid = 1;
     }
     
     limbMsg.timeTag = this->sensorTimeTag;
@@ -29,6 +29,7 @@
 #include "opencv2/imgcodecs.hpp"
 #include "../simulation/simFswInterfaceMessages/cameraImageMsg.h"
 #include "../simulation/simFswInterfaceMessages/limbOpNavMsg.h"
+#include "../simulation/simFswInterfaceMessages/circlesOpNavMsg.h"
 #include "../simulation/_GeneralModuleFiles/sys_model.h"
 #include "../simulation/utilities/avsEigenMRP.h"
 #include "../simulation/utilities/bskLogging.h"
@@ -45,12 +46,18 @@ public:
     void SelfInit();
     void CrossInit();
     void Reset(uint64_t CurrentSimNanos);
-    
+
+private:
+    void findLimb(const cv::Mat &imageCV, const cv::Rect &window, std::vector<cv::Point2i> &locations);
+    bool limbInWindow(const std::vector<cv::Point2i> &locations, const cv::Rect &window, const cv::Rect &fullFrame);
+    cv::Rect predictWindow(const cv::Rect &fullFrame);
+
 public:
     std::string filename;                //!< Filename for module to read an image directly
     std::string opnavLimbOutMsgName;  //!< The name of the Limb output message
     std::string imageInMsgName;          //!< The name of the ImageFswMsg output message
     std::string saveDir;                //!< Directory to save images to
+    std::string circlesPriorInMsgName;  //!< The name of the optional CirclesOpNavMsg used to place the region of interest
 
     uint64_t sensorTimeTag;              //!< [ns] Current time tag for sensor out
     /* OpenCV specific arguments needed for Limb finding*/
@@ -59,12 +66,17 @@ public:
     int32_t cannyThreshLow;                  //!< [-] Second Threshold for Canny detection
     int32_t saveImages;                  //!< [-] 1 to save images to file for debugging
     int32_t limbNumThresh;                  //!< [-] Threshold for when a limb is detected
+    int32_t roiMode;                     //!< [-] 1 to only process a region of interest around the tracked limb
+    int32_t roiMargin;                   //!< [px] Margin added around the tracked limb to form the region of interest
     
     BSKLogger bskLogger;                //!< -- BSK Logging
 private:
     uint64_t OutputBufferCount;          //!< [-] Count on the number of output message buffers
     int32_t opnavLimbOutMsgID;        //!< ID for the outgoing message
     int32_t imageInMsgID;                //!< ID for the outgoing message
+    int32_t circlesPriorInMsgID;         //!< ID for the circles prior message
+    cv::Rect trackWindow;                //!< [px] Region of interest around the last detected limb
+    int32_t trackValid;                  //!< [-] 1 if a limb was detected in the last image
 };
 
 
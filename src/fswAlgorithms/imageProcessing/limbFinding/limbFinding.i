@@ -31,10 +31,12 @@ from Basilisk.simulation.swig_common_model import *
 %include "limbFinding.h"
 %include "../../simulation/simFswInterfaceMessages/limbOpNavMsg.h"
 %include "../../simulation/simFswInterfaceMessages/cameraImageMsg.h"
+%include "../../simulation/simFswInterfaceMessages/circlesOpNavMsg.h"
 %include "swig_conly_data.i"
 
 GEN_SIZEOF(LimbOpNavMsg)
 GEN_SIZEOF(CameraImageMsg)
+GEN_SIZEOF(CirclesOpNavMsg)
 
 
 %pythoncode %{
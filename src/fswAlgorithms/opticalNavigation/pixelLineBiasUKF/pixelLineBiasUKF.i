@@ -19,7 +19,7 @@
 %module pixelLineBiasUKF
 %{
    #include "pixelLineBiasUKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -38,7 +38,7 @@ GEN_SIZEOF(CirclesOpNavMsg);
 GEN_SIZEOF(CameraConfigMsg);
 GEN_SIZEOF(NavAttIntMsg);
 %include "pixelLineBiasUKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/pixelLineFilterFswMsg.h"
 %include "simFswInterfaceMessages/navTransIntMsg.h"
 %include "simFswInterfaceMessages/circlesOpNavMsg.h"
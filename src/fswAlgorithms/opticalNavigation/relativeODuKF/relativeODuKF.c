@@ -21,7 +21,11 @@
 #include <stdlib.h>
 #include <math.h>
 #include "relativeODuKF.h"
-#include "../_GeneralModuleFiles/ukfUtilities.h"
+#include "simulation/utilities/ukfUtilities.h"
+
+#define UKF_CORE_N_STATES ODUKF_N_STATES
+#define UKF_CORE_N_MEAS ODUKF_N_MEAS
+#include "simulation/utilities/ukfCore.h"
 
 /*! This method creates the two moduel output messages.
  @return void
@@ -303,12 +307,7 @@ void relODuKFTwoBodyDyn(double state[ODUKF_N_STATES], double muPlanet, double *s
  */
 int relODuKFTimeUpdate(RelODuKFConfig *configData, double updateTime)
 {
-    uint64_t i, Index;
-    double sBarT[ODUKF_N_STATES*ODUKF_N_STATES]; // Sbar transpose (chol decomp of covar)
-    double xComp[ODUKF_N_STATES], AT[(2 * ODUKF_N_STATES + ODUKF_N_STATES)*ODUKF_N_STATES]; // Intermediate state, process noise chol decomp
-    double aRow[ODUKF_N_STATES], rAT[ODUKF_N_STATES*ODUKF_N_STATES], xErr[ODUKF_N_STATES]; //Row of A mat, R of QR decomp of A, state error
-    double sBarUp[ODUKF_N_STATES*ODUKF_N_STATES]; // S bar cholupdate
-    double *spPtr; //sigma point intermediate varaible
+    int i;
     double procNoise[ODUKF_N_STATES*ODUKF_N_STATES]; //process noise
     int32_t badUpdate=0;
     
@@ -324,87 +323,27 @@ int relODuKFTimeUpdate(RelODuKFConfig *configData, double updateTime)
     }
 
     mCopy(configData->sQnoise, ODUKF_N_STATES, ODUKF_N_STATES, procNoise);
-    /*! - Copy over the current state estimate into the 0th Sigma point and propagate by dt*/
-    vCopy(configData->state, configData->numStates,
-          &(configData->SP[0 * configData->numStates + 0]));
-    relODStateProp(configData, &(configData->SP[0]),
-                      configData->dt);
-    /*! - Scale that Sigma point by the appopriate scaling factor (Wm[0])*/
-    vScale(configData->wM[0], &(configData->SP[0]),
-           configData->numStates, configData->xBar);
-    /*! - Get the transpose of the sBar matrix because it is easier to extract Rows vs columns*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               sBarT);
-    /*! - For each Sigma point, apply sBar-based error, propagate forward, and scale by Wm just like 0th.
-     Note that we perform +/- sigma points simultaneously in loop to save loop values.*/
-    for (i = 0; i<configData->countHalfSPs; i++)
+    /*! - Spread the sigma points about the current state using the columns of sBar and
+     propagate each of them forward by dt*/
+    ukfCoreSigmaPoints(configData->state, configData->sBar, configData->gamma, configData->SP);
+    for (i = 0; i<UKF_CORE_N_SIGMA; i++)
     {
-        /*! - Adding covariance columns from sigma points*/
-        Index = i + 1;
-        spPtr = &(configData->SP[Index*configData->numStates]);
-        vCopy(&sBarT[i*configData->numStates], configData->numStates, spPtr);
-        vScale(configData->gamma, spPtr, configData->numStates, spPtr);
-        vAdd(spPtr, configData->numStates, configData->state, spPtr);
-        relODStateProp(configData, spPtr, configData->dt);
-        vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-        vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-        /*! - Subtracting covariance columns from sigma points*/
-        Index = i + 1 + configData->countHalfSPs;
-        spPtr = &(configData->SP[Index*configData->numStates]);
-        vCopy(&sBarT[i*configData->numStates], configData->numStates, spPtr);
-        vScale(-configData->gamma, spPtr, configData->numStates, spPtr);
-        vAdd(spPtr, configData->numStates, configData->state, spPtr);
-        relODStateProp(configData, spPtr, configData->dt);
-        vScale(configData->wM[Index], spPtr, configData->numStates, xComp);
-        vAdd(xComp, configData->numStates, configData->xBar, configData->xBar);
-    }
-    /*! - Zero the AT matrix prior to assembly*/
-    mSetZero(AT, (2 * configData->countHalfSPs + configData->numStates),
-             configData->countHalfSPs);
-    /*! - Assemble the AT matrix.  Note that this matrix is the internals of
-     the qr decomposition call in the source design documentation.  It is
-     the inside of equation 20 in that document*/
-    for (i = 0; i<2 * configData->countHalfSPs; i++)
-    {
-        vScale(-1.0, configData->xBar, configData->numStates, aRow);
-        vAdd(aRow, configData->numStates,
-             &(configData->SP[(i+1)*configData->numStates]), aRow);
-        /*Check sign of wC to know if the sqrt will fail*/
-        if (configData->wC[i+1]<=0){
-            relODuKFCleanUpdate(configData);
-            return -1;}
-        vScale(sqrt(configData->wC[i+1]), aRow, configData->numStates, aRow);
-        memcpy((void *)&AT[(size_t)i*configData->numStates], (void *)aRow,
-               configData->numStates*sizeof(double));
-        
+        relODStateProp(configData, &(configData->SP[i*ODUKF_N_STATES]), configData->dt);
     }
-    /*! - Pop the sQNoise matrix on to the end of AT prior to getting QR decomposition*/
-    memcpy(&AT[2 * configData->countHalfSPs*configData->numStates],
-           procNoise, configData->numStates*configData->numStates
-           *sizeof(double));
-    /*! - QR decomposition (only R computed!) of the AT matrix provides the new sBar matrix*/
-    ukfQRDJustR(AT, 2 * configData->countHalfSPs + configData->numStates,
-                configData->countHalfSPs, rAT);
-    
-    mCopy(rAT, configData->numStates, configData->numStates, sBarT);
-    mTranspose(sBarT, configData->numStates, configData->numStates,
-               configData->sBar);
-    
-    /*! - Shift the sBar matrix over by the xBar vector using the appropriate weight
-     like in equation 21 in design document.*/
-    vScale(-1.0, configData->xBar, configData->numStates, xErr);
-    vAdd(xErr, configData->numStates, &configData->SP[0], xErr);
-    badUpdate += ukfCholDownDate(configData->sBar, xErr, configData->wC[0],
-                                 configData->numStates, sBarUp);
-    
-    
-    /*! - Save current sBar matrix, covariance, and state estimate off for further use*/
-    mCopy(sBarUp, configData->numStates, configData->numStates, configData->sBar);
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               configData->covar);
-    mMultM(configData->sBar, configData->numStates, configData->numStates,
-           configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    /*! - Compute the weighted mean of the propagated sigma points*/
+    ukfCoreStateMean(configData->SP, configData->wM, configData->xBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 1) < 0){
+        relODuKFCleanUpdate(configData);
+        return(-1);}
+    /*! - QR decomposition of the weighted sigma point spread and process noise provides the
+     new sBar matrix, which is then shifted by the 0th sigma point (equations 20 and 21
+     in design document)*/
+    badUpdate += ukfCoreStateSqrt(configData->SP, configData->xBar, configData->wC, procNoise,
+                                  configData->sBar);
+    
+    /*! - Save current covariance and state estimate off for further use*/
+    ukfCoreCovar(configData->sBar, configData->covar);
     vCopy(&(configData->SP[0]), configData->numStates, configData->state);
     
     if (badUpdate<0){
@@ -446,14 +385,8 @@ void relODuKFMeasModel(RelODuKFConfig *configData)
  */
 int relODuKFMeasUpdate(RelODuKFConfig *configData)
 {
-    uint32_t i;
-    double yBar[3], syInv[3*3]; //measurement, Sy inv
-    double kMat[ODUKF_N_STATES*3], cholNoise[ODUKF_N_MEAS*ODUKF_N_MEAS];//Kalman Gain, chol decomp of noise
-    double xHat[ODUKF_N_STATES], Ucol[ODUKF_N_STATES], sBarT[ODUKF_N_STATES*ODUKF_N_STATES], tempYVec[3];// state error, U column eq 28, intermediate variables
-    double AT[(2 * ODUKF_N_STATES + 3)*3]; //Process noise matrix
-    double rAT[3*3], syT[3*3]; //QR R decomp, Sy transpose
-    double sy[3*3]; // Chol of covariance
-    double updMat[3*3], pXY[ODUKF_N_STATES*3], Umat[ODUKF_N_STATES*3]; // Intermediate variable, covariance eq 26, U eq 28
+    double yBar[ODUKF_N_MEAS], cholNoise[ODUKF_N_MEAS*ODUKF_N_MEAS]; //measurement, chol decomp of noise
+    double sy[ODUKF_N_MEAS*ODUKF_N_MEAS], pXY[ODUKF_N_STATES*ODUKF_N_MEAS]; // Chol of covariance, covariance eq 26
     int32_t badUpdate=0;
     
     vCopy(configData->state, configData->numStates, configData->statePrev);
@@ -464,115 +397,34 @@ int relODuKFMeasUpdate(RelODuKFConfig *configData)
     
     /*! - Compute the value for the yBar parameter (note that this is equation 23 in the
      time update section of the reference document*/
-    vSetZero(yBar, configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2+1; i++)
-    {
-        vCopy(&(configData->yMeas[i*configData->numObs]), configData->numObs,
-              tempYVec);
-        vScale(configData->wM[i], tempYVec, configData->numObs, tempYVec);
-        vAdd(yBar, configData->numObs, tempYVec, yBar);
-    }
-    
-    /*! - Populate the matrix that we perform the QR decomposition on in the measurement
-     update section of the code.  This is based on the differenence between the yBar
-     parameter and the calculated measurement models.  Equation 24 in driving doc. */
-    mSetZero(AT, configData->countHalfSPs*2+configData->numObs,
-             configData->numObs);
-    for(i=0; i<configData->countHalfSPs*2; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[(i+1)*configData->numObs]), tempYVec);
-        if (configData->wC[i+1]<0){return -1;}
-        vScale(sqrt(configData->wC[i+1]), tempYVec, configData->numObs, tempYVec);
-        memcpy(&(AT[i*configData->numObs]), tempYVec,
-               configData->numObs*sizeof(double));
-    }
+    ukfCoreMeasMean(configData->yMeas, configData->wM, (int32_t) configData->numObs, yBar);
+    /*! - Check the sign of wC to know if the square roots below will fail*/
+    if (ukfCoreCheckWeights(configData->wC, 0) < 0){return(-1);}
     
     /*! - This is the square-root of the Rk matrix which we treat as the Cholesky
      decomposition of the observation variance matrix constructed for our number
      of observations*/
     mSetIdentity(configData->measNoise, ODUKF_N_MEAS, ODUKF_N_MEAS);
     mCopy(configData->opNavInMsg.covar_N, ODUKF_N_MEAS, ODUKF_N_MEAS, configData->measNoise);
-    mScale(configData->noiseSF, &AT, 2*configData->countHalfSPs, configData->numObs, &AT);
     badUpdate += ukfCholDecomp(configData->measNoise, ODUKF_N_MEAS, ODUKF_N_MEAS, cholNoise);
-    memcpy(&(AT[2*configData->countHalfSPs*configData->numObs]),
-           cholNoise, configData->numObs*configData->numObs*sizeof(double));
-    /*! - Perform QR decomposition (only R again) of the above matrix to obtain the
-     current Sy matrix*/
-    ukfQRDJustR(AT, 2*configData->countHalfSPs+configData->numObs,
-                configData->numObs, rAT);
-    
-    mCopy(rAT, configData->numObs, configData->numObs, syT);
-    mTranspose(syT, configData->numObs, configData->numObs, sy);
-    /*! - Shift the matrix over by the difference between the 0th SP-based measurement
-     model and the yBar matrix (cholesky down-date again)*/
-    vScale(-1.0, yBar, configData->numObs, tempYVec);
-    vAdd(tempYVec, configData->numObs, &(configData->yMeas[0]), tempYVec);
-    badUpdate += ukfCholDownDate(sy, tempYVec, configData->wC[0],
-                                 configData->numObs, updMat);
-    
-    /*! - Shifted matrix represents the Sy matrix */
-    mCopy(updMat, configData->numObs, configData->numObs, sy);
-    mTranspose(sy, configData->numObs, configData->numObs, syT);
+    /*! - QR decomposition of the measurement model spread and the noise, shifted by the
+     0th sigma point, gives the current Sy matrix (equations 24 and 25 in driving doc)*/
+    badUpdate += ukfCoreMeasSqrt(configData->yMeas, yBar, configData->wC, cholNoise, configData->noiseSF,
+                                 (int32_t) configData->numObs, sy);
     
     /*! - Construct the Pxy matrix (equation 26) which multiplies the Sigma-point cloud
      by the measurement model cloud (weighted) to get the total Pxy matrix*/
-    mSetZero(pXY, configData->numStates, configData->numObs);
-    for(i=0; i<2*configData->countHalfSPs+1; i++)
-    {
-        vScale(-1.0, yBar, configData->numObs, tempYVec);
-        vAdd(tempYVec, configData->numObs,
-             &(configData->yMeas[i*configData->numObs]), tempYVec);
-        vSubtract(&(configData->SP[i*configData->numStates]), configData->numStates,
-                  configData->xBar, xHat);
-        vScale(configData->wC[i], xHat, configData->numStates, xHat);
-        mMultM(xHat, configData->numStates, 1, tempYVec, 1, configData->numObs,
-               kMat);
-        mAdd(pXY, configData->numStates, configData->numObs, kMat, pXY);
-    }
+    ukfCoreCrossCovar(configData->SP, configData->xBar, configData->yMeas, yBar,
+                      configData->wC, (int32_t) configData->numObs, pXY);
     
-    /*! - Then we need to invert the SyT*Sy matrix to get the Kalman gain factor.  Since
-     The Sy matrix is lower triangular, we can do a back-sub inversion instead of
-     a full matrix inversion.  That is the ukfUInv and ukfLInv calls below.  Once that
-     multiplication is done (equation 27), we have the Kalman Gain.*/
-    ukfUInv(syT, configData->numObs, configData->numObs, syInv);
-    
-    mMultM(pXY, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    ukfLInv(sy, configData->numObs, configData->numObs, syInv);
-    mMultM(kMat, configData->numStates, configData->numObs, syInv,
-           configData->numObs, configData->numObs, kMat);
-    
-    
-    /*! - Difference the yBar and the observations to get the observed error and
-     multiply by the Kalman Gain to get the state update.  Add the state update
-     to the state to get the updated state value (equation 27).*/
-    vSubtract(configData->obs, configData->numObs, yBar, tempYVec);
-    mMultM(kMat, configData->numStates, configData->numObs, tempYVec,
-           configData->numObs, 1, xHat);
-    vAdd(configData->state, configData->numStates, xHat, configData->state);
-    /*! - Compute the updated matrix U from equation 28.  Note that I then transpose it
-     so that I can extract "columns" from adjacent memory*/
-    mMultM(kMat, configData->numStates, configData->numObs, sy,
-           configData->numObs, configData->numObs, Umat);
-    mTranspose(Umat, configData->numStates, configData->numObs, Umat);
-    /*! - For each column in the update matrix, perform a cholesky down-date on it to
-     get the total shifted S matrix (called sBar in internal parameters*/
-    for(i=0; i<configData->numObs; i++)
-    {
-        vCopy(&(Umat[i*configData->numStates]), configData->numStates, Ucol);
-        badUpdate += ukfCholDownDate(configData->sBar, Ucol, -1.0, configData->numStates, sBarT);
-        mCopy(sBarT, configData->numStates, configData->numStates,
-              configData->sBar);
-    }
+    /*! - Compute the Kalman gain (equation 27) using triangular back-substitution on Sy,
+     apply the innovation to the state and down-date sBar with each column of the
+     update matrix U from equation 28*/
+    badUpdate += ukfCoreMeasUpdate(pXY, sy, configData->obs, yBar, (int32_t) configData->numObs,
+                                   configData->state, configData->sBar);
     
     /*! - Compute equivalent covariance based on updated sBar matrix*/
-    mTranspose(configData->sBar, configData->numStates, configData->numStates,
-               configData->covar);
-    mMultM(configData->sBar, configData->numStates, configData->numStates,
-           configData->covar, configData->numStates, configData->numStates,
-           configData->covar);
+    ukfCoreCovar(configData->sBar, configData->covar);
     
     if (badUpdate<0){
         relODuKFCleanUpdate(configData);
@@ -19,7 +19,7 @@
 %module relativeODuKF
 %{
    #include "relativeODuKF.h"
-   #include "../_GeneralModuleFiles/ukfUtilities.h"
+   #include "utilities/ukfUtilities.h"
 %}
 
 %include "swig_conly_data.i"
@@ -37,7 +37,7 @@ GEN_SIZEOF(OpNavFilterFswMsg);
 GEN_SIZEOF(OpNavFswMsg);
 GEN_SIZEOF(RelODuKFConfig);
 %include "relativeODuKF.h"
-%include "../_GeneralModuleFiles/ukfUtilities.h"
+%include "utilities/ukfUtilities.h"
 %include "../../fswMessages/opNavFswMsg.h"
 %include "../../fswMessages/opNavFilterFswMsg.h"
 %include "simFswInterfaceMessages/navTransIntMsg.h"
@@ -0,0 +1,169 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "architecture/messaging/image_frame_pool.h"
+
+ImageFramePool* ImageFramePool::TheInstance = NULL;
+
+/*!
+ * The constructor only exists to make the pool a singleton
+ */
+ImageFramePool::ImageFramePool()
+{
+}
+
+/*!
+ * The destructor frees all the frames of the pool
+ */
+ImageFramePool::~ImageFramePool()
+{
+    for (std::vector<PoolFrame*>::iterator it = this->frames.begin(); it != this->frames.end(); it++)
+    {
+        delete *it;
+    }
+}
+
+/*!
+ * This gets the single instance of the pool, and creates it the first time it is called
+ * @return ImageFramePool* TheInstance
+ */
+ImageFramePool* ImageFramePool::GetInstance()
+{
+    if(TheInstance == NULL)
+    {
+        TheInstance = new ImageFramePool();
+    }
+    return(TheInstance);
+}
+
+/*!
+ * This returns a frame of at least frameBytes bytes with a reference count of 1.  The smallest free frame that is
+ * large enough is reused, and a new frame is only allocated if there is none.
+ * @param frameBytes Number of bytes of the frame
+ * @return void* pointer to the first byte of the frame
+ */
+void* ImageFramePool::acquire(size_t frameBytes)
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    PoolFrame *bestFrame = NULL;
+    for (std::vector<PoolFrame*>::iterator it = this->frames.begin(); it != this->frames.end(); it++)
+    {
+        if ((*it)->referenceCount == 0 && (*it)->data.size() >= frameBytes
+            && (bestFrame == NULL || (*it)->data.size() < bestFrame->data.size()))
+        {
+            bestFrame = *it;
+        }
+    }
+    if (bestFrame == NULL)
+    {
+        bestFrame = new PoolFrame;
+        bestFrame->data.resize(frameBytes > 0 ? frameBytes : 1);
+        this->frames.push_back(bestFrame);
+    }
+    bestFrame->referenceCount = 1;
+    return(bestFrame->data.data());
+}
+
+/*!
+ * This adds a reference to a frame of the pool.  Pointers that do not come from the pool are ignored.
+ * @param frame Pointer returned by acquire()
+ * @return void
+ */
+void ImageFramePool::retain(const void *frame)
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    PoolFrame *poolFrame = this->findFrame(frame);
+    if (poolFrame != NULL && poolFrame->referenceCount > 0)
+    {
+        poolFrame->referenceCount++;
+    }
+}
+
+/*!
+ * This removes a reference to a frame of the pool.  The frame is recycled once no reference is left.
+ * @param frame Pointer returned by acquire()
+ * @return void
+ */
+void ImageFramePool::release(const void *frame)
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    PoolFrame *poolFrame = this->findFrame(frame);
+    if (poolFrame != NULL && poolFrame->referenceCount > 0)
+    {
+        poolFrame->referenceCount--;
+    }
+}
+
+/*!
+ * This returns the number of references to a frame, or -1 if the pointer does not come from the pool
+ * @param frame Pointer returned by acquire()
+ * @return int32_t reference count
+ */
+int32_t ImageFramePool::getReferenceCount(const void *frame)
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    PoolFrame *poolFrame = this->findFrame(frame);
+    return(poolFrame != NULL ? poolFrame->referenceCount : -1);
+}
+
+/*!
+ * This returns the number of frames allocated by the pool
+ * @return size_t number of frames
+ */
+size_t ImageFramePool::getNumFrames()
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    return(this->frames.size());
+}
+
+/*!
+ * This returns the number of frames that are currently referenced
+ * @return size_t number of frames in use
+ */
+size_t ImageFramePool::getNumFramesInUse()
+{
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    size_t numInUse = 0;
+    for (std::vector<PoolFrame*>::iterator it = this->frames.begin(); it != this->frames.end(); it++)
+    {
+        if ((*it)->referenceCount > 0)
+        {
+            numInUse++;
+        }
+    }
+    return(numInUse);
+}
+
+/*!
+ * This finds the pool frame that starts at the given pointer.  The pool holds a handful of frames, so a linear
+ * search is used.  The pool mutex must be held by the caller.
+ * @param frame Pointer returned by acquire()
+ * @return PoolFrame* frame, or NULL if the pointer does not come from the pool
+ */
+ImageFramePool::PoolFrame* ImageFramePool::findFrame(const void *frame)
+{
+    for (std::vector<PoolFrame*>::iterator it = this->frames.begin(); it != this->frames.end(); it++)
+    {
+        if ((*it)->data.data() == frame)
+        {
+            return(*it);
+        }
+    }
+    return(NULL);
+}
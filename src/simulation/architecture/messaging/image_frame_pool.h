@@ -0,0 +1,72 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _ImageFramePool_HH_
+#define _ImageFramePool_HH_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <mutex>
+
+/*! @brief Pool of reference counted raw image frames.
+
+ Raw camera frames are written once into a frame from this pool and passed by pointer in a CameraImageMsg with
+ the IMAGE_FORMAT_RAW format, so all downstream image processing modules read the same pixels without decoding or
+ copying them.  The producer holds a reference to each frame it publishes and releases it once the message
+ buffers no longer point to it.  Consumers that keep a frame past their own update must retain it.  Released
+ frames are recycled for the next frames of equal or smaller size, so the steady state allocates no memory.
+ The pool lives in the shared SimMessaging library, like SystemMessaging, so all the module libraries use the
+ same instance.
+ */
+#ifdef _WIN32
+class __declspec( dllexport) ImageFramePool
+#else
+class ImageFramePool
+#endif
+{
+public:
+    static ImageFramePool* GetInstance();      //!< -- returns a pointer to the sim instance of ImageFramePool
+    void* acquire(size_t frameBytes);
+    void retain(const void *frame);
+    void release(const void *frame);
+    int32_t getReferenceCount(const void *frame);
+    size_t getNumFrames();
+    size_t getNumFramesInUse();
+
+private:
+    ImageFramePool();
+    ~ImageFramePool();
+    ImageFramePool(const ImageFramePool&) = delete;
+    ImageFramePool& operator=(const ImageFramePool&) = delete;
+
+    /*! @brief One frame buffer of the pool */
+    typedef struct {
+        std::vector<uint8_t> data;              //!< -- pixel storage of the frame
+        int32_t referenceCount;                 //!< -- number of holders of the frame, 0 if free
+    }PoolFrame;
+
+    PoolFrame* findFrame(const void *frame);
+
+    static ImageFramePool *TheInstance;         //!< -- instance of the frame pool
+    std::vector<PoolFrame*> frames;             //!< -- all the frames allocated by the pool
+    std::mutex poolMutex;                       //!< -- protects the frames and their reference counts
+};
+
+#endif /* _ImageFramePool_HH_ */
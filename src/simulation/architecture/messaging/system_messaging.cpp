@@ -28,6 +28,12 @@
  */
 SystemMessaging* SystemMessaging::TheInstance = NULL;
 
+/*!
+ * Messaging system of the calling thread, set by attachThreadInstance().  It is file static rather than a class
+ * member because thread local data cannot be exported from a Windows DLL.
+ */
+static thread_local SystemMessaging *ThreadInstance = NULL;
+
 /*!
  * This constructor for SystemMessaging initializes things
  */
@@ -54,6 +60,10 @@ SystemMessaging::~SystemMessaging()
  */
 SystemMessaging* SystemMessaging::GetInstance()
 {
+    if(ThreadInstance != NULL)
+    {
+        return(ThreadInstance);
+    }
     if(TheInstance == NULL)
     {
         TheInstance = new SystemMessaging();
@@ -61,6 +71,35 @@ SystemMessaging* SystemMessaging::GetInstance()
     return(TheInstance);
 }
 
+/*!
+ * This gives the calling thread its own, empty messaging system.  Until detachThreadInstance() is called,
+ * GetInstance() returns it on this thread only, so several simulations can run concurrently in one process, one
+ * per thread.  Threads that never attach keep sharing the process wide instance.
+ * @return void
+ */
+void SystemMessaging::attachThreadInstance()
+{
+    if(ThreadInstance == NULL)
+    {
+        ThreadInstance = new SystemMessaging();
+    }
+}
+
+/*!
+ * This deletes the messaging system of the calling thread, GetInstance() then returns the process wide instance
+ * again.
+ * @return void
+ */
+void SystemMessaging::detachThreadInstance()
+{
+    if(ThreadInstance != NULL)
+    {
+        ThreadInstance->clearMessaging();
+        delete ThreadInstance;
+        ThreadInstance = NULL;
+    }
+}
+
 /*!
   Attach Storeage to Bucket
   @return int64_t bufferCount
@@ -103,6 +103,8 @@ class SystemMessaging
     
 public:
     static SystemMessaging* GetInstance();  //! -- returns a pointer to the sim instance of SystemMessaging
+    static void attachThreadInstance();  //! -- gives the calling thread its own messaging system
+    static void detachThreadInstance();  //! -- deletes the messaging system of the calling thread
     int64_t AttachStorageBucket(std::string bufferName = "");  //! -- adds a new buffer to the messaging system
     void SetNumMessages(int64_t MessageCount);  //! --updates message count in buffer header
     int64_t GetMessageCount(int32_t bufferSelect = -1);  //! --gets the number of messages in buffer bufferSelect
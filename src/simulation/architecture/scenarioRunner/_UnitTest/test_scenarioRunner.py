@@ -0,0 +1,343 @@
+''' '''
+'''
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+'''
+#
+#   Unit Test Script
+#   Module Name:        scenarioRunner
+#   Creation Date:      October 19, 2026
+#
+# Runs the attitude feedback scenario of examples/scenarioAttitudeFeedback.py once through python and once
+# through the native bskScenarioRunner executable, and checks that the logged messages are identical.  The
+# Monte Carlo test runs dispersed cases of the same scenario and checks that the retained data does not depend
+# on the number of threads.
+#
+
+import os
+import struct
+import subprocess
+import pytest
+
+from Basilisk import __path__
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import unitTestSupport
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+from Basilisk.utilities import simIncludeGravBody
+from Basilisk.simulation import spacecraftPlus
+from Basilisk.simulation import extForceTorque
+from Basilisk.simulation import simple_nav
+from Basilisk.fswAlgorithms import inertial3D
+from Basilisk.fswAlgorithms import attTrackingError
+from Basilisk.fswAlgorithms import MRP_Feedback
+from Basilisk.fswAlgorithms import vehicleConfigData
+
+bskPath = __path__[0]
+runnerPath = os.path.join(bskPath, "bskScenarioRunner")
+
+simTaskName = "simTask"
+simProcessName = "simProcess"
+simulationTime = macros.min2nano(10.)
+simulationTimeStep = macros.sec2nano(.1)
+samplingTime = simulationTime // (50 - 1)
+I = [900., 0., 0.,
+     0., 800., 0.,
+     0., 0., 600.]
+sigma_BNInit = [0.1, 0.2, -0.3]
+omega_BN_BInit = [0.001, -0.01, 0.03]
+extTorquePntB_B = [0.25, -0.25, 0.1]
+loggedMessages = ["extTorquePntB_B_cmds", "attErrorInertial3DMsg", "simple_trans_nav_output"]
+
+
+def initialOrbit(mu):
+    oe = orbitalMotion.ClassicElements()
+    oe.a = 10000000.0
+    oe.e = 0.01
+    oe.i = 33.3 * macros.D2R
+    oe.Omega = 48.2 * macros.D2R
+    oe.omega = 347.8 * macros.D2R
+    oe.f = 85.3 * macros.D2R
+    return orbitalMotion.elem2rv(mu, oe)
+
+
+def readArchive(fileName):
+    """Reads a messageLogger archive into a dictionary of message name to (log count, log buffer)"""
+    logs = {}
+    with open(fileName, "rb") as archive:
+        data = archive.read()
+    offset = 0
+    (messageCount,) = struct.unpack_from("<I", data, offset)
+    offset += 4
+    for i in range(messageCount):
+        (nameLength,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        name = data[offset:offset + nameLength - 1].decode()
+        offset += nameLength
+        (messageID, logCount, bufferSize) = struct.unpack_from("<qQQ", data, offset)
+        offset += 24
+        logs[name] = (logCount, data[offset:offset + bufferSize])
+        offset += bufferSize
+    return logs
+
+
+def runPython(useIntGain, archiveName):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+    scObject.hub.mHub = 750.0
+    scObject.hub.r_BcB_B = [[0.0], [0.0], [0.0]]
+    scObject.hub.IHubPntBc_B = unitTestSupport.np2EigenMatrix3d(I)
+    scSim.AddModelToTask(simTaskName, scObject)
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    scObject.gravField.gravBodies = spacecraftPlus.GravBodyVector(list(gravFactory.gravBodies.values()))
+
+    extFTObject = extForceTorque.ExtForceTorque()
+    extFTObject.ModelTag = "externalDisturbance"
+    extFTObject.extTorquePntB_B = [[extTorquePntB_B[0]], [extTorquePntB_B[1]], [extTorquePntB_B[2]]]
+    scObject.addDynamicEffector(extFTObject)
+    scSim.AddModelToTask(simTaskName, extFTObject)
+
+    sNavObject = simple_nav.SimpleNav()
+    sNavObject.ModelTag = "SimpleNavigation"
+    scSim.AddModelToTask(simTaskName, sNavObject)
+
+    inertial3DConfig = inertial3D.inertial3DConfig()
+    inertial3DWrap = scSim.setModelDataWrap(inertial3DConfig)
+    inertial3DWrap.ModelTag = "inertial3D"
+    scSim.AddModelToTask(simTaskName, inertial3DWrap, inertial3DConfig)
+    inertial3DConfig.sigma_R0N = [0., 0., 0.]
+    inertial3DConfig.outputDataName = "guidanceInertial3D"
+
+    attErrorConfig = attTrackingError.attTrackingErrorConfig()
+    attErrorWrap = scSim.setModelDataWrap(attErrorConfig)
+    attErrorWrap.ModelTag = "attErrorInertial3D"
+    scSim.AddModelToTask(simTaskName, attErrorWrap, attErrorConfig)
+    attErrorConfig.outputDataName = "attErrorInertial3DMsg"
+    attErrorConfig.inputRefName = inertial3DConfig.outputDataName
+    attErrorConfig.inputNavName = sNavObject.outputAttName
+
+    mrpControlConfig = MRP_Feedback.MRP_FeedbackConfig()
+    mrpControlWrap = scSim.setModelDataWrap(mrpControlConfig)
+    mrpControlWrap.ModelTag = "MRP_Feedback"
+    scSim.AddModelToTask(simTaskName, mrpControlWrap, mrpControlConfig)
+    mrpControlConfig.inputGuidName = attErrorConfig.outputDataName
+    mrpControlConfig.vehConfigInMsgName = "vehicleConfigName"
+    mrpControlConfig.outputDataName = extFTObject.cmdTorqueInMsgName
+    mrpControlConfig.K = 3.5
+    mrpControlConfig.Ki = 0.0002 if useIntGain else -1
+    mrpControlConfig.P = 30.0
+    mrpControlConfig.integralLimit = 2. / mrpControlConfig.Ki * 0.1
+
+    vehicleConfig = vehicleConfigData.VehConfigInputData()
+    vehicleConfigWrap = scSim.setModelDataWrap(vehicleConfig)
+    vehicleConfigWrap.ModelTag = "vehicleConfig"
+    scSim.AddModelToTask(simTaskName, vehicleConfigWrap, vehicleConfig)
+    vehicleConfig.ISCPntB_B = I
+    vehicleConfig.outputPropsName = mrpControlConfig.vehConfigInMsgName
+
+    for messageName in loggedMessages:
+        scSim.TotalSim.logThisMessage(messageName, samplingTime)
+
+    rN, vN = initialOrbit(earth.mu)
+    scObject.hub.r_CN_NInit = rN
+    scObject.hub.v_CN_NInit = vN
+    scObject.hub.sigma_BNInit = [[sigma_BNInit[0]], [sigma_BNInit[1]], [sigma_BNInit[2]]]
+    scObject.hub.omega_BN_BInit = [[omega_BN_BInit[0]], [omega_BN_BInit[1]], [omega_BN_BInit[2]]]
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(simulationTime)
+    scSim.ExecuteSimulation()
+    scSim.TotalSim.messageLogs.archiveLogsToDisk(archiveName)
+    return earth.mu, earth.radEquator, mrpControlConfig.Ki, mrpControlConfig.integralLimit
+
+
+def writeScenario(fileName, mu, radEquator, Ki, integralLimit):
+    """Writes the same scenario as runPython() for the native runner, with all values printed exactly"""
+    def values(vector):
+        return " ".join(repr(float(v)) for v in vector)
+    rN, vN = initialOrbit(mu)
+    lines = [
+        "process " + simProcessName,
+        "task " + simTaskName + " " + simProcessName + " " + str(simulationTimeStep),
+        "module spacecraftPlus spacecraftBody " + simTaskName,
+        "set spacecraftBody hub.mHub 750.0",
+        "set spacecraftBody hub.r_BcB_B 0.0 0.0 0.0",
+        "set spacecraftBody hub.IHubPntBc_B " + values(I),
+        "set spacecraftBody gravBody earth " + repr(mu) + " " + repr(radEquator) + " true",
+        "module extForceTorque externalDisturbance " + simTaskName,
+        "set externalDisturbance extTorquePntB_B " + values(extTorquePntB_B),
+        "link spacecraftBody addDynamicEffector externalDisturbance",
+        "module simpleNav SimpleNavigation " + simTaskName,
+        "module inertial3D inertial3D " + simTaskName,
+        "set inertial3D sigma_R0N 0. 0. 0.",
+        "set inertial3D outputDataName guidanceInertial3D",
+        "module attTrackingError attErrorInertial3D " + simTaskName,
+        "set attErrorInertial3D outputDataName attErrorInertial3DMsg",
+        "set attErrorInertial3D inputRefName guidanceInertial3D",
+        "set attErrorInertial3D inputNavName simple_att_nav_output",
+        "module MRP_Feedback MRP_Feedback " + simTaskName,
+        "set MRP_Feedback inputGuidName attErrorInertial3DMsg",
+        "set MRP_Feedback vehConfigInMsgName vehicleConfigName",
+        "set MRP_Feedback outputDataName extTorquePntB_B_cmds",
+        "set MRP_Feedback K 3.5",
+        "set MRP_Feedback Ki " + repr(Ki),
+        "set MRP_Feedback P 30.0",
+        "set MRP_Feedback integralLimit " + repr(integralLimit),
+        "module vehicleConfigData vehicleConfig " + simTaskName,
+        "set vehicleConfig ISCPntB_B " + values(I),
+        "set vehicleConfig outputPropsName vehicleConfigName",
+        "set spacecraftBody hub.r_CN_NInit " + values(rN),
+        "set spacecraftBody hub.v_CN_NInit " + values(vN),
+        "set spacecraftBody hub.sigma_BNInit " + values(sigma_BNInit),
+        "set spacecraftBody hub.omega_BN_BInit " + values(omega_BN_BInit),
+    ]
+    lines += ["log " + messageName + " " + str(samplingTime) for messageName in loggedMessages]
+    lines.append("stop " + str(simulationTime))
+    with open(fileName, "w") as scenarioFile:
+        scenarioFile.write("\n".join(lines) + "\n")
+
+
+@pytest.mark.skipif(not os.path.exists(runnerPath),
+                    reason="bskScenarioRunner is only built with -DBUILD_NATIVE_RUNNER=ON")
+@pytest.mark.parametrize("useIntGain", [False, True])
+def test_scenarioRunner(tmpdir, useIntGain):
+    """Module Unit Test"""
+    [testResults, testMessage] = scenarioRunnerTest(str(tmpdir), useIntGain)
+    assert testResults < 1, testMessage
+
+
+def scenarioRunnerTest(workDir, useIntGain):
+    testFailCount = 0
+    testMessages = []
+
+    pythonArchive = os.path.join(workDir, "python.bin")
+    nativeArchive = os.path.join(workDir, "native.bin")
+    scenarioName = os.path.join(workDir, "scenario.cfg")
+
+    mu, radEquator, Ki, integralLimit = runPython(useIntGain, pythonArchive)
+    writeScenario(scenarioName, mu, radEquator, Ki, integralLimit)
+    result = subprocess.run([runnerPath, scenarioName, "-o", nativeArchive],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    if result.returncode != 0:
+        testFailCount += 1
+        testMessages.append("FAILED: bskScenarioRunner returned " + str(result.returncode) + " "
+                            + result.stderr.decode())
+        return [testFailCount, "".join(testMessages)]
+
+    pythonLogs = readArchive(pythonArchive)
+    nativeLogs = readArchive(nativeArchive)
+    for messageName in loggedMessages:
+        if messageName not in nativeLogs:
+            testFailCount += 1
+            testMessages.append("FAILED: " + messageName + " was not logged by the native runner\n")
+            continue
+        if pythonLogs[messageName][0] != nativeLogs[messageName][0]:
+            testFailCount += 1
+            testMessages.append("FAILED: " + messageName + " log counts differ\n")
+        elif pythonLogs[messageName][1] != nativeLogs[messageName][1]:
+            testFailCount += 1
+            testMessages.append("FAILED: " + messageName + " logged data differs\n")
+
+    if testFailCount == 0:
+        print("PASSED: scenarioRunner")
+
+    return [testFailCount, "".join(testMessages)]
+
+
+@pytest.mark.skipif(not os.path.exists(runnerPath),
+                    reason="bskScenarioRunner is only built with -DBUILD_NATIVE_RUNNER=ON")
+def test_monteCarloRunner(tmpdir):
+    """Module Unit Test"""
+    [testResults, testMessage] = monteCarloRunnerTest(str(tmpdir))
+    assert testResults < 1, testMessage
+
+
+def readCsv(fileName):
+    with open(fileName) as csvFile:
+        lines = csvFile.read().splitlines()
+    return lines[0].split(","), [line.split(",") for line in lines[1:]]
+
+
+def monteCarloRunnerTest(workDir):
+    testFailCount = 0
+    testMessages = []
+    numCases = 8
+
+    earth = simIncludeGravBody.gravBodyFactory().createEarth()
+    scenarioName = os.path.join(workDir, "monteCarlo.cfg")
+    writeScenario(scenarioName, earth.mu, earth.radEquator, -1., -0.2)
+    with open(scenarioName, "a") as scenarioFile:
+        scenarioFile.write("disperse MRP_Feedback K uniform 2.0 5.0\n")
+        scenarioFile.write("disperse spacecraftBody hub.omega_BN_BInit normal "
+                           "0.001 -0.01 0.03 0.001 0.001 0.001\n")
+        scenarioFile.write("retain attErrorInertial3DMsg " + str(samplingTime) + " sigma_BR omega_BR_B\n")
+
+    outputs = []
+    for numThreads in ["1", "3"]:
+        outputDir = os.path.join(workDir, "threads" + numThreads)
+        os.mkdir(outputDir)
+        result = subprocess.run([runnerPath, scenarioName, "-n", str(numCases), "-j", numThreads, "-s", "42",
+                                 "-d", outputDir], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        if result.returncode != 0:
+            testFailCount += 1
+            testMessages.append("FAILED: bskScenarioRunner returned " + str(result.returncode) + " "
+                                + result.stderr.decode())
+            return [testFailCount, "".join(testMessages)]
+        outputs.append([readCsv(os.path.join(outputDir, "dispersions.csv")),
+                        readCsv(os.path.join(outputDir, "attErrorInertial3DMsg.csv"))])
+
+    if outputs[0] != outputs[1]:
+        testFailCount += 1
+        testMessages.append("FAILED: Monte Carlo results depend on the number of threads\n")
+
+    (dispersionHeader, dispersions), (retainedHeader, retained) = outputs[0]
+    gains = [float(row[1]) for row in dispersions]
+    if len(dispersions) != numCases or len(set(gains)) != numCases or min(gains) < 2.0 or max(gains) > 5.0:
+        testFailCount += 1
+        testMessages.append("FAILED: wrong dispersed values " + str(gains) + "\n")
+    if retainedHeader != ["case", "time", "sigma_BR_0", "sigma_BR_1", "sigma_BR_2",
+                          "omega_BR_B_0", "omega_BR_B_1", "omega_BR_B_2"]:
+        testFailCount += 1
+        testMessages.append("FAILED: wrong retained columns " + str(retainedHeader) + "\n")
+    # the logging times only depend on the task period and the sampling time, so every case has the same rows
+    numLogs = len([row for row in retained if row[0] == "0"])
+    if numLogs < simulationTime // samplingTime:
+        testFailCount += 1
+        testMessages.append("FAILED: case 0 retained " + str(numLogs) + " messages\n")
+    for case in range(numCases):
+        rows = [row for row in retained if row[0] == str(case)]
+        if len(rows) != numLogs:
+            testFailCount += 1
+            testMessages.append("FAILED: case " + str(case) + " retained " + str(len(rows)) + " messages\n")
+        elif case > 0 and rows[-1][2:] == retained[numLogs - 1][2:]:
+            testFailCount += 1
+            testMessages.append("FAILED: case " + str(case) + " is not dispersed\n")
+
+    if testFailCount == 0:
+        print("PASSED: monteCarloRunner")
+
+    return [testFailCount, "".join(testMessages)]
+
+
+if __name__ == "__main__":
+    scenarioRunnerTest(".", False)
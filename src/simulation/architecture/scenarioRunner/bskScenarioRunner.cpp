@@ -0,0 +1,175 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Runs a scenario file without python.  Build with -DBUILD_NATIVE_RUNNER=ON and run
+ *
+ *     ./bskScenarioRunner <scenario file> [-o <log archive>] [-t <stop time ns>]
+ *     ./bskScenarioRunner <scenario file> -n <cases> [-j <threads>] [-s <seed>] [-d <output directory>]
+ *
+ * The -o and -t options override the archive and stop commands of the scenario file.  With -n the scenario is
+ * run as a Monte Carlo analysis and the retained data is written to csv files in the output directory.  The
+ * program returns a non-zero exit code if the scenario cannot be loaded or if any case failed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <stdexcept>
+#include "architecture/scenarioRunner/scenarioRunner.h"
+#include "architecture/scenarioRunner/monteCarloRunner.h"
+
+static void printUsage(const char *program)
+{
+    std::vector<std::string> typeNames = ModuleRegistry::GetInstance()->getTypeNames();
+    printf("usage: %s <scenario file> [-o <log archive>] [-t <stop time ns>]\n", program);
+    printf("       %s <scenario file> -n <cases> [-j <threads>] [-s <seed>] [-d <output directory>] "
+           "[-t <stop time ns>]\n", program);
+    printf("module types:");
+    for(size_t i = 0; i < typeNames.size(); i++)
+    {
+        printf(" %s", typeNames[i].c_str());
+    }
+    printf("\n");
+}
+
+/*! Runs the cases of a Monte Carlo scenario and writes the retained data */
+static int runMonteCarlo(std::string scenarioFile, std::string stopTime, std::string numCases,
+                         std::string numThreads, std::string seed, std::string outputDirectory)
+{
+    MonteCarloRunner runner;
+    uint64_t cases;
+    uint32_t threads = 0;
+    try
+    {
+        assignParameter(cases, ParameterValues(1, numCases));
+        if(!numThreads.empty())
+        {
+            assignParameter(threads, ParameterValues(1, numThreads));
+        }
+        if(!seed.empty())
+        {
+            assignParameter(runner.seed, ParameterValues(1, seed));
+        }
+        runner.loadScenario(scenarioFile);
+        if(!stopTime.empty())
+        {
+            runner.parseLine("stop " + stopTime);
+        }
+        runner.executeCases(cases, threads);
+        runner.sink.writeCsv(outputDirectory);
+    }
+    catch(const std::exception &error)
+    {
+        fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    std::map<uint64_t, std::string> failedCases = runner.sink.getFailedCases();
+    std::map<uint64_t, std::string>::iterator it;
+    for(it = failedCases.begin(); it != failedCases.end(); it++)
+    {
+        fprintf(stderr, "case %llu failed: %s\n", (unsigned long long) it->first, it->second.c_str());
+    }
+    return(failedCases.empty() ? 0 : 1);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string scenarioFile;
+    std::string archiveFile;
+    std::string stopTime;
+    std::string numCases;
+    std::string numThreads;
+    std::string seed;
+    std::string outputDirectory = ".";
+    int i;
+
+    registerScenarioModules();
+    for(i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            archiveFile = argv[++i];
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            stopTime = argv[++i];
+        }
+        else if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            numCases = argv[++i];
+        }
+        else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            numThreads = argv[++i];
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            seed = argv[++i];
+        }
+        else if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            outputDirectory = argv[++i];
+        }
+        else if(argv[i][0] != '-' && scenarioFile.empty())
+        {
+            scenarioFile = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if(scenarioFile.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if(!numCases.empty())
+    {
+        return(runMonteCarlo(scenarioFile, stopTime, numCases, numThreads, seed, outputDirectory));
+    }
+
+    ScenarioRunner runner;
+    try
+    {
+        runner.loadScenario(scenarioFile);
+        if(!stopTime.empty())
+        {
+            runner.parseLine("stop " + stopTime);
+        }
+        if(!archiveFile.empty())
+        {
+            runner.archiveFileName = archiveFile;
+        }
+        runner.initializeSimulation();
+        runner.executeSimulation(runner.stopTime);
+        if(!runner.archiveFileName.empty())
+        {
+            runner.archiveLogs(runner.archiveFileName);
+        }
+    }
+    catch(const std::exception &error)
+    {
+        fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
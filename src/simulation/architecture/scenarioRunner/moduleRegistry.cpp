@@ -0,0 +1,330 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "architecture/scenarioRunner/moduleRegistry.h"
+#include <stdexcept>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <cmath>
+
+ModuleRegistry* ModuleRegistry::TheInstance = NULL;
+
+/*! Adds a settable parameter to the module type
+ @return ModuleType& this type, so parameters can be chained
+ @param name name of the parameter in the scenario files
+ @param setter function that converts the values and sets the parameter
+ */
+ModuleType &ModuleType::parameter(std::string name, ParameterSetter setter)
+{
+    this->parameters[name] = setter;
+    return(*this);
+}
+
+/*! Adds a link to another module to the module type
+ @return ModuleType& this type, so links can be chained
+ @param name name of the link in the scenario files
+ @param linker function that connects the other module to this one
+ */
+ModuleType &ModuleType::link(std::string name, ModuleLinker linker)
+{
+    this->links[name] = linker;
+    return(*this);
+}
+
+/*! The registry is created empty */
+ModuleRegistry::ModuleRegistry()
+{
+}
+
+/*! Nothing to destroy */
+ModuleRegistry::~ModuleRegistry()
+{
+}
+
+/*!
+ * This gets the single instance of the registry, and creates it the first time it is called
+ * @return ModuleRegistry* TheInstance
+ */
+ModuleRegistry* ModuleRegistry::GetInstance()
+{
+    if(TheInstance == NULL)
+    {
+        TheInstance = new ModuleRegistry();
+    }
+    return(TheInstance);
+}
+
+/*! Registers a new module type.  Registering a name again replaces the previous type.
+ @return ModuleType& the new type to add parameters and links to
+ @param typeName name of the module type in the scenario files
+ @param factory function that creates an instance of the module
+ */
+ModuleType &ModuleRegistry::addType(std::string typeName, ModuleFactory factory)
+{
+    ModuleType newType;
+    newType.create = factory;
+    this->types[typeName] = newType;
+    return(this->types[typeName]);
+}
+
+/*! Looks up a module type by name
+ @return ModuleType* the module type, NULL if the name is not registered
+ @param typeName name of the module type
+ */
+ModuleType *ModuleRegistry::findType(std::string typeName)
+{
+    std::map<std::string, ModuleType>::iterator it = this->types.find(typeName);
+    if(it == this->types.end())
+    {
+        return(NULL);
+    }
+    return(&(it->second));
+}
+
+/*! Lists the registered module types
+ @return std::vector<std::string> the type names in alphabetical order
+ */
+std::vector<std::string> ModuleRegistry::getTypeNames()
+{
+    std::vector<std::string> names;
+    std::map<std::string, ModuleType>::iterator it;
+    for(it = this->types.begin(); it != this->types.end(); it++)
+    {
+        names.push_back(it->first);
+    }
+    return(names);
+}
+
+/*! Registers a double field of a message struct.  Registering a field again replaces it.
+ @return void
+ @param messageStruct name of the message struct, as given to CreateNewMessage()
+ @param fieldName name of the field
+ @param offset [bytes] offset of the field in the message payload
+ @param numValues number of doubles of the field
+ */
+void ModuleRegistry::addMessageField(std::string messageStruct, std::string fieldName, size_t offset,
+                                     size_t numValues)
+{
+    MessageField field;
+    field.offset = offset;
+    field.numValues = numValues;
+    this->messageFields[messageStruct][fieldName] = field;
+}
+
+/*! Looks up a registered message field
+ @return MessageField* the field, NULL if the struct or field is not registered
+ @param messageStruct name of the message struct
+ @param fieldName name of the field
+ */
+MessageField *ModuleRegistry::findMessageField(std::string messageStruct, std::string fieldName)
+{
+    std::map<std::string, std::map<std::string, MessageField> >::iterator it = this->messageFields.find(messageStruct);
+    if(it == this->messageFields.end())
+    {
+        return(NULL);
+    }
+    std::map<std::string, MessageField>::iterator field = it->second.find(fieldName);
+    return(field == it->second.end() ? NULL : &(field->second));
+}
+
+/*! Throws if the number of values is not the expected one */
+static void checkValueCount(const ParameterValues &values, size_t expected)
+{
+    if(values.size() != expected)
+    {
+        throw std::runtime_error("expected " + std::to_string(expected) + " value(s) but got "
+                                 + std::to_string(values.size()));
+    }
+}
+
+/*! Converts one value to a double.  The conversion is correctly rounded, so a value printed with 17
+ significant digits gives back exactly the same double as in python. */
+static double parseDouble(const std::string &text)
+{
+    char *end;
+    double value;
+    errno = 0;
+    value = strtod(text.c_str(), &end);
+    if(text.empty() || *end != '\0' || errno == ERANGE)
+    {
+        throw std::runtime_error("'" + text + "' is not a valid number");
+    }
+    return(value);
+}
+
+/*! Converts one value to an integer */
+static long long parseInteger(const std::string &text)
+{
+    char *end;
+    long long value;
+    errno = 0;
+    value = strtoll(text.c_str(), &end, 0);
+    if(text.empty() || *end != '\0' || errno == ERANGE)
+    {
+        throw std::runtime_error("'" + text + "' is not a valid integer");
+    }
+    return(value);
+}
+
+/*! Sets a double parameter from one value */
+void assignParameter(double &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    value = parseDouble(values[0]);
+}
+
+/*! Sets a 32 bit integer parameter from one value */
+void assignParameter(int32_t &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    value = (int32_t) parseInteger(values[0]);
+}
+
+/*! Sets an unsigned 32 bit integer parameter from one value */
+void assignParameter(uint32_t &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    value = (uint32_t) parseInteger(values[0]);
+}
+
+/*! Sets a 64 bit integer parameter from one value */
+void assignParameter(int64_t &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    value = (int64_t) parseInteger(values[0]);
+}
+
+/*! Sets an unsigned 64 bit integer parameter from one value.  Times in nanoseconds can exceed the signed
+ range, so the value is converted as unsigned. */
+void assignParameter(uint64_t &value, const ParameterValues &values)
+{
+    char *end;
+    checkValueCount(values, 1);
+    errno = 0;
+    value = strtoull(values[0].c_str(), &end, 0);
+    if(values[0].empty() || values[0][0] == '-' || *end != '\0' || errno == ERANGE)
+    {
+        throw std::runtime_error("'" + values[0] + "' is not a valid unsigned integer");
+    }
+}
+
+/*! Sets a flag from one value, accepting 0/1 and true/false */
+void assignParameter(bool &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    if(values[0] == "true" || values[0] == "True" || values[0] == "1")
+    {
+        value = true;
+    }
+    else if(values[0] == "false" || values[0] == "False" || values[0] == "0")
+    {
+        value = false;
+    }
+    else
+    {
+        throw std::runtime_error("'" + values[0] + "' is not a valid flag");
+    }
+}
+
+/*! Sets a string parameter, such as a message name, from one value */
+void assignParameter(std::string &value, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    value = values[0];
+}
+
+/*! Sets a 3 vector from three values */
+void assignParameter(Eigen::Vector3d &value, const ParameterValues &values)
+{
+    checkValueCount(values, 3);
+    for(int i = 0; i < 3; i++)
+    {
+        value(i) = parseDouble(values[i]);
+    }
+}
+
+/*! Sets a 3x3 matrix from nine values in row major order, as unitTestSupport.np2EigenMatrix3d() */
+void assignParameter(Eigen::Matrix3d &value, const ParameterValues &values)
+{
+    checkValueCount(values, 9);
+    for(int i = 0; i < 3; i++)
+    {
+        for(int j = 0; j < 3; j++)
+        {
+            value(i, j) = parseDouble(values[3*i + j]);
+        }
+    }
+}
+
+/*! Sets a variable size vector to the given values */
+void assignParameter(Eigen::VectorXd &value, const ParameterValues &values)
+{
+    value.resize((Eigen::Index) values.size());
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        value((Eigen::Index) i) = parseDouble(values[i]);
+    }
+}
+
+/*! Sets a square matrix from n*n values in row major order */
+void assignParameter(Eigen::MatrixXd &value, const ParameterValues &values)
+{
+    Eigen::Index size = (Eigen::Index) std::lround(std::sqrt((double) values.size()));
+    if((size_t) (size*size) != values.size())
+    {
+        throw std::runtime_error("expected n*n values for a square matrix but got "
+                                 + std::to_string(values.size()));
+    }
+    value.resize(size, size);
+    for(Eigen::Index i = 0; i < size; i++)
+    {
+        for(Eigen::Index j = 0; j < size; j++)
+        {
+            value(i, j) = parseDouble(values[(size_t) (i*size + j)]);
+        }
+    }
+}
+
+/*! Sets the leading elements of a double array, at most maxLength values are accepted */
+void assignDoubleArray(double *value, size_t maxLength, const ParameterValues &values)
+{
+    if(values.empty() || values.size() > maxLength)
+    {
+        throw std::runtime_error("expected 1 to " + std::to_string(maxLength) + " values but got "
+                                 + std::to_string(values.size()));
+    }
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        value[i] = parseDouble(values[i]);
+    }
+}
+
+/*! Copies one value into a character array, it must fit with its terminating zero */
+void assignCharArray(char *value, size_t maxLength, const ParameterValues &values)
+{
+    checkValueCount(values, 1);
+    if(values[0].size() >= maxLength)
+    {
+        throw std::runtime_error("'" + values[0] + "' is longer than "
+                                 + std::to_string(maxLength - 1) + " characters");
+    }
+    memset(value, 0x0, maxLength);
+    memcpy(value, values[0].c_str(), values[0].size());
+}
@@ -0,0 +1,201 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _ModuleRegistry_HH_
+#define _ModuleRegistry_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
+#include <Eigen/Dense>
+#include "_GeneralModuleFiles/sys_model.h"
+#include "architecture/alg_contain/alg_contain.h"
+#include "utilities/bskLogging.h"
+
+typedef std::vector<std::string> ParameterValues;   //!< -- string values given to one parameter in a scenario
+
+/*! @brief One module created by the scenario runner.  The model is what gets added to a task, the data is the
+ C++ module itself or the configuration structure of a C module, and the storage owns everything the instance
+ allocated. */
+class ModuleInstance
+{
+public:
+    /*! Returns the module or C configuration data as the given type
+     @return M* pointer to the module data
+     */
+    template <typename M> M* getData() {return static_cast<M*>(this->data);}
+
+public:
+    std::string typeName;                       //!< -- registered type name of the module
+    SysModel *model;                            //!< -- model that is scheduled in a task
+    void *data;                                 //!< -- module object or C configuration structure
+    std::vector<std::shared_ptr<void> > storage;//!< -- objects owned by the instance
+};
+
+typedef std::function<void(ModuleInstance &, BSKLogger *)> ModuleFactory;                   //!< -- creates a module instance
+typedef std::function<void(ModuleInstance &, const ParameterValues &)> ParameterSetter;    //!< -- sets one module parameter
+typedef std::function<void(ModuleInstance &, ModuleInstance &)> ModuleLinker;              //!< -- connects two module instances
+
+/*! @brief Description of one module type that scenarios can instantiate: how to create it, which parameters can
+ be set and which links to other modules can be made. */
+class ModuleType
+{
+public:
+    ModuleType &parameter(std::string name, ParameterSetter setter);
+    ModuleType &link(std::string name, ModuleLinker linker);
+
+public:
+    ModuleFactory create;                               //!< -- creates a new instance of the module
+    std::map<std::string, ParameterSetter> parameters;  //!< -- settable parameters by name
+    std::map<std::string, ModuleLinker> links;          //!< -- links to other modules by name
+};
+
+/*! @brief Location of a double or double array field inside a message payload */
+class MessageField
+{
+public:
+    size_t offset;                              //!< [bytes] offset of the field in the message payload
+    size_t numValues;                           //!< -- number of doubles of the field
+};
+
+/*! @brief Registry of the module types available to native scenarios.  Modules are registered once by
+ registerScenarioModules() and then looked up by the type name used in the scenario file.  The registry also holds
+ the double fields of the message types that Monte Carlo runs can retain. */
+class ModuleRegistry
+{
+public:
+    static ModuleRegistry* GetInstance();       //!< -- returns a pointer to the sim instance of ModuleRegistry
+    ModuleType &addType(std::string typeName, ModuleFactory factory);
+    ModuleType *findType(std::string typeName);
+    std::vector<std::string> getTypeNames();
+    void addMessageField(std::string messageStruct, std::string fieldName, size_t offset, size_t numValues);
+    MessageField *findMessageField(std::string messageStruct, std::string fieldName);
+
+private:
+    ModuleRegistry();
+    ~ModuleRegistry();
+    ModuleRegistry(const ModuleRegistry&) = delete;
+    ModuleRegistry& operator=(const ModuleRegistry&) = delete;
+
+    static ModuleRegistry *TheInstance;         //!< -- instance of the module registry
+    std::map<std::string, ModuleType> types;    //!< -- registered module types by name
+    std::map<std::string, std::map<std::string, MessageField> > messageFields; //!< -- message fields by struct and field name
+};
+
+void registerScenarioModules();
+
+void assignParameter(double &value, const ParameterValues &values);
+void assignParameter(int32_t &value, const ParameterValues &values);
+void assignParameter(uint32_t &value, const ParameterValues &values);
+void assignParameter(int64_t &value, const ParameterValues &values);
+void assignParameter(uint64_t &value, const ParameterValues &values);
+void assignParameter(bool &value, const ParameterValues &values);
+void assignParameter(std::string &value, const ParameterValues &values);
+void assignParameter(Eigen::Vector3d &value, const ParameterValues &values);
+void assignParameter(Eigen::Matrix3d &value, const ParameterValues &values);
+void assignParameter(Eigen::VectorXd &value, const ParameterValues &values);
+void assignParameter(Eigen::MatrixXd &value, const ParameterValues &values);
+void assignDoubleArray(double *value, size_t maxLength, const ParameterValues &values);
+void assignCharArray(char *value, size_t maxLength, const ParameterValues &values);
+
+/*! Sets a fixed size double array such as a C configuration vector, at most N values are accepted
+ @return void
+ @param value array to set
+ @param values parameter values from the scenario
+ */
+template <size_t N> void assignParameter(double (&value)[N], const ParameterValues &values)
+{
+    assignDoubleArray(value, N, values);
+}
+
+/*! Sets a fixed size character array such as a C configuration message name
+ @return void
+ @param value array to set
+ @param values parameter values from the scenario
+ */
+template <size_t N> void assignParameter(char (&value)[N], const ParameterValues &values)
+{
+    assignCharArray(value, N, values);
+}
+
+/*! Registers a C++ module that derives from SysModel and is default constructible
+ @return ModuleType& the new type to add parameters and links to
+ @param typeName name of the module type in the scenario files
+ */
+template <typename M> ModuleType &registerModel(std::string typeName)
+{
+    return ModuleRegistry::GetInstance()->addType(typeName,
+        [](ModuleInstance &instance, BSKLogger *) {
+            std::shared_ptr<M> module = std::make_shared<M>();
+            instance.storage.push_back(module);
+            instance.model = module.get();
+            instance.data = module.get();
+        });
+}
+
+/*! Registers a C module by its configuration structure and its update and initialization functions.  The
+ configuration is zero initialized and wrapped in an AlgContain, as setModelDataWrap() does in python.
+ @return ModuleType& the new type to add parameters and links to
+ @param typeName name of the module type in the scenario files
+ @param update Update_ function of the module
+ @param selfInit SelfInit_ function of the module
+ @param crossInit CrossInit_ function of the module
+ @param reset Reset_ function of the module
+ */
+template <typename C> ModuleType &registerAlgorithm(std::string typeName,
+                                                    void (*update)(C*, uint64_t, int64_t),
+                                                    void (*selfInit)(C*, int64_t),
+                                                    void (*crossInit)(C*, int64_t),
+                                                    void (*reset)(C*, uint64_t, int64_t))
+{
+    return ModuleRegistry::GetInstance()->addType(typeName,
+        [=](ModuleInstance &instance, BSKLogger *logger) {
+            std::shared_ptr<C> config(new C());
+            config->bskLogger = logger;
+            std::shared_ptr<AlgContain> wrap = std::make_shared<AlgContain>(config.get(),
+                reinterpret_cast<AlgUpdatePtr>(update), reinterpret_cast<AlgPtr>(selfInit),
+                reinterpret_cast<AlgPtr>(crossInit), reinterpret_cast<AlgUpdatePtr>(reset));
+            instance.storage.push_back(config);
+            instance.storage.push_back(wrap);
+            instance.model = wrap.get();
+            instance.data = config.get();
+        });
+}
+
+/*! Defines a parameter setter for a (possibly nested) public member of a module or C configuration */
+#define BSK_PARAMETER(Type, member) \
+    [](ModuleInstance &instance, const ParameterValues &values) { \
+        assignParameter(instance.getData<Type>()->member, values); \
+    }
+
+/*! Registers a double or double array field of a message struct so Monte Carlo runs can retain it by name */
+#define BSK_MESSAGE_FIELD(Type, member) \
+    do { \
+        static_assert(std::is_same<std::remove_all_extents<decltype(Type::member)>::type, double>::value, \
+                      #Type "." #member " is not a double field"); \
+        ModuleRegistry::GetInstance()->addMessageField(#Type, #member, offsetof(Type, member), \
+                                                       sizeof(((Type *) 0)->member)/sizeof(double)); \
+    } while(0)
+
+#endif /* _ModuleRegistry_HH_ */
@@ -0,0 +1,582 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "architecture/scenarioRunner/monteCarloRunner.h"
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <random>
+#include <thread>
+#include <atomic>
+
+/*! Gives the calling thread its own messaging system for as long as it exists, so that the simulation
+ built in its scope does not touch the messages of any other thread */
+class ThreadMessagingScope
+{
+public:
+    ThreadMessagingScope() {SystemMessaging::attachThreadInstance();}
+    ~ThreadMessagingScope() {SystemMessaging::detachThreadInstance();}
+};
+
+/*! Adds a case to the sink
+ @return void
+ @param caseNumber number of the case
+ @param values dispersed values of the case
+ @param caseData retained data of each message, moved into the sink
+ */
+void MonteCarloSink::addCase(uint64_t caseNumber, const std::vector<double> &values,
+                             std::vector<RetainedColumns> &caseData)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    this->dispersedValues[caseNumber] = values;
+    this->cases[caseNumber].swap(caseData);
+}
+
+/*! Sets the names of the retained messages and of the columns of the output files, and clears the sink
+ @return void
+ @param names names of the retained messages
+ @param columns column names of each retained message
+ @param dispersedColumns column names of the dispersed values
+ */
+void MonteCarloSink::setColumns(const std::vector<std::string> &names,
+                                const std::vector<std::vector<std::string> > &columns,
+                                const std::vector<std::string> &dispersedColumns)
+{
+    this->clear();
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    this->messageNames = names;
+    this->messageColumns = columns;
+    this->dispersionColumns = dispersedColumns;
+}
+
+/*! Records a case that could not be run
+ @return void
+ @param caseNumber number of the case
+ @param reason error message of the case
+ */
+void MonteCarloSink::addFailedCase(uint64_t caseNumber, std::string reason)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    this->failedCases[caseNumber] = reason;
+}
+
+/*! Removes the data of all cases
+ @return void
+ */
+void MonteCarloSink::clear()
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    this->dispersedValues.clear();
+    this->cases.clear();
+    this->failedCases.clear();
+}
+
+/*! Writes one line of comma separated values, the doubles with 17 significant digits so that they read back
+ exactly */
+static void writeCsvRow(FILE *csvFile, uint64_t caseNumber, const uint64_t *time, const std::vector<double> &values)
+{
+    fprintf(csvFile, "%llu", (unsigned long long) caseNumber);
+    if(time != NULL)
+    {
+        fprintf(csvFile, ",%llu", (unsigned long long) *time);
+    }
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        fprintf(csvFile, ",%.17g", values[i]);
+    }
+    fprintf(csvFile, "\n");
+}
+
+/*! Opens a csv file and writes its header line */
+static FILE *openCsv(std::string fileName, std::string firstColumns, const std::vector<std::string> &columns)
+{
+    FILE *csvFile = fopen(fileName.c_str(), "w");
+    if(csvFile == NULL)
+    {
+        throw std::runtime_error("could not open " + fileName);
+    }
+    fprintf(csvFile, "%s", firstColumns.c_str());
+    for(size_t i = 0; i < columns.size(); i++)
+    {
+        fprintf(csvFile, ",%s", columns[i].c_str());
+    }
+    fprintf(csvFile, "\n");
+    return(csvFile);
+}
+
+/*! Writes the sink to comma separated files in an existing directory.  dispersions.csv has one row per case with
+ the dispersed values, and <message>.csv has one row per retained message with the case, the write time in
+ nanoseconds and the retained values.  The rows are in case order, so the files do not depend on the order in
+ which the cases finished.
+ @return void
+ @param directory directory of the files
+ */
+void MonteCarloSink::writeCsv(std::string directory)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    std::map<uint64_t, std::vector<RetainedColumns> >::iterator it;
+    FILE *csvFile = openCsv(directory + "/dispersions.csv", "case", this->dispersionColumns);
+    for(it = this->cases.begin(); it != this->cases.end(); it++)
+    {
+        writeCsvRow(csvFile, it->first, NULL, this->dispersedValues[it->first]);
+    }
+    fclose(csvFile);
+
+    for(size_t m = 0; m < this->messageNames.size(); m++)
+    {
+        csvFile = openCsv(directory + "/" + this->messageNames[m] + ".csv", "case,time", this->messageColumns[m]);
+        std::vector<double> row(this->messageColumns[m].size());
+        for(it = this->cases.begin(); it != this->cases.end(); it++)
+        {
+            RetainedColumns &data = it->second[m];
+            for(size_t k = 0; k < data.times.size(); k++)
+            {
+                for(size_t c = 0; c < row.size(); c++)
+                {
+                    row[c] = data.columns[c][k];
+                }
+                writeCsvRow(csvFile, it->first, &data.times[k], row);
+            }
+        }
+        fclose(csvFile);
+    }
+}
+
+/*! Lists the cases that were run successfully
+ @return std::vector<uint64_t> the case numbers in increasing order
+ */
+std::vector<uint64_t> MonteCarloSink::getCaseNumbers()
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    std::vector<uint64_t> caseNumbers;
+    std::map<uint64_t, std::vector<RetainedColumns> >::iterator it;
+    for(it = this->cases.begin(); it != this->cases.end(); it++)
+    {
+        caseNumbers.push_back(it->first);
+    }
+    return(caseNumbers);
+}
+
+/*! Lists the cases that could not be run
+ @return std::map<uint64_t, std::string> the error message by case number
+ */
+std::map<uint64_t, std::string> MonteCarloSink::getFailedCases()
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    return(this->failedCases);
+}
+
+/*! Gets the dispersed values of a case
+ @return std::vector<double> the values, in the order of the dispersions.csv columns
+ @param caseNumber number of the case
+ */
+std::vector<double> MonteCarloSink::getDispersedValues(uint64_t caseNumber)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    std::map<uint64_t, std::vector<double> >::iterator it = this->dispersedValues.find(caseNumber);
+    return(it == this->dispersedValues.end() ? std::vector<double>() : it->second);
+}
+
+/*! Gets the retained data of a message in a case
+ @return RetainedColumns the data, empty if the case or message is unknown
+ @param caseNumber number of the case
+ @param messageName name of the retained message
+ */
+RetainedColumns MonteCarloSink::getCaseData(uint64_t caseNumber, std::string messageName)
+{
+    std::lock_guard<std::mutex> lock(this->sinkMutex);
+    std::map<uint64_t, std::vector<RetainedColumns> >::iterator it = this->cases.find(caseNumber);
+    for(size_t m = 0; it != this->cases.end() && m < this->messageNames.size(); m++)
+    {
+        if(this->messageNames[m] == messageName)
+        {
+            return(it->second[m]);
+        }
+    }
+    return(RetainedColumns());
+}
+
+/*! The runner starts without scenario lines, dispersions or retained messages */
+MonteCarloRunner::MonteCarloRunner()
+{
+    this->seed = 0;
+    this->disperseSeeds = false;
+    this->scenarioName = "scenario";
+}
+
+/*! Nothing to destroy */
+MonteCarloRunner::~MonteCarloRunner()
+{
+}
+
+/*! Reads a Monte Carlo scenario file.  The disperse and retain lines are read here, every other line is kept to
+ build the cases.
+ @return void
+ @param fileName path of the scenario file
+ */
+void MonteCarloRunner::loadScenario(std::string fileName)
+{
+    std::ifstream scenarioFile(fileName);
+    std::string line;
+    if(!scenarioFile.is_open())
+    {
+        throw std::runtime_error("could not open scenario file " + fileName);
+    }
+    this->scenarioName = fileName;
+    this->scenarioLines.clear();
+    while(std::getline(scenarioFile, line))
+    {
+        try
+        {
+            this->parseLine(line);
+        }
+        catch(const std::exception &error)
+        {
+            throw std::runtime_error(fileName + ":" + std::to_string(this->scenarioLines.size() + 1) + ": "
+                                     + error.what());
+        }
+    }
+}
+
+/*! Reads one Monte Carlo scenario line.  In addition to the ScenarioRunner commands there are
+
+     disperse <module> <parameter> uniform <lower values...> <upper values...>
+     disperse <module> <parameter> normal <means...> <standard deviations...>
+     retain <message> <period ns> <fields...>
+
+ The archive command is not available, as all cases would write the same file.
+ @return void
+ @param line the scenario line
+ */
+void MonteCarloRunner::parseLine(std::string line)
+{
+    std::vector<std::string> words;
+    std::string word;
+    std::string content = line.substr(0, line.find('#'));
+    std::istringstream lineStream(content);
+    while(lineStream >> word)
+    {
+        words.push_back(word);
+    }
+
+    /* the MC lines are kept as empty lines so that the line numbers of the case errors match the file */
+    if(!words.empty() && words[0] == "disperse")
+    {
+        if(words.size() < 6 || (words.size() - 4) % 2 != 0)
+        {
+            throw std::runtime_error("disperse needs a module, a parameter, a distribution and two sets of values");
+        }
+        size_t numValues = (words.size() - 4) / 2;
+        std::vector<double> center(numValues);
+        std::vector<double> spread(numValues);
+        for(size_t i = 0; i < numValues; i++)
+        {
+            assignParameter(center[i], ParameterValues(1, words[4 + i]));
+            assignParameter(spread[i], ParameterValues(1, words[4 + numValues + i]));
+        }
+        this->addDispersion(words[1], words[2], words[3], center, spread);
+        line.clear();
+    }
+    else if(!words.empty() && words[0] == "retain")
+    {
+        if(words.size() < 4)
+        {
+            throw std::runtime_error("retain needs a message, a period and at least one field");
+        }
+        uint64_t logPeriod;
+        assignParameter(logPeriod, ParameterValues(1, words[2]));
+        this->addRetention(words[1], logPeriod, std::vector<std::string>(words.begin() + 3, words.end()));
+        line.clear();
+    }
+    else if(!words.empty() && words[0] == "archive")
+    {
+        throw std::runtime_error("archive is not available for Monte Carlo cases, use retain");
+    }
+    this->scenarioLines.push_back(line);
+}
+
+/*! Disperses a double parameter of a module.  Every value of the parameter is drawn independently for each case.
+ @return void
+ @param moduleName name of the module
+ @param parameterName name of the parameter
+ @param distribution uniform or normal
+ @param center lower bounds for uniform, means for normal
+ @param spread upper bounds for uniform, standard deviations for normal
+ */
+void MonteCarloRunner::addDispersion(std::string moduleName, std::string parameterName, std::string distribution,
+                                     const std::vector<double> &center, const std::vector<double> &spread)
+{
+    ParameterDispersion dispersion;
+    if(distribution != "uniform" && distribution != "normal")
+    {
+        throw std::runtime_error("unknown distribution " + distribution + ", use uniform or normal");
+    }
+    if(center.empty() || center.size() != spread.size())
+    {
+        throw std::runtime_error("the dispersion of " + moduleName + "." + parameterName
+                                 + " needs the same number of lower and upper values");
+    }
+    dispersion.moduleName = moduleName;
+    dispersion.parameterName = parameterName;
+    dispersion.normal = distribution == "normal";
+    dispersion.center = center;
+    dispersion.spread = spread;
+    this->dispersions.push_back(dispersion);
+}
+
+/*! Retains double fields of a message from every case.  The fields must be registered with BSK_MESSAGE_FIELD.
+ @return void
+ @param messageName name of the message
+ @param logPeriod [ns] minimum time between retained messages
+ @param fieldNames names of the retained fields
+ */
+void MonteCarloRunner::addRetention(std::string messageName, uint64_t logPeriod,
+                                    const std::vector<std::string> &fieldNames)
+{
+    MessageRetention retention;
+    retention.messageName = messageName;
+    retention.logPeriod = logPeriod;
+    retention.fieldNames = fieldNames;
+    this->retentions.push_back(retention);
+}
+
+/*! Builds the scenario of a case and logs the retained messages */
+void MonteCarloRunner::buildCase(ScenarioRunner &runner)
+{
+    for(size_t i = 0; i < this->scenarioLines.size(); i++)
+    {
+        try
+        {
+            runner.parseLine(this->scenarioLines[i]);
+        }
+        catch(const std::exception &error)
+        {
+            throw std::runtime_error(this->scenarioName + ":" + std::to_string(i + 1) + ": " + error.what());
+        }
+    }
+    for(size_t m = 0; m < this->retentions.size(); m++)
+    {
+        runner.logMessage(this->retentions[m].messageName, this->retentions[m].logPeriod);
+    }
+}
+
+/*! Builds and initializes one case on the calling thread to check the dispersed parameters and to resolve the
+ retained fields before any worker starts, so that a mistake in the scenario is reported once and not by every
+ case. */
+void MonteCarloRunner::prepareCases()
+{
+    ThreadMessagingScope messagingScope;
+    ScenarioRunner runner;
+    std::vector<std::string> messageNames;
+    std::vector<std::vector<std::string> > messageColumns;
+    std::vector<std::string> dispersionColumns;
+    char valueText[32];
+
+    this->buildCase(runner);
+    for(size_t d = 0; d < this->dispersions.size(); d++)
+    {
+        ParameterDispersion &dispersion = this->dispersions[d];
+        ParameterValues values;
+        std::string columnName = dispersion.moduleName + "." + dispersion.parameterName;
+        for(size_t i = 0; i < dispersion.center.size(); i++)
+        {
+            snprintf(valueText, sizeof(valueText), "%.17g", dispersion.center[i]);
+            values.push_back(valueText);
+            dispersionColumns.push_back(dispersion.center.size() > 1 ? columnName + "_" + std::to_string(i)
+                                        : columnName);
+        }
+        runner.setParameter(dispersion.moduleName, dispersion.parameterName, values);
+    }
+    runner.initializeSimulation();
+
+    this->retainedFields.clear();
+    for(size_t m = 0; m < this->retentions.size(); m++)
+    {
+        MessageRetention &retention = this->retentions[m];
+        MessageHeaderData header;
+        std::vector<MessageField> fields;
+        std::vector<std::string> columns;
+        if(runner.simulation.getMessageID(retention.messageName).itemID < 0)
+        {
+            throw std::runtime_error("retained message " + retention.messageName + " is not written by any module");
+        }
+        runner.simulation.populateMessageHeader(retention.messageName, &header);
+        for(size_t f = 0; f < retention.fieldNames.size(); f++)
+        {
+            MessageField *field = ModuleRegistry::GetInstance()->findMessageField(header.messageStruct,
+                                                                                retention.fieldNames[f]);
+            if(field == NULL)
+            {
+                throw std::runtime_error("field " + retention.fieldNames[f] + " of " + header.messageStruct
+                                         + " is not registered");
+            }
+            if(field->offset + field->numValues*sizeof(double) > header.MaxMessageSize)
+            {
+                throw std::runtime_error("field " + retention.fieldNames[f] + " is outside of "
+                                         + header.messageStruct);
+            }
+            fields.push_back(*field);
+            for(size_t i = 0; i < field->numValues; i++)
+            {
+                columns.push_back(field->numValues > 1 ? retention.fieldNames[f] + "_" + std::to_string(i)
+                                  : retention.fieldNames[f]);
+            }
+        }
+        this->retainedFields.push_back(fields);
+        messageNames.push_back(retention.messageName);
+        messageColumns.push_back(columns);
+    }
+    this->sink.setColumns(messageNames, messageColumns, dispersionColumns);
+}
+
+/*! Builds, disperses and runs one case and adds its retained data to the sink.  The random generator of the case
+ only depends on the seed and the case number, so a case gives the same result on any thread.  A case that fails
+ is recorded in the sink and does not stop the other cases. */
+void MonteCarloRunner::runCase(uint64_t caseNumber)
+{
+    ScenarioRunner runner;
+    std::seed_seq caseSeeds{(uint32_t) (this->seed & 0xFFFFFFFF), (uint32_t) (this->seed >> 32),
+                            (uint32_t) (caseNumber & 0xFFFFFFFF), (uint32_t) (caseNumber >> 32)};
+    std::mt19937_64 caseGenerator(caseSeeds);
+    std::vector<double> dispersedValues;
+    std::vector<RetainedColumns> caseData(this->retentions.size());
+    char valueText[32];
+
+    try
+    {
+        this->buildCase(runner);
+        if(this->disperseSeeds)
+        {
+            std::vector<std::string> moduleNames = runner.getModuleNames();
+            for(size_t i = 0; i < moduleNames.size(); i++)
+            {
+                uint64_t moduleSeed = caseGenerator() & 0xFFFFFFFF;
+                runner.setParameter(moduleNames[i], "RNGSeed", ParameterValues(1, std::to_string(moduleSeed)));
+            }
+        }
+        for(size_t d = 0; d < this->dispersions.size(); d++)
+        {
+            ParameterDispersion &dispersion = this->dispersions[d];
+            ParameterValues values;
+            for(size_t i = 0; i < dispersion.center.size(); i++)
+            {
+                double value;
+                if(dispersion.normal)
+                {
+                    std::normal_distribution<double> distribution(dispersion.center[i], dispersion.spread[i]);
+                    value = distribution(caseGenerator);
+                }
+                else
+                {
+                    std::uniform_real_distribution<double> distribution(dispersion.center[i], dispersion.spread[i]);
+                    value = distribution(caseGenerator);
+                }
+                snprintf(valueText, sizeof(valueText), "%.17g", value);
+                values.push_back(valueText);
+                dispersedValues.push_back(value);
+            }
+            runner.setParameter(dispersion.moduleName, dispersion.parameterName, values);
+        }
+        runner.initializeSimulation();
+        runner.executeSimulation(runner.stopTime);
+
+        std::vector<messageLogContainer> &logData = runner.simulation.messageLogs.logData;
+        for(size_t m = 0; m < this->retentions.size(); m++)
+        {
+            size_t logIndex = 0;
+            while(logData[logIndex].messageName != this->retentions[m].messageName)
+            {
+                logIndex++;
+            }
+            messageLogContainer &log = logData[logIndex];
+            std::vector<MessageField> &fields = this->retainedFields[m];
+            RetainedColumns &data = caseData[m];
+            for(size_t f = 0; f < fields.size(); f++)
+            {
+                data.columns.resize(data.columns.size() + fields[f].numValues);
+            }
+            for(size_t k = 0; k < log.storOff.size(); k++)
+            {
+                uint8_t *record = &(log.messageBuffer.StorageBuffer[log.storOff[k]]);
+                SingleMessageHeader header;
+                memcpy(&header, record, sizeof(header));
+                data.times.push_back(header.WriteClockNanos);
+                size_t column = 0;
+                for(size_t f = 0; f < fields.size(); f++)
+                {
+                    for(size_t i = 0; i < fields[f].numValues; i++)
+                    {
+                        double value;
+                        memcpy(&value, record + sizeof(header) + fields[f].offset + i*sizeof(double),
+                               sizeof(double));
+                        data.columns[column++].push_back(value);
+                    }
+                }
+            }
+        }
+        this->sink.addCase(caseNumber, dispersedValues, caseData);
+    }
+    catch(const std::exception &error)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "Monte Carlo case %llu failed: %s", (unsigned long long) caseNumber,
+                               error.what());
+        this->sink.addFailedCase(caseNumber, error.what());
+    }
+}
+
+/*! Runs the cases 0 to numCases - 1 on a pool of threads.  Each thread has its own messaging system and takes
+ the next case number until all cases are done.  Errors in the scenario are thrown before any case runs, errors
+ of single cases are recorded in the sink.
+ @return void
+ @param numCases number of cases
+ @param numThreads number of worker threads, 0 uses one thread per hardware thread
+ */
+void MonteCarloRunner::executeCases(uint64_t numCases, uint32_t numThreads)
+{
+    std::atomic<uint64_t> nextCase(0);
+    std::vector<std::thread> workers;
+
+    this->prepareCases();
+    if(numThreads == 0)
+    {
+        numThreads = std::thread::hardware_concurrency();
+        numThreads = numThreads == 0 ? 1 : numThreads;
+    }
+    if((uint64_t) numThreads > numCases)
+    {
+        numThreads = (uint32_t) numCases;
+    }
+    for(uint32_t t = 0; t < numThreads; t++)
+    {
+        workers.emplace_back([this, &nextCase, numCases]()
+        {
+            ThreadMessagingScope messagingScope;
+            for(uint64_t caseNumber = nextCase++; caseNumber < numCases; caseNumber = nextCase++)
+            {
+                this->runCase(caseNumber);
+            }
+        });
+    }
+    for(size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _MonteCarloRunner_HH_
+#define _MonteCarloRunner_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "architecture/scenarioRunner/scenarioRunner.h"
+#include "utilities/bskLogging.h"
+
+/*! @brief Dispersion of one module parameter.  Each value of the parameter is drawn independently, uniformly
+ between the lower and upper bounds or normally with the mean and standard deviation. */
+class ParameterDispersion
+{
+public:
+    std::string moduleName;                 //!< -- module of the dispersed parameter
+    std::string parameterName;              //!< -- dispersed parameter
+    bool normal;                            //!< -- true for a normal, false for a uniform distribution
+    std::vector<double> center;             //!< -- lower bounds or means of the values
+    std::vector<double> spread;             //!< -- upper bounds or standard deviations of the values
+};
+
+/*! @brief Fields of one message that are retained from every case */
+class MessageRetention
+{
+public:
+    std::string messageName;                //!< -- retained message
+    uint64_t logPeriod;                     //!< [ns] minimum time between retained messages
+    std::vector<std::string> fieldNames;    //!< -- retained double fields of the message
+};
+
+/*! @brief Retained data of one message in one case, stored column by column */
+class RetainedColumns
+{
+public:
+    std::vector<uint64_t> times;                    //!< [ns] write time of each retained message
+    std::vector<std::vector<double> > columns;      //!< -- one column per retained double value
+};
+
+/*! @brief Thread safe sink of the dispersed values and retained data of all cases.  Cases can be added in any
+ order, they are written out in case order. */
+class MonteCarloSink
+{
+public:
+    void setColumns(const std::vector<std::string> &messageNames,
+                    const std::vector<std::vector<std::string> > &messageColumns,
+                    const std::vector<std::string> &dispersionColumns);
+    void addCase(uint64_t caseNumber, const std::vector<double> &dispersedValues,
+                 std::vector<RetainedColumns> &caseData);
+    void addFailedCase(uint64_t caseNumber, std::string reason);
+    void clear();
+    void writeCsv(std::string directory);
+    std::vector<uint64_t> getCaseNumbers();
+    std::map<uint64_t, std::string> getFailedCases();
+    std::vector<double> getDispersedValues(uint64_t caseNumber);
+    RetainedColumns getCaseData(uint64_t caseNumber, std::string messageName);
+
+private:
+    std::mutex sinkMutex;                                       //!< -- protects all sink data
+    std::vector<std::string> messageNames;                      //!< -- retained messages
+    std::vector<std::vector<std::string> > messageColumns;      //!< -- column names of each retained message
+    std::vector<std::string> dispersionColumns;                 //!< -- column names of the dispersed values
+    std::map<uint64_t, std::vector<double> > dispersedValues;   //!< -- dispersed values by case number
+    std::map<uint64_t, std::vector<RetainedColumns> > cases;    //!< -- retained data by case number
+    std::map<uint64_t, std::string> failedCases;                //!< -- failure reason by case number
+};
+
+/*! @brief Runs the cases of a Monte Carlo analysis concurrently in one process.
+
+ Every worker thread has its own messaging system and builds each case from the scenario lines with a
+ ScenarioRunner, which takes milliseconds.  The parameter dispersions are then applied by name, the case is run and
+ the retained message fields are added to the shared sink.  Case n always draws its dispersions from a random
+ generator seeded with the seed and n, so the results do not depend on the number of threads.
+ */
+class MonteCarloRunner
+{
+public:
+    MonteCarloRunner();
+    ~MonteCarloRunner();
+    void loadScenario(std::string fileName);
+    void parseLine(std::string line);
+    void addDispersion(std::string moduleName, std::string parameterName, std::string distribution,
+                       const std::vector<double> &center, const std::vector<double> &spread);
+    void addRetention(std::string messageName, uint64_t logPeriod, const std::vector<std::string> &fieldNames);
+    void executeCases(uint64_t numCases, uint32_t numThreads = 0);
+
+public:
+    uint64_t seed;                          //!< -- seed of the case random generators
+    bool disperseSeeds;                     //!< -- if true, the RNGSeed of every module is drawn for every case
+    MonteCarloSink sink;                    //!< -- dispersed values and retained data of the cases
+    BSKLogger bskLogger;                    //!< -- BSK Logging
+
+private:
+    void prepareCases();
+    void buildCase(ScenarioRunner &runner);
+    void runCase(uint64_t caseNumber);
+
+    std::string scenarioName;                           //!< -- scenario file, used in error messages
+    std::vector<std::string> scenarioLines;             //!< -- lines that build each case, empty for the MC lines
+    std::vector<ParameterDispersion> dispersions;       //!< -- dispersed parameters
+    std::vector<MessageRetention> retentions;           //!< -- retained message fields
+    std::vector<std::vector<MessageField> > retainedFields;  //!< -- resolved fields of each retention
+};
+
+#endif /* _MonteCarloRunner_HH_ */
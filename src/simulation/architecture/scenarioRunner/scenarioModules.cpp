@@ -0,0 +1,193 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Module types available to native scenarios.  To make another module available, add its sources to the
+ * scenario runner CMakeLists.txt and register it below with the parameters and links that scenarios need, and
+ * register the double fields of its output messages that Monte Carlo runs may retain.
+ */
+
+#include "architecture/scenarioRunner/moduleRegistry.h"
+#include <stdexcept>
+#include "dynamics/SpacecraftDynamics/spacecraftPlus.h"
+#include "dynamics/extForceTorque/extForceTorque.h"
+#include "navigation/simple_nav/simple_nav.h"
+#include "attGuidance/inertial3D/inertial3D.h"
+#include "attGuidance/attTrackingError/attTrackingError.h"
+#include "attControl/MRP_Feedback/MRP_Feedback.h"
+#include "vehicleConfigData/vehicleConfigData.h"
+#include "simMessages/scPlusStatesSimMsg.h"
+#include "simFswInterfaceMessages/navAttIntMsg.h"
+#include "simFswInterfaceMessages/navTransIntMsg.h"
+#include "simFswInterfaceMessages/cmdTorqueBodyIntMsg.h"
+#include "fswMessages/attRefFswMsg.h"
+#include "fswMessages/attGuidFswMsg.h"
+#include "fswMessages/vehicleConfigFswMsg.h"
+
+/*! Adds a gravity body to a spacecraft from the values <name> <mu> <radEquator> <isCentralBody>.  The message
+ names follow simIncludeGravBody.gravBodyFactory, so a body named earth reads earth_planet_data. */
+static void addGravBody(ModuleInstance &instance, const ParameterValues &values)
+{
+    SpacecraftPlus *scObject = instance.getData<SpacecraftPlus>();
+    if(values.size() != 4)
+    {
+        throw std::runtime_error("expected <name> <mu> <radEquator> <isCentralBody>");
+    }
+    std::shared_ptr<GravBodyData> body = std::make_shared<GravBodyData>();
+    body->bodyInMsgName = values[0] + "_planet_data";
+    body->outputMsgName = values[0] + "_display_frame_data";
+    assignParameter(body->mu, ParameterValues(1, values[1]));
+    assignParameter(body->radEquator, ParameterValues(1, values[2]));
+    assignParameter(body->isCentralBody, ParameterValues(1, values[3]));
+    body->useSphericalHarmParams = false;
+    instance.storage.push_back(body);
+    scObject->gravField.gravBodies.push_back(body.get());
+}
+
+/*! Attaches a dynamic effector module to a spacecraft */
+static void addDynamicEffector(ModuleInstance &instance, ModuleInstance &other)
+{
+    DynamicEffector *effector = dynamic_cast<DynamicEffector*>(other.model);
+    if(effector == NULL)
+    {
+        throw std::runtime_error(other.typeName + " is not a dynamic effector");
+    }
+    instance.getData<SpacecraftPlus>()->addDynamicEffector(effector);
+}
+
+/*! Attaches a state effector module to a spacecraft */
+static void addStateEffector(ModuleInstance &instance, ModuleInstance &other)
+{
+    StateEffector *effector = dynamic_cast<StateEffector*>(other.model);
+    if(effector == NULL)
+    {
+        throw std::runtime_error(other.typeName + " is not a state effector");
+    }
+    instance.getData<SpacecraftPlus>()->addStateEffector(effector);
+}
+
+/*! Registers the module types of the native scenario runner.  Calling it again has no effect.
+ @return void
+ */
+void registerScenarioModules()
+{
+    static bool registered = false;
+    if(registered)
+    {
+        return;
+    }
+    registered = true;
+
+    registerModel<SpacecraftPlus>("spacecraftPlus")
+        .parameter("hub.mHub", BSK_PARAMETER(SpacecraftPlus, hub.mHub))
+        .parameter("hub.r_BcB_B", BSK_PARAMETER(SpacecraftPlus, hub.r_BcB_B))
+        .parameter("hub.IHubPntBc_B", BSK_PARAMETER(SpacecraftPlus, hub.IHubPntBc_B))
+        .parameter("hub.r_CN_NInit", BSK_PARAMETER(SpacecraftPlus, hub.r_CN_NInit))
+        .parameter("hub.v_CN_NInit", BSK_PARAMETER(SpacecraftPlus, hub.v_CN_NInit))
+        .parameter("hub.sigma_BNInit", BSK_PARAMETER(SpacecraftPlus, hub.sigma_BNInit))
+        .parameter("hub.omega_BN_BInit", BSK_PARAMETER(SpacecraftPlus, hub.omega_BN_BInit))
+        .parameter("scStateOutMsgName", BSK_PARAMETER(SpacecraftPlus, scStateOutMsgName))
+        .parameter("scMassStateOutMsgName", BSK_PARAMETER(SpacecraftPlus, scMassStateOutMsgName))
+        .parameter("attRefInMsgName", BSK_PARAMETER(SpacecraftPlus, attRefInMsgName))
+        .parameter("numOutMsgBuffers", BSK_PARAMETER(SpacecraftPlus, numOutMsgBuffers))
+        .parameter("gravBody", addGravBody)
+        .link("addDynamicEffector", addDynamicEffector)
+        .link("addStateEffector", addStateEffector);
+
+    registerModel<ExtForceTorque>("extForceTorque")
+        .parameter("extForce_N", BSK_PARAMETER(ExtForceTorque, extForce_N))
+        .parameter("extForce_B", BSK_PARAMETER(ExtForceTorque, extForce_B))
+        .parameter("extTorquePntB_B", BSK_PARAMETER(ExtForceTorque, extTorquePntB_B))
+        .parameter("cmdTorqueInMsgName", BSK_PARAMETER(ExtForceTorque, cmdTorqueInMsgName))
+        .parameter("cmdForceInertialInMsgName", BSK_PARAMETER(ExtForceTorque, cmdForceInertialInMsgName))
+        .parameter("cmdForceBodyInMsgName", BSK_PARAMETER(ExtForceTorque, cmdForceBodyInMsgName));
+
+    registerModel<SimpleNav>("simpleNav")
+        .parameter("inputStateName", BSK_PARAMETER(SimpleNav, inputStateName))
+        .parameter("outputAttName", BSK_PARAMETER(SimpleNav, outputAttName))
+        .parameter("outputTransName", BSK_PARAMETER(SimpleNav, outputTransName))
+        .parameter("inputSunName", BSK_PARAMETER(SimpleNav, inputSunName))
+        .parameter("PMatrix", BSK_PARAMETER(SimpleNav, PMatrix))
+        .parameter("walkBounds", BSK_PARAMETER(SimpleNav, walkBounds))
+        .parameter("crossTrans", BSK_PARAMETER(SimpleNav, crossTrans))
+        .parameter("crossAtt", BSK_PARAMETER(SimpleNav, crossAtt));
+
+    registerAlgorithm<inertial3DConfig>("inertial3D", Update_inertial3D, SelfInit_inertial3D,
+                                        CrossInit_inertial3D, Reset_inertial3D)
+        .parameter("sigma_R0N", BSK_PARAMETER(inertial3DConfig, sigma_R0N))
+        .parameter("outputDataName", BSK_PARAMETER(inertial3DConfig, outputDataName));
+
+    registerAlgorithm<attTrackingErrorConfig>("attTrackingError", Update_attTrackingError,
+                                              SelfInit_attTrackingError, CrossInit_attTrackingError,
+                                              Reset_attTrackingError)
+        .parameter("sigma_R0R", BSK_PARAMETER(attTrackingErrorConfig, sigma_R0R))
+        .parameter("outputDataName", BSK_PARAMETER(attTrackingErrorConfig, outputDataName))
+        .parameter("inputRefName", BSK_PARAMETER(attTrackingErrorConfig, inputRefName))
+        .parameter("inputNavName", BSK_PARAMETER(attTrackingErrorConfig, inputNavName));
+
+    registerAlgorithm<MRP_FeedbackConfig>("MRP_Feedback", Update_MRP_Feedback, SelfInit_MRP_Feedback,
+                                          CrossInit_MRP_Feedback, Reset_MRP_Feedback)
+        .parameter("K", BSK_PARAMETER(MRP_FeedbackConfig, K))
+        .parameter("P", BSK_PARAMETER(MRP_FeedbackConfig, P))
+        .parameter("Ki", BSK_PARAMETER(MRP_FeedbackConfig, Ki))
+        .parameter("integralLimit", BSK_PARAMETER(MRP_FeedbackConfig, integralLimit))
+        .parameter("knownTorquePntB_B", BSK_PARAMETER(MRP_FeedbackConfig, knownTorquePntB_B))
+        .parameter("rwParamsInMsgName", BSK_PARAMETER(MRP_FeedbackConfig, rwParamsInMsgName))
+        .parameter("vehConfigInMsgName", BSK_PARAMETER(MRP_FeedbackConfig, vehConfigInMsgName))
+        .parameter("rwAvailInMsgName", BSK_PARAMETER(MRP_FeedbackConfig, rwAvailInMsgName))
+        .parameter("inputRWSpeedsName", BSK_PARAMETER(MRP_FeedbackConfig, inputRWSpeedsName))
+        .parameter("inputGuidName", BSK_PARAMETER(MRP_FeedbackConfig, inputGuidName))
+        .parameter("outputDataName", BSK_PARAMETER(MRP_FeedbackConfig, outputDataName));
+
+    registerAlgorithm<VehConfigInputData>("vehicleConfigData", Update_vehicleConfigData,
+                                          SelfInit_vehicleConfigData, CrossInit_vehicleConfigData,
+                                          Reset_vehicleConfigData)
+        .parameter("ISCPntB_B", BSK_PARAMETER(VehConfigInputData, ISCPntB_B))
+        .parameter("CoM_B", BSK_PARAMETER(VehConfigInputData, CoM_B))
+        .parameter("outputPropsName", BSK_PARAMETER(VehConfigInputData, outputPropsName));
+
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, r_BN_N);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, v_BN_N);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, r_CN_N);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, v_CN_N);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, sigma_BN);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, omega_BN_B);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, omegaDot_BN_B);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, TotalAccumDVBdy);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, TotalAccumDV_BN_B);
+    BSK_MESSAGE_FIELD(SCPlusStatesSimMsg, nonConservativeAccelpntB_B);
+    BSK_MESSAGE_FIELD(NavAttIntMsg, timeTag);
+    BSK_MESSAGE_FIELD(NavAttIntMsg, sigma_BN);
+    BSK_MESSAGE_FIELD(NavAttIntMsg, omega_BN_B);
+    BSK_MESSAGE_FIELD(NavAttIntMsg, vehSunPntBdy);
+    BSK_MESSAGE_FIELD(NavTransIntMsg, timeTag);
+    BSK_MESSAGE_FIELD(NavTransIntMsg, r_BN_N);
+    BSK_MESSAGE_FIELD(NavTransIntMsg, v_BN_N);
+    BSK_MESSAGE_FIELD(NavTransIntMsg, vehAccumDV);
+    BSK_MESSAGE_FIELD(CmdTorqueBodyIntMsg, torqueRequestBody);
+    BSK_MESSAGE_FIELD(AttRefFswMsg, sigma_RN);
+    BSK_MESSAGE_FIELD(AttRefFswMsg, omega_RN_N);
+    BSK_MESSAGE_FIELD(AttRefFswMsg, domega_RN_N);
+    BSK_MESSAGE_FIELD(AttGuidFswMsg, sigma_BR);
+    BSK_MESSAGE_FIELD(AttGuidFswMsg, omega_BR_B);
+    BSK_MESSAGE_FIELD(AttGuidFswMsg, omega_RN_B);
+    BSK_MESSAGE_FIELD(AttGuidFswMsg, domega_RN_B);
+    BSK_MESSAGE_FIELD(VehicleConfigFswMsg, ISCPntB_B);
+    BSK_MESSAGE_FIELD(VehicleConfigFswMsg, CoM_B);
+}
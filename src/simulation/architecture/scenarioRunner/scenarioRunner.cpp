@@ -0,0 +1,389 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "architecture/scenarioRunner/scenarioRunner.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+/*! The constructor clears the messaging system, as the python SimBaseClass does, so that a scenario always
+ starts from an empty set of messages. */
+ScenarioRunner::ScenarioRunner()
+{
+    this->simulation.terminateSimulation();
+    this->stopTime = 0;
+    this->lineNumber = 0;
+}
+
+/*! Nothing to destroy, the processes, tasks and modules are owned by the runner */
+ScenarioRunner::~ScenarioRunner()
+{
+}
+
+/*! Converts a scenario file value to an unsigned integer */
+static uint64_t parseUnsigned(const std::string &text)
+{
+    ParameterValues values(1, text);
+    uint64_t value;
+    assignParameter(value, values);
+    return(value);
+}
+
+/*! Converts a scenario file value to a signed integer */
+static int64_t parseSigned(const std::string &text)
+{
+    ParameterValues values(1, text);
+    int64_t value;
+    assignParameter(value, values);
+    return(value);
+}
+
+/*! Reads a scenario file and executes every line of it in order.  Errors are reported with the file name and
+ line number.
+ @return void
+ @param fileName path of the scenario file
+ */
+void ScenarioRunner::loadScenario(std::string fileName)
+{
+    std::ifstream scenarioFile(fileName);
+    std::string line;
+    if(!scenarioFile.is_open())
+    {
+        throw std::runtime_error("could not open scenario file " + fileName);
+    }
+    this->lineNumber = 0;
+    while(std::getline(scenarioFile, line))
+    {
+        this->lineNumber++;
+        try
+        {
+            this->parseLine(line);
+        }
+        catch(const std::exception &error)
+        {
+            throw std::runtime_error(fileName + ":" + std::to_string(this->lineNumber) + ": " + error.what());
+        }
+    }
+}
+
+/*! Executes one scenario line.  Everything after a '#' is a comment, and the words of the line are
+ separated by white space.  The commands are
+
+     process <name> [priority]
+     task <name> <process> <period ns> [taskPriority] [delay ns] [firstStart ns]
+     module <type> <name> <task> [priority]
+     set <module> <parameter> <values...>
+     link <module> <link> <otherModule>
+     log <message> [period ns]
+     stop <time ns>
+     archive <file>
+
+ @return void
+ @param line the scenario line
+ */
+void ScenarioRunner::parseLine(std::string line)
+{
+    std::vector<std::string> words;
+    std::string word;
+    size_t commentStart = line.find('#');
+    if(commentStart != std::string::npos)
+    {
+        line.erase(commentStart);
+    }
+    std::istringstream lineStream(line);
+    while(lineStream >> word)
+    {
+        words.push_back(word);
+    }
+    if(words.empty())
+    {
+        return;
+    }
+
+    const std::string &command = words[0];
+    size_t numArgs = words.size() - 1;
+    if(command == "process" && numArgs >= 1 && numArgs <= 2)
+    {
+        this->createProcess(words[1], numArgs > 1 ? parseSigned(words[2]) : -1);
+    }
+    else if(command == "task" && numArgs >= 3 && numArgs <= 6)
+    {
+        this->createTask(words[1], words[2], parseUnsigned(words[3]),
+                         numArgs > 3 ? (int32_t) parseSigned(words[4]) : -1,
+                         numArgs > 4 ? parseUnsigned(words[5]) : 0,
+                         numArgs > 5 ? parseUnsigned(words[6]) : 0);
+    }
+    else if(command == "module" && numArgs >= 3 && numArgs <= 4)
+    {
+        this->createModule(words[1], words[2], words[3], numArgs > 3 ? (int32_t) parseSigned(words[4]) : -1);
+    }
+    else if(command == "set" && numArgs >= 3)
+    {
+        this->setParameter(words[1], words[2], ParameterValues(words.begin() + 3, words.end()));
+    }
+    else if(command == "link" && numArgs == 3)
+    {
+        this->linkModules(words[1], words[2], words[3]);
+    }
+    else if(command == "log" && numArgs >= 1 && numArgs <= 2)
+    {
+        this->logMessage(words[1], numArgs > 1 ? parseUnsigned(words[2]) : 0);
+    }
+    else if(command == "stop" && numArgs == 1)
+    {
+        this->stopTime = parseUnsigned(words[1]);
+    }
+    else if(command == "archive" && numArgs == 1)
+    {
+        this->archiveFileName = words[1];
+    }
+    else
+    {
+        throw std::runtime_error("unknown command or wrong number of arguments: " + line);
+    }
+}
+
+/*! Creates a process and adds it to the simulation, as SimBaseClass.CreateNewProcess()
+ @return void
+ @param processName name of the process
+ @param priority priority of the process, higher goes first
+ */
+void ScenarioRunner::createProcess(std::string processName, int64_t priority)
+{
+    if(this->findProcess(processName) != NULL)
+    {
+        throw std::runtime_error("process " + processName + " already exists");
+    }
+    this->processes.emplace_back(new SysProcess(processName));
+    this->processes.back()->processPriority = priority;
+    this->simulation.addNewProcess(this->processes.back().get());
+}
+
+/*! Creates a task and adds it to a process, as SimBaseClass.CreateNewTask() followed by addTask()
+ @return void
+ @param taskName name of the task
+ @param processName name of the process the task runs in
+ @param taskPeriod [ns] update period of the task
+ @param taskPriority priority of the task in the process, higher goes first
+ @param inputDelay [ns] delay of the task
+ @param firstStart [ns] first time the task is run
+ */
+void ScenarioRunner::createTask(std::string taskName, std::string processName, uint64_t taskPeriod,
+                                int32_t taskPriority, uint64_t inputDelay, uint64_t firstStart)
+{
+    SysProcess *process = this->findProcess(processName);
+    if(process == NULL)
+    {
+        throw std::runtime_error("unknown process " + processName);
+    }
+    if(this->findTask(taskName) != NULL)
+    {
+        throw std::runtime_error("task " + taskName + " already exists");
+    }
+    this->tasks.emplace_back(new SysModelTask(taskPeriod, inputDelay, firstStart));
+    this->tasks.back()->TaskName = taskName;
+    process->addNewTask(this->tasks.back().get(), taskPriority);
+}
+
+/*! Creates a module of a registered type and adds it to a task, as SimBaseClass.AddModelToTask().  The
+ ModelTag defaults to the module name.
+ @return ModuleInstance& the new module
+ @param typeName registered type of the module
+ @param moduleName unique name of the module in the scenario
+ @param taskName name of the task the module runs in
+ @param modelPriority priority of the module in the task, higher goes first
+ */
+ModuleInstance &ScenarioRunner::createModule(std::string typeName, std::string moduleName, std::string taskName,
+                                             int32_t modelPriority)
+{
+    ModuleType *moduleType = ModuleRegistry::GetInstance()->findType(typeName);
+    SysModelTask *task = this->findTask(taskName);
+    if(moduleType == NULL)
+    {
+        throw std::runtime_error("unknown module type " + typeName);
+    }
+    if(task == NULL)
+    {
+        throw std::runtime_error("unknown task " + taskName);
+    }
+    if(this->findModule(moduleName) != NULL)
+    {
+        throw std::runtime_error("module " + moduleName + " already exists");
+    }
+    ModuleInstance &instance = this->modules[moduleName];
+    instance.typeName = typeName;
+    moduleType->create(instance, &this->bskLogger);
+    instance.model->ModelTag = moduleName;
+    task->AddNewObject(instance.model, modelPriority);
+    return(instance);
+}
+
+/*! Sets a module parameter.  The ModelTag and RNGSeed can be set on every module, the other parameters are
+ the ones registered for the module type.
+ @return void
+ @param moduleName name of the module
+ @param parameterName name of the parameter
+ @param values values of the parameter
+ */
+void ScenarioRunner::setParameter(std::string moduleName, std::string parameterName,
+                                  const ParameterValues &values)
+{
+    ModuleInstance *instance = this->findModule(moduleName);
+    if(instance == NULL)
+    {
+        throw std::runtime_error("unknown module " + moduleName);
+    }
+    try
+    {
+        if(parameterName == "ModelTag")
+        {
+            assignParameter(instance->model->ModelTag, values);
+            return;
+        }
+        if(parameterName == "RNGSeed")
+        {
+            assignParameter(instance->model->RNGSeed, values);
+            return;
+        }
+        ModuleType *moduleType = ModuleRegistry::GetInstance()->findType(instance->typeName);
+        std::map<std::string, ParameterSetter>::iterator it = moduleType->parameters.find(parameterName);
+        if(it == moduleType->parameters.end())
+        {
+            throw std::runtime_error("unknown parameter of " + instance->typeName);
+        }
+        it->second(*instance, values);
+    }
+    catch(const std::exception &error)
+    {
+        throw std::runtime_error(moduleName + "." + parameterName + ": " + error.what());
+    }
+}
+
+/*! Connects another module to a module, such as a dynamic effector to a spacecraft
+ @return void
+ @param moduleName name of the module the link belongs to
+ @param linkName name of the link
+ @param otherName name of the module that is connected
+ */
+void ScenarioRunner::linkModules(std::string moduleName, std::string linkName, std::string otherName)
+{
+    ModuleInstance *instance = this->findModule(moduleName);
+    ModuleInstance *other = this->findModule(otherName);
+    if(instance == NULL || other == NULL)
+    {
+        throw std::runtime_error("unknown module " + (instance == NULL ? moduleName : otherName));
+    }
+    ModuleType *moduleType = ModuleRegistry::GetInstance()->findType(instance->typeName);
+    std::map<std::string, ModuleLinker>::iterator it = moduleType->links.find(linkName);
+    if(it == moduleType->links.end())
+    {
+        throw std::runtime_error("unknown link " + linkName + " of " + instance->typeName);
+    }
+    it->second(*instance, *other);
+}
+
+/*! Logs a message, as TotalSim.logThisMessage()
+ @return void
+ @param messageName name of the message
+ @param logPeriod [ns] minimum time between logged messages
+ */
+void ScenarioRunner::logMessage(std::string messageName, uint64_t logPeriod)
+{
+    this->simulation.logThisMessage(messageName, logPeriod);
+}
+
+/*! Initializes the simulation in the same order as SimBaseClass.InitializeSimulation()
+ @return void
+ */
+void ScenarioRunner::initializeSimulation()
+{
+    this->simulation.ResetSimulation();
+    this->simulation.selfInitSimulation();
+    this->simulation.crossInitSimulation();
+    this->simulation.resetInitSimulation();
+}
+
+/*! Runs the simulation until the stop time.  Without events, python processes or logged variables the loop of
+ SimBaseClass.ExecuteSimulation() reduces to stepping until the stop time.
+ @return void
+ @param stopTime [ns] time at which the simulation stops
+ */
+void ScenarioRunner::executeSimulation(uint64_t stopTime)
+{
+    this->simulation.StepUntilStop(stopTime, -1);
+}
+
+/*! Writes the message logs to disk, to be read back with messageLogs.loadArchiveFromDisk()
+ @return void
+ @param fileName path of the archive
+ */
+void ScenarioRunner::archiveLogs(std::string fileName)
+{
+    this->simulation.messageLogs.archiveLogsToDisk(fileName);
+}
+
+/*! Looks up a module by name
+ @return ModuleInstance* the module, NULL if there is none
+ @param moduleName name of the module
+ */
+ModuleInstance *ScenarioRunner::findModule(std::string moduleName)
+{
+    std::map<std::string, ModuleInstance>::iterator it = this->modules.find(moduleName);
+    return(it == this->modules.end() ? NULL : &(it->second));
+}
+
+/*! Lists the modules of the scenario
+ @return std::vector<std::string> the module names in alphabetical order
+ */
+std::vector<std::string> ScenarioRunner::getModuleNames()
+{
+    std::vector<std::string> names;
+    std::map<std::string, ModuleInstance>::iterator it;
+    for(it = this->modules.begin(); it != this->modules.end(); it++)
+    {
+        names.push_back(it->first);
+    }
+    return(names);
+}
+
+/*! Looks up a process by name */
+SysProcess *ScenarioRunner::findProcess(std::string processName)
+{
+    for(size_t i = 0; i < this->processes.size(); i++)
+    {
+        if(this->processes[i]->processName == processName)
+        {
+            return(this->processes[i].get());
+        }
+    }
+    return(NULL);
+}
+
+/*! Looks up a task by name */
+SysModelTask *ScenarioRunner::findTask(std::string taskName)
+{
+    for(size_t i = 0; i < this->tasks.size(); i++)
+    {
+        if(this->tasks[i]->TaskName == taskName)
+        {
+            return(this->tasks[i].get());
+        }
+    }
+    return(NULL);
+}
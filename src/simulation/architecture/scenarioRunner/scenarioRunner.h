@@ -0,0 +1,77 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _ScenarioRunner_HH_
+#define _ScenarioRunner_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include "architecture/system_model/sim_model.h"
+#include "architecture/system_model/sys_process.h"
+#include "architecture/system_model/sys_model_task.h"
+#include "architecture/scenarioRunner/moduleRegistry.h"
+#include "utilities/bskLogging.h"
+
+/*! @brief Builds and runs a simulation without the python layer.
+
+ The runner mirrors the SimulationBaseClass calls: processes, tasks and modules are created and configured either
+ through the methods below or from a scenario file, the simulation is initialized and then stepped until the stop
+ time.  Modules are created by type name from the ModuleRegistry.  Errors are reported with std::runtime_error.
+ */
+class ScenarioRunner
+{
+public:
+    ScenarioRunner();
+    ~ScenarioRunner();
+    void loadScenario(std::string fileName);
+    void parseLine(std::string line);
+    void createProcess(std::string processName, int64_t priority = -1);
+    void createTask(std::string taskName, std::string processName, uint64_t taskPeriod,
+                    int32_t taskPriority = -1, uint64_t inputDelay = 0, uint64_t firstStart = 0);
+    ModuleInstance &createModule(std::string typeName, std::string moduleName, std::string taskName,
+                                 int32_t modelPriority = -1);
+    void setParameter(std::string moduleName, std::string parameterName, const ParameterValues &values);
+    void linkModules(std::string moduleName, std::string linkName, std::string otherName);
+    void logMessage(std::string messageName, uint64_t logPeriod = 0);
+    void initializeSimulation();
+    void executeSimulation(uint64_t stopTime);
+    void archiveLogs(std::string fileName);
+    ModuleInstance *findModule(std::string moduleName);
+    std::vector<std::string> getModuleNames();
+
+public:
+    SimModel simulation;                    //!< -- the simulation that is built and run
+    uint64_t stopTime;                      //!< [ns] stop time given by the scenario file
+    std::string archiveFileName;            //!< -- log archive given by the scenario file, empty for none
+    BSKLogger bskLogger;                    //!< -- BSK Logging, also handed to the C modules
+
+private:
+    SysProcess *findProcess(std::string processName);
+    SysModelTask *findTask(std::string taskName);
+
+    std::vector<std::unique_ptr<SysProcess> > processes;    //!< -- processes created by the scenario
+    std::vector<std::unique_ptr<SysModelTask> > tasks;      //!< -- tasks created by the scenario
+    std::map<std::string, ModuleInstance> modules;          //!< -- modules created by the scenario by name
+    uint64_t lineNumber;                                    //!< -- line of the scenario file being parsed
+};
+
+#endif /* _ScenarioRunner_HH_ */
@@ -143,9 +143,9 @@ void HingedRigidBodyStateEffector::linkInStates(DynParamManager& statesIn)
     // - Get access to the hubs sigma, omegaBN_B and velocity needed for dynamic coupling and gravity
     std::string tmpMsgName;
     tmpMsgName = this->nameOfSpacecraftAttachedTo + "centerOfMassSC";
-    this->c_B = statesIn.getPropertyReference(tmpMsgName);
+    this->c_B = statesIn.getTypedPropertyReference<Eigen::Vector3d>(tmpMsgName);
     tmpMsgName = this->nameOfSpacecraftAttachedTo + "centerOfMassPrimeSC";
-    this->cPrime_B = statesIn.getPropertyReference(tmpMsgName);
+    this->cPrime_B = statesIn.getTypedPropertyReference<Eigen::Vector3d>(tmpMsgName);
 
     this->sigma_BN = statesIn.getStateObject(this->nameOfSpacecraftAttachedTo + "hubSigma");
     this->omega_BN_B = statesIn.getStateObject(this->nameOfSpacecraftAttachedTo + "hubOmega");
@@ -39,8 +39,8 @@ public:
     double thetaDotInit;             //!< [rad/s] Initial hinged rigid body angle rate
     std::string nameOfThetaState;    //!< -- Identifier for the theta state data container
     std::string nameOfThetaDotState; //!< -- Identifier for the thetaDot state data container
-    Eigen::MatrixXd *c_B;            //!< [m] Vector from point B to CoM of s/c in B frame components
-    Eigen::MatrixXd *cPrime_B;       //!< [m/s] Body time derivative of vector c_B in B frame components
+    DynPropertyRef<Eigen::Vector3d> c_B;        //!< [m] Vector from point B to CoM of s/c in B frame components
+    DynPropertyRef<Eigen::Vector3d> cPrime_B;   //!< [m/s] Body time derivative of vector c_B in B frame components
     Eigen::Matrix3d IPntS_S;         //!< [kg-m^2] Inertia of hinged rigid body about point S in S frame components
     Eigen::Vector3d r_HB_B;          //!< [m] vector pointing from body frame origin to Hinge location
     Eigen::Matrix3d dcm_HB;          //!< -- DCM from body frame to hinge frame
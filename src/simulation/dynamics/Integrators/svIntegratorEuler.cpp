@@ -24,6 +24,8 @@
 
 svIntegratorEuler::svIntegratorEuler(DynamicObject* dyn) : StateVecIntegrator(dyn)
 {
+    this->stageTimes = {0.0};
+    this->stageWeights = {1.0};
     
     return;
 }
@@ -24,6 +24,8 @@
 
 svIntegratorRK2::svIntegratorRK2(DynamicObject* dyn) : StateVecIntegrator(dyn)
 {
+    this->stageTimes = {0.0, 1.0};
+    this->stageWeights = {0.5, 0.5};
     
     return;
 }
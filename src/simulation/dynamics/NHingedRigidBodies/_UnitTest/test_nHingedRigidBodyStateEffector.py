@@ -39,6 +39,7 @@ from Basilisk.utilities import macros
     ('NoGravity'),
     ('Gravity')
 ])
+@pytest.mark.parametrize("useDenseSolve", [False, True])
 
 # uncomment this line is this test is to be skipped in the global unit test run, adjust message as needed
 # @pytest.mark.skipif(conditionstring)
@@ -46,7 +47,7 @@ from Basilisk.utilities import macros
 # @pytest.mark.xfail() # need to update how the RW states are defined
 # provide a unique test method name, starting with test_
 
-def test_nHingedRigidBodyAllTest(show_plots, testCase):
+def test_nHingedRigidBodyAllTest(show_plots, testCase, useDenseSolve):
     """
 In this integrated test there are two hinged rigid bodies connected to the spacecraft hub, one with 4 \
 interconnected panels and one with 3 interconnected panels.  Depending on the scenario, there are different \
@@ -58,6 +59,8 @@ energy, the conservation of rotational angular momentum and the conservation of
 
 - testCase: [string]
     defines whether or not the gravity is included in this test.
+- useDenseSolve: [bool]
+    solves the panel equations with the dense reference instead of the recursive solve.
 
 **Description of Variables Being Tested**
 
@@ -79,10 +82,10 @@ desired result. In the python test these values are automatically checked theref
 values have all been confirmed to be conserved.
 
     """
-    [testResults, testMessage] = nHingedRigidBody(show_plots, testCase)
+    [testResults, testMessage] = nHingedRigidBody(show_plots, testCase, useDenseSolve)
     assert testResults < 1, testMessage
 
-def nHingedRigidBody(show_plots, testCase):
+def nHingedRigidBody(show_plots, testCase, useDenseSolve=False):
     # The __tracebackhide__ setting influences pytest showing of tracebacks:
     # the mrp_steering_tracking() function will not be shown unless the
     # --fulltrace command line option is specified.
@@ -119,6 +122,8 @@ def nHingedRigidBody(show_plots, testCase):
     unitTestSim.effector2.dcm_HB = [[1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]]
     unitTestSim.effector2.nameOfThetaState = "nHingedRigidBody2Theta"
     unitTestSim.effector2.nameOfThetaDotState = "nHingedRigidBody2ThetaDot"
+    unitTestSim.effector1.useDenseSolve = useDenseSolve
+    unitTestSim.effector2.useDenseSolve = useDenseSolve
 
     # Define Variable for a panel
     unitTestSim.panel.mass = 50.0
@@ -35,6 +35,7 @@ NHingedRigidBodyStateEffector::NHingedRigidBodyStateEffector()
     this->dcm_HB.Identity();
     this->nameOfThetaState ="nHingedRigidBodyTheta";
     this->nameOfThetaDotState = "nHingedRigidBodyThetaDot";
+    this->useDenseSolve = false;
 
     return;
 }
@@ -242,7 +243,25 @@ void NHingedRigidBodyStateEffector::updateContributions(double integTime, BackSu
     // - Define omegaTildeLoc_BN_B
     this->omegaTildeLoc_BN_B = eigenTilde(this->omegaLoc_BN_B);
 
+    if (this->useDenseSolve) {
+        this->denseContributions(backSubContr, g_B);
+    } else {
+        this->recursiveContributions(backSubContr, g_B);
+    }
+
+    return;
+}
+
+/*! This method assembles the panel equations densely and inverts the A matrix, the cost grows with the cube of the
+ number of panels.  It is kept as the reference for the recursive solve.
+ @return void
+ @param backSubContr back-substitution contributions of the effector
+ @param g_B gravitational acceleration in B frame components
+ */
+void NHingedRigidBodyStateEffector::denseContributions(BackSubMatrices & backSubContr, const Eigen::Vector3d & g_B)
+{
     // - Define A matrix for the panel equations
+    std::vector<HingedPanel>::iterator PanelIt;
     std::vector<HingedPanel>::iterator PanelIt2;
     this->matrixADHRB.resize((int) this->PanelVec.size(), (int) this->PanelVec.size());
     this->matrixADHRB.setZero();
@@ -450,7 +469,146 @@ void NHingedRigidBodyStateEffector::updateContributions(double integTime, BackSu
         j += 1;
     }
 
-    
+    // - Keep the panel solution for the derivatives
+    this->matrixXDHRB.resize((int) this->PanelVec.size(), 7);
+    this->matrixXDHRB << this->matrixEDHRB*this->matrixFDHRB, this->matrixEDHRB*this->matrixGDHRB,
+        this->matrixEDHRB*this->vectorVDHRB;
+
+    return;
+}
+
+/*! This method solves the panel equations recursively, in a time that grows linearly with the number of panels.
+ Written in the absolute panel accelerations, the sums of thetaDDot from the first panel up to each panel, the
+ panel equations are a diagonal plus nested outer products of the sHat3 vectors.  Like an articulated body they are
+ eliminated from the last panel inwards, after which the absolute accelerations follow from the first panel outwards.
+ The F, G and v terms and the coupling vectors of the back-substitution contributions are accumulated from the last
+ panel inwards as well.  The result equals the dense solve up to round-off.
+ @return void
+ @param backSubContr back-substitution contributions of the effector
+ @param g_B gravitational acceleration in B frame components
+ */
+void NHingedRigidBodyStateEffector::recursiveContributions(BackSubMatrices & backSubContr, const Eigen::Vector3d & g_B)
+{
+    int numPanels = (int) this->PanelVec.size();
+    this->matrixXDHRB.resize(numPanels, 7);
+    this->matrixNumDHRB.resize(numPanels, 7);
+    this->matrixPsiDHRB.resize(3, numPanels);
+    this->vectorDenDHRB.resize(numPanels);
+    this->matrixTransDHRB.resize(3, numPanels);
+    this->matrixRotDHRB.resize(3, numPanels);
+    this->vectorSumThetaDotDHRB.resize(numPanels);
+    this->matrixSumCentDHRB.resize(3, numPanels);
+
+    // - Sum the panel rates and the centripetal terms from the first panel outwards
+    double sumThetaDot = 0;
+    Eigen::Vector3d sumCent;
+    sumCent.setZero();
+    for(int j = 0; j < numPanels; j++){
+        HingedPanel &panel = this->PanelVec[j];
+        sumThetaDot += panel.thetaDot;
+        sumCent += pow(sumThetaDot,2)*panel.d*panel.sHat1_B;
+        this->vectorSumThetaDotDHRB(j) = sumThetaDot;
+        this->matrixSumCentDHRB.col(j) = sumCent;
+    }
+
+    // - Build the F, G and v rows from the last panel inwards and eliminate each panel as it is reached
+    backSubContr.matrixA.setZero();
+    backSubContr.matrixB.setZero();
+    backSubContr.vecTrans.setZero();
+    backSubContr.matrixC.setZero();
+    backSubContr.matrixD.setZero();
+    backSubContr.vecRot.setZero();
+    Eigen::Matrix3d sumRTildeOut;       // sum of rTilde_SB_B of the outboard panels
+    sumRTildeOut.setZero();
+    Eigen::Vector3d sumVelOut;          // sum of the velocity terms of the outboard panels
+    sumVelOut.setZero();
+    Eigen::Vector3d sumCentOut;         // centripetal terms weighted by the number of panels outboard of them
+    sumCentOut.setZero();
+    Eigen::Vector3d transTerm;
+    transTerm.setZero();
+    Eigen::Vector3d rotTerm;
+    rotTerm.setZero();
+    double massOut = 0;
+    Eigen::Matrix3d articulatedStiffness;
+    articulatedStiffness.setZero();
+    Eigen::Matrix<double, 3, 7> articulatedRhs;
+    articulatedRhs.setZero();
+    Eigen::Matrix<double, 1, 7> rhsRow;
+    for(int j = numPanels - 1; j >= 0; j--){
+        HingedPanel &panel = this->PanelVec[j];
+        int numOut = numPanels - 1 - j;
+        double omegaAbs = this->vectorSumThetaDotDHRB(j);
+        double md = panel.mass*panel.d;
+        Eigen::Matrix3d rTildeChain = panel.rTilde_SB_B + 2*sumRTildeOut;
+        sumCentOut += (numOut == 0 ? 2.0 : 4.0)*this->matrixSumCentDHRB.col(j);
+
+        // - F, G and v rows of the panel equations
+        double springTerm = -panel.k*(panel.theta-panel.theta_0)-panel.c*panel.thetaDot;
+        if(j+1 < numPanels){
+            HingedPanel &nextPanel = this->PanelVec[j+1];
+            springTerm += nextPanel.k*(nextPanel.theta - nextPanel.theta_0) + nextPanel.c*nextPanel.thetaDot;
+        }
+        Eigen::Vector3d sumTerm3 = sumCentOut - pow(omegaAbs,2)*panel.d*panel.sHat1_B;
+        rhsRow.leftCols<3>() = -(2*numOut+1)*md*panel.sHat3_B.transpose();
+        rhsRow.middleCols<3>(3) = -panel.IPntS_S(1,1)*panel.sHat2_B.transpose()
+            + md*panel.sHat3_B.transpose()*rTildeChain;
+        rhsRow(6) = springTerm - (panel.IPntS_S(0,0) - panel.IPntS_S(2,2))*panel.omega_BN_S(2)*panel.omega_BN_S(0)
+            - md*panel.sHat3_B.dot(2*this->omegaTildeLoc_BN_B*panel.rPrime_SB_B
+                + this->omegaTildeLoc_BN_B*this->omegaTildeLoc_BN_B*panel.r_SB_B + sumVelOut + sumTerm3)
+            + panel.sHat2_B.dot(-panel.d*panel.sHat1_B.cross(panel.mass*g_B))
+            + 2.0*panel.d*panel.sHat3_B.dot(massOut*g_B);
+
+        // - Coupling vectors of the panel and the velocity terms of the hub equations
+        transTerm += (2*numOut+1)*md*panel.sHat3_B;
+        rotTerm += panel.IPntS_S(1,1)*panel.sHat2_B + rTildeChain*md*panel.sHat3_B;
+        this->matrixTransDHRB.col(j) = transTerm;
+        this->matrixRotDHRB.col(j) = rotTerm;
+        backSubContr.vecTrans -= pow(omegaAbs,2)*(2*numOut+1)*md*panel.sHat1_B;
+        backSubContr.vecRot -= panel.mass*this->omegaTildeLoc_BN_B*panel.rTilde_SB_B*panel.rPrime_SB_B
+            + pow(omegaAbs,2)*rTildeChain*md*panel.sHat1_B
+            + panel.IPntS_S(1,1)*omegaAbs*this->omegaTildeLoc_BN_B*panel.sHat2_B;
+
+        // - Eliminate the panel, the articulated terms act on the absolute acceleration of the previous panel
+        double mdd = md*panel.d;
+        Eigen::Matrix3d stiffness = articulatedStiffness + (numOut == 0 ? 2.0 : 4.0)*Eigen::Matrix3d::Identity();
+        Eigen::Vector3d psi = stiffness*panel.sHat3_B;
+        double den = panel.IPntS_S(1,1) - mdd*panel.sHat3_B.dot(panel.sHat3_B) + mdd*panel.sHat3_B.dot(psi);
+        Eigen::Matrix<double, 1, 7> num = rhsRow - mdd*panel.sHat3_B.transpose()*articulatedRhs;
+        articulatedStiffness = stiffness - mdd/den*psi*psi.transpose();
+        articulatedRhs += psi*num/den;
+        this->matrixPsiDHRB.col(j) = psi;
+        this->vectorDenDHRB(j) = den;
+        this->matrixNumDHRB.row(j) = num;
+
+        sumVelOut += 4*this->omegaTildeLoc_BN_B*panel.rPrime_SB_B
+            + 2*this->omegaTildeLoc_BN_B*this->omegaTildeLoc_BN_B*panel.r_SB_B;
+        sumRTildeOut += panel.rTilde_SB_B;
+        massOut += panel.mass;
+    }
+
+    // - Absolute panel accelerations from the first panel outwards, thetaDDot are their differences
+    Eigen::Matrix<double, 3, 7> chainAcc;
+    chainAcc.setZero();
+    Eigen::Matrix<double, 1, 7> absAcc;
+    Eigen::Matrix<double, 1, 7> absAccPrev;
+    absAccPrev.setZero();
+    for(int j = 0; j < numPanels; j++){
+        HingedPanel &panel = this->PanelVec[j];
+        double mdd = panel.mass*panel.d*panel.d;
+        absAcc = (this->matrixNumDHRB.row(j) - mdd*this->matrixPsiDHRB.col(j).transpose()*chainAcc)
+            /this->vectorDenDHRB(j);
+        chainAcc += panel.sHat3_B*absAcc;
+        this->matrixXDHRB.row(j) = absAcc - absAccPrev;
+        absAccPrev = absAcc;
+
+        backSubContr.matrixA += this->matrixTransDHRB.col(j)*this->matrixXDHRB.block<1,3>(j,0);
+        backSubContr.matrixB += this->matrixTransDHRB.col(j)*this->matrixXDHRB.block<1,3>(j,3);
+        backSubContr.vecTrans -= this->matrixTransDHRB.col(j)*this->matrixXDHRB(j,6);
+        backSubContr.matrixC += this->matrixRotDHRB.col(j)*this->matrixXDHRB.block<1,3>(j,0);
+        backSubContr.matrixD += this->matrixRotDHRB.col(j)*this->matrixXDHRB.block<1,3>(j,3);
+        backSubContr.vecRot -= this->matrixRotDHRB.col(j)*this->matrixXDHRB(j,6);
+    }
+
     return;
 }
 
@@ -472,14 +630,9 @@ void NHingedRigidBodyStateEffector::computeDerivatives(double integTime, Eigen::
     rDDotLoc_BN_B = dcm_BN*rDDotLoc_BN_N;
 
     // - Compute Derivatives
-    std::vector<HingedPanel>::iterator PanelIt;
     Eigen::MatrixXd thetaDDot(this->PanelVec.size(),1);
-    int i = 0;
-    for(PanelIt=this->PanelVec.begin(); PanelIt!=this->PanelVec.end(); PanelIt++){
-        thetaDDot(i,0) = this->matrixEDHRB.row(i).dot(this->matrixFDHRB*rDDotLoc_BN_B)
-        + this->matrixEDHRB.row(i)*this->matrixGDHRB*omegaDotLoc_BN_B + this->matrixEDHRB.row(i)*this->vectorVDHRB;
-        i += 1;
-    }
+    thetaDDot = this->matrixXDHRB.leftCols(3)*rDDotLoc_BN_B + this->matrixXDHRB.middleCols(3,3)*omegaDotLoc_BN_B
+        + this->matrixXDHRB.col(6);
     // - First is trivial
     this->thetaState->setDerivative(this->thetaDotState->getState());
     // - Second, a little more involved
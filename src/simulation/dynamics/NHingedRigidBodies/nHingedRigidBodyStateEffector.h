@@ -66,6 +66,7 @@ public:
     Eigen::Vector3d r_HB_B;          //!< [m] vector pointing from body frame origin to the first Hinge location
     Eigen::Matrix3d rTilde_HB_B;     //!< -- Tilde matrix of rHB_B
     Eigen::Matrix3d dcm_HB;          //!< -- DCM from body frame to hinge frame
+    bool useDenseSolve;              //!< -- if true the panel equations are assembled and inverted densely, O(N^3)
     void addHingedPanel(HingedPanel NewPanel) {PanelVec.push_back(NewPanel);} //!< class method
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
@@ -83,6 +84,14 @@ private:
     Eigen::MatrixXd matrixLDHRB;    //!< [-] term needed for back substitution
     Eigen::MatrixXd matrixMDHRB;    //!< [-] term needed for back substitution
     Eigen::VectorXd vectorVDHRB;    //!< [-] term needed for back substitution
+    Eigen::MatrixXd matrixXDHRB;    //!< [-] solution E*[F G v] of the panel equations, gives thetaDDot
+    Eigen::MatrixXd matrixNumDHRB;  //!< [-] numerators of the absolute panel accelerations in the recursive solve
+    Eigen::MatrixXd matrixPsiDHRB;  //!< [-] articulated stiffness times sHat3 of each panel in the recursive solve
+    Eigen::VectorXd vectorDenDHRB;  //!< [-] denominators of the absolute panel accelerations in the recursive solve
+    Eigen::MatrixXd matrixTransDHRB; //!< [-] translational coupling vector of each panel
+    Eigen::MatrixXd matrixRotDHRB;  //!< [-] rotational coupling vector of each panel
+    Eigen::VectorXd vectorSumThetaDotDHRB; //!< [rad/s] sum of the panel rates up to and including each panel
+    Eigen::MatrixXd matrixSumCentDHRB; //!< [m/s^2] sum of the centripetal terms up to and including each panel
     Eigen::Vector3d aTheta;         //!< -- term needed for back substitution
     Eigen::Vector3d bTheta;         //!< -- term needed for back substitution
     Eigen::Vector3d omegaLoc_BN_B;  //!< [rad/s] local copy of omegaBN
@@ -91,6 +100,9 @@ private:
     StateData *hubOmega;            //!< -- state manager access to the hubs omegaBN_B state
     StateData *hubVelocity;         //!< -- state manager access to the hubs rDotBN_N state
 
+    void denseContributions(BackSubMatrices & backSubContr, const Eigen::Vector3d & g_B);
+    void recursiveContributions(BackSubMatrices & backSubContr, const Eigen::Vector3d & g_B);
+
 public:
     NHingedRigidBodyStateEffector();  //!< -- Contructor
     ~NHingedRigidBodyStateEffector();  //!< -- Destructor
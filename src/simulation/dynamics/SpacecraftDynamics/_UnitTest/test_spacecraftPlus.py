@@ -36,6 +36,7 @@ from Basilisk.utilities import RigidBodyKinematics
 from Basilisk.fswAlgorithms import fswMessages
 from Basilisk.utilities import simIncludeGravBody
 from Basilisk.simulation import GravityGradientEffector
+from Basilisk.utilities import orbitalMotion
 
 
 # uncomment this line is this test is to be skipped in the global unit test run, adjust message as needed
@@ -991,5 +992,178 @@ def test_scAttRef(show_plots, accuracy):
 
     return [testFailCount, ''.join(testMessages)]
 
+@pytest.mark.parametrize("useSundmanTime, timeStep, accuracy", [(False, 10.0, 1e-2), (True, 600.0, 1e-2)])
+def test_SCSundmanTime(show_plots, useSundmanTime, timeStep, accuracy):
+    """Checks the integration in the Sundman transformed time against the Keplerian solution of an orbit with an
+    eccentricity of 0.9.  With a 600 s task step, which is far too long for the periapsis passage in time, the steps in
+    the Sundman variable reach the accuracy of 10 s steps in time with about a tenth of the evaluations."""
+    __tracebackhide__ = True
+
+    testFailCount = 0  # zero unit test result counter
+    testMessages = []  # create empty list to store test log messages
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+
+    unitTaskName = "unitTask"  # arbitrary name (don't change)
+    unitProcessName = "TestProcess"  # arbitrary name (don't change)
+
+    #   Create a sim module as an empty container
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+
+    # Create test thread
+    testProcessRate = macros.sec2nano(timeStep)  # update process rate update time
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    # Add test module to runtime call list
+    unitTestSim.AddModelToTask(unitTaskName, scObject)
+
+    unitTestSim.earthGravBody = gravityEffector.GravBodyData()
+    unitTestSim.earthGravBody.bodyInMsgName = "earth_planet_data"
+    unitTestSim.earthGravBody.outputMsgName = "earth_display_frame_data"
+    unitTestSim.earthGravBody.mu = 0.3986004415E+15 # meters!
+    unitTestSim.earthGravBody.isCentralBody = True
+    unitTestSim.earthGravBody.useSphericalHarmParams = False
+
+    scObject.gravField.gravBodies = spacecraftPlus.GravBodyVector([unitTestSim.earthGravBody])
+
+    unitTestSim.TotalSim.logThisMessage(scObject.scStateOutMsgName, testProcessRate)
+
+    # Start at apoapsis of an orbit with a 7000 km periapsis radius, so that the periapsis passage is integrated
+    mu = unitTestSim.earthGravBody.mu
+    oe = orbitalMotion.ClassicElements()
+    oe.e = 0.9
+    oe.a = 7000.0e3 / (1.0 - oe.e)
+    oe.i = 63.4 * macros.D2R
+    oe.Omega = 40.0 * macros.D2R
+    oe.omega = 270.0 * macros.D2R
+    oe.f = math.pi
+    rN, vN = orbitalMotion.elem2rv(mu, oe)
+
+    # Define initial conditions of the spacecraft
+    scObject.hub.mHub = 100
+    scObject.hub.r_CN_NInit = [[rN[0]], [rN[1]], [rN[2]]]
+    scObject.hub.v_CN_NInit = [[vN[0]], [vN[1]], [vN[2]]]
+    scObject.hub.useSundmanTime = useSundmanTime
+    scObject.hub.sundmanStep = 0.005
+
+    unitTestSim.InitializeSimulation()
+
+    # Half a revolution, through periapsis
+    numSteps = int(math.pi * math.sqrt(oe.a ** 3 / mu) / timeStep)
+    stopTime = numSteps * timeStep
+    unitTestSim.ConfigureStopTime(macros.sec2nano(stopTime))
+    unitTestSim.ExecuteSimulation()
+
+    moduleOutput = unitTestSim.pullMessageLogData(scObject.scStateOutMsgName + '.r_BN_N',
+                                                  list(range(3)))
+
+    # Keplerian position at the stop time
+    meanAnomaly = orbitalMotion.E2M(orbitalMotion.f2E(oe.f, oe.e), oe.e) + math.sqrt(mu / oe.a ** 3) * stopTime
+    oe.f = orbitalMotion.E2f(orbitalMotion.M2E(meanAnomaly, oe.e), oe.e)
+    truePos, trueVel = orbitalMotion.elem2rv(mu, oe)
+
+    error = numpy.linalg.norm(moduleOutput[-1, 1:4] - numpy.array(truePos))
+    if error > accuracy:
+        testFailCount += 1
+        testMessages.append("FAILED: SCHub Sundman time test position error of " + str(error) + " m")
+
+    if testFailCount == 0:
+        print("PASSED: " + " SCHub Sundman time test")
+
+    assert testFailCount < 1, testMessages
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+def runEnckeCase(useEnckeMode, timeStep, stopTime):
+    """Propagates a low Earth orbit perturbed by a constant inertial force and returns the final position"""
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+
+    unitTaskName = "unitTask"  # arbitrary name (don't change)
+    unitProcessName = "TestProcess"  # arbitrary name (don't change)
+
+    #   Create a sim module as an empty container
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+
+    # Create test thread
+    testProcessRate = macros.sec2nano(timeStep)  # update process rate update time
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    # Add test module to runtime call list
+    unitTestSim.AddModelToTask(unitTaskName, scObject)
+
+    unitTestSim.earthGravBody = gravityEffector.GravBodyData()
+    unitTestSim.earthGravBody.bodyInMsgName = "earth_planet_data"
+    unitTestSim.earthGravBody.outputMsgName = "earth_display_frame_data"
+    unitTestSim.earthGravBody.mu = 0.3986004415E+15 # meters!
+    unitTestSim.earthGravBody.isCentralBody = True
+    unitTestSim.earthGravBody.useSphericalHarmParams = False
+
+    scObject.gravField.gravBodies = spacecraftPlus.GravBodyVector([unitTestSim.earthGravBody])
+    scObject.gravField.useEnckeMode = useEnckeMode
+
+    extFTObject = extForceTorque.ExtForceTorque()
+    extFTObject.ModelTag = "externalDisturbance"
+    extFTObject.extForce_N = [[1.0e-3], [2.0e-3], [-1.0e-3]]
+    scObject.addDynamicEffector(extFTObject)
+    unitTestSim.AddModelToTask(unitTaskName, extFTObject)
+
+    unitTestSim.TotalSim.logThisMessage(scObject.scStateOutMsgName, testProcessRate)
+
+    oe = orbitalMotion.ClassicElements()
+    oe.e = 0.01
+    oe.a = 7000.0e3
+    oe.i = 0.5
+    oe.Omega = 0.2
+    oe.omega = 0.3
+    oe.f = 0.1
+    rN, vN = orbitalMotion.elem2rv(unitTestSim.earthGravBody.mu, oe)
+
+    # Define initial conditions of the spacecraft
+    scObject.hub.mHub = 100
+    scObject.hub.r_CN_NInit = [[rN[0]], [rN[1]], [rN[2]]]
+    scObject.hub.v_CN_NInit = [[vN[0]], [vN[1]], [vN[2]]]
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(stopTime))
+    unitTestSim.ExecuteSimulation()
+
+    moduleOutput = unitTestSim.pullMessageLogData(scObject.scStateOutMsgName + '.r_BN_N',
+                                                  list(range(3)))
+    return moduleOutput[-1, 1:4]
+
+
+@pytest.mark.parametrize("useEnckeMode, accuracy", [(False, 100.0), (True, 1e-2)])
+def test_SCEnckeMode(show_plots, useEnckeMode, accuracy):
+    """Checks the Encke mode of the gravity effector against an integration of the full gravity with 1 s steps.  The
+    orbit is perturbed by a constant force of a few mN.  With 60 s steps over about one revolution the deviations from
+    the osculating conic are integrated to within a centimeter, where the integration of the full gravity is tens of
+    meters off."""
+    __tracebackhide__ = True
+
+    testFailCount = 0  # zero unit test result counter
+    testMessages = []  # create empty list to store test log messages
+
+    stopTime = 6000.0
+    truePos = runEnckeCase(False, 1.0, stopTime)
+    finalPos = runEnckeCase(useEnckeMode, 60.0, stopTime)
+
+    error = numpy.linalg.norm(finalPos - truePos)
+    if error > accuracy:
+        testFailCount += 1
+        testMessages.append("FAILED: SCHub Encke mode test position error of " + str(error) + " m")
+
+    if testFailCount == 0:
+        print("PASSED: " + " SCHub Encke mode test")
+
+    assert testFailCount < 1, testMessages
+
+    return [testFailCount, ''.join(testMessages)]
+
+
 if __name__ == "__main__":
     test_scAttRef(True, 1e-3)
@@ -40,6 +40,17 @@ HubEffector::HubEffector()
     this->nameOfHubVelocity = "hubVelocity";
     this->nameOfHubSigma = "hubSigma";
     this->nameOfHubOmega = "hubOmega";
+    this->nameOfHubTime = "hubTime";
+    this->nameOfHubPositionDeviation = "hubPositionDeviation";
+    this->nameOfHubVelocityDeviation = "hubVelocityDeviation";
+
+    // - integrate in time unless the Sundman transformation is requested
+    this->useSundmanTime = false;
+    this->sundmanStep = 0.01;
+    this->timeState = nullptr;
+    this->useEnckeStates = false;
+    this->posDeviationState = nullptr;
+    this->velDeviationState = nullptr;
 
     // - define a default mass of 1kg
     this->mHub = 1.0;
@@ -68,6 +79,9 @@ void HubEffector::prependSpacecraftNameToStates()
     this->nameOfHubVelocity = this->nameOfSpacecraftAttachedTo + this->nameOfHubVelocity;
     this->nameOfHubSigma = this->nameOfSpacecraftAttachedTo + this->nameOfHubSigma;
     this->nameOfHubOmega = this->nameOfSpacecraftAttachedTo + this->nameOfHubOmega;
+    this->nameOfHubTime = this->nameOfSpacecraftAttachedTo + this->nameOfHubTime;
+    this->nameOfHubPositionDeviation = this->nameOfSpacecraftAttachedTo + this->nameOfHubPositionDeviation;
+    this->nameOfHubVelocityDeviation = this->nameOfSpacecraftAttachedTo + this->nameOfHubVelocityDeviation;
 
     return;
 }
@@ -87,6 +101,26 @@ void HubEffector::registerStates(DynParamManager& states)
     this->sigmaState->setState(this->sigma_BNInit);
     this->omegaState->setState(this->omega_BN_BInit);
 
+    /* - With the Sundman transformation the independent variable of the integrator is no longer the time, so the time
+     is integrated as a state alongside the others */
+    if (this->useSundmanTime) {
+        Eigen::MatrixXd timeInit(1, 1);
+        timeInit.setZero();
+        this->timeState = states.registerState(1, 1, this->nameOfHubTime);
+        this->timeState->setState(timeInit);
+    }
+
+    /* - In the Encke mode the deviations from the osculating conic are integrated, the position and velocity states
+     are recomputed from the conic and the deviations */
+    if (this->useEnckeStates) {
+        Eigen::Vector3d deviationInit;
+        deviationInit.setZero();
+        this->posDeviationState = states.registerState(3, 1, this->nameOfHubPositionDeviation);
+        this->velDeviationState = states.registerState(3, 1, this->nameOfHubVelocityDeviation);
+        this->posDeviationState->setState(deviationInit);
+        this->velDeviationState->setState(deviationInit);
+    }
+
     return;
 }
 
@@ -153,6 +187,13 @@ void HubEffector::computeDerivatives(double integTime, Eigen::Vector3d rDDot_BN_
     // - Set kinematic derivative
     posState->setDerivative(rDotLocal_BN_N);
 
+    // - The time rate is one here, spacecraftPlus scales all the derivatives by dt/ds of the Sundman transformation
+    if (this->useSundmanTime) {
+        Eigen::MatrixXd timeRate(1, 1);
+        timeRate.fill(1.0);
+        this->timeState->setDerivative(timeRate);
+    }
+
     return;
 }
 
@@ -188,3 +229,75 @@ void HubEffector::modifyStates(double integTime)
     }
     return;
 }
+
+/*! This method computes dt/ds of the Sundman transformation dt = r^(3/2)/sqrt(mu) ds.  The independent variable s
+ advances like the mean anomaly of the circular orbit through the current position, so a fixed step in s gives short time
+ steps at periapsis and long time steps at apoapsis of eccentric and hyperbolic orbits.
+ @return double
+ @param mu [m^3/s^2] gravitational parameter of the body the hub position is relative to
+ */
+double HubEffector::computeSundmanTimeRate(double mu)
+{
+    double rNorm = this->posState->getState().norm();
+    return(rNorm*sqrt(rNorm/mu));
+}
+
+/*! This method sets the time state used with the Sundman transformation
+ @return void
+ @param time [s] current time
+ */
+void HubEffector::setTime(double time)
+{
+    Eigen::MatrixXd timeLocal(1, 1);
+    timeLocal.fill(time);
+    this->timeState->setState(timeLocal);
+
+    return;
+}
+
+/*! This method returns the time state used with the Sundman transformation
+ @return double
+ */
+double HubEffector::getTime()
+{
+    return(this->timeState->getState()(0, 0));
+}
+
+/*! This method sets the Encke deviations from the position and velocity states and the osculating conic
+ @return void
+ @param r_osc_N [m] position on the osculating conic
+ @param v_osc_N [m/s] velocity on the osculating conic
+ */
+void HubEffector::setEnckeDeviation(Eigen::Vector3d r_osc_N, Eigen::Vector3d v_osc_N)
+{
+    this->posDeviationState->setState(this->posState->getState() - r_osc_N);
+    this->velDeviationState->setState(this->velocityState->getState() - v_osc_N);
+
+    return;
+}
+
+/*! This method sets the position and velocity states from the osculating conic and the Encke deviations
+ @return void
+ @param r_osc_N [m] position on the osculating conic
+ @param v_osc_N [m/s] velocity on the osculating conic
+ */
+void HubEffector::applyEnckeDeviation(Eigen::Vector3d r_osc_N, Eigen::Vector3d v_osc_N)
+{
+    this->posState->setState(r_osc_N + this->posDeviationState->getState());
+    this->velocityState->setState(v_osc_N + this->velDeviationState->getState());
+
+    return;
+}
+
+/*! This method computes the derivatives of the Encke deviations once the hub acceleration is known.  The position and
+ velocity derivatives are left as they are, the stateEffectors use the hub acceleration.
+ @return void
+ @param rDDot_osc_N [m/s^2] point mass gravity at the osculating conic position
+ */
+void HubEffector::computeEnckeDerivatives(Eigen::Vector3d rDDot_osc_N)
+{
+    this->posDeviationState->setDerivative(this->velDeviationState->getState());
+    this->velDeviationState->setDerivative(this->velocityState->getStateDeriv() - rDDot_osc_N);
+
+    return;
+}
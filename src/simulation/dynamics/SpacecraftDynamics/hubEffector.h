@@ -35,6 +35,12 @@ public:
     std::string nameOfHubVelocity;       //!< -- Identifier for hub velocity states
     std::string nameOfHubSigma;          //!< -- Identifier for hub sigmaBN states
     std::string nameOfHubOmega;          //!< -- Identifier for hub omegaBN_B states
+    std::string nameOfHubTime;           //!< -- Identifier for hub time state, only used with useSundmanTime
+    std::string nameOfHubPositionDeviation;  //!< -- Identifier for hub position deviation state, Encke mode only
+    std::string nameOfHubVelocityDeviation;  //!< -- Identifier for hub velocity deviation state, Encke mode only
+    bool useSundmanTime;                 //!< -- Flag to integrate the states in the Sundman transformed time
+    bool useEnckeStates;                 //!< -- Flag to register the Encke deviation states, set by spacecraftPlus
+    double sundmanStep;                  //!< [rad] Step of the Sundman independent variable
     Eigen::Vector3d r_BcB_B;             //!< [m] vector from point B to CoM of hub in B frame components
     Eigen::Matrix3d IHubPntBc_B;         //!< [kg m^2] Inertia of hub about point Bc in B frame components
     BackSubMatrices hubBackSubMatrices;  //!< class method
@@ -54,6 +60,12 @@ public:
     void updateEnergyMomContributions(double integTime, Eigen::Vector3d & rotAngMomPntCContr_B,
                                       double & rotEnergyContr, Eigen::Vector3d omega_BN_B); //!< -- Add contributions to energy and momentum
     void modifyStates(double integTime); //!< -- Method to switch MRPs
+    double computeSundmanTimeRate(double mu);  //!< -- Method to compute dt/ds of the Sundman transformation
+    void setTime(double time);           //!< -- Method to set the time state of the Sundman transformation
+    double getTime();                    //!< -- Method to get the time state of the Sundman transformation
+    void setEnckeDeviation(Eigen::Vector3d r_osc_N, Eigen::Vector3d v_osc_N);  //!< -- Method to set the deviations from the position and velocity states
+    void applyEnckeDeviation(Eigen::Vector3d r_osc_N, Eigen::Vector3d v_osc_N);  //!< -- Method to set the position and velocity states from the deviations
+    void computeEnckeDerivatives(Eigen::Vector3d rDDot_osc_N);  //!< -- Method to compute the deviation derivatives
     void prependSpacecraftNameToStates(); //!< class method
 
 private:
@@ -63,6 +75,9 @@ private:
     StateData *velocityState;            //!< [-] State data container for hub velocity
     StateData *sigmaState;               //!< [-] State data container for hub sigma_BN
     StateData *omegaState;               //!< [-] State data container for hub omegaBN_B
+    StateData *timeState;                //!< [-] State data container for hub time with useSundmanTime
+    StateData *posDeviationState;        //!< [-] State data container for hub position deviation in Encke mode
+    StateData *velDeviationState;        //!< [-] State data container for hub velocity deviation in Encke mode
 };
 
 #endif /* HUB_EFFECTOR_H */
@@ -986,6 +986,19 @@ void SpacecraftDynamics::integrateState(double integrateToThisTime)
 
     // - Integrate the state from the last time (timeBefore) to the integrateToThisTime
     double timeBefore = integrateToThisTime - localTimeStep;
+    std::vector<Spacecraft*> allSpacecraft;
+    allSpacecraft.push_back(&this->primaryCentralSpacecraft);
+    allSpacecraft.insert(allSpacecraft.end(), this->spacecraftDockedToPrimary.begin(), this->spacecraftDockedToPrimary.end());
+    allSpacecraft.insert(allSpacecraft.end(), this->unDockedSpacecraft.begin(), this->unDockedSpacecraft.end());
+    std::vector<Spacecraft*>::iterator spacecraftIt;
+    std::vector<DynamicEffector*>::iterator dynIt;
+    for(spacecraftIt = allSpacecraft.begin(); spacecraftIt != allSpacecraft.end(); spacecraftIt++)
+    {
+        for(dynIt = (*spacecraftIt)->dynEffectors.begin(); dynIt != (*spacecraftIt)->dynEffectors.end(); dynIt++)
+        {
+            (*dynIt)->prepareIntegrationStep(timeBefore, localTimeStep, this->integrator);
+        }
+    }
     this->integrator->integrate(timeBefore, localTimeStep);
     this->timePrevious = integrateToThisTime;     // - copy the current time into previous time for next integrate state call
 
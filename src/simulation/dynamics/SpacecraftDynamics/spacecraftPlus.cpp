@@ -44,6 +44,10 @@ SpacecraftPlus::SpacecraftPlus()
     this->numOutMsgBuffers = 2;
     this->dvAccum_B.setZero();
     this->dvAccum_BN_B.setZero();
+    this->sundmanStepping = false;
+    this->sundmanMu = 0.0;
+    this->sundmanBodyWarned = false;
+    this->enckeStepping = false;
 
     // - Set integrator as RK4 by default
     this->integrator = new svIntegratorRK4(this);
@@ -213,9 +217,9 @@ void SpacecraftPlus::linkInStates(DynParamManager& statesIn)
     this->hubOmega_BN_B = statesIn.getStateObject("hubOmega");
 
     // - Get access to the hubs position and velocity in the property manager
-    this->inertialPositionProperty = statesIn.getPropertyReference("r_BN_N");
-    this->inertialVelocityProperty = statesIn.getPropertyReference("v_BN_N");
-    this->g_N = statesIn.getPropertyReference("g_N");
+    this->inertialPositionProperty = statesIn.getTypedPropertyReference<Eigen::Vector3d>("r_BN_N");
+    this->inertialVelocityProperty = statesIn.getTypedPropertyReference<Eigen::Vector3d>("v_BN_N");
+    this->g_N = statesIn.getTypedPropertyReference<Eigen::Vector3d>("g_N");
 
     return;
 }
@@ -226,29 +230,37 @@ void SpacecraftPlus::linkInStates(DynParamManager& statesIn)
 void SpacecraftPlus::initializeDynamics()
 {
     // - SpacecraftPlus initiates all of the spaceCraft mass properties
-    Eigen::MatrixXd initM_SC(1,1);
-    Eigen::MatrixXd initMDot_SC(1,1);
-    Eigen::MatrixXd initC_B(3,1);
-    Eigen::MatrixXd initISCPntB_B(3,3);
-    Eigen::MatrixXd initCPrime_B(3,1);
-    Eigen::MatrixXd initCDot_B(3,1);
-    Eigen::MatrixXd initISCPntBPrime_B(3,3);
-    Eigen::MatrixXd systemTime(2,1);
+    Eigen::Matrix<double, 1, 1> initM_SC;
+    Eigen::Matrix<double, 1, 1> initMDot_SC;
+    Eigen::Vector3d initC_B;
+    Eigen::Matrix3d initISCPntB_B;
+    Eigen::Vector3d initCPrime_B;
+    Eigen::Vector3d initCDot_B;
+    Eigen::Matrix3d initISCPntBPrime_B;
+    Eigen::Vector2d systemTime;
+    initM_SC.setZero();
+    initMDot_SC.setZero();
+    initC_B.setZero();
+    initISCPntB_B.setZero();
+    initCPrime_B.setZero();
+    initCDot_B.setZero();
+    initISCPntBPrime_B.setZero();
     systemTime.setZero();
-    // - Create the properties
-    this->m_SC = this->dynManager.createProperty("m_SC", initM_SC);
-    this->mDot_SC = this->dynManager.createProperty("mDot_SC", initMDot_SC);
-    this->c_B = this->dynManager.createProperty("centerOfMassSC", initC_B);
-    this->ISCPntB_B = this->dynManager.createProperty("inertiaSC", initISCPntB_B);
-    this->ISCPntBPrime_B = this->dynManager.createProperty("inertiaPrimeSC", initISCPntBPrime_B);
-    this->cPrime_B = this->dynManager.createProperty("centerOfMassPrimeSC", initCPrime_B);
-    this->cDot_B = this->dynManager.createProperty("centerOfMassDotSC", initCDot_B);
-    this->sysTime = this->dynManager.createProperty(this->sysTimePropertyName, systemTime);
+    // - Create the properties, the fixed size handles are used in the mass property and back-substitution updates
+    this->m_SC = this->dynManager.createTypedProperty("m_SC", initM_SC);
+    this->mDot_SC = this->dynManager.createTypedProperty("mDot_SC", initMDot_SC);
+    this->c_B = this->dynManager.createTypedProperty("centerOfMassSC", initC_B);
+    this->ISCPntB_B = this->dynManager.createTypedProperty("inertiaSC", initISCPntB_B);
+    this->ISCPntBPrime_B = this->dynManager.createTypedProperty("inertiaPrimeSC", initISCPntBPrime_B);
+    this->cPrime_B = this->dynManager.createTypedProperty("centerOfMassPrimeSC", initCPrime_B);
+    this->cDot_B = this->dynManager.createTypedProperty("centerOfMassDotSC", initCDot_B);
+    this->sysTime = this->dynManager.createTypedProperty(this->sysTimePropertyName, systemTime);
     
     // - Register the gravity properties with the dynManager, 'erbody wants g_N!
     this->gravField.registerProperties(this->dynManager);
     
-    // - Register the hub states
+    // - Register the hub states, with the deviation states if the gravity field uses the Encke mode
+    this->hub.useEnckeStates = this->gravField.useEnckeMode;
     this->hub.registerStates(this->dynManager);
     
     // - Loop through stateEffectors to register their states
@@ -353,6 +365,20 @@ void SpacecraftPlus::updateSCMassProps(double time)
  dynParam Manager thus solving for Xdot*/
 void SpacecraftPlus::equationsOfMotion(double integTimeSeconds)
 {
+    // - With the Sundman transformation the integrator variable is not the time, the time is a hub state
+    if (this->hub.useSundmanTime) {
+        integTimeSeconds = this->hub.getTime();
+    }
+
+    // - In the Encke mode the hub position and velocity are the osculating conic plus the integrated deviations
+    Eigen::Vector3d rOsc_N;
+    Eigen::Vector3d vOsc_N;
+    Eigen::Vector3d rDDotOsc_N;
+    if (this->enckeStepping) {
+        this->gravField.computeEnckeReference(integTimeSeconds, rOsc_N, vOsc_N, rDDotOsc_N);
+        this->hub.applyEnckeDeviation(rOsc_N, vOsc_N);
+    }
+
     // - Update time to the current time
     uint64_t integTimeNanos = this->simTimePrevious + (integTimeSeconds-this->timePrevious)/NANO2SEC;
     (*this->sysTime) << integTimeNanos, integTimeSeconds;
@@ -465,6 +491,21 @@ void SpacecraftPlus::equationsOfMotion(double integTimeSeconds)
         (*it)->computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
     }
 
+    // - The deviations are driven by the hub acceleration minus the point mass gravity on the osculating conic
+    if (this->enckeStepping) {
+        this->hub.computeEnckeDerivatives(rDDotOsc_N);
+    }
+
+    // - Map the time derivatives to derivatives with respect to the Sundman variable, dX/ds = dX/dt dt/ds
+    if (this->sundmanStepping) {
+        double timeRate = this->hub.computeSundmanTimeRate(this->sundmanMu);
+        std::map<std::string, StateData>::iterator stateIt;
+        for(stateIt = this->dynManager.stateContainer.stateMap.begin(); stateIt != this->dynManager.stateContainer.stateMap.end(); stateIt++)
+        {
+            stateIt->second.stateDeriv *= timeRate;
+        }
+    }
+
     return;
 }
 
@@ -492,7 +533,23 @@ void SpacecraftPlus::integrateState(double integrateToThisTime)
 
     // - Integrate the state from the last time (timeBefore) to the integrateToThisTime
     double timeBefore = integrateToThisTime - localTimeStep;
-    this->integrator->integrate(timeBefore, localTimeStep);
+    // - The Sundman steps are not fixed in time, so the effectors are not told the integrator stages
+    StateVecIntegrator *stepIntegrator = this->hub.useSundmanTime ? nullptr : this->integrator;
+    std::vector<DynamicEffector*>::iterator dynIt;
+    for(dynIt = this->dynEffectors.begin(); dynIt != this->dynEffectors.end(); dynIt++)
+    {
+        (*dynIt)->prepareIntegrationStep(timeBefore, localTimeStep, stepIntegrator);
+    }
+    this->enckeStepping = this->gravField.useEnckeMode && this->prepareEnckeStep(timeBefore);
+    Eigen::Vector3d gravityDV_N;
+    if (this->hub.useSundmanTime) {
+        this->integrateSundmanTime(timeBefore, localTimeStep, gravityDV_N);
+    } else {
+        this->integrator->integrate(timeBefore, localTimeStep);
+        this->applyEnckeStep(integrateToThisTime);
+        gravityDV_N = (*this->g_N)*localTimeStep;
+    }
+    this->enckeStepping = false;
     this->timePrevious = integrateToThisTime;     // - copy the current time into previous time for next integrate state call
 
     // - Call mass properties to get current info on the mass props of the spacecraft
@@ -516,10 +573,8 @@ void SpacecraftPlus::integrateState(double integrateToThisTime)
     dV_N = newV_CN_N - oldV_CN_N;
     dV_B_N = newV_BN_N - oldV_BN_N;
     // - Subtract out gravity
-    Eigen::Vector3d gLocal_N;
-    gLocal_N = *this->g_N;
-    dV_N -= gLocal_N*localTimeStep;
-    dV_B_N -= gLocal_N*localTimeStep;
+    dV_N -= gravityDV_N;
+    dV_B_N -= gravityDV_N;
     dV_B_B = newDcm_NB.transpose()*dV_B_N;
 
     // - Find accumulated DV of the center of mass in the body frame
@@ -555,6 +610,112 @@ void SpacecraftPlus::integrateState(double integrateToThisTime)
     return;
 }
 
+/*! This method integrates the states over one time step with the Sundman transformation dt = r^(3/2)/sqrt(mu) ds.
+ Steps of hub.sundmanStep in s are taken until the next one is expected to pass the end of the time step.  The remaining
+ time is then integrated with time as the independent variable, backwards if the last step in s went past the end, so
+ that the step ends exactly at the requested time.  The
+ hub MRPs are switched between the sub-steps.
+ @return void
+ @param timeBefore [s] time at the start of the step
+ @param timeStep [s] time step
+ @param gravityDV_N [m/s] velocity change due to gravity over the step, used for the accumulated delta-v
+ */
+void SpacecraftPlus::integrateSundmanTime(double timeBefore, double timeStep, Eigen::Vector3d &gravityDV_N)
+{
+    // - The hub position is relative to the central body, or to the single gravity body without one
+    gravityDV_N.setZero();
+    if (this->gravField.centralBody) {
+        this->sundmanMu = this->gravField.centralBody->mu;
+    } else if (!this->gravField.gravBodies.empty()) {
+        if (this->gravField.gravBodies.size() > 1 && !this->sundmanBodyWarned) {
+            bskLogger.bskLog(BSK_WARNING, "SpacecraftPlus %s uses useSundmanTime with %d gravity bodies and no central "
+                             "body, the Sundman transformation uses the first gravity body. Set isCentralBody on one "
+                             "of them.", this->ModelTag.c_str(), (int) this->gravField.gravBodies.size());
+            this->sundmanBodyWarned = true;
+        }
+        this->sundmanMu = this->gravField.gravBodies[0]->mu;
+    } else {
+        this->sundmanMu = 0.0;
+    }
+
+    double timeEnd = timeBefore + timeStep;
+    double time = timeBefore;
+    this->hub.setTime(timeBefore);
+    while (this->sundmanMu > 0.0 && time < timeEnd) {
+        // - Time step of the next Sundman step, estimated from the current radius
+        if (this->hub.sundmanStep*this->hub.computeSundmanTimeRate(this->sundmanMu) >= timeEnd - time) {
+            break;
+        }
+        this->sundmanStepping = true;
+        this->integrator->integrate(time, this->hub.sundmanStep);
+        this->sundmanStepping = false;
+        double timeNext = this->hub.getTime();
+        this->applyEnckeStep(timeNext);
+        gravityDV_N += (*this->g_N)*(timeNext - time);
+        time = timeNext;
+        this->hub.modifyStates(time);
+    }
+
+    // - Integrate in time up to the end of the step, backwards if the last Sundman step went past it
+    if (time != timeEnd) {
+        this->integrator->integrate(time, timeEnd - time);
+        this->applyEnckeStep(timeEnd);
+        gravityDV_N += (*this->g_N)*(timeEnd - time);
+    }
+    this->hub.setTime(timeEnd);
+
+    return;
+}
+
+/*! This method prepares a step in the Encke mode.  The osculating conic of the gravity effector is reset to the
+ current orbit if it is not set yet, if the central body changed or if the position deviation exceeds
+ gravField.enckeRectificationRatio times the conic radius.  The deviations are then set from the current hub position
+ and velocity, so that changes of these states between the steps are kept.
+ @return bool true if the deviations are integrated, false if the gravity field has no conic for this state
+ @param time [s] time at the start of the step
+ */
+bool SpacecraftPlus::prepareEnckeStep(double time)
+{
+    Eigen::Vector3d r_BN_N = this->hubR_N->getState();
+    Eigen::Vector3d v_BN_N = this->hubV_N->getState();
+    Eigen::Vector3d rOsc_N;
+    Eigen::Vector3d vOsc_N;
+    Eigen::Vector3d rDDotOsc_N;
+
+    bool rectify = !this->gravField.enckeReferenceValid();
+    if (!rectify) {
+        this->gravField.computeEnckeReference(time, rOsc_N, vOsc_N, rDDotOsc_N);
+        rectify = (r_BN_N - rOsc_N).norm() > this->gravField.enckeRectificationRatio*rOsc_N.norm();
+    }
+    if (rectify) {
+        if (!this->gravField.setEnckeReference(r_BN_N, v_BN_N, time)) {
+            return(false);
+        }
+        this->gravField.computeEnckeReference(time, rOsc_N, vOsc_N, rDDotOsc_N);
+    }
+    this->hub.setEnckeDeviation(rOsc_N, vOsc_N);
+
+    return(true);
+}
+
+/*! This method sets the hub position and velocity from the osculating conic and the deviations after an integration
+ step in the Encke mode, the integrated position and velocity states are only used within the step.
+ @return void
+ @param time [s] time at the end of the integration step
+ */
+void SpacecraftPlus::applyEnckeStep(double time)
+{
+    if (this->enckeStepping) {
+        Eigen::Vector3d rOsc_N;
+        Eigen::Vector3d vOsc_N;
+        Eigen::Vector3d rDDotOsc_N;
+        this->gravField.computeEnckeReference(time, rOsc_N, vOsc_N, rDDotOsc_N);
+        this->hub.applyEnckeDeviation(rOsc_N, vOsc_N);
+    }
+
+    return;
+}
+
 /*! This method is used to find the total energy and momentum of the spacecraft. It finds the total orbital energy,
  total orbital angular momentum, total rotational energy and total rotational angular momentum. These values are used 
  for validation purposes. */
@@ -55,15 +55,15 @@ public:
     Eigen::Vector3d sumForceExternal_N;  //!< [N] Sum of forces given in the inertial frame
     Eigen::Vector3d sumForceExternal_B;  //!< [N] Sum of forces given in the body frame
     Eigen::Vector3d sumTorquePntB_B;     //!< [N-m] Total torque about point B in B frame components
-    Eigen::MatrixXd *m_SC;               //!< [kg] spacecrafts total mass
-    Eigen::MatrixXd *mDot_SC;            //!< [kg/s] Time derivative of spacecrafts total mass
-    Eigen::MatrixXd *ISCPntB_B;          //!< [kg m^2] Inertia of s/c about point B in B frame components
-    Eigen::MatrixXd *c_B;                //!< [m] Vector from point B to CoM of s/c in B frame components
-    Eigen::MatrixXd *cPrime_B;           //!< [m/s] Body time derivative of c_B
-    Eigen::MatrixXd *cDot_B;             //!< [m/s] Inertial time derivative of c_B
-    Eigen::MatrixXd *ISCPntBPrime_B;     //!< [kg m^2/s] Body time derivative of ISCPntB_B
-    Eigen::MatrixXd *g_N;                //!< [m/s^2] Gravitational acceleration in N frame components
-    Eigen::MatrixXd *sysTime;            //!< [s] System time
+    DynPropertyRef<Eigen::Matrix<double, 1, 1> > m_SC;  //!< [kg] spacecrafts total mass
+    DynPropertyRef<Eigen::Matrix<double, 1, 1> > mDot_SC;  //!< [kg/s] Time derivative of spacecrafts total mass
+    DynPropertyRef<Eigen::Matrix3d> ISCPntB_B;  //!< [kg m^2] Inertia of s/c about point B in B frame components
+    DynPropertyRef<Eigen::Vector3d> c_B;  //!< [m] Vector from point B to CoM of s/c in B frame components
+    DynPropertyRef<Eigen::Vector3d> cPrime_B;  //!< [m/s] Body time derivative of c_B
+    DynPropertyRef<Eigen::Vector3d> cDot_B;  //!< [m/s] Inertial time derivative of c_B
+    DynPropertyRef<Eigen::Matrix3d> ISCPntBPrime_B;  //!< [kg m^2/s] Body time derivative of ISCPntB_B
+    DynPropertyRef<Eigen::Vector3d> g_N;  //!< [m/s^2] Gravitational acceleration in N frame components
+    DynPropertyRef<Eigen::Vector2d> sysTime;  //!< [s] System time
     Eigen::Vector3d dvAccum_B;           //!< [m/s] Accumulated delta-v of center of mass relative to inertial frame in body frame coordinates
     Eigen::Vector3d dvAccum_BN_B;        //!< [m/s] accumulated delta-v of body frame relative to inertial frame in body frame coordinates
     Eigen::Vector3d nonConservativeAccelpntB_B;//!< [m/s/s] Current spacecraft body acceleration in the B frame
@@ -99,14 +99,21 @@ private:
     StateData *hubV_N;                          //!< -- State data access to inertial velocity for the hub
     StateData *hubOmega_BN_B;                   //!< -- State data access to the attitude rate of the hub
     StateData *hubSigma;                        //!< -- State data access to sigmaBN for the hub
-    Eigen::MatrixXd *inertialPositionProperty;  //!< [m] r_N inertial position relative to system spice zeroBase/refBase
-    Eigen::MatrixXd *inertialVelocityProperty;  //!< [m] v_N inertial velocity relative to system spice zeroBase/refBase
+    DynPropertyRef<Eigen::Vector3d> inertialPositionProperty;  //!< [m] r_N inertial position relative to system spice zeroBase/refBase
+    DynPropertyRef<Eigen::Vector3d> inertialVelocityProperty;  //!< [m] v_N inertial velocity relative to system spice zeroBase/refBase
     int64_t scStateOutMsgId;                    //!< -- Message ID for the outgoing spacecraft state
     int64_t scMassStateOutMsgId;                //!< -- Message ID for the outgoing spacecraft mass state
     int64_t attRefInMsgId;                      //!< -- Message ID for the optional incoming attitude reference message
+    bool sundmanStepping;                       //!< -- True while the integrator steps the Sundman variable instead of time
+    double sundmanMu;                           //!< [m^3/s^2] Gravitational parameter used in the Sundman transformation
+    bool sundmanBodyWarned;                     //!< -- True once the missing central body of the Sundman transformation is reported
+    bool enckeStepping;                         //!< -- True while the deviations from the osculating conic are integrated
 
 private:
     void readAttRefMsg();                       //!< -- Read the optional attitude reference input message and set the reference attitude
+    void integrateSundmanTime(double timeBefore, double timeStep, Eigen::Vector3d &gravityDV_N);  //!< -- Integrate one step with the Sundman transformation
+    bool prepareEnckeStep(double time);         //!< -- Rectify the osculating conic if needed and set the Encke deviations
+    void applyEnckeStep(double time);           //!< -- Set the hub position and velocity from the integrated Encke deviations
 };
 
 
@@ -49,6 +49,8 @@ from Basilisk.simulation import sim_model
 from Basilisk.simulation import thrusterDynamicEffector
 from Basilisk.simulation import stateArchitecture
 from Basilisk.simulation import spacecraftPlus
+from Basilisk.simulation import svIntegrators
+from Basilisk.simulation import fuelTank
 from Basilisk.utilities import macros
 
 
@@ -725,6 +727,100 @@ def unitThrusters(testFixture, show_plots, ramp, thrustNumber , duration  ,  lon
     # testMessage
     return [testFailCount, ''.join(testMessages)]
 
+@pytest.mark.parametrize("integratorCase", ["RK4", "RK2", "Euler"])
+def test_pulseEdgeIntegration(show_plots, integratorCase):
+    """Checks that a pulse shorter than the integration step gives the exact impulse and propellant use
+    when integrated by the spacecraft with the RK4, RK2 or Euler integrator, and that the thruster output
+    message reports the commanded thrust factor"""
+    unitProcessName = "TestProcess"
+    unitTaskName = "unitTask"
+    g = 9.80665
+    Isp = 226.7
+    maxThrust = 1.0
+    pulseTime = 0.095
+    timeStep = 0.1
+    mHub = 750.0
+    propMass = 40.0
+
+    TotalSim = SimulationBaseClass.SimBaseClass()
+    testProc = TotalSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(TotalSim.CreateNewTask(unitTaskName, macros.sec2nano(timeStep)))
+
+    # thruster through the center of mass, such that the pulse does not change the attitude
+    thrusterSet = thrusterDynamicEffector.ThrusterDynamicEffector()
+    thrusterSet.ModelTag = "ACSThrusterDynamics"
+    thrusterSet.usePulseEdgeIntegration = True
+    thruster1 = thrusterDynamicEffector.THRConfigSimMsg()
+    thruster1.thrLoc_B = [[0.0], [0.0], [0.0]]
+    thruster1.thrDir_B = [[0.0], [0.6], [0.8]]
+    thruster1.MaxThrust = maxThrust
+    thruster1.steadyIsp = Isp
+    thruster1.MinOnTime = 0.006
+    thrusterSet.addThruster(thruster1)
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+    scObject.hub.mHub = mHub
+    scObject.hub.r_BcB_B = [[0.0], [0.0], [0.0]]
+    scObject.hub.IHubPntBc_B = [[900.0, 0.0, 0.0], [0.0, 800.0, 0.0], [0.0, 0.0, 600.0]]
+    scObject.addDynamicEffector(thrusterSet)
+    if integratorCase == "RK2":
+        integratorObject = svIntegrators.svIntegratorRK2(scObject)
+        scObject.setIntegrator(integratorObject)
+    elif integratorCase == "Euler":
+        integratorObject = svIntegrators.svIntegratorEuler(scObject)
+        scObject.setIntegrator(integratorObject)
+
+    fuelTankEffector = fuelTank.FuelTank()
+    fuelTankEffector.setTankModel(fuelTank.TANK_MODEL_CONSTANT_VOLUME)
+    tankModel = fuelTank.cvar.FuelTankModelConstantVolume
+    tankModel.propMassInit = propMass
+    tankModel.r_TcT_TInit = [[0.0], [0.0], [0.0]]
+    tankModel.radiusTankInit = 0.5
+    fuelTankEffector.r_TB_B = [[0.0], [0.0], [0.0]]
+    fuelTankEffector.addThrusterSet(thrusterSet)
+    scObject.addStateEffector(fuelTankEffector)
+
+    TotalSim.AddModelToTask(unitTaskName, thrusterSet)
+    TotalSim.AddModelToTask(unitTaskName, scObject)
+
+    ThrustMessage = thrusterDynamicEffector.THRArrayOnTimeCmdIntMsg()
+    thrMessageSize = ThrustMessage.getStructSize()
+    ThrustMessage.OnTimeRequest = [pulseTime]
+    TotalSim.TotalSim.CreateNewMessage(unitProcessName, "acs_thruster_cmds", thrMessageSize, 2)
+    TotalSim.TotalSim.WriteMessageData("acs_thruster_cmds", thrMessageSize, 0, ThrustMessage)
+    thrOutMsgName = "thruster_" + thrusterSet.ModelTag + "_0_data"
+    TotalSim.TotalSim.logThisMessage(thrOutMsgName, macros.sec2nano(timeStep))
+
+    TotalSim.InitializeSimulation()
+    TotalSim.ConfigureStopTime(macros.sec2nano(3*timeStep))
+    TotalSim.ExecuteSimulation()
+
+    velocity = np.array(scObject.dynManager.getStateObject("hubVelocity").getState()).flatten()
+    propellantMass = propMass - scObject.dynManager.getStateObject(fuelTankEffector.nameOfMassState).getState()[0][0]
+    thrustFactor = TotalSim.pullMessageLogData(thrOutMsgName + ".thrustFactor")
+
+    trueMass = maxThrust*pulseTime/(g*Isp)
+    trueVelocity = maxThrust*pulseTime*np.array([0.0, 0.6, 0.8])/(mHub + propMass)
+
+    testFailCount = 0
+    testMessages = []
+    if np.max(np.abs(velocity - trueVelocity)) > 1e-6*np.linalg.norm(trueVelocity):
+        testFailCount += 1
+        testMessages.append("FAILED: " + integratorCase + " pulse velocity change " + str(velocity)
+                            + " instead of " + str(trueVelocity) + "\n")
+    if abs(propellantMass - trueMass) > 1e-9*trueMass:
+        testFailCount += 1
+        testMessages.append("FAILED: " + integratorCase + " pulse propellant mass " + str(propellantMass)
+                            + " instead of " + str(trueMass) + "\n")
+    if not np.all(np.isin(thrustFactor[:, 1], [0.0, 1.0])):
+        testFailCount += 1
+        testMessages.append("FAILED: " + integratorCase + " thruster output message thrust factor "
+                            + str(thrustFactor[:, 1]) + " is not the commanded one\n")
+
+    assert testFailCount < 1, ''.join(testMessages)
+
+
 if __name__ == "__main__":
     unitThrusters(ResultsStore(), False, "ON", 1, 5.0, 30.,  15.,[[1.125], [0.5], [2.0]], 1E8, "ON", "ON")
 
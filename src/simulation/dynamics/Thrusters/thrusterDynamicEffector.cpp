@@ -22,6 +22,7 @@
 #include <cmath>
 
 #include "thrusterDynamicEffector.h"
+#include "../_GeneralModuleFiles/stateVecIntegrator.h"
 #include "architecture/messaging/system_messaging.h"
 #include "utilities/linearAlgebra.h"
 #include "utilities/astroConstants.h"
@@ -37,8 +38,11 @@ ThrusterDynamicEffector::ThrusterDynamicEffector()
 , InputCmds("acs_thruster_cmds")
 , thrusterOutMsgNameBufferCount(2)
 , prevFireTime(0.0)
+, usePulseEdgeIntegration(false)
 , CmdsInMsgID(-1)
 , prevCommandTime(0xFFFFFFFFFFFFFFFF)
+, integStepStartTime(0.0)
+, integStepSize(0.0)
 {
     CallCounts = 0;
     forceExternal_B.fill(0.0);
@@ -72,6 +76,7 @@ void ThrusterDynamicEffector::SelfInit()
     std::string tmpThrustMsgName;
     int thrustIdx = 0;
     mDotTotal = 0.0;
+    this->updateActiveThrusters();
     for (it = this->thrusterData.begin(); it != this->thrusterData.end(); ++it)
     {
         tmpThrustMsgName = "thruster_" + this->ModelTag + "_" + std::to_string(thrustIdx) + "_data";
@@ -204,7 +209,59 @@ void ThrusterDynamicEffector::ConfigureThrustRequests(double currentTime)
         //! After we have assigned the firing to the internal thruster, zero the command request.
         *CmdIt = 0.0;
     }
-    
+
+    //! - Only the thrusters that are now firing or still shutting down are evaluated during the integration
+    this->updateActiveThrusters();
+}
+
+/*! This method rebuilds the set of active thrusters, i.e. the thrusters that are
+ commanded on or that are still shutting down.  Thrusters that are off do not
+ contribute any force, torque or mass flow and are skipped in the integration.
+ @return void
+ */
+void ThrusterDynamicEffector::updateActiveThrusters()
+{
+    this->activeThrusters.clear();
+    for(size_t idx = 0; idx < this->thrusterData.size(); idx++)
+    {
+        THROperationSimMsg *ops = &this->thrusterData[idx].ThrustOps;
+        if(ops->ThrustOnCmd > 0.0 || ops->ThrustFactor > 0.0)
+        {
+            this->activeThrusters.push_back(idx);
+        }
+    }
+}
+
+/*! This method stores the integration step that the states are about to be
+ integrated over and the stage times and weights of the integrator.  It is used to
+ integrate the thruster pulse edges within the step.  The pulse edge integration is
+ off for the step if the integrator does not report its stages.
+ @return void
+ @param integTime Start time of the integration step
+ @param timeStep Size of the integration step
+ @param integrator Integrator of the step, nullptr if the step is not integrated in time
+ */
+void ThrusterDynamicEffector::prepareIntegrationStep(double integTime, double timeStep,
+                                                     StateVecIntegrator *integrator)
+{
+    this->integStepStartTime = integTime;
+    this->integStepSize = 0.0;
+    this->stageTimes.clear();
+    this->stageCellEnds.clear();
+    if(integrator == nullptr || integrator->stageTimes.empty() ||
+       integrator->stageTimes.size() != integrator->stageWeights.size())
+    {
+        return;
+    }
+    //! - Each stage represents a part of the step as long as its weight, in the order of the stage times
+    double cellEnd = 0.0;
+    for(size_t idx = 0; idx < integrator->stageTimes.size(); idx++)
+    {
+        cellEnd += integrator->stageWeights[idx];
+        this->stageTimes.push_back(integrator->stageTimes[idx]);
+        this->stageCellEnds.push_back(cellEnd);
+    }
+    this->integStepSize = timeStep;
 }
 
 /*! This method is used to link the states to the thrusters
@@ -246,13 +303,17 @@ void ThrusterDynamicEffector::computeForceTorque(double integTime){
 	omegaLocal_BN_B = hubOmega->getState();
 	axesWeightMatrix << 2, 0, 0, 0, 1, 0, 0, 0, 1;
     
-    //! - Iterate through all of the thrusters to aggregate the force/torque in the system
-    for(it = this->thrusterData.begin(); it != this->thrusterData.end(); it++)
+    //! - Iterate through the active thrusters to aggregate the force/torque in the system
+    size_t numActive = 0;
+    std::vector<size_t>::iterator activeIt;
+    for(activeIt = this->activeThrusters.begin(); activeIt != this->activeThrusters.end(); activeIt++)
     {
+        it = this->thrusterData.begin() + *activeIt;
         ops = &it->ThrustOps;
         //! - For each thruster see if the on-time is still valid and if so, call ComputeThrusterFire()
-        if((ops->ThrustOnCmd + ops->ThrusterStartTime  - integTime) >= -dt*10E-10 &&
-           ops->ThrustOnCmd > 0.0)
+        bool thrusterFiring = (ops->ThrustOnCmd + ops->ThrusterStartTime  - integTime) >= -dt*10E-10 &&
+                              ops->ThrustOnCmd > 0.0;
+        if(thrusterFiring)
         {
             ComputeThrusterFire(&(*it), integTime);
         }
@@ -261,8 +322,23 @@ void ThrusterDynamicEffector::computeForceTorque(double integTime){
         {
             ComputeThrusterShut(&(*it), integTime);
         }
+        //! - Use the thrust factor averaged over the part of the integration step, if available
+        double thrustFactor = ops->ThrustFactor;
+        double ispFactor = ops->IspFactor;
+        double pulseThrustFactor = this->computePulseThrustFactor(&(*it), integTime);
+        if(pulseThrustFactor >= 0.0)
+        {
+            thrustFactor = pulseThrustFactor;
+            ispFactor = pulseThrustFactor > 0.0 ? 1.0 : 0.0;
+        }
+        //! - Keep the thruster in the active set until it is neither firing nor shutting down
+        if(thrusterFiring || ops->ThrustFactor > 0.0 || thrustFactor > 0.0)
+        {
+            this->activeThrusters[numActive] = *activeIt;
+            numActive++;
+        }
         //! - For each thruster, aggregate the current thrust direction into composite body force
-        tmpThrustMag = it->MaxThrust*ops->ThrustFactor;
+        tmpThrustMag = it->MaxThrust*thrustFactor;
         // Apply dispersion to magnitude
         tmpThrustMag *= (1. + it->thrusterMagDisp);
         SingleThrusterForce = it->thrDir_B*tmpThrustMag;
@@ -275,10 +351,10 @@ void ThrusterDynamicEffector::computeForceTorque(double integTime){
 		if (!it->updateOnly) {
 			//! - Add the mass depletion force contribution
 			mDotNozzle = 0.0;
-			if (it->steadyIsp * ops->IspFactor > 0.0)
+			if (it->steadyIsp * ispFactor > 0.0)
 			{
-				mDotNozzle = it->MaxThrust*ops->ThrustFactor / (EARTH_GRAV *
-					it->steadyIsp * ops->IspFactor);
+				mDotNozzle = it->MaxThrust*thrustFactor / (EARTH_GRAV *
+					it->steadyIsp * ispFactor);
 			}
 			this->forceExternal_B += 2 * mDotNozzle*omegaLocal_BN_B.cross(it->thrLoc_B);
 
@@ -297,10 +373,60 @@ void ThrusterDynamicEffector::computeForceTorque(double integTime){
         eigenVector3d2CArray(SingleThrusterForce, it->ThrustOps.opThrustForce_B);
         eigenVector3d2CArray(SingleThrusterTorque, it->ThrustOps.opThrustTorquePntB_B);
     }
+    this->activeThrusters.resize(numActive);
     //! - Once all thrusters have been checked, update time-related variables for next evaluation
     prevFireTime = integTime;
 }
 
+/*! This method computes the average thrust factor of a thruster over the part of
+ the integration step that the current integrator stage represents.  The stages
+ reported by the integrator split the step into consecutive parts as long as their
+ weights, e.g. [0, 1/6], [1/6, 5/6] and [5/6, 1] for the RK4 evaluations at the
+ start, middle and end of the step.  Averaging the rectangular thrust profile over
+ these parts integrates the impulse and propellant use of pulses that start or end
+ within the step exactly.  Thrusters with on or off ramps keep the sampled thrust
+ factor.  The thrust factor of the thruster operation state is not changed.
+ @return double The average thrust factor, or -1 if not applicable
+ @param CurrentThruster Pointer to the configuration data for a given thruster
+ @param integTime The current integration time
+ */
+double ThrusterDynamicEffector::computePulseThrustFactor(THRConfigSimMsg *CurrentThruster,
+                                                         double integTime)
+{
+    THROperationSimMsg *ops = &(CurrentThruster->ThrustOps);
+    double timeStep = this->integStepSize;
+    if(!this->usePulseEdgeIntegration || timeStep <= 0.0 ||
+       CurrentThruster->ThrusterOnRamp.size() > 0 || CurrentThruster->ThrusterOffRamp.size() > 0)
+    {
+        return(-1.0);
+    }
+
+    //! - Find the part of the integration step represented by this evaluation
+    double stepFraction = (integTime - this->integStepStartTime)/timeStep;
+    size_t stage = 0;
+    while(stage < this->stageTimes.size() && fabs(stepFraction - this->stageTimes[stage]) >= 1E-9)
+    {
+        stage++;
+    }
+    if(stage == this->stageTimes.size())
+    {
+        return(-1.0);
+    }
+    double cellStart = stage > 0 ? this->stageCellEnds[stage - 1] : 0.0;
+    double cellEnd = this->stageCellEnds[stage];
+    cellStart = this->integStepStartTime + cellStart*timeStep;
+    cellEnd = this->integStepStartTime + cellEnd*timeStep;
+
+    //! - Average the commanded on-time window over the interval
+    if(ops->ThrustOnCmd <= 0.0)
+    {
+        return(0.0);
+    }
+    double onTime = std::min(cellEnd, ops->ThrusterStartTime + ops->ThrustOnCmd) -
+                    std::max(cellStart, ops->ThrusterStartTime);
+    return(std::max(onTime, 0.0)/(cellEnd - cellStart));
+}
+
 void ThrusterDynamicEffector::addThruster(THRConfigSimMsg *newThruster)
 {
     this->thrusterData.push_back(*newThruster);
@@ -314,15 +440,25 @@ void ThrusterDynamicEffector::computeStateContribution(double integTime){
     double mDotSingle=0.0;
     this->mDotTotal = 0.0;
 	this->stateDerivContribution.setZero();
-    //! - Iterate through all of the thrusters to aggregate the force/torque in the system
-    for(it = this->thrusterData.begin(); it != this->thrusterData.end(); it++)
+    //! - Iterate through the active thrusters to aggregate the mass flow in the system
+    std::vector<size_t>::iterator activeIt;
+    for(activeIt = this->activeThrusters.begin(); activeIt != this->activeThrusters.end(); activeIt++)
     {
+        it = this->thrusterData.begin() + *activeIt;
         ops = &it->ThrustOps;
+        double thrustFactor = ops->ThrustFactor;
+        double ispFactor = ops->IspFactor;
+        double pulseThrustFactor = this->computePulseThrustFactor(&(*it), integTime);
+        if(pulseThrustFactor >= 0.0)
+        {
+            thrustFactor = pulseThrustFactor;
+            ispFactor = pulseThrustFactor > 0.0 ? 1.0 : 0.0;
+        }
         mDotSingle = 0.0;
-        if(it->steadyIsp * ops->IspFactor > 0.0)
+        if(it->steadyIsp * ispFactor > 0.0)
         {
-            mDotSingle = it->MaxThrust*ops->ThrustFactor/(EARTH_GRAV *
-                                                          it->steadyIsp * ops->IspFactor);
+            mDotSingle = it->MaxThrust*thrustFactor/(EARTH_GRAV *
+                                                     it->steadyIsp * ispFactor);
         }
         this->mDotTotal += mDotSingle;
         
@@ -43,6 +43,7 @@ public:
     void linkInStates(DynParamManager& states);
     void computeForceTorque(double integTime);
     void computeStateContribution(double integTime);
+    void prepareIntegrationStep(double integTime, double timeStep, StateVecIntegrator *integrator);
     void SelfInit();
     void CrossInit();
     //! Add a new thruster to the thruster set
@@ -55,6 +56,9 @@ public:
                              double currentTime);
     void ComputeThrusterShut(THRConfigSimMsg *CurrentThruster,
                              double currentTime);
+    void updateActiveThrusters();
+    double computePulseThrustFactor(THRConfigSimMsg *CurrentThruster,
+                                    double integTime);
     
 
 public:
@@ -72,6 +76,7 @@ public:
 	StateData *hubSigma;                           //!< class variable
     StateData *hubOmega;                           //!< class varaible
     BSKLogger bskLogger;                      //!< -- BSK Logging
+    bool usePulseEdgeIntegration;                  //!< -- Flag to integrate the on and off edges of thrusters without ramps exactly within the integration step
 
 private:
     //    bool bdyFrmReady;                         //!< [-] Flag indicating that the body frame is ready
@@ -81,6 +86,11 @@ private:
     //int64_t propsInID;                            //!< [-] The ID associated with the mss props msg
     THRArrayOnTimeCmdIntMsg IncomingCmdBuffer;     //!< -- One-time allocation for savings
     uint64_t prevCommandTime;                       //!< -- Time for previous valid thruster firing
+    std::vector<size_t> activeThrusters;            //!< -- Indices of the thrusters that are firing or shutting down
+    double integStepStartTime;                      //!< s  Start time of the current integration step
+    double integStepSize;                           //!< s  Size of the current integration step, zero if unknown
+    std::vector<double> stageTimes;                 //!< -- Integrator stage times as fractions of the integration step
+    std::vector<double> stageCellEnds;              //!< -- End of the part of the step represented by each stage, as fractions of the step
 
 };
 
@@ -0,0 +1,168 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the constellation propagator.  The first part propagates the same circular orbits with one
+ * spacecraftPlus per spacecraft, each with its own point mass gravity field, and with a single constellation
+ * propagator, and prints the time per step and the largest position difference.  The second part times the
+ * constellation propagator with J2 to J6 and drag for growing numbers of spacecraft.  The modules are driven
+ * directly, without a SimModel.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchConstellationPropagator [number of 10 s steps]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <memory>
+#include <vector>
+#include "architecture/messaging/system_messaging.h"
+#include "dynamics/SpacecraftDynamics/spacecraftPlus.h"
+#include "dynamics/constellationPropagator/constellationPropagator.h"
+#include "utilities/astroConstants.h"
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+/*! Circular orbit of spacecraft i, spread over 10 planes and over the argument of latitude within a plane */
+static void walkerOrbit(int i, int numSc, Eigen::Vector3d &r_N, Eigen::Vector3d &v_N)
+{
+    double mu = MU_EARTH*1.0e9;
+    double radius = REQ_EARTH*1.0e3 + 500.0e3 + 10.0*(i % 50);
+    double raan = 2.0*M_PI*(i % 10)/10.0;
+    double arg = 2.0*M_PI*(i/10)/((numSc + 9)/10) + 0.01*i;
+    double inc = 53.0*M_PI/180.0;
+    double speed = sqrt(mu/radius);
+    Eigen::Vector3d rHat(cos(arg), sin(arg)*cos(inc), sin(arg)*sin(inc));
+    Eigen::Vector3d vHat(-sin(arg), cos(arg)*cos(inc), cos(arg)*sin(inc));
+    Eigen::Matrix3d raanRot;
+    raanRot << cos(raan), -sin(raan), 0.0, sin(raan), cos(raan), 0.0, 0.0, 0.0, 1.0;
+    r_N = radius*raanRot*rHat;
+    v_N = speed*raanRot*vHat;
+}
+
+int main(int argc, char *argv[])
+{
+    long numSteps = argc > 1 ? atol(argv[1]) : 360;
+    uint64_t stepNanos = 10000000000ULL;
+    struct timespec start, stop;
+
+    SystemMessaging::GetInstance()->AttachStorageBucket("benchProcess");
+    SystemMessaging::GetInstance()->selectMessageBuffer(0);
+
+    // - One spacecraftPlus per spacecraft against one constellation propagator, point mass gravity only
+    int numCompared = 100;
+    GravBodyData earth;
+    earth.bodyInMsgName = "earth_planet_data";
+    earth.outputMsgName = "earth_display_frame_data";
+    earth.mu = MU_EARTH*1.0e9;
+    earth.radEquator = REQ_EARTH*1.0e3;
+    earth.isCentralBody = true;
+    earth.useSphericalHarmParams = false;
+    std::vector<std::unique_ptr<SpacecraftPlus> > spacecraft;
+    ConstellationPropagator constellation;
+    constellation.ModelTag = "constellation";
+    for(int i = 0; i < numCompared; i++)
+    {
+        Eigen::Vector3d r_N, v_N;
+        walkerOrbit(i, numCompared, r_N, v_N);
+        spacecraft.emplace_back(new SpacecraftPlus());
+        SpacecraftPlus &sc = *spacecraft.back();
+        sc.ModelTag = "sc" + std::to_string(i);
+        sc.scStateOutMsgName = "sc" + std::to_string(i) + "_state";
+        sc.scMassStateOutMsgName = "sc" + std::to_string(i) + "_mass";
+        sc.hub.r_CN_NInit = r_N;
+        sc.hub.v_CN_NInit = v_N;
+        sc.gravField.gravBodies.push_back(&earth);
+        constellation.addSpacecraft(r_N, v_N, 0.0, "constellation_sc" + std::to_string(i) + "_state");
+    }
+    for(auto &sc : spacecraft)
+    {
+        sc->SelfInit();
+    }
+    constellation.SelfInit();
+    for(auto &sc : spacecraft)
+    {
+        sc->CrossInit();
+    }
+    constellation.CrossInit();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long step = 0; step < numSteps; step++)
+    {
+        for(auto &sc : spacecraft)
+        {
+            sc->UpdateState(step*stepNanos);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    double separateTime = elapsedSeconds(&start, &stop);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long step = 0; step < numSteps; step++)
+    {
+        constellation.UpdateState(step*stepNanos);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    double constellationTime = elapsedSeconds(&start, &stop);
+
+    Eigen::MatrixXd positions = constellation.getPositions();
+    double maxDiff = 0.0;
+    for(int i = 0; i < numCompared; i++)
+    {
+        Eigen::Vector3d r_N = spacecraft[i]->dynManager.getStateObject("hubPosition")->getState();
+        maxDiff = std::max(maxDiff, (r_N - positions.row(i).transpose()).norm());
+    }
+    printf("%ld steps of RK4 for %d spacecraft with point mass gravity, all state messages written\n", numSteps,
+           numCompared);
+    printf("  spacecraftPlus per spacecraft  %10.3f us per step\n", 1.0e6*separateTime/(double) numSteps);
+    printf("  constellation propagator       %10.3f us per step\n", 1.0e6*constellationTime/(double) numSteps);
+    printf("  largest position difference    %10.3e m\n", maxDiff);
+
+    // - Constellation propagator with zonal harmonics and drag, state messages for the first 10 spacecraft
+    printf("%ld steps of RK4 with J2 to J6 and drag, 10 state messages\n", numSteps);
+    printf("%12s %16s %20s\n", "spacecraft", "us per step", "ns per spacecraft");
+    int sizes[] = {100, 1000, 10000};
+    for(int numSc : sizes)
+    {
+        ConstellationPropagator large;
+        large.ModelTag = "constellation" + std::to_string(numSc);
+        large.zonalJ = {J2_EARTH, J3_EARTH, J4_EARTH, J5_EARTH, J6_EARTH};
+        large.baseDensity = 1.217;
+        large.scaleHeight = 8500.0;
+        for(int i = 0; i < numSc; i++)
+        {
+            Eigen::Vector3d r_N, v_N;
+            walkerOrbit(i, numSc, r_N, v_N);
+            large.addSpacecraft(r_N, v_N, 0.01, i < 10 ? large.ModelTag + "_sc" + std::to_string(i) : "");
+        }
+        large.SelfInit();
+        large.CrossInit();
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(long step = 0; step < numSteps; step++)
+        {
+            large.UpdateState(step*stepNanos);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        double perStep = elapsedSeconds(&start, &stop)/(double) numSteps;
+        printf("%12d %16.3f %20.3f\n", numSc, 1.0e6*perStep, 1.0e9*perStep/(double) numSc);
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the spacecraftPlus integration of the full gravity (Cowell) against the integration of the deviations
+ * from an osculating conic (Encke mode of the gravity effector) on a perturbed Earth orbit and on a translunar
+ * trajectory.  The perturbations, J2 and the gravity of a Moon on a circular orbit, are applied by a dynamic
+ * effector, so that no ephemeris messages are needed.  Each case prints the number of equations of motion evaluations,
+ * the run time and the final position error with respect to a Cowell run with 1 s steps.  The modules are driven
+ * directly, without a SimModel.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchEnckeMode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "architecture/messaging/system_messaging.h"
+#include "dynamics/SpacecraftDynamics/spacecraftPlus.h"
+#include "dynamics/_GeneralModuleFiles/dynamicEffector.h"
+#include "utilities/astroConstants.h"
+#include "utilities/orbitalMotion.h"
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+/*! Dynamic effector applying the J2 or lunar perturbation to a 100 kg hub and counting the evaluations */
+class PerturbationEffector : public DynamicEffector
+{
+public:
+    bool lunar = false;
+    long evaluations = 0;
+    StateData *hubPosition = nullptr;
+    void linkInStates(DynParamManager& states) {this->hubPosition = states.getStateObject("hubPosition");}
+    void computeForceTorque(double integTime)
+    {
+        Eigen::Vector3d r_N = this->hubPosition->getState();
+        Eigen::Vector3d accel;
+        if (this->lunar) {
+            double mu = MU_MOON*1.0e9;
+            double radius = 384400.0e3;
+            double angle = 2.0*M_PI/(27.32*86400.0)*integTime + 1.2;
+            Eigen::Vector3d rMoon(radius*cos(angle), radius*sin(angle), 0.0);
+            Eigen::Vector3d rRel = rMoon - r_N;
+            accel = mu*(rRel/pow(rRel.norm(), 3) - rMoon/pow(rMoon.norm(), 3));
+        } else {
+            double mu = MU_EARTH*1.0e9;
+            double req = REQ_EARTH*1.0e3;
+            double r = r_N.norm();
+            double zr2 = r_N(2)*r_N(2)/(r*r);
+            double factor = -1.5*J2_EARTH*mu*req*req/pow(r, 5);
+            accel << factor*r_N(0)*(1.0 - 5.0*zr2), factor*r_N(1)*(1.0 - 5.0*zr2), factor*r_N(2)*(3.0 - 5.0*zr2);
+        }
+        this->forceExternal_N = 100.0*accel;
+        this->evaluations++;
+    }
+};
+
+/*! Propagate the orbit with the given step, in the Encke mode or not, and return the final position */
+static Eigen::Vector3d runCase(GravBodyData &earth, classicElements oe, bool lunar, double duration, double taskStep,
+                              bool encke, Eigen::Vector3d *truth)
+{
+    static int caseNumber = 0;
+    std::string prefix = "case" + std::to_string(caseNumber++) + "_";
+    double rVec[3], vVec[3];
+    struct timespec start, stop;
+    elem2rv(MU_EARTH*1.0e9, &oe, rVec, vVec);
+
+    SpacecraftPlus scObject;
+    PerturbationEffector perturbation;
+    perturbation.lunar = lunar;
+    scObject.ModelTag = prefix + "spacecraftBody";
+    scObject.scStateOutMsgName = prefix + "inertial_state_output";
+    scObject.scMassStateOutMsgName = prefix + "mass_state_output";
+    scObject.hub.mHub = 100.0;
+    scObject.hub.r_CN_NInit << rVec[0], rVec[1], rVec[2];
+    scObject.hub.v_CN_NInit << vVec[0], vVec[1], vVec[2];
+    scObject.gravField.gravBodies.push_back(&earth);
+    scObject.gravField.useEnckeMode = encke;
+    scObject.addDynamicEffector(&perturbation);
+    scObject.SelfInit();
+    scObject.CrossInit();
+
+    long numSteps = (long) (duration/taskStep + 0.5);
+    uint64_t stepNanos = (uint64_t) (taskStep*1.0e9);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long step = 0; step <= numSteps; step++)
+    {
+        scObject.UpdateState(step*stepNanos);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    Eigen::Vector3d r_BN_N = scObject.dynManager.getStateObject("hubPosition")->getState();
+    if (truth) {
+        printf("  %-7s time step %6.0f s %10ld %12.3f %14.3e\n", encke ? "Encke" : "Cowell", taskStep,
+               perturbation.evaluations, 1.0e3*elapsedSeconds(&start, &stop), (r_BN_N - *truth).norm());
+    }
+    return(r_BN_N);
+}
+
+static void runComparison(GravBodyData &earth, classicElements oe, bool lunar, double duration,
+                          const std::vector<double> &taskSteps)
+{
+    Eigen::Vector3d truth = runCase(earth, oe, lunar, duration, 1.0, false, nullptr);
+    printf("  %-34s %10s %12s %14s\n", "integration", "evals", "time [ms]", "error [m]");
+    for(bool encke : {false, true})
+    {
+        for(double taskStep : taskSteps)
+        {
+            runCase(earth, oe, lunar, duration, taskStep, encke, &truth);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SystemMessaging::GetInstance()->AttachStorageBucket("benchProcess");
+    SystemMessaging::GetInstance()->selectMessageBuffer(0);
+
+    GravBodyData earth;
+    earth.bodyInMsgName = "earth_planet_data";
+    earth.outputMsgName = "earth_display_frame_data";
+    earth.mu = MU_EARTH*1.0e9;
+    earth.radEquator = REQ_EARTH*1.0e3;
+    earth.isCentralBody = true;
+    earth.useSphericalHarmParams = false;
+
+    // - One day of a 0.1 eccentricity orbit with a 7500 km periapsis radius and J2
+    classicElements oe;
+    oe.e = 0.1;
+    oe.a = 7500.0e3/(1.0 - oe.e);
+    oe.i = 51.6*M_PI/180.0;
+    oe.Omega = 40.0*M_PI/180.0;
+    oe.omega = 30.0*M_PI/180.0;
+    oe.f = 0.0;
+    printf("one day of a e = 0.1 orbit with a 7500 km periapsis radius, point mass and J2 gravity\n");
+    runComparison(earth, oe, false, 86400.0, {10.0, 30.0, 60.0, 120.0});
+
+    // - Three days of a translunar trajectory with the gravity of the Moon, from 2000 km after perigee
+    oe.e = 0.97;
+    oe.a = 6700.0e3/(1.0 - oe.e);
+    oe.i = 28.5*M_PI/180.0;
+    oe.Omega = 0.0;
+    oe.omega = 0.0;
+    oe.f = 20.0*M_PI/180.0;
+    printf("three days of a translunar trajectory, point mass gravity and a Moon on a circular orbit\n");
+    runComparison(earth, oe, true, 3.0*86400.0, {30.0, 60.0, 300.0, 600.0});
+    return 0;
+}
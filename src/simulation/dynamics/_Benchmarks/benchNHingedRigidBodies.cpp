@@ -0,0 +1,158 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the dense and the recursive panel solve of the N hinged rigid body effector for chains of 2 to 64
+ * panels.  For every chain the effector is set up twice with the same deflected and spinning panels, once with
+ * useDenseSolve, and driven directly through the mass property update, the back-substitution contributions and the
+ * derivatives.  The largest difference between the two solves, relative to the largest magnitude of each result,
+ * is printed next to the time of one contribution call.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchNHingedRigidBodies
+ *
+ * The benchmark returns 1 if the solves differ by more than the tolerance.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <algorithm>
+#include "dynamics/NHingedRigidBodies/nHingedRigidBodyStateEffector.h"
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+/*! Effector with its own state manager, so the dense and the recursive chain can be set up side by side */
+class ChainSetup
+{
+public:
+    ChainSetup(int numPanels, bool useDenseSolve)
+    {
+        Eigen::MatrixXd sigma(3,1), omega(3,1), velocity(3,1), gravity(3,1);
+        sigma << 0.1, -0.2, 0.3;
+        omega << 0.05, -0.04, 0.03;
+        velocity << 10.0, -5.0, 2.0;
+        gravity << 0.3, -8.1, 4.2;
+        this->states.registerState(3, 1, "hubSigma")->setState(sigma);
+        this->states.registerState(3, 1, "hubOmega")->setState(omega);
+        this->states.registerState(3, 1, "hubVelocity")->setState(velocity);
+        this->states.createProperty("g_N", gravity);
+        this->states.getStateObject("hubOmega")->setDerivative(Eigen::Vector3d(0.01, 0.02, -0.03));
+        this->states.getStateObject("hubVelocity")->setDerivative(Eigen::Vector3d(-0.4, 0.2, 0.1));
+
+        this->effector.useDenseSolve = useDenseSolve;
+        this->effector.r_HB_B << 0.5, 0.0, 1.0;
+        this->effector.dcm_HB << -1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 1.0;
+        for(int i = 0; i < numPanels; i++)
+        {
+            HingedPanel panel;
+            panel.mass = 5.0 + (i % 3);
+            panel.d = 0.5 + 0.05*(i % 4);
+            panel.IPntS_S << 5.0, 0.0, 0.0, 0.0, 2.5 + 0.1*i, 0.0, 0.0, 0.0, 2.5;
+            panel.k = 50.0;
+            panel.c = 0.1;
+            panel.thetaInit = 0.1*sin(0.7*i);
+            panel.thetaDotInit = 0.05*cos(1.3*i);
+            this->effector.addHingedPanel(panel);
+        }
+        this->effector.registerStates(this->states);
+        this->effector.linkInStates(this->states);
+    }
+
+    /*! Update the mass properties and the contributions, the derivatives are left to computeDerivatives */
+    void updateContributions()
+    {
+        this->effector.updateEffectorMassProps(0.0);
+        this->effector.updateContributions(0.0, this->backSub, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero(),
+                                           Eigen::Vector3d::Zero());
+    }
+
+    /*! Panel accelerations for the hub accelerations set in the constructor */
+    Eigen::MatrixXd thetaDDot()
+    {
+        this->effector.computeDerivatives(0.0, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero(),
+                                          Eigen::Vector3d::Zero());
+        return(this->states.getStateObject(this->effector.nameOfThetaDotState)->getStateDeriv());
+    }
+
+    DynParamManager states;
+    NHingedRigidBodyStateEffector effector;
+    BackSubMatrices backSub;
+};
+
+/*! Largest difference of two results relative to the largest magnitude of the first */
+static double relativeDifference(const Eigen::MatrixXd &reference, const Eigen::MatrixXd &value)
+{
+    double scale = std::max(reference.cwiseAbs().maxCoeff(), 1.0e-300);
+    return((reference - value).cwiseAbs().maxCoeff()/scale);
+}
+
+/*! Time of one mass property and contribution update in microseconds */
+static double timeContributions(ChainSetup &chain, long reps)
+{
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long rep = 0; rep < reps; rep++)
+    {
+        chain.updateContributions();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    return(1.0e6*elapsedSeconds(&start, &stop)/(double) reps);
+}
+
+int main()
+{
+    int chainSizes[] = {2, 4, 8, 16, 32, 64};
+    double tolerance = 1.0e-10;
+    int failed = 0;
+
+    printf("%8s %14s %14s %10s %14s\n", "panels", "dense [us]", "recursive [us]", "speedup", "max rel diff");
+    for(int numPanels : chainSizes)
+    {
+        ChainSetup dense(numPanels, true);
+        ChainSetup recursive(numPanels, false);
+        dense.updateContributions();
+        recursive.updateContributions();
+
+        double maxDiff = 0.0;
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.matrixA, recursive.backSub.matrixA));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.matrixB, recursive.backSub.matrixB));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.matrixC, recursive.backSub.matrixC));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.matrixD, recursive.backSub.matrixD));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.vecTrans, recursive.backSub.vecTrans));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.backSub.vecRot, recursive.backSub.vecRot));
+        maxDiff = std::max(maxDiff, relativeDifference(dense.thetaDDot(), recursive.thetaDDot()));
+
+        long reps = std::max(20L, 2000000L/((long) numPanels*numPanels*numPanels));
+        double denseTime = timeContributions(dense, reps);
+        double recursiveTime = timeContributions(recursive, std::max(reps, 200000L/numPanels));
+        printf("%8d %14.3f %14.3f %10.1f %14.3e\n", numPanels, denseTime, recursiveTime, denseTime/recursiveTime,
+               maxDiff);
+        if(maxDiff > tolerance)
+        {
+            failed = 1;
+        }
+    }
+    if(failed)
+    {
+        printf("dense and recursive solves differ by more than %.1e\n", tolerance);
+    }
+    return(failed);
+}
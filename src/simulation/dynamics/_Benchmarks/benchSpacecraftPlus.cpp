@@ -0,0 +1,139 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the spacecraftPlus integration with three reaction wheels and two hinged panels, the effector
+ * set of the hinged rigid body and reaction wheel integrated unit tests.  The modules are driven directly, without
+ * a SimModel, so the time is spent in the RK4 stages: the mass property updates, the back-substitution
+ * contributions and the hub equations of motion.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchSpacecraftPlus [number of 0.1 s steps]
+ *
+ * The final hub states are printed with 17 digits so that two builds can be compared.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "architecture/messaging/system_messaging.h"
+#include "dynamics/SpacecraftDynamics/spacecraftPlus.h"
+#include "dynamics/reactionWheels/reactionWheelStateEffector.h"
+#include "dynamics/HingedRigidBodies/hingedRigidBodyStateEffector.h"
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+static void setUpPanel(HingedRigidBodyStateEffector &panel, int number, double side)
+{
+    std::string suffix = std::to_string(number);
+    panel.mass = 100.0;
+    panel.IPntS_S << 100.0, 0.0, 0.0, 0.0, 50.0, 0.0, 0.0, 0.0, 50.0;
+    panel.d = 1.5;
+    panel.k = 100.0;
+    panel.c = 0.0;
+    panel.r_HB_B << side*0.5, 0.0, 1.0;
+    panel.dcm_HB << side, 0.0, 0.0, 0.0, side, 0.0, 0.0, 0.0, 1.0;
+    panel.thetaInit = 5.0*M_PI/180.0;
+    panel.thetaDotInit = 0.0;
+    panel.nameOfThetaState = "hingedRigidBodyTheta" + suffix;
+    panel.nameOfThetaDotState = "hingedRigidBodyThetaDot" + suffix;
+    panel.hingedRigidBodyOutMsgName = "panel" + suffix + "_OutputStates";
+    panel.hingedRigidBodyConfigLogOutMsgName = "panel" + suffix + "_ConfigLog";
+    panel.ModelTag = "panel" + suffix;
+}
+
+int main(int argc, char *argv[])
+{
+    long numSteps = argc > 1 ? atol(argv[1]) : 20000;
+    uint64_t stepNanos = 100000000;
+    struct timespec start, stop;
+
+    SystemMessaging::GetInstance()->AttachStorageBucket("benchProcess");
+    SystemMessaging::GetInstance()->selectMessageBuffer(0);
+
+    SpacecraftPlus scObject;
+    scObject.ModelTag = "spacecraftBody";
+    scObject.hub.mHub = 750.0;
+    scObject.hub.r_BcB_B << 0.0, 0.0, 1.0;
+    scObject.hub.IHubPntBc_B << 900.0, 0.0, 0.0, 0.0, 800.0, 0.0, 0.0, 0.0, 600.0;
+    scObject.hub.r_CN_NInit << -4020338.690396649, 7490566.741852513, 5248299.211589362;
+    scObject.hub.v_CN_NInit << -5199.77710904224, -3436.681645356935, 1041.576797498721;
+    scObject.hub.sigma_BNInit << 0.0, 0.0, 0.0;
+    scObject.hub.omega_BN_BInit << 0.1, -0.1, 0.1;
+
+    ReactionWheelStateEffector rwEffector;
+    rwEffector.InputCmds = "";
+    rwEffector.ModelTag = "reactionWheels";
+    for(int i = 0; i < 3; i++)
+    {
+        RWConfigSimMsg wheel;
+        wheel.gsHat_B.setZero();
+        wheel.gsHat_B(i) = 1.0;
+        wheel.w2Hat0_B = wheel.gsHat_B.unitOrthogonal();
+        wheel.w3Hat0_B = wheel.gsHat_B.cross(wheel.w2Hat0_B);
+        wheel.rWB_B << 0.1*(i + 1), -0.1*i, 0.2;
+        wheel.mass = 9.0;
+        wheel.Js = 0.1;
+        wheel.Jt = 0.05;
+        wheel.Jg = 0.05;
+        wheel.Omega = 100.0*(i + 1)*M_PI/30.0;
+        wheel.u_current = 0.1*(i - 1);
+        rwEffector.addReactionWheel(&wheel);
+    }
+
+    HingedRigidBodyStateEffector panel1;
+    HingedRigidBodyStateEffector panel2;
+    setUpPanel(panel1, 1, -1.0);
+    setUpPanel(panel2, 2, 1.0);
+
+    scObject.addStateEffector(&rwEffector);
+    scObject.addStateEffector(&panel1);
+    scObject.addStateEffector(&panel2);
+
+    rwEffector.SelfInit();
+    panel1.SelfInit();
+    panel2.SelfInit();
+    scObject.SelfInit();
+    rwEffector.CrossInit();
+    panel1.CrossInit();
+    panel2.CrossInit();
+    scObject.CrossInit();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long step = 0; step < numSteps; step++)
+    {
+        rwEffector.UpdateState(step*stepNanos);
+        panel1.UpdateState(step*stepNanos);
+        panel2.UpdateState(step*stepNanos);
+        scObject.UpdateState(step*stepNanos);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    Eigen::Vector3d sigma_BN = scObject.dynManager.getStateObject("hubSigma")->getState();
+    Eigen::Vector3d omega_BN_B = scObject.dynManager.getStateObject("hubOmega")->getState();
+    Eigen::Vector3d r_BN_N = scObject.dynManager.getStateObject("hubPosition")->getState();
+    printf("%ld steps of RK4 with 3 reaction wheels and 2 hinged panels\n", numSteps);
+    printf("  %.3f us per step\n", 1.0e6*elapsedSeconds(&start, &stop)/(double) numSteps);
+    printf("  sigma_BN   %.17g %.17g %.17g\n", sigma_BN(0), sigma_BN(1), sigma_BN(2));
+    printf("  omega_BN_B %.17g %.17g %.17g\n", omega_BN_B(0), omega_BN_B(1), omega_BN_B(2));
+    printf("  r_BN_N     %.17g %.17g %.17g\n", r_BN_N(0), r_BN_N(1), r_BN_N(2));
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the spacecraftPlus integration in time against the integration in the Sundman transformed time on a
+ * highly eccentric orbit and on a hyperbolic flyby with point mass gravity.  Each case prints the number of equations
+ * of motion evaluations, counted by a dynamic effector, the run time and the final position error with respect to
+ * the Keplerian solution.  The modules are driven directly, without a SimModel.  Build with -DBUILD_BENCHMARKS=ON and
+ * run
+ *
+ *     ./benchSundmanTime
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "architecture/messaging/system_messaging.h"
+#include "dynamics/SpacecraftDynamics/spacecraftPlus.h"
+#include "dynamics/_GeneralModuleFiles/dynamicEffector.h"
+#include "utilities/astroConstants.h"
+#include "utilities/orbitalMotion.h"
+
+static double elapsedSeconds(const struct timespec *start, const struct timespec *stop)
+{
+    return((double) (stop->tv_sec - start->tv_sec) + 1.0e-9*(double) (stop->tv_nsec - start->tv_nsec));
+}
+
+/*! Dynamic effector without force or torque that counts the equations of motion evaluations */
+class EvaluationCounter : public DynamicEffector
+{
+public:
+    long evaluations = 0;
+    void linkInStates(DynParamManager& states) {}
+    void computeForceTorque(double integTime) {this->evaluations++;}
+};
+
+/*! Keplerian position after the time dt, for elliptic and hyperbolic orbits */
+static Eigen::Vector3d keplerPosition(double mu, classicElements oe, double dt)
+{
+    double rVec[3], vVec[3];
+    if (oe.a > 0.0) {
+        double meanAnomaly = E2M(f2E(oe.f, oe.e), oe.e) + sqrt(mu/(oe.a*oe.a*oe.a))*dt;
+        oe.f = E2f(M2E(meanAnomaly, oe.e), oe.e);
+    } else {
+        double meanAnomaly = H2N(f2H(oe.f, oe.e), oe.e) + sqrt(-mu/(oe.a*oe.a*oe.a))*dt;
+        oe.f = H2f(N2H(meanAnomaly, oe.e), oe.e);
+    }
+    elem2rv(mu, &oe, rVec, vVec);
+    return(Eigen::Vector3d(rVec[0], rVec[1], rVec[2]));
+}
+
+/*! Propagate the orbit for numSteps task steps, in time if sundmanStep is zero, and print the results */
+static void runCase(GravBodyData &earth, classicElements oe, long numSteps, double taskStep, double sundmanStep)
+{
+    static int caseNumber = 0;
+    std::string prefix = "case" + std::to_string(caseNumber++) + "_";
+    double mu = MU_EARTH*1.0e9;
+    double rVec[3], vVec[3];
+    struct timespec start, stop;
+    elem2rv(mu, &oe, rVec, vVec);
+
+    SpacecraftPlus scObject;
+    EvaluationCounter counter;
+    scObject.ModelTag = prefix + "spacecraftBody";
+    scObject.scStateOutMsgName = prefix + "inertial_state_output";
+    scObject.scMassStateOutMsgName = prefix + "mass_state_output";
+    scObject.hub.r_CN_NInit << rVec[0], rVec[1], rVec[2];
+    scObject.hub.v_CN_NInit << vVec[0], vVec[1], vVec[2];
+    scObject.hub.useSundmanTime = sundmanStep > 0.0;
+    scObject.hub.sundmanStep = sundmanStep;
+    scObject.gravField.gravBodies.push_back(&earth);
+    scObject.addDynamicEffector(&counter);
+    scObject.SelfInit();
+    scObject.CrossInit();
+
+    uint64_t stepNanos = (uint64_t) (taskStep*1.0e9);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(long step = 0; step <= numSteps; step++)
+    {
+        scObject.UpdateState(step*stepNanos);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    Eigen::Vector3d r_BN_N = scObject.dynManager.getStateObject("hubPosition")->getState();
+    double error = (r_BN_N - keplerPosition(mu, oe, numSteps*taskStep)).norm();
+    if (sundmanStep > 0.0) {
+        printf("  Sundman ds %6.3f, task step %6.0f s %10ld %12.3f %14.3e\n", sundmanStep, taskStep,
+               counter.evaluations, 1.0e3*elapsedSeconds(&start, &stop), error);
+    } else {
+        printf("  time step %7.2f s                  %10ld %12.3f %14.3e\n", taskStep, counter.evaluations,
+               1.0e3*elapsedSeconds(&start, &stop), error);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SystemMessaging::GetInstance()->AttachStorageBucket("benchProcess");
+    SystemMessaging::GetInstance()->selectMessageBuffer(0);
+
+    GravBodyData earth;
+    earth.bodyInMsgName = "earth_planet_data";
+    earth.outputMsgName = "earth_display_frame_data";
+    earth.mu = MU_EARTH*1.0e9;
+    earth.radEquator = REQ_EARTH*1.0e3;
+    earth.isCentralBody = true;
+    earth.useSphericalHarmParams = false;
+
+    // - One revolution of an orbit with a 7000 km periapsis radius and an eccentricity of 0.9, from apoapsis
+    classicElements oe;
+    oe.e = 0.9;
+    oe.a = 7000.0e3/(1.0 - oe.e);
+    oe.i = 63.4*M_PI/180.0;
+    oe.Omega = 40.0*M_PI/180.0;
+    oe.omega = 270.0*M_PI/180.0;
+    oe.f = M_PI;
+    double period = 2.0*M_PI*sqrt(oe.a*oe.a*oe.a/(MU_EARTH*1.0e9));
+    printf("one revolution of a e = 0.9 orbit with a 7000 km periapsis radius\n");
+    printf("  %-38s %10s %12s %14s\n", "integration", "evals", "time [ms]", "error [m]");
+    double timeSteps[] = {60.0, 20.0, 5.0, 1.0};
+    for(double taskStep : timeSteps)
+    {
+        runCase(earth, oe, (long) (period/taskStep), taskStep, 0.0);
+    }
+    double sundmanSteps[] = {0.05, 0.02, 0.01, 0.005};
+    for(double sundmanStep : sundmanSteps)
+    {
+        runCase(earth, oe, (long) (period/600.0), 600.0, sundmanStep);
+    }
+
+    // - Hyperbolic flyby with a 7000 km periapsis radius and an eccentricity of 2, from 100 to -100 deg true anomaly
+    oe.e = 2.0;
+    oe.a = -7000.0e3/(oe.e - 1.0);
+    oe.f = -100.0*M_PI/180.0;
+    double flybyTime = 2.0*H2N(f2H(-oe.f, oe.e), oe.e)/sqrt(-MU_EARTH*1.0e9/(oe.a*oe.a*oe.a));
+    printf("hyperbolic flyby with e = 2 and a 7000 km periapsis radius, -100 to 100 deg true anomaly\n");
+    printf("  %-38s %10s %12s %14s\n", "integration", "evals", "time [ms]", "error [m]");
+    for(double taskStep : timeSteps)
+    {
+        runCase(earth, oe, (long) (flybyTime/taskStep), taskStep, 0.0);
+    }
+    for(double sundmanStep : sundmanSteps)
+    {
+        runCase(earth, oe, (long) (flybyTime/600.0), 600.0, sundmanStep);
+    }
+    return 0;
+}
@@ -38,6 +38,21 @@ public:
     StateVector operator*(double scaleFactor);          //!< class method
 };
 
+/*! @brief Fixed size handle to a dynamic property.  The property itself stays an Eigen::MatrixXd in the manager,
+ so python and the untyped getPropertyReference() see the same data, but dereferencing the handle gives an
+ Eigen::Map of the fixed size type T.  Arithmetic on *handle is then done with fixed size Eigen expressions that the
+ compiler unrolls and vectorizes.  The handle is resolved once when the states are linked. */
+template <typename T>
+class DynPropertyRef {
+public:
+    DynPropertyRef() : property(nullptr) {}                                     //!< -- unlinked handle
+    explicit DynPropertyRef(Eigen::MatrixXd *prop) : property(prop) {}          //!< -- handle to a property
+    Eigen::Map<T> operator*() const {return(Eigen::Map<T>(this->property->data()));}  //!< -- fixed size view
+    bool isLinked() const {return(this->property != nullptr);}                  //!< -- true if the property exists
+public:
+    Eigen::MatrixXd *property;      //!< -- property in the manager, nullptr until linked
+};
+
 /*! dynamic parameter manager class */
 class DynParamManager {
 public:
@@ -57,7 +72,37 @@ public:
     Eigen::MatrixXd* getPropertyReference(std::string propName); //!< class method
     void setPropertyValue(const std::string propName,
                           const Eigen::MatrixXd & propValue); //!< class method
-    
+
+    /*! Creates a property and returns a fixed size handle to it
+     @return DynPropertyRef<T> handle to the new property
+     @param propName name of the property
+     @param propValue initial value, which also gives the size of the property
+     */
+    template <typename T>
+    DynPropertyRef<T> createTypedProperty(std::string propName, const T & propValue)
+    {
+        return(DynPropertyRef<T>(this->createProperty(propName, propValue)));
+    }
+
+    /*! Gets a fixed size handle to an existing property.  The handle is not linked if the property does not exist
+     or does not have the size of T.
+     @return DynPropertyRef<T> handle to the property
+     @param propName name of the property
+     */
+    template <typename T>
+    DynPropertyRef<T> getTypedPropertyReference(std::string propName)
+    {
+        Eigen::MatrixXd *prop = this->getPropertyReference(propName);
+        if(prop != nullptr && (prop->rows() != T::RowsAtCompileTime || prop->cols() != T::ColsAtCompileTime))
+        {
+            bskLogger.bskLog(BSK_ERROR, "The property: %s is %dx%d, not the requested %dx%d.  Null returned.",
+                             propName.c_str(), (int) prop->rows(), (int) prop->cols(),
+                             (int) T::RowsAtCompileTime, (int) T::ColsAtCompileTime);
+            return(DynPropertyRef<T>());
+        }
+        return(DynPropertyRef<T>(prop));
+    }
+
 };
 
 
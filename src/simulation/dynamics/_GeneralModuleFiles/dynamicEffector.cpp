@@ -42,3 +42,12 @@ void DynamicEffector::computeStateContribution(double integTime)
 {
     return;
 }
+
+/*! This method is an optional method by a dynamic effector and is called before the states are integrated from integTime
+    over timeStep by the integrator, which is a nullptr if the step is not integrated in time.  It allows the dynamics
+    effector to account for events within the integration step.  Example - a thruster pulse ending between the
+    integrator stages */
+void DynamicEffector::prepareIntegrationStep(double /*integTime*/, double /*timeStep*/, StateVecIntegrator* /*integrator*/)
+{
+    return;
+}
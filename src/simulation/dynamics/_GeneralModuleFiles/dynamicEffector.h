@@ -24,6 +24,8 @@
 #include "dynParamManager.h"
 #include "utilities/bskLogging.h"
 
+class StateVecIntegrator;
+
 /*! @brief dynamic effector class */
 class DynamicEffector {
 public:
@@ -32,6 +34,7 @@ public:
     virtual void computeStateContribution(double integTime);
     virtual void linkInStates(DynParamManager& states) = 0;  //!< -- Method to get access to other states/stateEffectors
     virtual void computeForceTorque(double integTime) = 0;  //!< -- Method to computeForce and torque on the body
+    virtual void prepareIntegrationStep(double integTime, double timeStep, StateVecIntegrator *integrator);  //!< -- Method called before the states are integrated over a time step
     
 public:
     Eigen::VectorXd stateDerivContribution; //!< -- DynamicEffectors contribution to a stateEffector
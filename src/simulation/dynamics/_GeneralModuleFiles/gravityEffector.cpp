@@ -389,6 +389,15 @@ GravityEffector::GravityEffector()
     this->centralBodyOutMsgId = -1;
     this->inertialPositionPropName = "r_BN_N";
     this->inertialVelocityPropName = "v_BN_N";
+    this->useEnckeMode = false;
+    this->enckeRectificationRatio = 0.01;
+    this->enckeBody = nullptr;
+    this->enckeEpoch = 0.0;
+    this->enckeMeanAnomaly = 0.0;
+    this->enckeMeanMotion = 0.0;
+    this->enckeAnomaly = 0.0;
+    this->enckeP_N.setZero();
+    this->enckeQ_N.setZero();
     return;
 }
 
@@ -603,3 +612,113 @@ void GravityEffector::addGravBody(GravBodyData* gravBody)
     this->gravBodies.push_back(gravBody);
     return;
 }
+
+/*!
+    Set the osculating conic of the Encke mode to the orbit of the current state about the central body.  The
+    integrated deviations are relative to this conic until it is set again.
+    @return bool true if the conic is set, false without a central body or for a parabolic orbit
+    @param r_BP_N [m] position relative to the central body
+    @param v_BP_N [m/s] velocity relative to the central body
+    @param time [s] time of the state
+*/
+bool GravityEffector::setEnckeReference(Eigen::Vector3d r_BP_N, Eigen::Vector3d v_BP_N, double time)
+{
+    double rVec[3];
+    double vVec[3];
+    classicElements elements;
+
+    if (!this->centralBody || this->centralBody->mu <= 0.0) {
+        this->enckeBody = nullptr;
+        return(false);
+    }
+    v3Copy(r_BP_N.data(), rVec);
+    v3Copy(v_BP_N.data(), vVec);
+    rv2elem(this->centralBody->mu, rVec, vVec, &elements);
+    /* the mean anomaly of a near parabolic conic is not well defined, the state is then integrated as is */
+    if (fabs(elements.e - 1.0) < 1.0e-6) {
+        this->enckeBody = nullptr;
+        return(false);
+    }
+
+    this->enckeBody = this->centralBody;
+    this->enckeElements = elements;
+    this->enckeEpoch = time;
+    this->enckeMeanMotion = sqrt(this->centralBody->mu/fabs(elements.a*elements.a*elements.a));
+    if (elements.a > 0.0) {
+        this->enckeAnomaly = f2E(elements.f, elements.e);
+        this->enckeMeanAnomaly = E2M(this->enckeAnomaly, elements.e);
+    } else {
+        this->enckeAnomaly = f2H(elements.f, elements.e);
+        this->enckeMeanAnomaly = H2N(this->enckeAnomaly, elements.e);
+    }
+
+    /* the perifocal axes are the directions of the conic at 0 and 90 deg true anomaly */
+    elements.f = 0.0;
+    elem2rv(this->centralBody->mu, &elements, rVec, vVec);
+    this->enckeP_N = Eigen::Map<Eigen::Vector3d>(rVec).normalized();
+    elements.f = M_PI_2;
+    elem2rv(this->centralBody->mu, &elements, rVec, vVec);
+    this->enckeQ_N = Eigen::Map<Eigen::Vector3d>(rVec).normalized();
+    return(true);
+}
+
+/*!
+    Check that the osculating conic of the Encke mode is set and still about the central body
+    @return bool
+*/
+bool GravityEffector::enckeReferenceValid()
+{
+    return(this->enckeBody != nullptr && this->enckeBody == this->centralBody);
+}
+
+/*!
+    Compute the state and the point mass acceleration on the osculating conic of the Encke mode
+    @return void
+    @param time [s] time at which the conic is evaluated
+    @param r_BP_N [m] conic position relative to the central body
+    @param v_BP_N [m/s] conic velocity relative to the central body
+    @param rDDot_BP_N [m/s^2] point mass gravity of the central body at the conic position
+*/
+void GravityEffector::computeEnckeReference(double time, Eigen::Vector3d &r_BP_N, Eigen::Vector3d &v_BP_N,
+                                            Eigen::Vector3d &rDDot_BP_N)
+{
+    double a = this->enckeElements.a;
+    double e = this->enckeElements.e;
+    double mu = this->enckeBody->mu;
+    double meanAnomaly = this->enckeMeanAnomaly + this->enckeMeanMotion*(time - this->enckeEpoch);
+    double anomaly = this->enckeAnomaly;
+    double delta = 1.0;
+    int count = 0;
+
+    /* Kepler's equation is solved by Newton iterations from the last solution, which is close within a step */
+    if (a > 0.0) {
+        while (fabs(delta) > 1.0e-14*(1.0 + fabs(anomaly)) && ++count < 30) {
+            delta = (anomaly - e*sin(anomaly) - meanAnomaly)/(1.0 - e*cos(anomaly));
+            anomaly -= delta;
+        }
+        if (count >= 30) {
+            anomaly = M2E(meanAnomaly, e);
+        }
+        double rNorm = a*(1.0 - e*cos(anomaly));
+        double b = sqrt(1.0 - e*e);
+        r_BP_N = a*(cos(anomaly) - e)*this->enckeP_N + a*b*sin(anomaly)*this->enckeQ_N;
+        v_BP_N = sqrt(mu*a)/rNorm*(-sin(anomaly)*this->enckeP_N + b*cos(anomaly)*this->enckeQ_N);
+    } else {
+        while (fabs(delta) > 1.0e-14*(1.0 + fabs(anomaly)) && ++count < 30) {
+            delta = (e*sinh(anomaly) - anomaly - meanAnomaly)/(e*cosh(anomaly) - 1.0);
+            anomaly -= delta;
+        }
+        if (count >= 30) {
+            anomaly = N2H(meanAnomaly, e);
+        }
+        double rNorm = -a*(e*cosh(anomaly) - 1.0);
+        double b = sqrt(e*e - 1.0);
+        r_BP_N = -a*(e - cosh(anomaly))*this->enckeP_N - a*b*sinh(anomaly)*this->enckeQ_N;
+        v_BP_N = sqrt(-mu*a)/rNorm*(-sinh(anomaly)*this->enckeP_N + b*cosh(anomaly)*this->enckeQ_N);
+    }
+    this->enckeAnomaly = anomaly;
+    double rNorm = r_BP_N.norm();
+    rDDot_BP_N = -mu/(rNorm*rNorm*rNorm)*r_BP_N;
+
+    return;
+}
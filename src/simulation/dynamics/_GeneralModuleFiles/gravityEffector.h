@@ -28,6 +28,7 @@
 #include <Eigen/Dense>
 #include "simMessages/spicePlanetStateSimMsg.h"
 #include "utilities/bskLogging.h"
+#include "utilities/orbitalMotion.h"
 
 /*! @brief spherical harmonics class */
 class SphericalHarmonics
@@ -125,6 +126,10 @@ public:
     void setGravBodies(std::vector<GravBodyData *> gravBodies); //!< class method
     void addGravBody(GravBodyData* gravBody); //!< class method
     void prependSpacecraftNameToStates(); //!< class method
+    bool setEnckeReference(Eigen::Vector3d r_BP_N, Eigen::Vector3d v_BP_N, double time); //!< class method
+    bool enckeReferenceValid(); //!< class method
+    void computeEnckeReference(double time, Eigen::Vector3d &r_BP_N, Eigen::Vector3d &v_BP_N,
+                               Eigen::Vector3d &rDDot_BP_N); //!< class method
     
 private:
     Eigen::Vector3d getEulerSteppedGravBodyPosition(GravBodyData *bodyData); //!< class method
@@ -138,6 +143,8 @@ public:
     std::string inertialPositionPropName;           //!< [-] Name of the inertial position property
     std::string inertialVelocityPropName;           //!< [-] Name of the inertial velocity property
     std::string nameOfSpacecraftAttachedTo;         //!< [-] Name of the s/c this gravity model is attached to
+    bool useEnckeMode;                              //!< [-] Flag to integrate the deviation from an osculating conic
+    double enckeRectificationRatio;                 //!< [-] Deviation to conic radius ratio at which the conic is reset
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
 private:
@@ -147,6 +154,14 @@ private:
     std::string centralBodyOutMsgName;              //!< [-] Unique name for the central body spice data output message
     Eigen::MatrixXd *inertialPositionProperty;             //!< [m] r_N inertial position relative to system spice zeroBase/refBase coordinate frame, property for output.
     Eigen::MatrixXd *inertialVelocityProperty;             //!< [m/s] v_N inertial velocity relative to system spice zeroBase/refBase coordinate frame, property for output.
+    GravBodyData *enckeBody;                        //!< [-] Body of the osculating conic, nullptr before the first one
+    classicElements enckeElements;                  //!< [-] Elements of the osculating conic at its epoch
+    double enckeEpoch;                              //!< [s] Time of the osculating conic elements
+    double enckeMeanAnomaly;                        //!< [rad] Mean elliptic or hyperbolic anomaly at the epoch
+    double enckeMeanMotion;                         //!< [rad/s] Mean motion of the osculating conic
+    double enckeAnomaly;                            //!< [rad] Last eccentric or hyperbolic anomaly, starts the next solve
+    Eigen::Vector3d enckeP_N;                       //!< [-] Unit vector towards the periapsis of the conic
+    Eigen::Vector3d enckeQ_N;                       //!< [-] Unit vector 90 deg ahead of the periapsis in the orbit plane
 
 };
 
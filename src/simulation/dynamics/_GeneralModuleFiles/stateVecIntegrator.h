@@ -21,6 +21,7 @@
 #ifndef stateVecIntegrator_h
 #define stateVecIntegrator_h
 
+#include <vector>
 
 class DynamicObject;
 
@@ -33,6 +34,10 @@ public:
     virtual ~StateVecIntegrator(void);
     virtual void integrate(double currentTime, double timeStep) = 0; //!< class method
     
+public:
+    std::vector<double> stageTimes;     //!< -- Distinct times of the equations of motion evaluations as fractions of the time step, empty if unknown
+    std::vector<double> stageWeights;   //!< -- Summed weights of the evaluations at each of the stageTimes
+    
 protected:
     DynamicObject* dynPtr; //!< This is an object that contains the method equationsOfMotion(), also known as the F function.
 };
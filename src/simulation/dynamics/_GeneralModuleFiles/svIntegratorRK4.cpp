@@ -24,6 +24,8 @@
 
 svIntegratorRK4::svIntegratorRK4(DynamicObject* dyn) : StateVecIntegrator(dyn)
 {
+    this->stageTimes = {0.0, 0.5, 1.0};
+    this->stageWeights = {1.0/6.0, 2.0/3.0, 1.0/6.0};
     
     return;
 }
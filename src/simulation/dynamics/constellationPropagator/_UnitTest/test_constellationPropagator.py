@@ -0,0 +1,198 @@
+# ISC License
+#
+# Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+from Basilisk.simulation import spacecraftPlus
+from Basilisk.simulation import constellationPropagator
+
+
+def referenceAcceleration(r_N, v_N, useZonalDrag, ballisticCoeff):
+    """Point mass gravity, J2 to J6 from orbitalMotion.jPerturb and exponential atmosphere drag"""
+    mu = orbitalMotion.MU_EARTH * 1e9
+    acc = -mu * r_N / np.linalg.norm(r_N) ** 3
+    if useZonalDrag:
+        acc += np.array(orbitalMotion.jPerturb(r_N / 1000., 6, 'CELESTIAL_EARTH')) * 1000.
+        vRel = v_N - np.cross([0., 0., orbitalMotion.OMEGA_EARTH], r_N)
+        density = 1.217 * np.exp((orbitalMotion.REQ_EARTH * 1000. - np.linalg.norm(r_N)) / 8500.)
+        acc += -0.5 * density * ballisticCoeff * np.linalg.norm(vRel) * vRel
+    return acc
+
+
+def referenceRK4(r_N, v_N, dt, numSteps, useZonalDrag, ballisticCoeff):
+    """RK4 propagation of a single spacecraft with the steps of the simulation"""
+    x = np.concatenate([r_N, v_N])
+    f = lambda x: np.concatenate([x[3:], referenceAcceleration(x[:3], x[3:], useZonalDrag, ballisticCoeff)])
+    for step in range(numSteps):
+        k1 = f(x)
+        k2 = f(x + 0.5 * dt * k1)
+        k3 = f(x + 0.5 * dt * k2)
+        k4 = f(x + dt * k3)
+        x = x + dt / 6. * (k1 + 2. * k2 + 2. * k3 + k4)
+    return x[:3], x[3:]
+
+
+@pytest.mark.parametrize("useZonalDrag", [False, True])
+def test_constellationTranslation(show_plots, useZonalDrag):
+    """
+    Tests whether constellationPropagator:
+        1. Propagates every spacecraft as an RK4 integration of point mass gravity, and of J2 to J6 and drag;
+        2. Only writes state messages for the spacecraft that are given a message name;
+        3. Returns the states of all spacecraft with getPositions and getVelocities.
+    :return:
+    """
+    simTaskName = "simTask"
+    simProcessName = "simProcess"
+    scSim = SimulationBaseClass.SimBaseClass()
+    scSim.TotalSim.terminateSimulation()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    simulationTimeStep = macros.sec2nano(10.)
+    numSteps = 60
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    constellation = constellationPropagator.ConstellationPropagator()
+    constellation.ModelTag = "constellation"
+    constellation.mu = orbitalMotion.MU_EARTH * 1e9
+    constellation.radEquator = orbitalMotion.REQ_EARTH * 1000.
+    if useZonalDrag:
+        constellation.zonalJ = [orbitalMotion.J2_EARTH, orbitalMotion.J3_EARTH, orbitalMotion.J4_EARTH,
+                                orbitalMotion.J5_EARTH, orbitalMotion.J6_EARTH]
+        constellation.baseDensity = 1.217
+        constellation.scaleHeight = 8500.
+        constellation.planetRotationRate = orbitalMotion.OMEGA_EARTH
+
+    # low orbits in different planes, the second spacecraft does not write a state message
+    initialStates = []
+    ballisticCoeffs = [0.01, 0.02, 0.005]
+    for c in range(3):
+        oe = orbitalMotion.ClassicElements()
+        oe.a = (orbitalMotion.REQ_EARTH + 300. + 100. * c) * 1000.
+        oe.e = 0.001 * c
+        oe.i = np.radians(30. + 25. * c)
+        oe.Omega = np.radians(40. * c)
+        oe.omega = np.radians(10.)
+        oe.f = np.radians(70. * c)
+        r_N, v_N = orbitalMotion.elem2rv(orbitalMotion.MU_EARTH * 1e9, oe)
+        initialStates.append((np.array(r_N), np.array(v_N)))
+        msgName = "" if c == 1 else "sc" + str(c) + "_state"
+        idx = constellation.addSpacecraft(np.array(r_N).reshape(3, 1).tolist(), np.array(v_N).reshape(3, 1).tolist(),
+                                          ballisticCoeffs[c], msgName)
+        assert idx == c
+    scSim.AddModelToTask(simTaskName, constellation)
+
+    for c in [0, 2]:
+        scSim.TotalSim.logThisMessage(constellation.getStateOutMsgName(c), simulationTimeStep)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(numSteps * simulationTimeStep)
+    scSim.ExecuteSimulation()
+
+    accuracy = 1e-10
+    testFailCount = 0
+    testMessages = []
+    if constellation.getNumSpacecraft() != 3 or constellation.getStateOutMsgName(1) != "":
+        testFailCount += 1
+        testMessages.append("FAILED: spacecraft count or message names\n")
+    positions = np.array(constellation.getPositions())
+    velocities = np.array(constellation.getVelocities())
+    for c in range(3):
+        rTrue, vTrue = referenceRK4(initialStates[c][0], initialStates[c][1], 10., numSteps, useZonalDrag,
+                                    ballisticCoeffs[c])
+        if not positions[c] == pytest.approx(rTrue, rel=accuracy):
+            testFailCount += 1
+            testMessages.append("FAILED: position of spacecraft " + str(c) + "\n")
+        if not velocities[c] == pytest.approx(vTrue, rel=accuracy):
+            testFailCount += 1
+            testMessages.append("FAILED: velocity of spacecraft " + str(c) + "\n")
+        if c != 1:
+            rMsg = scSim.pullMessageLogData(constellation.getStateOutMsgName(c) + '.r_BN_N', range(3))
+            if len(rMsg) != numSteps + 1 or not rMsg[-1, 1:] == pytest.approx(rTrue, rel=accuracy):
+                testFailCount += 1
+                testMessages.append("FAILED: state message of spacecraft " + str(c) + "\n")
+
+    assert testFailCount < 1, ''.join(testMessages)
+
+
+def test_constellationAttitude(show_plots):
+    """
+    Tests whether the torque free attitude of constellationPropagator matches a spacecraftPlus hub with the same
+    inertia and no gravity, including the MRP switches.
+    :return:
+    """
+    simTaskName = "simTask"
+    simProcessName = "simProcess"
+    scSim = SimulationBaseClass.SimBaseClass()
+    scSim.TotalSim.terminateSimulation()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    simulationTimeStep = macros.sec2nano(0.01)
+    simulationTime = macros.sec2nano(20.)
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    inertia = [[500., 10., 5.], [10., 200., 2.], [5., 2., 300.]]
+    sigmaInit = [[0.1], [-0.2], [0.3]]
+    omegaInit = [[0.5], [-0.4], [0.7]]
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+    scObject.hub.mHub = 100.
+    scObject.hub.r_BcB_B = [[0.0], [0.0], [0.0]]
+    scObject.hub.IHubPntBc_B = inertia
+    scObject.hub.r_CN_NInit = [[7000e3], [0.0], [0.0]]
+    scObject.hub.v_CN_NInit = [[0.0], [7.5e3], [0.0]]
+    scObject.hub.sigma_BNInit = sigmaInit
+    scObject.hub.omega_BN_BInit = omegaInit
+    scSim.AddModelToTask(simTaskName, scObject)
+
+    constellation = constellationPropagator.ConstellationPropagator()
+    constellation.ModelTag = "constellation"
+    constellation.mu = 0.
+    constellation.attitudeEnabled = True
+    idx = constellation.addSpacecraft([[7000e3], [0.0], [0.0]], [[0.0], [7.5e3], [0.0]], 0., "sc_state")
+    constellation.setAttitude(idx, sigmaInit, omegaInit, inertia)
+    scSim.AddModelToTask(simTaskName, constellation)
+
+    scSim.TotalSim.logThisMessage(scObject.scStateOutMsgName, simulationTimeStep)
+    scSim.TotalSim.logThisMessage("sc_state", simulationTimeStep)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(simulationTime)
+    scSim.ExecuteSimulation()
+
+    accuracy = 1e-9
+    testFailCount = 0
+    testMessages = []
+    for field in ['.sigma_BN', '.omega_BN_B', '.r_BN_N']:
+        trueData = scSim.pullMessageLogData(scObject.scStateOutMsgName + field, range(3))
+        testData = scSim.pullMessageLogData("sc_state" + field, range(3))
+        if not testData[:, 1:].flatten() == pytest.approx(trueData[:, 1:].flatten(), rel=accuracy, abs=accuracy):
+            testFailCount += 1
+            testMessages.append("FAILED: " + field + "\n")
+    trueSwitches = scSim.pullMessageLogData(scObject.scStateOutMsgName + '.MRPSwitchCount', range(1))
+    testSwitches = scSim.pullMessageLogData("sc_state.MRPSwitchCount", range(1))
+    if trueSwitches[-1, 1] == 0 or testSwitches[-1, 1] != trueSwitches[-1, 1]:
+        testFailCount += 1
+        testMessages.append("FAILED: MRP switch count\n")
+
+    assert testFailCount < 1, ''.join(testMessages)
+
+
+if __name__ == '__main__':
+    test_constellationTranslation(False, True)
+    test_constellationAttitude(False)
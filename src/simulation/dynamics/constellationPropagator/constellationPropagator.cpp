@@ -0,0 +1,504 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "constellationPropagator.h"
+#include <string.h>
+#include "architecture/messaging/system_messaging.h"
+#include "simFswInterfaceMessages/macroDefinitions.h"
+#include "../_GeneralModuleFiles/svIntegratorRK4.h"
+#include "utilities/avsEigenSupport.h"
+#include "utilities/avsEigenMRP.h"
+#include "utilities/astroConstants.h"
+
+/*! Stack a list of vectors into an N by 3 matrix, one row per vector */
+static Eigen::MatrixXd stackRows(const std::vector<Eigen::Vector3d> &vectors)
+{
+    Eigen::MatrixXd stacked((int) vectors.size(), 3);
+    for(size_t i = 0; i < vectors.size(); i++)
+    {
+        stacked.row(i) = vectors[i].transpose();
+    }
+    return(stacked);
+}
+
+/*! This is the constructor, setting the Earth as central body without zonal harmonics and drag */
+ConstellationPropagator::ConstellationPropagator()
+{
+    this->mu = MU_EARTH*1.0e9;
+    this->radEquator = REQ_EARTH*1.0e3;
+    this->baseDensity = 0.0;
+    this->scaleHeight = 8500.0;
+    this->planetRotationRate = OMEGA_EARTH;
+    this->attitudeEnabled = false;
+    this->numOutMsgBuffers = 2;
+    this->timePrevious = 0.0;
+    this->posState = nullptr;
+    this->velState = nullptr;
+    this->sigmaState = nullptr;
+    this->omegaState = nullptr;
+
+    // - Set integrator as RK4 by default
+    this->integrator = new svIntegratorRK4(this);
+
+    return;
+}
+
+/*! The destructor deletes the integrator */
+ConstellationPropagator::~ConstellationPropagator()
+{
+    delete this->integrator;
+    return;
+}
+
+/*! This method adds a spacecraft to the constellation.  The attitude is at rest and aligned with the N frame unless
+ it is set with setAttitude.
+ @return int index of the spacecraft
+ @param r_BN_NInit [m] initial inertial position
+ @param v_BN_NInit [m/s] initial inertial velocity
+ @param ballisticCoeff [m^2/kg] drag coefficient times the projected area over the mass, zero for no drag
+ @param scStateOutMsgName name of the state message of the spacecraft, empty to not write one
+ */
+int ConstellationPropagator::addSpacecraft(Eigen::Vector3d r_BN_NInit, Eigen::Vector3d v_BN_NInit,
+                                           double ballisticCoeff, std::string scStateOutMsgName)
+{
+    this->r_BN_NInit.push_back(r_BN_NInit);
+    this->v_BN_NInit.push_back(v_BN_NInit);
+    this->sigma_BNInit.push_back(Eigen::Vector3d::Zero());
+    this->omega_BN_BInit.push_back(Eigen::Vector3d::Zero());
+    this->IPntB_B.push_back(Eigen::Matrix3d::Identity());
+    this->ballisticCoeffs.push_back(ballisticCoeff);
+    this->scStateOutMsgNames.push_back(scStateOutMsgName);
+    this->scStateOutMsgIds.push_back(-1);
+    this->MRPSwitchCounts.push_back(0);
+
+    return((int) this->r_BN_NInit.size() - 1);
+}
+
+/*! This method sets the initial attitude and the inertia of a spacecraft, used if attitudeEnabled is set
+ @return void
+ @param scIndex index of the spacecraft
+ @param sigma_BNInit initial attitude MRP
+ @param omega_BN_BInit [rad/s] initial angular velocity in body frame components
+ @param IPntB_B [kg m^2] inertia about the center of mass in body frame components
+ */
+void ConstellationPropagator::setAttitude(int scIndex, Eigen::Vector3d sigma_BNInit, Eigen::Vector3d omega_BN_BInit,
+                                          Eigen::Matrix3d IPntB_B)
+{
+    if (!this->checkIndex(scIndex)) {
+        return;
+    }
+    this->sigma_BNInit[scIndex] = sigma_BNInit;
+    this->omega_BN_BInit[scIndex] = omega_BN_BInit;
+    this->IPntB_B[scIndex] = IPntB_B;
+
+    return;
+}
+
+/*! This method checks a spacecraft index
+ @return bool true if the index is valid
+ @param scIndex index of the spacecraft
+ */
+bool ConstellationPropagator::checkIndex(int scIndex)
+{
+    if (scIndex < 0 || scIndex >= this->getNumSpacecraft()) {
+        bskLogger.bskLog(BSK_ERROR, "ConstellationPropagator: spacecraft index %d is out of range, there are %d "
+                         "spacecraft.", scIndex, this->getNumSpacecraft());
+        return(false);
+    }
+    return(true);
+}
+
+/*! This method returns the state message name of a spacecraft
+ @return std::string message name, empty if the spacecraft does not write one
+ @param scIndex index of the spacecraft
+ */
+std::string ConstellationPropagator::getStateOutMsgName(int scIndex)
+{
+    if (!this->checkIndex(scIndex)) {
+        return("");
+    }
+    return(this->scStateOutMsgNames[scIndex]);
+}
+
+/*! This method creates the state messages of the spacecraft that have a message name
+ @return void
+ */
+void ConstellationPropagator::SelfInit()
+{
+    for(size_t i = 0; i < this->scStateOutMsgNames.size(); i++)
+    {
+        this->scStateOutMsgIds[i] = -1;
+        if (this->scStateOutMsgNames[i].length() > 0) {
+            this->scStateOutMsgIds[i] = SystemMessaging::GetInstance()->CreateNewMessage(
+                this->scStateOutMsgNames[i], sizeof(SCPlusStatesSimMsg), this->numOutMsgBuffers,
+                "SCPlusStatesSimMsg", this->moduleID);
+        }
+    }
+
+    return;
+}
+
+/*! This method initializes the dynamics, there are no input messages to subscribe to
+ @return void
+ */
+void ConstellationPropagator::CrossInit()
+{
+    this->initializeDynamics();
+
+    return;
+}
+
+/*! This method registers the constellation states with the dynamics manager and sets their initial values
+ @return void
+ */
+void ConstellationPropagator::initializeDynamics()
+{
+    int numSc = this->getNumSpacecraft();
+    if (this->zonalJ.size() > 5) {
+        bskLogger.bskLog(BSK_WARNING, "ConstellationPropagator: only the zonal harmonics up to J6 are used.");
+    }
+
+    // - Register the translational states, one row per spacecraft and one column per axis
+    this->posState = this->dynManager.registerState(numSc, 3, "constellationPosition");
+    this->velState = this->dynManager.registerState(numSc, 3, "constellationVelocity");
+    this->posState->setState(stackRows(this->r_BN_NInit));
+    this->velState->setState(stackRows(this->v_BN_NInit));
+    if (this->attitudeEnabled) {
+        this->sigmaState = this->dynManager.registerState(numSc, 3, "constellationSigma");
+        this->omegaState = this->dynManager.registerState(numSc, 3, "constellationOmega");
+        this->sigmaState->setState(stackRows(this->sigma_BNInit));
+        this->omegaState->setState(stackRows(this->omega_BN_BInit));
+    }
+
+    // - Spacecraft parameters as columns
+    this->ballisticArray = Eigen::Map<Eigen::ArrayXd>(this->ballisticCoeffs.data(), numSc);
+    this->inertiaArray.resize(numSc, 9);
+    this->inertiaInvArray.resize(numSc, 9);
+    for(int i = 0; i < numSc; i++)
+    {
+        Eigen::Matrix3d IInv = this->IPntB_B[i].inverse();
+        for(int j = 0; j < 3; j++)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                this->inertiaArray(i, 3*j+k) = this->IPntB_B[i](j, k);
+                this->inertiaInvArray(i, 3*j+k) = IInv(j, k);
+            }
+        }
+        this->MRPSwitchCounts[i] = 0;
+    }
+
+    return;
+}
+
+/*! This method computes the gravitational acceleration of all spacecraft.  The zonal terms follow jPerturb() of
+ orbitalMotion, evaluated for all spacecraft per coefficient.
+ @return void
+ @param r_N [m] N by 3 inertial positions
+ @param acc_N [m/s^2] N by 3 accelerations, overwritten
+ */
+void ConstellationPropagator::computeGravity(const Eigen::MatrixXd &r_N, Eigen::MatrixXd &acc_N)
+{
+    this->rInv = (r_N.col(0).array().square() + r_N.col(1).array().square()
+                  + r_N.col(2).array().square()).sqrt().inverse();
+    this->radialScale = -this->mu*this->rInv.cube();
+    for(int k = 0; k < 3; k++)
+    {
+        acc_N.col(k).array() = this->radialScale*r_N.col(k).array();
+    }
+    if (this->zonalJ.empty()) {
+        return;
+    }
+
+    // - radialScale holds mu/r^2 (req/r)^n, the x and y terms scale with planarScale and the z term is polarTerm
+    this->zHat = r_N.col(2).array()*this->rInv;
+    this->zHat2 = this->zHat.square();
+    this->radialScale = this->mu*this->rInv.square()*(this->radEquator*this->rInv).square();
+    this->planarScale.setZero(this->rInv.size());
+    this->polarTerm.setZero(this->rInv.size());
+    const Eigen::ArrayXd &u = this->zHat;
+    const Eigen::ArrayXd &u2 = this->zHat2;
+    for(size_t n = 2; n < this->zonalJ.size() + 2 && n <= 6; n++)
+    {
+        if (n > 2) {
+            this->radialScale *= this->radEquator*this->rInv;
+        }
+        double Jn = this->zonalJ[n-2];
+        switch (n) {
+            case 2:
+                this->planarScale += -1.5*Jn*this->radialScale*(1.0 - 5.0*u2)*this->rInv;
+                this->polarTerm += -1.5*Jn*this->radialScale*(3.0 - 5.0*u2)*u;
+                break;
+            case 3:
+                this->planarScale += 0.5*Jn*this->radialScale*5.0*u*(7.0*u2 - 3.0)*this->rInv;
+                this->polarTerm += 0.5*Jn*this->radialScale*(-3.0)*(10.0*u2 - 35.0/3.0*u2.square() - 1.0);
+                break;
+            case 4:
+                this->planarScale += 5.0/8.0*Jn*this->radialScale*(3.0 - 42.0*u2 + 63.0*u2.square())*this->rInv;
+                this->polarTerm += 5.0/8.0*Jn*this->radialScale*(15.0 - 70.0*u2 + 63.0*u2.square())*u;
+                break;
+            case 5:
+                this->planarScale += 1.0/8.0*Jn*this->radialScale*3.0*u*(35.0 - 210.0*u2 + 231.0*u2.square())
+                    *this->rInv;
+                this->polarTerm += -1.0/8.0*Jn*this->radialScale*(15.0 - 315.0*u2 + 945.0*u2.square()
+                    - 693.0*u2.cube());
+                break;
+            default:
+                this->planarScale += -1.0/16.0*Jn*this->radialScale*(35.0 - 945.0*u2 + 3465.0*u2.square()
+                    - 3003.0*u2.cube())*this->rInv;
+                this->polarTerm += 1.0/16.0*Jn*this->radialScale*(3003.0*u2.cube() - 4851.0*u2.square()
+                    + 2205.0*u2 - 245.0)*u;
+                break;
+        }
+    }
+    acc_N.col(0).array() += this->planarScale*r_N.col(0).array();
+    acc_N.col(1).array() += this->planarScale*r_N.col(1).array();
+    acc_N.col(2).array() += this->polarTerm;
+
+    return;
+}
+
+/*! This method adds the cannonball drag of an exponential atmosphere that rotates with the central body.  It uses the
+ inverse radii computed by computeGravity.
+ @return void
+ @param r_N [m] N by 3 inertial positions
+ @param v_N [m/s] N by 3 inertial velocities
+ @param acc_N [m/s^2] N by 3 accelerations, the drag is added
+ */
+void ConstellationPropagator::computeDrag(const Eigen::MatrixXd &r_N, const Eigen::MatrixXd &v_N,
+                                          Eigen::MatrixXd &acc_N)
+{
+    if (this->baseDensity <= 0.0) {
+        return;
+    }
+    this->vRel.resize(r_N.rows(), 3);
+    this->vRel.col(0) = v_N.col(0).array() + this->planetRotationRate*r_N.col(1).array();
+    this->vRel.col(1) = v_N.col(1).array() - this->planetRotationRate*r_N.col(0).array();
+    this->vRel.col(2) = v_N.col(2).array();
+    this->radialScale = -0.5*this->baseDensity*((this->radEquator - this->rInv.inverse())/this->scaleHeight).exp()
+        *this->ballisticArray*this->vRel.square().rowwise().sum().sqrt();
+    for(int k = 0; k < 3; k++)
+    {
+        acc_N.col(k).array() += this->radialScale*this->vRel.col(k);
+    }
+
+    return;
+}
+
+/*! This method computes the MRP rates and the torque free angular accelerations of all spacecraft
+ @return void
+ @param sigma_BN N by 3 attitudes
+ @param omega_BN_B [rad/s] N by 3 angular velocities
+ @param sigmaDot_BN [1/s] N by 3 MRP rates, overwritten
+ @param omegaDot_BN_B [rad/s^2] N by 3 angular accelerations, overwritten
+ */
+void ConstellationPropagator::computeAttitudeRates(const Eigen::MatrixXd &sigma_BN, const Eigen::MatrixXd &omega_BN_B,
+                                                   Eigen::MatrixXd &sigmaDot_BN, Eigen::MatrixXd &omegaDot_BN_B)
+{
+    auto s0 = sigma_BN.col(0).array();
+    auto s1 = sigma_BN.col(1).array();
+    auto s2 = sigma_BN.col(2).array();
+    auto w0 = omega_BN_B.col(0).array();
+    auto w1 = omega_BN_B.col(1).array();
+    auto w2 = omega_BN_B.col(2).array();
+
+    // - sigmaDot = 1/4 [(1 - sigma^2) omega + 2 sigma x omega + 2 (sigma . omega) sigma]
+    this->radialScale = 1.0 - s0.square() - s1.square() - s2.square();
+    this->planarScale = 2.0*(s0*w0 + s1*w1 + s2*w2);
+    sigmaDot_BN.col(0).array() = 0.25*(this->radialScale*w0 + 2.0*(s1*w2 - s2*w1) + this->planarScale*s0);
+    sigmaDot_BN.col(1).array() = 0.25*(this->radialScale*w1 + 2.0*(s2*w0 - s0*w2) + this->planarScale*s1);
+    sigmaDot_BN.col(2).array() = 0.25*(this->radialScale*w2 + 2.0*(s0*w1 - s1*w0) + this->planarScale*s2);
+
+    // - omegaDot = I^-1 (I omega x omega)
+    this->hVec.resize(sigma_BN.rows(), 3);
+    this->gyroTorque.resize(sigma_BN.rows(), 3);
+    for(int j = 0; j < 3; j++)
+    {
+        this->hVec.col(j) = this->inertiaArray.col(3*j)*w0 + this->inertiaArray.col(3*j+1)*w1
+            + this->inertiaArray.col(3*j+2)*w2;
+    }
+    this->gyroTorque.col(0) = this->hVec.col(1)*w2 - this->hVec.col(2)*w1;
+    this->gyroTorque.col(1) = this->hVec.col(2)*w0 - this->hVec.col(0)*w2;
+    this->gyroTorque.col(2) = this->hVec.col(0)*w1 - this->hVec.col(1)*w0;
+    for(int j = 0; j < 3; j++)
+    {
+        omegaDot_BN_B.col(j).array() = this->inertiaInvArray.col(3*j)*this->gyroTorque.col(0)
+            + this->inertiaInvArray.col(3*j+1)*this->gyroTorque.col(1)
+            + this->inertiaInvArray.col(3*j+2)*this->gyroTorque.col(2);
+    }
+
+    return;
+}
+
+/*! This method computes the state derivatives of all spacecraft
+ @return void
+ @param integTimeSeconds [s] time of the evaluation
+ */
+void ConstellationPropagator::equationsOfMotion(double integTimeSeconds)
+{
+    this->posState->stateDeriv = this->velState->state;
+    this->computeGravity(this->posState->state, this->velState->stateDeriv);
+    this->computeDrag(this->posState->state, this->velState->state, this->velState->stateDeriv);
+    if (this->attitudeEnabled) {
+        this->computeAttitudeRates(this->sigmaState->state, this->omegaState->state, this->sigmaState->stateDeriv,
+                                   this->omegaState->stateDeriv);
+    }
+
+    return;
+}
+
+/*! This method integrates all spacecraft states to the given time and switches the MRPs to the short rotation
+ @return void
+ @param integrateToThisTime [s] time to integrate to
+ */
+void ConstellationPropagator::integrateState(double integrateToThisTime)
+{
+    double localTimeStep = integrateToThisTime - this->timePrevious;
+    this->integrator->integrate(this->timePrevious, localTimeStep);
+    this->timePrevious = integrateToThisTime;
+
+    if (this->attitudeEnabled) {
+        Eigen::MatrixXd &sigma_BN = this->sigmaState->state;
+        for(int i = 0; i < sigma_BN.rows(); i++)
+        {
+            double sigmaSquared = sigma_BN.row(i).squaredNorm();
+            if (sigmaSquared > 1.0) {
+                sigma_BN.row(i) /= -sigmaSquared;
+                this->MRPSwitchCounts[i]++;
+            }
+        }
+    }
+
+    return;
+}
+
+/*! This method computes the drag acceleration of a single spacecraft for its state message
+ @return Eigen::Vector3d [m/s^2] drag acceleration in N frame components
+ @param scIndex index of the spacecraft
+ */
+Eigen::Vector3d ConstellationPropagator::dragAcceleration(int scIndex)
+{
+    Eigen::Vector3d r_N = this->posState->state.row(scIndex).transpose();
+    Eigen::Vector3d v_N = this->velState->state.row(scIndex).transpose();
+    if (this->baseDensity <= 0.0) {
+        return(Eigen::Vector3d::Zero());
+    }
+    Eigen::Vector3d vRel_N = v_N - Eigen::Vector3d(0.0, 0.0, this->planetRotationRate).cross(r_N);
+    double density = this->baseDensity*exp((this->radEquator - r_N.norm())/this->scaleHeight);
+    return(-0.5*density*this->ballisticCoeffs[scIndex]*vRel_N.norm()*vRel_N);
+}
+
+/*! This method writes the state messages of the spacecraft that have a message name.  The accumulated delta-v
+ fields are not tracked and are zero.
+ @return void
+ @param clockTime [ns] time stamp of the messages
+ */
+void ConstellationPropagator::writeOutputStateMessages(uint64_t clockTime)
+{
+    for(size_t i = 0; i < this->scStateOutMsgIds.size(); i++)
+    {
+        if (this->scStateOutMsgIds[i] < 0) {
+            continue;
+        }
+        SCPlusStatesSimMsg stateOut;
+        memset(&stateOut, 0x0, sizeof(SCPlusStatesSimMsg));
+        Eigen::Vector3d r_BN_N = this->posState->state.row(i).transpose();
+        Eigen::Vector3d v_BN_N = this->velState->state.row(i).transpose();
+        Eigen::Matrix3d dcm_BN = Eigen::Matrix3d::Identity();
+        eigenVector3d2CArray(r_BN_N, stateOut.r_BN_N);
+        eigenVector3d2CArray(v_BN_N, stateOut.v_BN_N);
+        eigenVector3d2CArray(r_BN_N, stateOut.r_CN_N);
+        eigenVector3d2CArray(v_BN_N, stateOut.v_CN_N);
+        if (this->attitudeEnabled) {
+            Eigen::Vector3d sigma_BN = this->sigmaState->state.row(i).transpose();
+            Eigen::Vector3d omega_BN_B = this->omegaState->state.row(i).transpose();
+            Eigen::Vector3d omegaDot_BN_B = this->IPntB_B[i].inverse()
+                *(this->IPntB_B[i]*omega_BN_B).cross(omega_BN_B);
+            Eigen::MRPd sigmaLocal_BN;
+            sigmaLocal_BN = sigma_BN;
+            dcm_BN = sigmaLocal_BN.toRotationMatrix().transpose();
+            eigenVector3d2CArray(sigma_BN, stateOut.sigma_BN);
+            eigenVector3d2CArray(omega_BN_B, stateOut.omega_BN_B);
+            eigenVector3d2CArray(omegaDot_BN_B, stateOut.omegaDot_BN_B);
+        }
+        Eigen::Vector3d nonConservativeAccelpntB_B = dcm_BN*this->dragAcceleration((int) i);
+        eigenVector3d2CArray(nonConservativeAccelpntB_B, stateOut.nonConservativeAccelpntB_B);
+        stateOut.MRPSwitchCount = this->MRPSwitchCounts[i];
+        SystemMessaging::GetInstance()->WriteMessage(this->scStateOutMsgIds[i], clockTime, sizeof(SCPlusStatesSimMsg),
+                                                     reinterpret_cast<uint8_t*> (&stateOut), this->moduleID);
+    }
+
+    return;
+}
+
+/*! This method integrates the constellation to the current time and writes the state messages
+ @return void
+ @param CurrentSimNanos [ns] current simulation time
+ */
+void ConstellationPropagator::UpdateState(uint64_t CurrentSimNanos)
+{
+    this->integrateState(CurrentSimNanos*NANO2SEC);
+    this->writeOutputStateMessages(CurrentSimNanos);
+
+    return;
+}
+
+/*! This method returns the inertial positions, the initial positions before the simulation is initialized
+ @return Eigen::MatrixXd [m] N by 3 positions, one row per spacecraft
+ */
+Eigen::MatrixXd ConstellationPropagator::getPositions()
+{
+    if (this->posState == nullptr) {
+        return(stackRows(this->r_BN_NInit));
+    }
+    return(this->posState->state);
+}
+
+/*! This method returns the inertial velocities, the initial velocities before the simulation is initialized
+ @return Eigen::MatrixXd [m/s] N by 3 velocities, one row per spacecraft
+ */
+Eigen::MatrixXd ConstellationPropagator::getVelocities()
+{
+    if (this->velState == nullptr) {
+        return(stackRows(this->v_BN_NInit));
+    }
+    return(this->velState->state);
+}
+
+/*! This method returns the attitudes, the initial attitudes if the attitude is not propagated
+ @return Eigen::MatrixXd N by 3 MRPs, one row per spacecraft
+ */
+Eigen::MatrixXd ConstellationPropagator::getAttitudes()
+{
+    if (this->sigmaState == nullptr) {
+        return(stackRows(this->sigma_BNInit));
+    }
+    return(this->sigmaState->state);
+}
+
+/*! This method returns the angular velocities, the initial angular velocities if the attitude is not propagated
+ @return Eigen::MatrixXd [rad/s] N by 3 angular velocities in body frame components, one row per spacecraft
+ */
+Eigen::MatrixXd ConstellationPropagator::getAngularVelocities()
+{
+    if (this->omegaState == nullptr) {
+        return(stackRows(this->omega_BN_BInit));
+    }
+    return(this->omegaState->state);
+}
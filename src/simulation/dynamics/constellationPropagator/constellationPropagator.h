@@ -0,0 +1,113 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef CONSTELLATION_PROPAGATOR_H
+#define CONSTELLATION_PROPAGATOR_H
+
+#include <vector>
+#include <stdint.h>
+#include <Eigen/Dense>
+#include "../_GeneralModuleFiles/dynamicObject.h"
+#include "../_GeneralModuleFiles/stateData.h"
+#include "_GeneralModuleFiles/sys_model.h"
+#include "simMessages/scPlusStatesSimMsg.h"
+#include "utilities/bskLogging.h"
+
+/*! @brief Propagates a constellation of point mass spacecraft about a single central body.
+
+ The positions and velocities of all spacecraft are stored as two N by 3 states, one column per axis, and integrated
+ together in one call of the integrator.  The gravity of the central body, with optional zonal harmonics up to J6, and
+ the cannonball drag of an exponential atmosphere are evaluated for all spacecraft at once with array expressions
+ over these columns.  The torque free attitude of every spacecraft can be propagated as well.  State messages are
+ only written for the spacecraft that are given a message name.
+ */
+class ConstellationPropagator : public DynamicObject {
+public:
+    double mu;                          //!< [m^3/s^2] gravitational parameter of the central body
+    double radEquator;                  //!< [m] equatorial radius of the central body
+    std::vector<double> zonalJ;         //!< -- zonal harmonic coefficients J2, J3, ... up to J6, empty for two-body gravity
+    double baseDensity;                 //!< [kg/m^3] atmosphere density at zero altitude, zero turns drag off
+    double scaleHeight;                 //!< [m] exponential atmosphere scale height
+    double planetRotationRate;          //!< [rad/s] rotation rate of the atmosphere about the third N frame axis
+    bool attitudeEnabled;               //!< -- if true the torque free attitude of every spacecraft is propagated
+    uint64_t numOutMsgBuffers;          //!< -- number of output message buffers for I/O
+    double timePrevious;                //!< [s] time of the last integration
+    BSKLogger bskLogger;                //!< -- BSK Logging
+
+public:
+    ConstellationPropagator();
+    ~ConstellationPropagator();
+    void SelfInit();
+    void CrossInit();
+    void UpdateState(uint64_t CurrentSimNanos);
+    void initializeDynamics();
+    void equationsOfMotion(double integTimeSeconds);
+    void integrateState(double integrateToThisTime);
+    void writeOutputStateMessages(uint64_t clockTime);
+    int addSpacecraft(Eigen::Vector3d r_BN_NInit, Eigen::Vector3d v_BN_NInit, double ballisticCoeff = 0.0,
+                      std::string scStateOutMsgName = "");
+    void setAttitude(int scIndex, Eigen::Vector3d sigma_BNInit, Eigen::Vector3d omega_BN_BInit,
+                     Eigen::Matrix3d IPntB_B);
+    int getNumSpacecraft() {return((int) this->r_BN_NInit.size());}  //!< -- number of spacecraft
+    std::string getStateOutMsgName(int scIndex);
+    Eigen::MatrixXd getPositions();
+    Eigen::MatrixXd getVelocities();
+    Eigen::MatrixXd getAttitudes();
+    Eigen::MatrixXd getAngularVelocities();
+
+private:
+    void computeGravity(const Eigen::MatrixXd &r_N, Eigen::MatrixXd &acc_N);
+    void computeDrag(const Eigen::MatrixXd &r_N, const Eigen::MatrixXd &v_N, Eigen::MatrixXd &acc_N);
+    void computeAttitudeRates(const Eigen::MatrixXd &sigma_BN, const Eigen::MatrixXd &omega_BN_B,
+                              Eigen::MatrixXd &sigmaDot_BN, Eigen::MatrixXd &omegaDot_BN_B);
+    Eigen::Vector3d dragAcceleration(int scIndex);
+    bool checkIndex(int scIndex);
+
+private:
+    std::vector<Eigen::Vector3d> r_BN_NInit;    //!< [m] initial position of each spacecraft
+    std::vector<Eigen::Vector3d> v_BN_NInit;    //!< [m/s] initial velocity of each spacecraft
+    std::vector<Eigen::Vector3d> sigma_BNInit;  //!< -- initial attitude of each spacecraft
+    std::vector<Eigen::Vector3d> omega_BN_BInit;    //!< [rad/s] initial angular velocity of each spacecraft
+    std::vector<Eigen::Matrix3d> IPntB_B;       //!< [kg m^2] inertia of each spacecraft
+    std::vector<double> ballisticCoeffs;        //!< [m^2/kg] drag coefficient times area over mass of each spacecraft
+    std::vector<std::string> scStateOutMsgNames;    //!< -- state message name of each spacecraft, empty for none
+    std::vector<int64_t> scStateOutMsgIds;      //!< -- state message ID of each spacecraft, -1 for none
+    std::vector<uint64_t> MRPSwitchCounts;      //!< -- number of MRP switches of each spacecraft
+
+    StateData *posState;                        //!< -- N by 3 state of the inertial positions
+    StateData *velState;                        //!< -- N by 3 state of the inertial velocities
+    StateData *sigmaState;                      //!< -- N by 3 state of the attitudes, if enabled
+    StateData *omegaState;                      //!< -- N by 3 state of the angular velocities, if enabled
+
+    Eigen::ArrayXd ballisticArray;              //!< [m^2/kg] ballistic coefficients as one column
+    Eigen::ArrayXXd inertiaArray;               //!< [kg m^2] row major inertia of each spacecraft, N by 9
+    Eigen::ArrayXXd inertiaInvArray;            //!< [1/(kg m^2)] row major inverse inertia of each spacecraft, N by 9
+    Eigen::ArrayXd rInv;                        //!< [1/m] inverse orbit radii, evaluation workspace
+    Eigen::ArrayXd zHat;                        //!< -- z over r, evaluation workspace
+    Eigen::ArrayXd zHat2;                       //!< -- square of z over r, evaluation workspace
+    Eigen::ArrayXd radialScale;                 //!< [m/s^2] gravity term common to all axes, evaluation workspace
+    Eigen::ArrayXd planarScale;                 //!< [1/s^2] zonal term of the first two axes, evaluation workspace
+    Eigen::ArrayXd polarTerm;                   //!< [m/s^2] zonal term of the third axis, evaluation workspace
+    Eigen::ArrayXXd vRel;                       //!< [m/s] velocity relative to the atmosphere, evaluation workspace
+    Eigen::ArrayXXd hVec;                       //!< [kg m^2/s] angular momenta, evaluation workspace
+    Eigen::ArrayXXd gyroTorque;                 //!< [N m] gyroscopic torques, evaluation workspace
+};
+
+
+#endif /* CONSTELLATION_PROPAGATOR_H */
@@ -60,7 +60,7 @@ void ReactionWheelStateEffector::linkInStates(DynParamManager& statesIn)
 	this->hubSigma = statesIn.getStateObject("hubSigma");
 	this->hubOmega = statesIn.getStateObject("hubOmega");
 	this->hubVelocity = statesIn.getStateObject("hubVelocity");
-    this->g_N = statesIn.getPropertyReference("g_N");
+    this->g_N = statesIn.getTypedPropertyReference<Eigen::Vector3d>("g_N");
 
 	return;
 }
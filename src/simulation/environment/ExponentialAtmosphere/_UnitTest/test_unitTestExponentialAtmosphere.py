@@ -252,6 +252,81 @@ def run(show_plots, useDefault, useMinReach, useMaxReach, usePlanetEphemeris):
     return [testFailCount, ''.join(testMessages)]
 
 
+def test_manySpacecraft(show_plots):
+    """Batch evaluation of the atmosphere for a large number of spacecraft"""
+    [testResults, testMessage] = runManySpacecraft(show_plots)
+    assert testResults < 1, testMessage
+
+
+def runManySpacecraft(show_plots):
+    testFailCount = 0                       # zero unit test result counter
+    testMessages = []                       # create empty array to store test log messages
+    unitTaskName = "unitTask"               # arbitrary name (don't change)
+    unitProcessName = "TestProcess"         # arbitrary name (don't change)
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProcessRate = macros.sec2nano(0.5)     # update process rate update time
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    testModule = exponentialAtmosphere.ExponentialAtmosphere()
+    testModule.ModelTag = "exponential"
+    simSetPlanetEnvironment.exponentialAtmosphere(testModule, "earth")
+    maxReach = 900*1000.0     # meters
+    testModule.envMaxReach = maxReach
+    unitTestSim.AddModelToTask(unitTaskName, testModule)
+
+    # spread the spacecraft between 100 km and 1100 km altitude such that some are outside of the max reach
+    numSc = 50
+    mu = 0.3986004415E+15  # meters^3/s^2
+    oe = orbitalMotion.ClassicElements()
+    oe.e = 0.0
+    oe.i = 45.0 * macros.D2R
+    oe.Omega = 30.0 * macros.D2R
+    oe.omega = 120.0 * macros.D2R
+    altList = []
+    for c in range(numSc):
+        scStateMsgName = "sc" + str(c) + "_state"
+        testModule.addSpacecraftToModel(scStateMsgName)
+        alt = 100.0 * 1000.0 + c * 20.0 * 1000.0
+        altList.append(alt)
+        oe.a = testModule.planetRadius + alt
+        oe.f = c * 7.0 * macros.D2R
+        rN, vN = orbitalMotion.elem2rv(mu, oe)
+        scStateMsg = simMessages.SCPlusStatesSimMsg()
+        scStateMsg.r_BN_N = rN
+        unitTestSupport.setMessage(unitTestSim.TotalSim,
+                                   unitProcessName,
+                                   scStateMsgName,
+                                   scStateMsg)
+        unitTestSim.TotalSim.logThisMessage("exponential_" + str(c) + "_data", testProcessRate)
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(1.0))
+    unitTestSim.ExecuteSimulation()
+
+    accuracy = 1e-5
+    for c in range(numSc):
+        densData = unitTestSim.pullMessageLogData("exponential_" + str(c) + "_data.neutralDensity")
+        trueDensity = testModule.baseDensity * math.exp(-altList[c]/testModule.scaleHeight)
+        if altList[c] > maxReach:
+            trueDensity = 0.0
+            testFailCount, testMessages = unitTestSupport.compareDoubleArray(
+                [trueDensity] * 3, densData, accuracy, "density sc" + str(c),
+                testFailCount, testMessages)
+        else:
+            testFailCount, testMessages = unitTestSupport.compareDoubleArrayRelative(
+                [trueDensity] * 3, densData, accuracy, "density sc" + str(c),
+                testFailCount, testMessages)
+
+    if testFailCount == 0:
+        print("PASSED: " + testModule.ModelTag + " many spacecraft")
+    else:
+        print("Failed: " + testModule.ModelTag + " many spacecraft")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
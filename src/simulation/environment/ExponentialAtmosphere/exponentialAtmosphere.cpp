@@ -54,3 +54,23 @@ void ExponentialAtmosphere::evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double
 
     return;
 }
+
+/*! This method evaluates the exponential atmosphere model for all spacecraft at once.  The densities are computed
+ as a single vectorized expression over the spacecraft altitudes.
+ @param msgs vector of atmosphere output messages, one per spacecraft
+ @param currentTime current time (s)
+ @return void
+ */
+void ExponentialAtmosphere::evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime)
+{
+    Eigen::ArrayXd densities = this->baseDensity * (-this->orbitAltitudeBatch.array() / this->scaleHeight).exp();
+
+    for (uint64_t c = 0; c < msgs.size(); c++) {
+        if (this->inReachBatch[c]) {
+            msgs[c].neutralDensity = densities[c];
+            msgs[c].localTemp = this->localTemp;
+        }
+    }
+
+    return;
+}
@@ -39,6 +39,7 @@ public:
 
 private:
     void evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double currentTime);
+    void evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime);
 
 
 public:
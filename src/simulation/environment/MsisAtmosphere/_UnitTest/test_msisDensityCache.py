@@ -0,0 +1,147 @@
+'''
+ ISC License
+
+ Copyright (c) 2016-2017, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+'''
+#
+# Basilisk Integrated Test
+#
+# Purpose:  Compare the cached NRLMSISE-00 density interpolation against exact evaluations
+#           for a set of LEO spacecraft, and report the run time of both approaches.
+#
+
+import time
+import numpy as np
+import pytest
+
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import unitTestSupport
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+from Basilisk.simulation import msisAtmosphere
+from Basilisk.simulation import spacecraftPlus
+from Basilisk.utilities import simIncludeGravBody
+
+
+@pytest.mark.parametrize("cacheTolerance", [5e-3, 1e-2])
+def test_msisDensityCache(show_plots, cacheTolerance):
+    '''This function is called by the py.test environment.'''
+    [testResults, testMessage] = run(show_plots, cacheTolerance)
+    assert testResults < 1, testMessage
+
+
+def runCase(useCache, cacheTolerance, numSc, simTime):
+    simTaskName = "simTask"
+    simProcessName = "simProcess"
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    simulationTimeStep = macros.sec2nano(10.)
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    newAtmo = msisAtmosphere.MsisAtmosphere()
+    newAtmo.ModelTag = "MsisAtmo"
+    newAtmo.epochDoy = 100
+    newAtmo.useDensityCache = useCache
+    newAtmo.cacheTolerance = cacheTolerance
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    planet = gravFactory.createEarth()
+    planet.isCentralBody = True
+    mu = planet.mu
+
+    # spread the spacecraft over LEO drag altitudes and inclinations
+    scList = []
+    for c in range(numSc):
+        scObject = spacecraftPlus.SpacecraftPlus()
+        scObject.ModelTag = "spacecraftBody" + str(c)
+        scObject.scStateOutMsgName = "inertial_state_output" + str(c)
+        scObject.gravField.gravBodies = spacecraftPlus.GravBodyVector(list(gravFactory.gravBodies.values()))
+        oe = orbitalMotion.ClassicElements()
+        oe.a = planet.radEquator + (250.0 + 30.0 * c) * 1000.0
+        oe.e = 0.001
+        oe.i = (10.0 + 17.0 * c) * macros.D2R
+        oe.Omega = 25.0 * c * macros.D2R
+        oe.omega = 0.0
+        oe.f = 40.0 * c * macros.D2R
+        rN, vN = orbitalMotion.elem2rv(mu, oe)
+        scObject.hub.r_CN_NInit = rN
+        scObject.hub.v_CN_NInit = vN
+        scSim.AddModelToTask(simTaskName, scObject)
+        newAtmo.addSpacecraftToModel(scObject.scStateOutMsgName)
+        scList.append(scObject)
+    scSim.AddModelToTask(simTaskName, newAtmo)
+
+    sw_msg_names = [
+        "ap_24_0", "ap_3_0", "ap_3_-3", "ap_3_-6", "ap_3_-9",
+        "ap_3_-12", "ap_3_-15", "ap_3_-18", "ap_3_-21", "ap_3_-24",
+        "ap_3_-27", "ap_3_-30", "ap_3_-33", "ap_3_-36", "ap_3_-39",
+        "ap_3_-42", "ap_3_-45", "ap_3_-48", "ap_3_-51", "ap_3_-54",
+        "ap_3_-57", "f107_1944_0", "f107_24_-24"
+    ]
+    for swName in sw_msg_names:
+        msgData = msisAtmosphere.SwDataSimMsg()
+        msgData.dataValue = 4.0
+        if swName.startswith("f107"):
+            msgData.dataValue = 150.0
+        unitTestSupport.setMessage(scSim.TotalSim, simProcessName, swName, msgData)
+
+    for msgName in newAtmo.envOutMsgNames:
+        scSim.TotalSim.logThisMessage(msgName, simulationTimeStep)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(simTime))
+    startTime = time.time()
+    scSim.ExecuteSimulation()
+    runTime = time.time() - startTime
+
+    densData = []
+    for msgName in newAtmo.envOutMsgNames:
+        densData.append(scSim.pullMessageLogData(msgName + '.neutralDensity')[:, 1])
+
+    return np.array(densData), runTime
+
+
+def run(show_plots, cacheTolerance):
+    testFailCount = 0
+    testMessages = []
+
+    numSc = 10
+    simTime = 3 * 5400.0
+
+    exactDens, exactTime = runCase(False, cacheTolerance, numSc, simTime)
+    cachedDens, cachedTime = runCase(True, cacheTolerance, numSc, simTime)
+
+    # the cache tolerance is checked at the grid cell centers, allow for some margin within the cells
+    accuracy = 2.0 * cacheTolerance
+    relErr = np.max(np.abs(cachedDens - exactDens) / exactDens)
+    if relErr > accuracy:
+        testFailCount += 1
+        testMessages.append("FAILED: MsisAtmosphere density cache relative error " + str(relErr)
+                            + " exceeds " + str(accuracy) + "\n")
+
+    print("exact NRLMSISE-00: " + str(exactTime) + "s, cached: " + str(cachedTime) + "s, max rel. error: "
+          + str(relErr))
+
+    if testFailCount == 0:
+        print("PASSED: MsisAtmosphere density cache")
+    else:
+        print("Failed: MsisAtmosphere density cache")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+if __name__ == '__main__':
+    run(False, 5e-3)
@@ -45,6 +45,18 @@ MsisAtmosphere::MsisAtmosphere()
     this->msisInput.ap_a = &this->aph;
     this->updateInputParams();
 
+    //! - turn off the density cache by default
+    this->useDensityCache = false;
+    this->cacheAltStep = 5.0;
+    this->cacheLatStep = 2.5;
+    this->cacheLstStep = 0.25;
+    this->cacheUtStep = 1.0;
+    this->cacheTolerance = 5e-3;
+    this->cacheMaxAge = 3*3600.0;
+    this->cacheValid = false;
+    this->cacheEpochTime = 0.0;
+    this->msisTime = 0.0;
+
 
     this->msisFlags.switches[0] = 1; //! NRLMSISE-00 should output in kg/m^3 for consistency with other atmospheric modules.
     //! Set default settings for NRLMSISE-00; we're using all the settings by default
@@ -150,6 +162,9 @@ bool MsisAtmosphere::customReadMessages(){
     SingleMessageHeader localHeader;
     SwDataSimMsg tmpSwData;
 
+    //! - only keep the latest space weather data
+    this->swDataList.clear();
+
     //! Iterate over swData message ids
     for(int ind = 0; ind < 23; ind++) {
         if (this->swDataInMsgIds[ind] >= 0) {
@@ -218,18 +233,12 @@ void MsisAtmosphere::updateSwIndices()
 
 }
 
-void MsisAtmosphere::evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double currentTime)
+/*! This method sets the NRLMSISE-00 date and time inputs from the current simulation time.
+ @param currentTime current time (s)
+ @return void
+ */
+void MsisAtmosphere::updateInputTime(double currentTime)
 {
-    this->updateSwIndices();
-    this->updateInputParams();
-    //! Compute the geodetic position using the planet orientation.
-
-    this->currentLLA = PCI2LLA(this->r_BP_N, this->planetState.J20002Pfix, this->planetRadius);
-    this->msisInput.g_lat = R2D*this->currentLLA[0];
-    this->msisInput.g_long = R2D*this->currentLLA[1];
-    this->msisInput.alt = this->currentLLA[2]/1000.0; // NRLMSISE Altitude input must be in kilometers!
-
-    //! Update time.
     struct tm localDateTime;                            // []       date/time structure
     localDateTime = this->epochDateTime;
     localDateTime.tm_sec += (int) round(currentTime);   // sets the current seconds
@@ -237,16 +246,50 @@ void MsisAtmosphere::evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double curren
     this->msisInput.year = localDateTime.tm_yday;
     this->msisInput.doy = localDateTime.tm_yday + 1;    // Jan 1 is the 1st day of year, not 0th
     this->msisInput.sec = localDateTime.tm_sec;
+    this->msisTime = currentTime;
 
+    return;
+}
+
+/*! This method evaluates NRLMSISE-00 at the current spacecraft position.  The space weather and time inputs
+ must be set prior to calling this method.
+ @param msg atmosphere output message structure
+ @return void
+ */
+void MsisAtmosphere::evaluateMsisModel(AtmoPropsSimMsg *msg)
+{
+    //! Compute the geodetic position using the planet orientation.
+    this->currentLLA = PCI2LLA(this->r_BP_N, this->planetState.J20002Pfix, this->planetRadius);
+    this->msisInput.g_lat = R2D*this->currentLLA[0];
+    this->msisInput.g_long = R2D*this->currentLLA[1];
+    this->msisInput.alt = this->currentLLA[2]/1000.0; // NRLMSISE Altitude input must be in kilometers!
 
     //WIP - need to actually figure out how to pull in these values.
     this->msisInput.lst = this->msisInput.sec/3600.0 + this->msisInput.g_long/15.0;
 
+    //! - use the interpolated density cache if possible, otherwise evaluate NRLMSISE-00 exactly
+    if (this->useDensityCache && this->evaluateCachedMsisModel(msg)) {
+        return;
+    }
+
+    this->evaluateExactMsisModel(&this->msisInput, &this->msisOutput);
+    msg->neutralDensity = this->msisOutput.d[5];
+    msg->localTemp = this->msisOutput.t[1];
+    return;
+}
+
+/*! This method calls NRLMSISE-00 for a given set of inputs.
+ @param input NRLMSISE-00 input structure
+ @param output NRLMSISE-00 output structure
+ @return void
+ */
+void MsisAtmosphere::evaluateExactMsisModel(nrlmsise_input *input, nrlmsise_output *output)
+{
     //!  NRLMSISE-00 uses different models depending on the altitude.
-    if(this->msisInput.alt < 500.0){
-        gtd7(&this->msisInput, \
+    if(input->alt < 500.0){
+        gtd7(input, \
        &this->msisFlags, \
-       &this->msisOutput);
+       output);
     }
 
         /* GTD7D */
@@ -255,12 +298,235 @@ void MsisAtmosphere::evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double curren
          *   affect satellite drag above 500 km. See the section "output" for
          *   additional details.
          */
-    else if(this->msisInput.alt >= 500.0){
-        gtd7d(&this->msisInput, \
+    else {
+        gtd7d(input, \
        &this->msisFlags, \
-       &this->msisOutput);
+       output);
+    }
+    return;
+}
+
+/*! Packs the four grid indices of the density cache into a single hash key.
+ @param altInd altitude grid index
+ @param latInd latitude grid index
+ @param lstInd local solar time grid index
+ @param utInd universal time grid index
+ @return uint64_t
+ */
+static uint64_t cacheKey(int altInd, int latInd, int lstInd, int utInd)
+{
+    return ((uint64_t) (uint16_t) (altInd + (1 << 15)) << 48) | ((uint64_t) (uint16_t) (latInd + (1 << 15)) << 32)
+            | ((uint64_t) (uint16_t) (lstInd + (1 << 15)) << 16) | (uint64_t) (uint16_t) (utInd + (1 << 15));
+}
+
+/*! This method clears the density cache if the space weather indices or the day of year changed, or if the
+ cache is older than cacheMaxAge.
+ @return void
+ */
+void MsisAtmosphere::checkCacheEpoch()
+{
+    bool epochChanged = !this->cacheValid;
+    epochChanged = epochChanged || this->cacheInput.doy != this->msisInput.doy;
+    epochChanged = epochChanged || this->cacheInput.f107 != this->msisInput.f107;
+    epochChanged = epochChanged || this->cacheInput.f107A != this->msisInput.f107A;
+    epochChanged = epochChanged || this->cacheInput.ap != this->msisInput.ap;
+    for (int apInd = 0; apInd < 7; apInd++) {
+        epochChanged = epochChanged || this->cacheAph.a[apInd] != this->aph.a[apInd];
+    }
+    epochChanged = epochChanged || fabs(this->msisTime - this->cacheEpochTime) > this->cacheMaxAge;
+
+    if (epochChanged) {
+        this->cacheNodes.clear();
+        this->cacheCells.clear();
+        this->cacheInput = this->msisInput;
+        this->cacheAph = this->aph;
+        this->cacheInput.ap_a = &this->cacheAph;
+        this->cacheEpochTime = this->msisTime;
+        this->cacheValid = true;
+    }
+
+    return;
+}
+
+/*! This method evaluates NRLMSISE-00 at a grid point using the cache epoch space weather inputs.  The longitude is
+ set consistent with the local solar time and the universal time of the grid point.
+ @param alt [km] altitude
+ @param lat [deg] geodetic latitude
+ @param lst [hr] local solar time
+ @param ut [hr] universal time
+ @param output NRLMSISE-00 output structure
+ @return void
+ */
+void MsisAtmosphere::evaluateCacheGridPoint(double alt, double lat, double lst, double ut, nrlmsise_output *output)
+{
+    nrlmsise_input gridInput = this->cacheInput;
+    gridInput.alt = alt;
+    gridInput.g_lat = lat;
+    gridInput.lst = lst;
+    gridInput.sec = ut*3600.0;
+    gridInput.g_long = (lst - ut)*15.0;
+    this->evaluateExactMsisModel(&gridInput, output);
+
+    return;
+}
+
+/*! This method returns the NRLMSISE-00 output at a grid node, evaluating and storing it if it is not cached yet.
+ @param altInd altitude grid index
+ @param latInd latitude grid index
+ @param lstInd local solar time grid index
+ @param utInd universal time grid index
+ @return const nrlmsise_output&
+ */
+const nrlmsise_output &MsisAtmosphere::getCacheNode(int altInd, int latInd, int lstInd, int utInd)
+{
+    uint64_t key = cacheKey(altInd, latInd, lstInd, utInd);
+    std::unordered_map<uint64_t, nrlmsise_output>::iterator it = this->cacheNodes.find(key);
+    if (it == this->cacheNodes.end()) {
+        nrlmsise_output nodeOutput;
+        this->evaluateCacheGridPoint(altInd*this->cacheAltStep,
+                                     latInd*this->cacheLatStep - 90.0,
+                                     lstInd*this->cacheLstStep,
+                                     utInd*this->cacheUtStep,
+                                     &nodeOutput);
+        it = this->cacheNodes.insert(std::make_pair(key, nodeOutput)).first;
+    }
+    return it->second;
+}
+
+/*! Quadrilinear interpolation of the log-density and temperature within a grid cell.
+ @param cell cache cell
+ @param wAlt normalized altitude position within the cell
+ @param wLat normalized latitude position within the cell
+ @param wLst normalized local solar time position within the cell
+ @param wUt normalized universal time position within the cell
+ @param density [kg/m^3] interpolated total mass density
+ @param temp [K] interpolated temperature
+ @return void
+ */
+static void interpolateCacheCell(const MsisCacheCell &cell, double wAlt, double wLat, double wLst, double wUt,
+                                 double *density, double *temp)
+{
+    double logDens = 0.0;
+    double tempSum = 0.0;
+    for (int n = 0; n < 16; n++) {
+        double w = ((n & 1) ? wAlt : 1.0 - wAlt) * ((n & 2) ? wLat : 1.0 - wLat) * ((n & 4) ? wLst : 1.0 - wLst)
+                * ((n & 8) ? wUt : 1.0 - wUt);
+        logDens += w*cell.logDensity[n];
+        tempSum += w*cell.temp[n];
+    }
+    *density = exp(logDens);
+    *temp = tempSum;
+}
+
+/*! This method returns a cell of the density cache, building it if it is not cached yet.  When a cell is built
+ the interpolated density and temperature at the cell center are compared to an exact evaluation, and the cell
+ is flagged as invalid if the difference exceeds cacheTolerance.
+ @param altInd altitude grid index
+ @param latInd latitude grid index
+ @param lstInd local solar time grid index
+ @param utInd universal time grid index
+ @return const MsisCacheCell&
+ */
+const MsisCacheCell &MsisAtmosphere::getCacheCell(int altInd, int latInd, int lstInd, int utInd)
+{
+    uint64_t key = cacheKey(altInd, latInd, lstInd, utInd);
+    std::unordered_map<uint64_t, MsisCacheCell>::iterator it = this->cacheCells.find(key);
+    if (it != this->cacheCells.end()) {
+        return it->second;
+    }
+
+    MsisCacheCell cell;
+    for (int n = 0; n < 16; n++) {
+        const nrlmsise_output &node = this->getCacheNode(altInd + (n & 1), latInd + ((n >> 1) & 1), lstInd + ((n >> 2) & 1),
+                                                         utInd + ((n >> 3) & 1));
+        cell.logDensity[n] = log(node.d[5]);
+        cell.temp[n] = node.t[1];
+    }
+
+    double interpDens, interpTemp;
+    interpolateCacheCell(cell, 0.5, 0.5, 0.5, 0.5, &interpDens, &interpTemp);
+    nrlmsise_output centerOutput;
+    this->evaluateCacheGridPoint((altInd + 0.5)*this->cacheAltStep,
+                                 (latInd + 0.5)*this->cacheLatStep - 90.0,
+                                 (lstInd + 0.5)*this->cacheLstStep,
+                                 (utInd + 0.5)*this->cacheUtStep,
+                                 &centerOutput);
+    cell.valid = fabs(interpDens - centerOutput.d[5]) <= this->cacheTolerance*fabs(centerOutput.d[5])
+            && fabs(interpTemp - centerOutput.t[1]) <= this->cacheTolerance*fabs(centerOutput.t[1]);
+
+    return this->cacheCells.insert(std::make_pair(key, cell)).first->second;
+}
+
+/*! This method interpolates the neutral density and temperature from the density cache.  Grid cells are built
+ on demand in (altitude, latitude, local solar time, universal time) for the current space weather epoch.  At a
+ fixed local solar time the density still depends on the universal time, so the grid nodes are evaluated at their
+ own universal time rather than at the cache epoch.
+ @param msg atmosphere output message structure
+ @return bool true if the cache was used, false if an exact evaluation is required
+ */
+bool MsisAtmosphere::evaluateCachedMsisModel(AtmoPropsSimMsg *msg)
+{
+    this->checkCacheEpoch();
+
+    //! - local solar time is periodic, wrap it to [0, 24) hours
+    double lst = fmod(this->msisInput.lst, 24.0);
+    if (lst < 0.0) {
+        lst += 24.0;
+    }
+
+    double altGrid = this->msisInput.alt/this->cacheAltStep;
+    double latGrid = (this->msisInput.g_lat + 90.0)/this->cacheLatStep;
+    double lstGrid = lst/this->cacheLstStep;
+    double utGrid = this->msisInput.sec/3600.0/this->cacheUtStep;
+    int altInd = (int) floor(altGrid);
+    int latInd = (int) floor(latGrid);
+    int lstInd = (int) floor(lstGrid);
+    int utInd = (int) floor(utGrid);
+
+    //! - fall back to exact evaluation if the cell does not meet the accuracy bound
+    const MsisCacheCell &cell = this->getCacheCell(altInd, latInd, lstInd, utInd);
+    if (!cell.valid) {
+        return false;
+    }
+
+    interpolateCacheCell(cell, altGrid - altInd, latGrid - latInd, lstGrid - lstInd, utGrid - utInd,
+                         &msg->neutralDensity, &msg->localTemp);
+
+    return true;
+}
+
+/*! This method evaluates the MSIS atmosphere model for a single spacecraft.
+ @param msg atmosphere output message structure
+ @param currentTime current time (s)
+ @return void
+ */
+void MsisAtmosphere::evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double currentTime)
+{
+    this->updateSwIndices();
+    this->updateInputParams();
+    this->updateInputTime(currentTime);
+    this->evaluateMsisModel(msg);
+    return;
+}
+
+/*! This method evaluates the MSIS atmosphere model for all spacecraft.  The space weather indices and the date/time
+ inputs are common to all spacecraft and are only set once per call, after which NRLMSISE-00 is evaluated
+ for each spacecraft that is within reach.
+ @param msgs vector of atmosphere output messages, one per spacecraft
+ @param currentTime current time (s)
+ @return void
+ */
+void MsisAtmosphere::evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime)
+{
+    this->updateSwIndices();
+    this->updateInputParams();
+    this->updateInputTime(currentTime);
+
+    for (uint64_t c = 0; c < msgs.size(); c++) {
+        if (this->inReachBatch[c]) {
+            this->setBatchElement(c);
+            this->evaluateMsisModel(&msgs[c]);
+        }
     }
-    msg->neutralDensity = this->msisOutput.d[5];
-    msg->localTemp = this->msisOutput.t[1];
     return;
 }
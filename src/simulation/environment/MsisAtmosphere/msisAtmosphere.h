@@ -24,6 +24,7 @@
 #include <Eigen/Dense>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "../../_GeneralModuleFiles/sys_model.h"
 #include "simMessages/spicePlanetStateSimMsg.h"
 #include "simMessages/scPlusStatesSimMsg.h"
@@ -37,6 +38,13 @@ extern "C" {
   #include "nrlmsise-00.h"
 }
 
+/*! @brief Structure used to store a cell of the NRLMSISE-00 density cache */
+typedef struct {
+    bool valid;                 //!< -- flag if the cell meets the cache accuracy bound
+    double logDensity[16];      //!< [-] natural log of the total mass density at the cell corners
+    double temp[16];            //!< [K] temperature at the cell corners
+}MsisCacheCell;
+
 
 /*! @brief MSIS athomsphere model */
 class MsisAtmosphere: public AtmosphereBase {
@@ -51,13 +59,29 @@ private:
     bool ReadInputs();
     void updateInputParams();
     void updateSwIndices();
+    void updateInputTime(double currentTime);
+    void evaluateMsisModel(AtmoPropsSimMsg *msg);
+    void evaluateExactMsisModel(nrlmsise_input *input, nrlmsise_output *output);
+    bool evaluateCachedMsisModel(AtmoPropsSimMsg *msg);
+    void checkCacheEpoch();
+    const nrlmsise_output &getCacheNode(int altInd, int latInd, int lstInd, int utInd);
+    void evaluateCacheGridPoint(double alt, double lat, double lst, double ut, nrlmsise_output *output);
+    const MsisCacheCell &getCacheCell(int altInd, int latInd, int lstInd, int utInd);
     void evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double currentTime);
+    void evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime);
     void customSetEpochFromVariable();
 
 public:
     int epochDoy;                               //!< [day] Day-of-Year at epoch
     std::string epochInMsgName;                 //!< epoch input msg name
     BSKLogger bskLogger;                        //!< -- BSK Logging
+    bool useDensityCache;                       //!< -- flag to interpolate the density from a cached grid instead of evaluating NRLMSISE-00 exactly, default false
+    double cacheAltStep;                        //!< [km] altitude spacing of the density cache grid
+    double cacheLatStep;                        //!< [deg] geodetic latitude spacing of the density cache grid
+    double cacheLstStep;                        //!< [hr] local solar time spacing of the density cache grid
+    double cacheUtStep;                         //!< [hr] universal time spacing of the density cache grid
+    double cacheTolerance;                      //!< [-] relative accuracy bound of a cache cell, cells exceeding this bound are evaluated exactly
+    double cacheMaxAge;                         //!< [s] time after which the cache is rebuilt even if the space weather has not changed
 
 
 private:
@@ -75,6 +99,14 @@ private:
     double f107;
     double f107A;
 
+    // NRLMSISE-00 density cache
+    std::unordered_map<uint64_t, nrlmsise_output> cacheNodes; //!< cached NRLMSISE-00 outputs at the grid nodes
+    std::unordered_map<uint64_t, MsisCacheCell> cacheCells;  //!< cached grid cells with their corner values
+    nrlmsise_input cacheInput;                  //!< NRLMSISE-00 inputs at the cache epoch
+    ap_array cacheAph;                          //!< ap array at the cache epoch
+    double cacheEpochTime;                      //!< [s] simulation time at which the cache was built
+    double msisTime;                            //!< [s] simulation time of the current NRLMSISE-00 inputs
+    bool cacheValid;                            //!< flag if the cache matches the current space weather epoch
 
 };
 
@@ -315,35 +315,92 @@ void AtmosphereBase::updateRelativePos(SpicePlanetStateSimMsg *planetState, SCPl
     return;
 }
 
-/*! This method is used to update the local magnetic field based on each spacecraft's position.
-  @return void
+/*! This method computes the planet relative position of all spacecraft in a single pass.  The results are stored
+ column-wise such that the atmosphere models can evaluate all spacecraft at once.
+ @param planetState A space planetstate message struct.
+ @return void
  */
-void AtmosphereBase::updateLocalAtmosphere(double currentTime)
+void AtmosphereBase::updateRelativePosBatch(SpicePlanetStateSimMsg *planetState)
 {
-    std::vector<SCPlusStatesSimMsg>::iterator it;
-    uint64_t atmoInd = 0;
+    long numSc = (long) this->scStates.size();
+    Eigen::Map<Eigen::Vector3d> r_PN_N(planetState->PositionVector);
+    Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor> > dcm_PN(&planetState->J20002Pfix[0][0]);
 
-    //! - loop over all the spacecraft
-    std::vector<AtmoPropsSimMsg>::iterator envMsgIt;
-    envMsgIt = this->envOutBuffer.begin();
-    for(it = scStates.begin(); it != scStates.end(); it++, atmoInd++, envMsgIt++){
-        //! - Computes planet relative state vector
-        this->updateRelativePos(&(this->planetState), &(*it));
+    this->r_BP_NBatch.resize(3, numSc);
+    for (long c = 0; c < numSc; c++) {
+        this->r_BP_NBatch.col(c) = Eigen::Map<Eigen::Vector3d>(this->scStates[c].r_BN_N) - r_PN_N;
+    }
 
-        //! - zero the output message for each spacecraft by default
-        memset(&(*envMsgIt), 0x0, sizeof(AtmoPropsSimMsg));
+    //! - convert all spacecraft position vectors to planet-fixed vector components
+    this->r_BP_PBatch.noalias() = dcm_PN * this->r_BP_NBatch;
+
+    //! - compute the orbit radii and altitudes
+    this->orbitRadiusBatch = this->r_BP_NBatch.colwise().norm().transpose();
+    this->orbitAltitudeBatch = this->orbitRadiusBatch.array() - this->planetRadius;
+
+    //! - check if the radii are in permissible range
+    this->inReachBatch.resize(numSc);
+    for (long c = 0; c < numSc; c++) {
+        this->inReachBatch[c] = this->orbitAltitudeBatch[c] > this->envMinReach &&
+                (this->orbitAltitudeBatch[c] < this->envMaxReach || this->envMaxReach < 0);
+    }
+
+    return;
+}
+
+/*! This method copies a single spacecraft entry of the batch position data into the scalar relative position
+ variables used by evaluateAtmosphereModel().
+ @param scInd index of the spacecraft in the batch
+ @return void
+ */
+void AtmosphereBase::setBatchElement(uint64_t scInd)
+{
+    this->r_BP_N = this->r_BP_NBatch.col(scInd);
+    this->r_BP_P = this->r_BP_PBatch.col(scInd);
+    this->orbitRadius = this->orbitRadiusBatch[scInd];
+    this->orbitAltitude = this->orbitAltitudeBatch[scInd];
+
+    return;
+}
 
-        //! - check if radius is in permissible range
-        if(this->orbitAltitude > this->envMinReach &&
-           (this->orbitAltitude < this->envMaxReach || this->envMaxReach < 0)) {
-            //! - compute the local magnetic field.  The evaluateMageticFieldModel() method must be implement for each model
-            evaluateAtmosphereModel(&(*envMsgIt), currentTime);
+/*! Default batch evaluation method.  This evaluates the atmosphere model one spacecraft at a time for all
+ spacecraft that are within reach.  Child classes can override this method to evaluate all spacecraft at once.
+ @param msgs vector of output messages, one per spacecraft
+ @param currentTime current time (s)
+ @return void
+ */
+void AtmosphereBase::evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime)
+{
+    for (uint64_t c = 0; c < msgs.size(); c++) {
+        if (this->inReachBatch[c]) {
+            this->setBatchElement(c);
+            evaluateAtmosphereModel(&msgs[c], currentTime);
         }
     }
 
     return;
 }
 
+/*! This method is used to update the local atmosphere based on each spacecraft's position.
+  @return void
+ */
+void AtmosphereBase::updateLocalAtmosphere(double currentTime)
+{
+    //! - zero the output message for each spacecraft by default
+    std::vector<AtmoPropsSimMsg>::iterator envMsgIt;
+    for(envMsgIt = this->envOutBuffer.begin(); envMsgIt != this->envOutBuffer.end(); envMsgIt++){
+        memset(&(*envMsgIt), 0x0, sizeof(AtmoPropsSimMsg));
+    }
+
+    //! - compute the planet relative states of all spacecraft
+    this->updateRelativePosBatch(&(this->planetState));
+
+    //! - compute the local atmosphere of all spacecraft.  The evaluateAtmosphereModelBatch() method defaults to calling evaluateAtmosphereModel() for each spacecraft
+    this->evaluateAtmosphereModelBatch(this->envOutBuffer, currentTime);
+
+    return;
+}
+
 
 /*! Computes the current local magnetic field for each spacecraft and writes their respective messages.
  @return void
@@ -44,7 +44,10 @@ protected:
     bool readMessages();
     void updateLocalAtmosphere(double currentTime);
     void updateRelativePos(SpicePlanetStateSimMsg  *planetState, SCPlusStatesSimMsg *scState);
+    void updateRelativePosBatch(SpicePlanetStateSimMsg *planetState);
+    void setBatchElement(uint64_t scInd);
     virtual void evaluateAtmosphereModel(AtmoPropsSimMsg *msg, double currentTime) = 0;     //!< class method
+    virtual void evaluateAtmosphereModelBatch(std::vector<AtmoPropsSimMsg> &msgs, double currentTime);
     virtual void customSelfInit();
     virtual void customCrossInit();
     virtual void customReset(uint64_t CurrentClock);
@@ -66,6 +69,11 @@ protected:
     Eigen::Vector3d r_BP_P;                 //!< [m] sc position vector relative to planet in planet-fixed frame components
     double orbitRadius;                     //!< [m] sc orbit radius about planet
     double orbitAltitude;                   //!< [m] sc altitude above planetRadius
+    Eigen::Matrix3Xd r_BP_NBatch;           //!< [m] sc positions relative to planet in N frame components, one column per sc
+    Eigen::Matrix3Xd r_BP_PBatch;           //!< [m] sc positions relative to planet in planet-fixed frame components, one column per sc
+    Eigen::VectorXd orbitRadiusBatch;       //!< [m] sc orbit radii about planet
+    Eigen::VectorXd orbitAltitudeBatch;     //!< [m] sc altitudes above planetRadius
+    std::vector<bool> inReachBatch;         //!< -- flag indicating if the sc is within the min/max reach of the environment
     uint64_t OutputBufferCount;                //!< number of output buffers for messaging system
     std::vector<AtmoPropsSimMsg> envOutBuffer; //!< -- Message buffer for magnetic field messages
     std::vector<int64_t>  envOutMsgIds;     //!< vector of module output message IDs
@@ -33,6 +33,8 @@ from Basilisk.utilities import RigidBodyKinematics as rbk
 from Basilisk.utilities import orbitalMotion
 from Basilisk.simulation import simMessages
 from Basilisk.simulation import groundLocation
+from Basilisk.simulation import spacecraftPlus
+from Basilisk.utilities import simIncludeGravBody
 
 filename = inspect.getframeinfo(inspect.currentframe()).filename
 path = os.path.dirname(os.path.abspath(filename))
@@ -206,6 +208,94 @@ def test_rotation(show_plots):
 
     assert (range_worked and elevation_worked and access_worked)
 
+def test_predictiveAccess(show_plots):
+    """
+    Tests whether groundLocation in the predictive access mode:
+        1. Reports the same access as the default mode for a spacecraft on a two-body orbit;
+        2. Reports AOS and LOS times that bracket the access changes seen at the task rate.
+    :return:
+    """
+    testFailCount = 0
+    testMessages = []
+
+    simTaskName = "simTask"
+    simProcessName = "simProcess"
+    scSim = SimulationBaseClass.SimBaseClass()
+    scSim.TotalSim.terminateSimulation()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    simulationTimeStep = macros.sec2nano(10.)
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    planet = gravFactory.createEarth()
+    planet.isCentralBody = True
+    mu = planet.mu
+    scObject.gravField.gravBodies = spacecraftPlus.GravBodyVector(list(gravFactory.gravBodies.values()))
+
+    oe = orbitalMotion.ClassicElements()
+    oe.a = 7000. * 1000
+    oe.e = 0.01
+    oe.i = 10. * macros.D2R
+    oe.Omega = 0.
+    oe.omega = 0.
+    oe.f = -60. * macros.D2R
+    rN, vN = orbitalMotion.elem2rv(mu, oe)
+    scObject.hub.r_CN_NInit = rN
+    scObject.hub.v_CN_NInit = vN
+    scSim.AddModelToTask(simTaskName, scObject)
+
+    groundTargets = []
+    for usePredictiveAccess in [False, True]:
+        groundTarget = groundLocation.GroundLocation()
+        groundTarget.ModelTag = "groundTarget" + str(int(usePredictiveAccess))
+        groundTarget.planetRadius = orbitalMotion.REQ_EARTH * 1000.
+        groundTarget.minimumElevation = np.radians(10.)
+        groundTarget.specifyLocation(np.radians(0.), np.radians(0.), 0.)
+        groundTarget.usePredictiveAccess = usePredictiveAccess
+        groundTarget.planetMu = mu
+        groundTarget.addSpacecraftToModel(scObject.scStateOutMsgName)
+        scSim.AddModelToTask(simTaskName, groundTarget)
+        scSim.TotalSim.logThisMessage(groundTarget.accessOutMsgNames[0], simulationTimeStep)
+        groundTargets.append(groundTarget)
+
+    n = np.sqrt(mu / oe.a ** 3)
+    simulationTime = macros.sec2nano(3. * 2. * np.pi / n)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(simulationTime)
+    scSim.ExecuteSimulation()
+
+    trueAccess = scSim.pullMessageLogData(groundTargets[0].accessOutMsgNames[0] + '.hasAccess', range(1))
+    testAccess = scSim.pullMessageLogData(groundTargets[1].accessOutMsgNames[0] + '.hasAccess', range(1))
+    aosTimes = scSim.pullMessageLogData(groundTargets[1].accessOutMsgNames[0] + '.aosTime', range(1))
+    losTimes = scSim.pullMessageLogData(groundTargets[1].accessOutMsgNames[0] + '.losTime', range(1))
+    timeAxis = trueAccess[:, 0] * macros.NANO2SEC
+
+    if not np.array_equal(trueAccess[:, 1], testAccess[:, 1]):
+        testFailCount += 1
+        testMessages.append("FAILED: predictive access differs from the default access\n")
+
+    # the spacecraft is integrated numerically, allow for a small difference to the two-body prediction
+    timeTolerance = 1.0
+    numPasses = 0
+    for k in range(1, len(timeAxis)):
+        if trueAccess[k, 1] > trueAccess[k - 1, 1]:
+            numPasses += 1
+            if not (timeAxis[k - 1] - timeTolerance < aosTimes[k, 1] <= timeAxis[k] + timeTolerance):
+                testFailCount += 1
+                testMessages.append("FAILED: AOS time not within the step of the access change\n")
+        if trueAccess[k, 1] < trueAccess[k - 1, 1]:
+            if not (timeAxis[k - 1] - timeTolerance <= losTimes[k - 1, 1] < timeAxis[k] + timeTolerance):
+                testFailCount += 1
+                testMessages.append("FAILED: LOS time not within the step of the access change\n")
+
+    if numPasses < 2:
+        testFailCount += 1
+        testMessages.append("FAILED: test geometry does not include multiple passes\n")
+
+    assert testFailCount < 1, ''.join(testMessages)
+
 def plot_geometry(groundLocation, scLocations, minimumElevation):
     """
     Plots the location of a ground station, its field of view,  and the positions of two spacecraft to verify whether
@@ -21,6 +21,7 @@
 #include "architecture/messaging/system_messaging.h"
 #include "../utilities/avsEigenSupport.h"
 #include "../utilities/linearAlgebra.h"
+#include "simFswInterfaceMessages/macroDefinitions.h"
 
 
 /*! @brief Creates an instance of the GroundLocation class with a minimum elevation of 10 degrees,
@@ -51,6 +52,19 @@ GroundLocation::GroundLocation()
     this->planetState.J20002Pfix[2][2] = 1;
 
     this->r_North_N << 0, 0, 1;
+
+    this->usePredictiveAccess = false;
+    this->planetMu = MU_EARTH*1e9;
+    this->predictionHorizon = 6.*3600.;
+    this->predictionStep = 30.;
+    this->predictionTolerance = 1e-3;
+    this->predictionMargin = 60.;
+    this->omega_PN_N.fill(0.0);
+    this->r_LP_N_Prediction.fill(0.0);
+    this->predictionMeanAnomaly = 0.0;
+    this->predictionMeanMotion = 0.0;
+    this->predictionMaxSpeed = 0.0;
+    this->sinMinimumElevation = sin(this->minimumElevation);
 }
 
 /*! Empty destructor method.
@@ -61,10 +75,25 @@ GroundLocation::~GroundLocation()
     return;
 }
 
-/*! Resets the internal position to the specified initial position.*/
+/*! Resets the internal position to the specified initial position and clears the predicted access windows.*/
 void GroundLocation::Reset(uint64_t CurrentSimNanos)
 {
     this->r_LP_P = this->r_LP_P_Init;
+    this->sinMinimumElevation = sin(this->minimumElevation);
+
+    size_t numSc = this->scStateInMsgNames.size();
+    SCPlusStatesSimMsg tmpScState;
+    memset(&tmpScState, 0x0, sizeof(SCPlusStatesSimMsg));
+    this->scStates.assign(numSc, tmpScState);
+    this->aosTimes.assign(numSc, -1.0);
+    this->losTimes.assign(numSc, -1.0);
+    this->predictionTimes.assign(numSc, -1.0);
+    this->predictionValidTimes.assign(numSc, -1.0);
+    std::vector<AccessSimMsg>::iterator accessIt;
+    for (accessIt = this->accessMsgBuffer.begin(); accessIt != this->accessMsgBuffer.end(); accessIt++) {
+        accessIt->aosTime = -1.0;
+        accessIt->losTime = -1.0;
+    }
 }
 
 /*! Specifies the ground location from planet-centered latitude, longitude, altitude position.
@@ -88,6 +117,9 @@ void GroundLocation::addSpacecraftToModel(std::string tmpScMsgName)
 {
     std::string tmpAccessMsgName;
     AccessSimMsg tmpAccessMsg;
+    memset(&tmpAccessMsg, 0x0, sizeof(AccessSimMsg));
+    tmpAccessMsg.aosTime = -1.0;
+    tmpAccessMsg.losTime = -1.0;
     this->scStateInMsgNames.push_back(tmpScMsgName);
         tmpAccessMsgName = this->ModelTag + "_" + std::to_string(this->scStateInMsgNames.size()-1) + "_access";
     this->accessOutMsgNames.push_back(tmpAccessMsgName);
@@ -161,17 +193,39 @@ bool GroundLocation::ReadMessages()
         bskLogger.bskLog(BSK_ERROR, "Ground location has no spacecraft to track.");
         scRead = false;
     }
-    //! - Read in the optional planet message.  if no planet message is set, then a zero planet position, velocity and orientation is assumed
+    bool planetRead = this->readPlanetMessage();
+
+    return(planetRead && scRead);
+}
+
+/*! Reads in the optional planet message.  If no planet message is set, then a zero planet position, velocity and orientation is assumed.
+ @return bool true if the planet state is available
+ */
+bool GroundLocation::readPlanetMessage()
+{
+    SingleMessageHeader localHeader;
     bool planetRead = true;
-    if(planetInMsgId >= 0)
+    if(this->planetInMsgId >= 0)
     {
         planetRead = SystemMessaging::GetInstance()->ReadMessage(this->planetInMsgId , &localHeader,
                                                                  sizeof(SpicePlanetStateSimMsg),
                                                                  reinterpret_cast<uint8_t*>(&this->planetState),
                                                                  moduleID);
     }
+    return(planetRead);
+}
 
-    return(planetRead && scRead);
+/*! Reads in the state message of a single spacecraft.
+ @return bool true if the message was read
+ @param scIdx index of the spacecraft
+ */
+bool GroundLocation::readSpacecraftMessage(size_t scIdx)
+{
+    SingleMessageHeader localHeader;
+    return(SystemMessaging::GetInstance()->ReadMessage(this->scStateInMsgIds[scIdx], &localHeader,
+                                                       sizeof(SCPlusStatesSimMsg),
+                                                       reinterpret_cast<uint8_t*>(&this->scStates[scIdx]),
+                                                       moduleID));
 }
 
 void GroundLocation::WriteMessages(uint64_t CurrentClock)
@@ -219,32 +273,277 @@ void GroundLocation::computeAccess()
     std::vector<AccessSimMsg>::iterator accessMsgIt;
     std::vector<SCPlusStatesSimMsg>::iterator scStatesMsgIt;
     for(scStatesMsgIt = scStates.begin(), accessMsgIt = accessMsgBuffer.begin(); scStatesMsgIt != scStates.end(); scStatesMsgIt++, accessMsgIt++){
-        //! Compute the relative position of each spacecraft to the site in the planet-centered inertial frame
-        Eigen::Vector3d r_BP_N = cArray2EigenVector3d(scStatesMsgIt->r_BN_N) - this->r_PN_N;
-        Eigen::Vector3d r_BL_N = r_BP_N - this->r_LP_N;
-        auto r_BL_mag = r_BL_N.norm();
-        Eigen::Vector3d relativeHeading_N = r_BL_N / r_BL_mag;
-
-        double viewAngle = (M_PI_2-acos(this->rhat_LP_N.dot(relativeHeading_N)));
-
-        if( (viewAngle > this->minimumElevation) && (r_BL_mag <= this->maximumRange)){
-            accessMsgIt->hasAccess = 1;
-            accessMsgIt->slantRange = r_BL_N.norm();
-            accessMsgIt->elevation = viewAngle;
-
-            Eigen::Vector3d sezPosition = this->dcm_LP * this->dcm_PN * r_BL_N;
-            double cos_az = -sezPosition[0]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
-            double sin_az = sezPosition[1]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
-            accessMsgIt->azimuth = atan2(sin_az, cos_az);
+        this->computeSpacecraftAccess(&(*scStatesMsgIt), &(*accessMsgIt));
+    }
+}
+
+/*! Computes the access of a single spacecraft to the ground location.
+ @return void
+ @param scState spacecraft state message
+ @param accessMsg access message to fill in
+ */
+void GroundLocation::computeSpacecraftAccess(SCPlusStatesSimMsg *scState, AccessSimMsg *accessMsg)
+{
+    //! Compute the relative position of each spacecraft to the site in the planet-centered inertial frame
+    Eigen::Vector3d r_BP_N = cArray2EigenVector3d(scState->r_BN_N) - this->r_PN_N;
+    Eigen::Vector3d r_BL_N = r_BP_N - this->r_LP_N;
+    auto r_BL_mag = r_BL_N.norm();
+    Eigen::Vector3d relativeHeading_N = r_BL_N / r_BL_mag;
+
+    double viewAngle = (M_PI_2-acos(this->rhat_LP_N.dot(relativeHeading_N)));
+
+    if( (viewAngle > this->minimumElevation) && (r_BL_mag <= this->maximumRange || this->maximumRange < 0)){
+        accessMsg->hasAccess = 1;
+        accessMsg->slantRange = r_BL_N.norm();
+        accessMsg->elevation = viewAngle;
+
+        Eigen::Vector3d sezPosition = this->dcm_LP * this->dcm_PN * r_BL_N;
+        double cos_az = -sezPosition[0]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
+        double sin_az = sezPosition[1]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
+        accessMsg->azimuth = atan2(sin_az, cos_az);
+    }
+    else
+    {
+        accessMsg->hasAccess = 0;
+        accessMsg->slantRange = 0.0;
+        accessMsg->elevation = 0.0;
+        accessMsg->azimuth = 0.0;
+    }
+}
+
+/*! Evaluates the access in the predictive mode.  The spacecraft states are only read and the full access check is
+ only run within the predicted access windows padded by predictionMargin.  Outside of these windows no access is
+ reported.  A new window is predicted once the current one has passed, once the searched horizon is exhausted, and
+ once more when the spacecraft approaches the predicted window to refine it with a recent state.
+ @return void
+ @param currentTime [s] current simulation time
+ */
+void GroundLocation::updatePredictedAccess(double currentTime)
+{
+    this->readPlanetMessage();
+    this->updateInertialPositions();
+
+    for (size_t c = 0; c < this->scStates.size(); c++) {
+        AccessSimMsg *accessMsg = &this->accessMsgBuffer[c];
+        bool scRead = false;
+        bool windowPredicted = this->aosTimes[c] >= 0.0;
+
+        //! - check if the access window of this spacecraft needs to be (re)predicted
+        bool predictWindow = this->predictionTimes[c] < 0.0 || this->predictionValidTimes[c] < 0.0
+                             || currentTime > this->predictionValidTimes[c];
+        if (windowPredicted && currentTime >= this->aosTimes[c] - this->predictionMargin
+            && this->predictionTimes[c] < this->aosTimes[c] - this->predictionMargin) {
+            predictWindow = true;
+        }
+        if (predictWindow) {
+            scRead = this->readSpacecraftMessage(c);
+            this->predictAccessWindow(c, currentTime);
+            windowPredicted = this->aosTimes[c] >= 0.0;
+        }
+
+        //! - run the full access check near the predicted window, or every step if no prediction is possible
+        bool nearWindow = this->predictionValidTimes[c] < 0.0;
+        if (windowPredicted && currentTime >= this->aosTimes[c] - this->predictionMargin
+            && currentTime <= this->losTimes[c] + this->predictionMargin) {
+            nearWindow = true;
+        }
+        if (nearWindow) {
+            if (!scRead) {
+                this->readSpacecraftMessage(c);
+            }
+            this->computeSpacecraftAccess(&this->scStates[c], accessMsg);
+        } else {
+            accessMsg->hasAccess = 0;
+            accessMsg->slantRange = 0.0;
+            accessMsg->elevation = 0.0;
+            accessMsg->azimuth = 0.0;
+        }
+        accessMsg->aosTime = this->aosTimes[c];
+        accessMsg->losTime = this->losTimes[c];
+    }
+}
+
+/*! Predicts the current or next access window of a spacecraft using two-body motion relative to the planet and a
+ uniformly rotating planet.  The window is bracketed by a coarse search with predictionStep and the AOS and LOS times
+ are refined by bisection to predictionTolerance.  Access windows shorter than predictionStep can be missed.
+ @return void
+ @param scIdx index of the spacecraft
+ @param currentTime [s] current simulation time
+ */
+void GroundLocation::predictAccessWindow(size_t scIdx, double currentTime)
+{
+    double r_BP_N[3];
+    double v_BP_N[3];
+    double dtAos;
+    double dtLos;
+
+    this->predictionTimes[scIdx] = currentTime;
+    this->aosTimes[scIdx] = -1.0;
+    this->losTimes[scIdx] = -1.0;
+    this->predictionValidTimes[scIdx] = -1.0;
+
+    //! - get the osculating orbit of the spacecraft relative to the planet
+    v3Subtract(this->scStates[scIdx].r_BN_N, this->planetState.PositionVector, r_BP_N);
+    v3Subtract(this->scStates[scIdx].v_BN_N, this->planetState.VelocityVector, v_BP_N);
+    if (v3Norm(r_BP_N) < 1.0) {
+        return;
+    }
+    rv2elem(this->planetMu, r_BP_N, v_BP_N, &this->predictionElements);
+    double e = this->predictionElements.e;
+    if (fabs(1.0 - e) < 1e-6 || this->predictionElements.a == 0.0) {
+        //! - near parabolic orbits are not predicted, the full access check is evaluated every step instead
+        return;
+    }
+    this->predictionMeanMotion = sqrt(this->planetMu/fabs(pow(this->predictionElements.a, 3)));
+    if (e < 1.0) {
+        this->predictionMeanAnomaly = E2M(f2E(this->predictionElements.f, e), e);
+    } else {
+        this->predictionMeanAnomaly = H2N(f2H(this->predictionElements.f, e), e);
+    }
+
+    //! - get the planet rotation rate from the orientation matrix derivative, [omega_PN_P x] = -dC/dt C^T
+    Eigen::Matrix3d dcm_PN0 = cArray2EigenMatrix3d(*this->planetState.J20002Pfix);
+    Eigen::Matrix3d dcmDot_PN = cArray2EigenMatrix3d(*this->planetState.J20002Pfix_dot);
+    Eigen::Matrix3d omegaTilde_PN_P = -dcmDot_PN*dcm_PN0.transpose();
+    Eigen::Vector3d omega_PN_P(omegaTilde_PN_P(2,1), omegaTilde_PN_P(0,2), omegaTilde_PN_P(1,0));
+    this->omega_PN_N = dcm_PN0.transpose()*omega_PN_P;
+    this->r_LP_N_Prediction = dcm_PN0.transpose()*this->r_LP_P_Init;
+
+    //! - bound the relative speed by the periapsis speed and the location speed
+    double rPeriapsis = this->predictionElements.a*(1.0 - e);
+    this->predictionMaxSpeed = sqrt(this->planetMu*(2.0/rPeriapsis - 1.0/this->predictionElements.a))
+                               + this->omega_PN_N.norm()*this->r_LP_P_Init.norm();
+
+    //! - search for the access window
+    if (this->evaluateAccessFunction(0.0, NULL) > 0.0) {
+        //! - the spacecraft is in a window, search back for its AOS
+        if (!this->findAccessTransition(0.0, -this->predictionHorizon, &dtAos)) {
+            dtAos = -this->predictionHorizon;
+        }
+        if (!this->findAccessTransition(0.0, this->predictionHorizon, &dtLos)) {
+            dtLos = this->predictionHorizon;
+        }
+    } else {
+        if (!this->findAccessTransition(0.0, this->predictionHorizon, &dtAos)) {
+            //! - no window within the prediction horizon
+            this->predictionValidTimes[scIdx] = currentTime + this->predictionHorizon;
+            return;
+        }
+        if (!this->findAccessTransition(dtAos, this->predictionHorizon, &dtLos)) {
+            dtLos = this->predictionHorizon;
+        }
+    }
+
+    //! - windows that started before the simulation start are reported from the start of the simulation
+    this->aosTimes[scIdx] = std::max(currentTime + dtAos, 0.0);
+    this->losTimes[scIdx] = currentTime + dtLos;
+    this->predictionValidTimes[scIdx] = this->losTimes[scIdx] + this->predictionMargin;
+}
+
+/*! Evaluates the access function of the spacecraft whose window is being predicted.  The function is positive if the
+ spacecraft is above the minimum elevation and within the maximum range of the ground location.  Optionally a bound on
+ the time until the function can become positive is returned, using that the line of sight direction changes at most
+ with the relative speed over the range and the local vertical with the planet rotation rate.
+ @return double access function value
+ @param dt [s] time since the prediction epoch
+ @param safeStep [s] time during which no access can start, not computed if NULL
+ */
+double GroundLocation::evaluateAccessFunction(double dt, double *safeStep)
+{
+    classicElements elements = this->predictionElements;
+    double e = elements.e;
+    double meanAnomaly = this->predictionMeanAnomaly + this->predictionMeanMotion*dt;
+    double r_BP_N[3];
+    double v_BP_N[3];
+
+    //! - propagate the two-body orbit
+    if (e < 1.0) {
+        meanAnomaly = fmod(meanAnomaly, 2.0*M_PI);
+        elements.f = E2f(M2E(meanAnomaly, e), e);
+    } else {
+        elements.f = H2f(N2H(meanAnomaly, e), e);
+    }
+    elem2rv(this->planetMu, &elements, r_BP_N, v_BP_N);
+
+    //! - rotate the location about the planet spin axis
+    Eigen::Vector3d r_LP_N = this->r_LP_N_Prediction;
+    double omegaMag = this->omega_PN_N.norm();
+    if (omegaMag > 0.0) {
+        Eigen::Vector3d spinAxis = this->omega_PN_N/omegaMag;
+        double angle = omegaMag*dt;
+        r_LP_N = r_LP_N*cos(angle) + spinAxis.cross(r_LP_N)*sin(angle)
+                 + spinAxis*spinAxis.dot(r_LP_N)*(1.0 - cos(angle));
+    }
+
+    Eigen::Vector3d r_BL_N = cArray2EigenVector3d(r_BP_N) - r_LP_N;
+    double r_BL_mag = r_BL_N.norm();
+    double elevationFunction = r_BL_N.dot(r_LP_N)/(r_BL_mag*r_LP_N.norm()) - this->sinMinimumElevation;
+    double rangeFunction = 1.0;
+    if (this->maximumRange > 0.0) {
+        rangeFunction = (this->maximumRange - r_BL_mag)/this->maximumRange;
+    }
+
+    if (safeStep != NULL) {
+        double stepElevation = 0.0;
+        double stepRange = 0.0;
+        if (elevationFunction <= 0.0) {
+            //! - limit the step to keep the range above half of its current value
+            stepElevation = std::min(0.5*r_BL_mag/this->predictionMaxSpeed,
+                                     -elevationFunction/(omegaMag + 2.0*this->predictionMaxSpeed/r_BL_mag));
+        }
+        if (rangeFunction <= 0.0) {
+            stepRange = -rangeFunction*this->maximumRange/this->predictionMaxSpeed;
+        }
+        *safeStep = std::max(stepElevation, stepRange);
+    }
+
+    return(std::min(elevationFunction, rangeFunction));
+}
+
+/*! Searches from dtStart towards dtEnd for the first change of access and refines it by bisection.
+ @return bool true if an access change was found
+ @param dtStart [s] start of the search relative to the prediction epoch
+ @param dtEnd [s] end of the search relative to the prediction epoch, may be before dtStart
+ @param dtTransition [s] time of the access change, reported on the far side of the change from dtStart
+ */
+bool GroundLocation::findAccessTransition(double dtStart, double dtEnd, double *dtTransition)
+{
+    double direction = dtEnd > dtStart ? 1.0 : -1.0;
+    double safeStep;
+    bool startAccess = this->evaluateAccessFunction(dtStart, &safeStep) > 0.0;
+    double dtNear = dtStart;
+    double dtFar;
+
+    //! - coarse search for a change of access, taking larger steps while no access can start
+    while (true) {
+        double step = this->predictionStep;
+        if (!startAccess) {
+            step = std::max(step, safeStep);
+        }
+        dtFar = dtNear + direction*step;
+        if (direction*(dtFar - dtEnd) > 0.0) {
+            dtFar = dtEnd;
+        }
+        if ((this->evaluateAccessFunction(dtFar, &safeStep) > 0.0) != startAccess) {
+            break;
         }
-        else
-        {
-            accessMsgIt->hasAccess = 0;
-            accessMsgIt->slantRange = 0.0;
-            accessMsgIt->elevation = 0.0;
-            accessMsgIt->azimuth = 0.0;
+        if (dtFar == dtEnd) {
+            return(false);
         }
+        dtNear = dtFar;
     }
+
+    //! - refine the change of access by bisection
+    while (fabs(dtFar - dtNear) > this->predictionTolerance) {
+        double dtMid = 0.5*(dtNear + dtFar);
+        if ((this->evaluateAccessFunction(dtMid, NULL) > 0.0) == startAccess) {
+            dtNear = dtMid;
+        } else {
+            dtFar = dtMid;
+        }
+    }
+    *dtTransition = dtFar;
+    return(true);
 }
 
 /*!
@@ -253,8 +552,12 @@ void GroundLocation::computeAccess()
  */
 void GroundLocation::UpdateState(uint64_t CurrentSimNanos)
 {
-    this->ReadMessages();
-    this->computeAccess();
+    if (this->usePredictiveAccess) {
+        this->updatePredictedAccess(CurrentSimNanos*NANO2SEC);
+    } else {
+        this->ReadMessages();
+        this->computeAccess();
+    }
     this->WriteMessages(CurrentSimNanos);
 
 }
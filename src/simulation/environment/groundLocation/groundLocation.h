@@ -31,6 +31,7 @@
 #include "simMessages/groundStateSimMsg.h"
 #include "../utilities/geodeticConversion.h"
 #include "utilities/astroConstants.h"
+#include "utilities/orbitalMotion.h"
 #include "utilities/bskLogging.h"
 
 /*! @brief ground location class */
@@ -50,6 +51,13 @@ public:
 private:
     void updateInertialPositions();
     void computeAccess();
+    void computeSpacecraftAccess(SCPlusStatesSimMsg *scState, AccessSimMsg *accessMsg);
+    bool readPlanetMessage();
+    void updatePredictedAccess(double currentTime);
+    void predictAccessWindow(size_t scIdx, double currentTime);
+    bool readSpacecraftMessage(size_t scIdx);
+    double evaluateAccessFunction(double dt, double *safeStep);
+    bool findAccessTransition(double dtStart, double dtEnd, double *dtTransition);
 
 public:
     double planetRadius; //!< [m] Planet radius in meters.
@@ -60,6 +68,12 @@ public:
     std::vector<std::string> accessOutMsgNames; //!< msg name
     Eigen::Vector3d r_LP_P_Init; //!< [m] Initial position of the location in planet-centric coordinates; can also be set using setGroundLocation.
     BSKLogger bskLogger;         //!< -- BSK Logging
+    bool usePredictiveAccess;    //!< [-] flag to only evaluate access near access windows predicted with two-body motion, defaults to false
+    double planetMu;             //!< [m^3/s^2] gravitational parameter used for the access window prediction, defaults to Earth
+    double predictionHorizon;    //!< [s] time span searched for the next access window, defaults to 6 hours
+    double predictionStep;       //!< [s] coarse search step of the access window prediction, defaults to 30 seconds
+    double predictionTolerance;  //!< [s] root-finding tolerance on the predicted AOS and LOS times, defaults to 1 ms
+    double predictionMargin;     //!< [s] time before AOS and after LOS during which the full access check is evaluated, defaults to 60 seconds
 
 private:
     uint64_t OutputBufferCount = 2;
@@ -80,6 +94,17 @@ private:
     Eigen::Vector3d rhat_LP_N;//!< [-] Surface normal vector from the target location.
     Eigen::Vector3d r_LN_N;
     Eigen::Vector3d r_North_N; //!<[-] Inertial 3rd axis, defined internally as "North".
+    std::vector<double> aosTimes;        //!< [s] predicted AOS time of each spacecraft, -1 if no window is predicted
+    std::vector<double> losTimes;        //!< [s] predicted LOS time of each spacecraft, -1 if no window is predicted
+    std::vector<double> predictionTimes; //!< [s] time at which each access window was predicted, -1 if not predicted yet
+    std::vector<double> predictionValidTimes; //!< [s] time up to which each access window prediction is valid
+    Eigen::Vector3d omega_PN_N;          //!< [rad/s] planet angular velocity used in the access window prediction
+    Eigen::Vector3d r_LP_N_Prediction;   //!< [m] location position at the time of the access window prediction
+    classicElements predictionElements;  //!< orbit elements of the spacecraft whose access window is being predicted
+    double predictionMeanAnomaly;        //!< [rad] mean (hyperbolic) anomaly at the time of the access window prediction
+    double predictionMeanMotion;         //!< [rad/s] mean motion of the spacecraft whose access window is being predicted
+    double predictionMaxSpeed;           //!< [m/s] bound on the speed of the spacecraft relative to the location
+    double sinMinimumElevation;          //!< [-] sine of the minimum elevation angle
 };
 
 
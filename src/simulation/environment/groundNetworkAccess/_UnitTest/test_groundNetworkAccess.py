@@ -0,0 +1,132 @@
+
+
+# ISC License
+#
+# Copyright (c) 2016-2017, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+
+import numpy as np
+import pytest
+
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import unitTestSupport
+from Basilisk.utilities import macros
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities import orbitalMotion
+from Basilisk.simulation import simMessages
+from Basilisk.simulation import groundLocation
+from Basilisk.simulation import groundNetworkAccess
+
+
+@pytest.mark.parametrize("maximumRange", [-1, 3000e3])
+def test_groundNetworkAccess(show_plots, maximumRange):
+    """
+    Tests whether groundNetworkAccess:
+        1. Produces the same access, slant range, elevation and azimuth as individual groundLocation instances;
+        2. Supports location specific minimum elevations and maximum ranges;
+        3. Supports multiple spacecraft and locations on a rotating planet.
+    :return:
+    """
+    simTaskName = "simTask"
+    simProcessName = "simProcess"
+    scSim = SimulationBaseClass.SimBaseClass()
+    scSim.TotalSim.terminateSimulation()
+    dynProcess = scSim.CreateNewProcess(simProcessName)
+    simulationTime = macros.sec2nano(10.)
+    simulationTimeStep = macros.sec2nano(1.)
+    dynProcess.addTask(scSim.CreateNewTask(simTaskName, simulationTimeStep))
+
+    planet_message = simMessages.SpicePlanetStateSimMsg()
+    planet_message_name = "test_planet"
+    planet_message.J20002Pfix = rbk.euler3(np.radians(-20.)).tolist()
+    planet_message.PositionVector = [1000., -2000., 500.]
+    unitTestSupport.setMessage(scSim.TotalSim, simProcessName, planet_message_name, planet_message)
+
+    groundNetwork = groundNetworkAccess.GroundNetworkAccess()
+    groundNetwork.ModelTag = "groundNetwork"
+    groundNetwork.planetRadius = orbitalMotion.REQ_EARTH * 1000.
+    groundNetwork.planetInMsgName = planet_message_name
+    groundNetwork.minimumElevation = np.radians(10.)
+    groundNetwork.maximumRange = maximumRange
+
+    # ground locations spread around the equator and mid latitudes
+    locations = [[0., 10., 0., 10.], [20., 15., 100., 5.], [-30., 30., 1500., 15.], [45., -5., 0., 10.]]
+    groundTargets = []
+    for idx, loc in enumerate(locations):
+        name = "groundTarget" + str(idx)
+        groundTarget = groundLocation.GroundLocation()
+        groundTarget.ModelTag = name
+        groundTarget.planetRadius = orbitalMotion.REQ_EARTH * 1000.
+        groundTarget.planetInMsgName = planet_message_name
+        groundTarget.maximumRange = maximumRange
+        groundTarget.minimumElevation = np.radians(loc[3])
+        groundTarget.specifyLocation(np.radians(loc[0]), np.radians(loc[1]), loc[2])
+        scSim.AddModelToTask(simTaskName, groundTarget)
+        groundTargets.append(groundTarget)
+        if idx == 0:
+            # use the module default minimum elevation and maximum range
+            groundNetwork.addGroundLocation(name + "Net", np.radians(loc[0]), np.radians(loc[1]), loc[2])
+        else:
+            groundNetwork.addGroundLocation(name + "Net", np.radians(loc[0]), np.radians(loc[1]), loc[2],
+                                            np.radians(loc[3]), maximumRange)
+
+    # spacecraft at different altitudes and positions above the locations
+    numSc = 6
+    for c in range(numSc):
+        sc_message = simMessages.SCPlusStatesSimMsg()
+        rP = rbk.euler3(np.radians(-20. + 8. * c)).dot(np.array([orbitalMotion.REQ_EARTH * 1e3 + 300e3 + 500e3 * c,
+                                                                 0., 0.]))
+        rP = rbk.euler2(np.radians(-6. * c)).dot(rP)
+        sc_message.r_BN_N = rbk.euler3(np.radians(-20.)).T.dot(rP) + np.array(planet_message.PositionVector)
+        sc_message_name = "sc" + str(c) + "_msg"
+        unitTestSupport.setMessage(scSim.TotalSim, simProcessName, sc_message_name, sc_message)
+        groundNetwork.addSpacecraftToModel(sc_message_name)
+        for groundTarget in groundTargets:
+            groundTarget.addSpacecraftToModel(sc_message_name)
+    scSim.AddModelToTask(simTaskName, groundNetwork)
+
+    numDataPoints = 2
+    samplingTime = int(simulationTime / (numDataPoints - 1))
+    for idx in range(len(locations)):
+        for c in range(numSc):
+            scSim.TotalSim.logThisMessage(groundTargets[idx].accessOutMsgNames[c], samplingTime)
+            scSim.TotalSim.logThisMessage(groundNetwork.getAccessOutMsgName(idx, c), samplingTime)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(simulationTime)
+    scSim.ExecuteSimulation()
+
+    accuracy = 1e-8
+    testFailCount = 0
+    testMessages = []
+    totalAccess = 0
+    for idx in range(len(locations)):
+        for c in range(numSc):
+            for field in ['.hasAccess', '.slantRange', '.elevation', '.azimuth']:
+                trueData = scSim.pullMessageLogData(groundTargets[idx].accessOutMsgNames[c] + field, range(1))
+                testData = scSim.pullMessageLogData(groundNetwork.getAccessOutMsgName(idx, c) + field, range(1))
+                if field == '.hasAccess':
+                    totalAccess += trueData[-1, 1]
+                if not testData[:, 1] == pytest.approx(trueData[:, 1], rel=accuracy, abs=accuracy):
+                    testFailCount += 1
+                    testMessages.append("FAILED: location " + str(idx) + " sc " + str(c) + field + "\n")
+
+    # make sure the geometry exercises both access and no access cases
+    if totalAccess == 0 or totalAccess == len(locations) * numSc:
+        testFailCount += 1
+        testMessages.append("FAILED: test geometry does not include both access and no access cases\n")
+
+    assert testFailCount < 1, ''.join(testMessages)
+
+
+if __name__ == '__main__':
+    test_groundNetworkAccess(False, -1)
@@ -0,0 +1,339 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "groundNetworkAccess.h"
+#include "architecture/messaging/system_messaging.h"
+#include "../utilities/avsEigenSupport.h"
+#include "../utilities/linearAlgebra.h"
+
+
+/*! @brief Creates an instance of the GroundNetworkAccess class with a default minimum elevation of 10 degrees,
+ @return void
+ */
+GroundNetworkAccess::GroundNetworkAccess()
+{
+    //! - Set some default initial conditions:
+    this->minimumElevation = 10.*D2R; // [rad] default minimum elevation above the local horizon needed to see a spacecraft
+    this->maximumRange = -1; // [m] default maximum range for the ground locations to compute access.
+    this->planetInMsgName = "";
+    this->planetInMsgId = -1;
+
+    this->planetRadius = REQ_EARTH*1e3;
+
+    memset(&this->planetState, 0x0, sizeof(SpicePlanetStateSimMsg));
+    this->planetState.J20002Pfix[0][0] = 1;
+    this->planetState.J20002Pfix[1][1] = 1;
+    this->planetState.J20002Pfix[2][2] = 1;
+}
+
+/*! Empty destructor method.
+ @return void
+ */
+GroundNetworkAccess::~GroundNetworkAccess()
+{
+    return;
+}
+
+/*! Resets the output message buffers.
+ @return void
+ */
+void GroundNetworkAccess::Reset(uint64_t CurrentSimNanos)
+{
+    AccessSimMsg tmpAccessMsg;
+    memset(&tmpAccessMsg, 0x0, sizeof(AccessSimMsg));
+    tmpAccessMsg.aosTime = -1.0;
+    tmpAccessMsg.losTime = -1.0;
+    this->accessMsgBuffer.assign(this->locationNames.size()*this->scStateInMsgNames.size(), tmpAccessMsg);
+}
+
+/*! Adds a ground location using the module default minimum elevation and maximum range.
+ @param locationName name of the ground location, used to name the output messages
+ @param lat [rad] latitude of the location
+ @param longitude [rad] longitude of the location
+ @param alt [m] altitude of the location
+ @return void
+ */
+void GroundNetworkAccess::addGroundLocation(std::string locationName, double lat, double longitude, double alt)
+{
+    this->addGroundLocation(locationName, lat, longitude, alt, this->minimumElevation, this->maximumRange);
+}
+
+/*! Adds a ground location from planet-centered latitude, longitude, altitude position.
+ @param locationName name of the ground location, used to name the output messages
+ @param lat [rad] latitude of the location
+ @param longitude [rad] longitude of the location
+ @param alt [m] altitude of the location
+ @param minElevation [rad] minimum elevation above the local horizon needed to see a spacecraft
+ @param maxRange [m] maximum slant range to compute access for; negative values represent no maximum range
+ @return void
+ */
+void GroundNetworkAccess::addGroundLocation(std::string locationName, double lat, double longitude, double alt,
+                                            double minElevation, double maxRange)
+{
+    long numLoc = (long) this->locationNames.size() + 1;
+    Eigen::Vector3d tmpLLAPosition(lat, longitude, alt);
+    Eigen::Vector3d r_LP_P_loc = LLA2PCPF(tmpLLAPosition, this->planetRadius);
+
+    this->locationNames.push_back(locationName);
+    this->r_LP_P.conservativeResize(3, numLoc);
+    this->r_LP_P.col(numLoc-1) = r_LP_P_loc;
+    this->rhat_LP_P.conservativeResize(3, numLoc);
+    this->rhat_LP_P.col(numLoc-1) = r_LP_P_loc.normalized();
+    this->r_LP_mag.conservativeResize(numLoc);
+    this->r_LP_mag[numLoc-1] = r_LP_P_loc.norm();
+    this->dcm_LP.push_back(C_PCPF2SEZ(lat, longitude));
+    this->minElevations.conservativeResize(numLoc);
+    this->minElevations[numLoc-1] = minElevation;
+    this->sinMinElevations.conservativeResize(numLoc);
+    this->sinMinElevations[numLoc-1] = sin(minElevation);
+    this->maxRanges.conservativeResize(numLoc);
+    this->maxRanges[numLoc-1] = maxRange;
+}
+
+/*! Adds a scState message name to the vector of names to be subscribed to.
+ @param tmpScMsgName spacecraft state message name
+ @return void
+ */
+void GroundNetworkAccess::addSpacecraftToModel(std::string tmpScMsgName)
+{
+    this->scStateInMsgNames.push_back(tmpScMsgName);
+}
+
+/*! Returns the name of the access message of a ground location and spacecraft pair.  The names follow the
+ groundLocation convention ``locationName_#_access`` where # is the index of the spacecraft.
+ @param locationIdx index of the ground location
+ @param scIdx index of the spacecraft
+ @return std::string
+ */
+std::string GroundNetworkAccess::getAccessOutMsgName(uint64_t locationIdx, uint64_t scIdx)
+{
+    return this->locationNames.at(locationIdx) + "_" + std::to_string(scIdx) + "_access";
+}
+
+/*! Creates the access messages of all ground location and spacecraft pairs, as well as the ground state
+ message of each location.
+ @return void
+ */
+void GroundNetworkAccess::SelfInit()
+{
+    this->accessOutMsgNames.clear();
+    this->accessOutMsgIds.clear();
+    this->groundStateOutMsgNames.clear();
+    this->groundStateOutMsgIds.clear();
+
+    for (uint64_t l = 0; l < this->locationNames.size(); l++) {
+        //! - create the access output messages for each spacecraft
+        for (uint64_t c = 0; c < this->scStateInMsgNames.size(); c++) {
+            this->accessOutMsgNames.push_back(this->getAccessOutMsgName(l, c));
+            this->accessOutMsgIds.push_back(SystemMessaging::GetInstance()->CreateNewMessage(this->accessOutMsgNames.back(),
+                                                                                              sizeof(AccessSimMsg),
+                                                                                              this->OutputBufferCount,
+                                                                                              "AccessSimMsg",
+                                                                                              moduleID));
+        }
+        //! - create the ground state message of the location
+        this->groundStateOutMsgNames.push_back(this->locationNames[l] + "_GroundState");
+        this->groundStateOutMsgIds.push_back(SystemMessaging::GetInstance()->CreateNewMessage(this->groundStateOutMsgNames.back(),
+                                                                                               sizeof(GroundStateSimMsg),
+                                                                                               this->OutputBufferCount,
+                                                                                               "GroundStateSimMsg",
+                                                                                               moduleID));
+    }
+
+    AccessSimMsg tmpAccessMsg;
+    memset(&tmpAccessMsg, 0x0, sizeof(AccessSimMsg));
+    tmpAccessMsg.aosTime = -1.0;
+    tmpAccessMsg.losTime = -1.0;
+    this->accessMsgBuffer.assign(this->accessOutMsgIds.size(), tmpAccessMsg);
+    GroundStateSimMsg tmpGroundStateMsg;
+    memset(&tmpGroundStateMsg, 0x0, sizeof(GroundStateSimMsg));
+    this->groundStateMsgBuffer.assign(this->locationNames.size(), tmpGroundStateMsg);
+}
+
+/*! Subscribes to the planet and spacecraft state messages.
+ @return void
+ */
+void GroundNetworkAccess::CrossInit()
+{
+    //! - if a planet message name is specified, subscribe to this message. If not, then a zero planet position and orientation is assumed
+    if (this->planetInMsgName.length() > 0) {
+        this->planetInMsgId = SystemMessaging::GetInstance()->subscribeToMessage(this->planetInMsgName, sizeof(SpicePlanetStateSimMsg), moduleID);
+    }
+    //! - subscribe to the spacecraft messages
+    this->scStateInMsgIds.clear();
+    std::vector<std::string>::iterator it;
+    for(it = this->scStateInMsgNames.begin(); it != this->scStateInMsgNames.end(); it++){
+        this->scStateInMsgIds.push_back(SystemMessaging::GetInstance()->subscribeToMessage(*it, sizeof(SCPlusStatesSimMsg), moduleID));
+    }
+}
+
+/*! Reads the planet state message and each spacecraft state message once.  The spacecraft positions relative to
+ the planet are stored column-wise.
+ @return bool
+ */
+bool GroundNetworkAccess::ReadMessages()
+{
+    SCPlusStatesSimMsg scMsg;
+    SingleMessageHeader localHeader;
+
+    //! - Read in the optional planet message.  if no planet message is set, then a zero planet position, velocity and orientation is assumed
+    bool planetRead = true;
+    if(this->planetInMsgId >= 0)
+    {
+        planetRead = SystemMessaging::GetInstance()->ReadMessage(this->planetInMsgId , &localHeader,
+                                                                 sizeof(SpicePlanetStateSimMsg),
+                                                                 reinterpret_cast<uint8_t*>(&this->planetState),
+                                                                 moduleID);
+    }
+    this->r_PN_N = cArray2EigenVector3d(this->planetState.PositionVector);
+
+    //! - read in the spacecraft state messages
+    bool scRead;
+    this->r_BP_N.resize(3, (long) this->scStateInMsgIds.size());
+    if(!this->scStateInMsgIds.empty())
+    {
+        scRead = true;
+        for(long c = 0; c < (long) this->scStateInMsgIds.size(); c++){
+            bool tmpScRead;
+            tmpScRead = SystemMessaging::GetInstance()->ReadMessage(this->scStateInMsgIds[c], &localHeader,
+                                                                    sizeof(SCPlusStatesSimMsg),
+                                                                    reinterpret_cast<uint8_t*>(&scMsg),
+                                                                    moduleID);
+            scRead = scRead && tmpScRead;
+            this->r_BP_N.col(c) = cArray2EigenVector3d(scMsg.r_BN_N) - this->r_PN_N;
+        }
+    } else {
+        bskLogger.bskLog(BSK_ERROR, "Ground network has no spacecraft to track.");
+        scRead = false;
+    }
+
+    return(planetRead && scRead);
+}
+
+/*! Writes the access messages of all ground location and spacecraft pairs, and the ground state messages.
+ @param CurrentClock The current time used for time-stamping the message
+ @return void
+ */
+void GroundNetworkAccess::WriteMessages(uint64_t CurrentClock)
+{
+    for (uint64_t i = 0; i < this->accessOutMsgIds.size(); i++) {
+        SystemMessaging::GetInstance()->WriteMessage(this->accessOutMsgIds[i],
+                                                     CurrentClock,
+                                                     sizeof(AccessSimMsg),
+                                                     reinterpret_cast<uint8_t*>(&this->accessMsgBuffer[i]),
+                                                     moduleID);
+    }
+    for (uint64_t l = 0; l < this->groundStateOutMsgIds.size(); l++) {
+        SystemMessaging::GetInstance()->WriteMessage(this->groundStateOutMsgIds[l],
+                                                     CurrentClock,
+                                                     sizeof(GroundStateSimMsg),
+                                                     reinterpret_cast<uint8_t*>(&this->groundStateMsgBuffer[l]),
+                                                     moduleID);
+    }
+}
+
+/*! Computes the inertial positions of all ground locations.
+ @return void
+ */
+void GroundNetworkAccess::updateInertialPositions()
+{
+    this->dcm_PN = cArray2EigenMatrix3d(*this->planetState.J20002Pfix);
+    Eigen::Matrix3Xd r_LP_N = this->dcm_PN.transpose() * this->r_LP_P;
+    for (long l = 0; l < r_LP_N.cols(); l++) {
+        Eigen::Vector3d r_LP_N_loc = r_LP_N.col(l);
+        Eigen::Vector3d r_LN_N = this->r_PN_N + r_LP_N_loc;
+        eigenVector3d2CArray(r_LN_N, this->groundStateMsgBuffer[l].r_LN_N);
+        eigenVector3d2CArray(r_LP_N_loc, this->groundStateMsgBuffer[l].r_LP_N);
+    }
+}
+
+/*! Computes the access of all spacecraft to all ground locations.  All spacecraft positions are first rotated to
+ the planet frame, and the height of each spacecraft above the local horizon plane of each location is computed
+ as a single matrix product.  Pairs below the horizon cone of a location are culled before the slant range,
+ elevation and azimuth are computed.
+ @return void
+ */
+void GroundNetworkAccess::computeAccess()
+{
+    //! - Update the ground locations' inertial positions
+    this->updateInertialPositions();
+
+    long numLoc = this->r_LP_P.cols();
+    long numSc = this->r_BP_N.cols();
+
+    //! - rotate all spacecraft positions into the planet frame
+    this->r_BP_P.noalias() = this->dcm_PN * this->r_BP_N;
+
+    //! - height of all spacecraft above the local horizon plane of all locations
+    this->heightAboveHorizon.noalias() = this->rhat_LP_P.transpose() * this->r_BP_P;
+    this->heightAboveHorizon.colwise() -= this->r_LP_mag;
+
+    AccessSimMsg noAccessMsg;
+    memset(&noAccessMsg, 0x0, sizeof(AccessSimMsg));
+    noAccessMsg.aosTime = -1.0;
+    noAccessMsg.losTime = -1.0;
+    for (long l = 0; l < numLoc; l++) {
+        bool minElevationAboveHorizon = this->minElevations[l] >= 0.0;
+        double maxRange = this->maxRanges[l];
+        for (long c = 0; c < numSc; c++) {
+            AccessSimMsg *accessMsg = &this->accessMsgBuffer[l*numSc + c];
+            double height = this->heightAboveHorizon(l, c);
+
+            //! - cull spacecraft that are below the local horizon plane
+            if (minElevationAboveHorizon && height <= 0.0) {
+                *accessMsg = noAccessMsg;
+                continue;
+            }
+
+            Eigen::Vector3d r_BL_P = this->r_BP_P.col(c) - this->r_LP_P.col(l);
+            double r_BL_mag = r_BL_P.norm();
+
+            //! - cull spacecraft that are outside of the horizon cone or the maximum range
+            if (height <= r_BL_mag*this->sinMinElevations[l] || (maxRange >= 0.0 && r_BL_mag > maxRange)) {
+                *accessMsg = noAccessMsg;
+                continue;
+            }
+
+            double viewAngle = M_PI_2 - acos(height/r_BL_mag);
+            if (viewAngle > this->minElevations[l]) {
+                accessMsg->hasAccess = 1;
+                accessMsg->slantRange = r_BL_mag;
+                accessMsg->elevation = viewAngle;
+
+                Eigen::Vector3d sezPosition = this->dcm_LP[l] * r_BL_P;
+                double cos_az = -sezPosition[0]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
+                double sin_az = sezPosition[1]/(sqrt(pow(sezPosition[0],2) + pow(sezPosition[1],2)));
+                accessMsg->azimuth = atan2(sin_az, cos_az);
+            } else {
+                *accessMsg = noAccessMsg;
+            }
+        }
+    }
+}
+
+/*!
+ update module
+ @param CurrentSimNanos
+ */
+void GroundNetworkAccess::UpdateState(uint64_t CurrentSimNanos)
+{
+    this->ReadMessages();
+    this->computeAccess();
+    this->WriteMessages(CurrentSimNanos);
+}
@@ -0,0 +1,93 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#ifndef GROUND_NETWORK_ACCESS_H
+#define GROUND_NETWORK_ACCESS_H
+
+#include <Eigen/Dense>
+#include <vector>
+#include <string>
+#include "../../_GeneralModuleFiles/sys_model.h"
+#include "simMessages/spicePlanetStateSimMsg.h"
+#include "simMessages/scPlusStatesSimMsg.h"
+#include "simMessages/accessSimMsg.h"
+#include "simMessages/groundStateSimMsg.h"
+#include "../utilities/geodeticConversion.h"
+#include "utilities/astroConstants.h"
+#include "utilities/bskLogging.h"
+
+/*! @brief ground network access class.  Evaluates the access of a set of ground locations to a set of spacecraft
+ in a single pass. */
+class GroundNetworkAccess:  public SysModel {
+public:
+    GroundNetworkAccess();
+    ~GroundNetworkAccess();
+    void SelfInit();
+    void CrossInit();
+    void UpdateState(uint64_t CurrentSimNanos);
+    void Reset(uint64_t CurrentSimNanos);
+    bool ReadMessages();
+    void WriteMessages(uint64_t CurrentClock);
+    void addSpacecraftToModel(std::string tmpScMsgName);
+    void addGroundLocation(std::string locationName, double lat, double longitude, double alt);
+    void addGroundLocation(std::string locationName, double lat, double longitude, double alt,
+                           double minElevation, double maxRange);
+    std::string getAccessOutMsgName(uint64_t locationIdx, uint64_t scIdx);
+
+private:
+    void updateInertialPositions();
+    void computeAccess();
+
+public:
+    double planetRadius; //!< [m] Planet radius in meters.
+    double minimumElevation; //!< [rad] default minimum elevation of the ground locations; defaults to 10 degrees equivalent.
+    double maximumRange; //!< [m] default maximum slant range of the ground locations; defaults to -1, which represents no maximum range.
+    std::string planetInMsgName;                //!< msg name
+    std::vector<std::string> locationNames;     //!< names of the ground locations
+    std::vector<std::string> accessOutMsgNames; //!< access msg names, ordered by ground location and then spacecraft
+    std::vector<std::string> groundStateOutMsgNames; //!< ground state msg names, one per ground location
+    BSKLogger bskLogger;         //!< -- BSK Logging
+
+private:
+    uint64_t OutputBufferCount = 2;
+    std::vector<std::string> scStateInMsgNames;
+    std::vector<int64_t> scStateInMsgIds;
+    std::vector<int64_t> accessOutMsgIds;
+    std::vector<int64_t> groundStateOutMsgIds;
+    int64_t planetInMsgId;
+    SpicePlanetStateSimMsg planetState;
+    std::vector<AccessSimMsg> accessMsgBuffer;          //!< access output buffer, ordered by ground location and then spacecraft
+    std::vector<GroundStateSimMsg> groundStateMsgBuffer; //!< ground state output buffer
+    Eigen::Matrix3Xd r_LP_P;                //!< [m] ground location positions relative to the planet in planet frame components, one column per location
+    Eigen::Matrix3Xd rhat_LP_P;             //!< [-] surface normals of the ground locations in planet frame components
+    Eigen::VectorXd r_LP_mag;               //!< [m] radius of the ground locations
+    std::vector<Eigen::Matrix3d> dcm_LP;    //!< rotation matrices from the planet frame P to the site-local topographic (SEZ) frames L
+    Eigen::VectorXd minElevations;          //!< [rad] minimum elevation of each ground location
+    Eigen::VectorXd sinMinElevations;       //!< [-] sine of the minimum elevation of each ground location
+    Eigen::VectorXd maxRanges;              //!< [m] maximum slant range of each ground location, negative for no limit
+    Eigen::Matrix3Xd r_BP_N;                //!< [m] spacecraft positions relative to the planet in inertial frame components
+    Eigen::Matrix3Xd r_BP_P;                //!< [m] spacecraft positions relative to the planet in planet frame components
+    Eigen::MatrixXd heightAboveHorizon;     //!< [m] spacecraft height above the local horizon plane of each location, locations by spacecraft
+    Eigen::Matrix3d dcm_PN;                 //!< Rotation matrix from inertial frame N to planet-centered to planet-fixed frame P
+    Eigen::Vector3d r_PN_N;                 //!< [m] Planet to inertial frame origin vector.
+};
+
+
+#endif /* GroundNetworkAccess */
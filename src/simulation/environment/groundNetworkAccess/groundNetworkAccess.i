@@ -0,0 +1,43 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+%module groundNetworkAccess
+%{
+    #include "groundNetworkAccess.h"
+%}
+
+%include "swig_common_model.i"
+%include "sys_model.h"
+%include "groundNetworkAccess.h"
+%include "../../simMessages/spicePlanetStateSimMsg.h"
+%include "../../simMessages/scPlusStatesSimMsg.h"
+%include "../../simMessages/accessSimMsg.h"
+%include "../../simMessages/groundStateSimMsg.h"
+
+GEN_SIZEOF(AccessSimMsg)
+GEN_SIZEOF(SpicePlanetStateSimMsg)
+GEN_SIZEOF(SCPlusStatesSimMsg)
+GEN_SIZEOF(GroundStateSimMsg)
+
+
+%pythoncode %{
+import sys
+protectAllClasses(sys.modules[__name__])
+%}
@@ -62,7 +62,30 @@ def test_module(show_plots,deviceStatus, accessStatus):
     assert testResults < 1, testMessage
 
 
-def run(deviceStatus, accessStatus):
+@pytest.mark.parametrize("predictedWindow", [True, False])
+def test_accessWindows(show_plots, predictedWindow):
+    """
+    **Validation Test Description**
+
+    With ``useAccessWindows`` set, checks:
+
+    1. Whether the spaceToGroundTransmitter scales the output message (baudRate) by the fraction of each time step
+       within the AOS and LOS times of an access message;
+    2. Whether an access message with the zero default AOS and LOS times, i.e. without a predicted window, still
+       downlinks according to its hasAccess flag.
+
+    :param show_plots: Not used; no plots to be shown.
+    :param predictedWindow: whether the access message contains a predicted access window
+
+    :return:
+    """
+
+    default_results, default_message = run(1, 1, True, predictedWindow)
+
+    assert default_results < 1, default_message
+
+
+def run(deviceStatus, accessStatus, useAccessWindows=False, predictedWindow=False):
 
     expectedValue = deviceStatus * accessStatus
 
@@ -82,10 +105,16 @@ def run(deviceStatus, accessStatus):
     # Create fake access messages
     accMsg1 = simMessages.AccessSimMsg()
     accMsg1.hasAccess = 0 # We'll never see this one, sadly
+    accMsg1.aosTime = -1
+    accMsg1.losTime = -1
     unitTestSupport.setMessage(unitTestSim.TotalSim, "TestProcess",'accessSimMsg1', accMsg1, 'AccessSimMsg')
 
     accMsg2 = simMessages.AccessSimMsg()
     accMsg2.hasAccess = accessStatus
+    if predictedWindow:
+        # access window starting and ending within a time step
+        accMsg2.aosTime = 1.25
+        accMsg2.losTime = 2.2
     unitTestSupport.setMessage(unitTestSim.TotalSim, "TestProcess",'accessSimMsg2', accMsg2, 'AccessSimMsg')
 
     # Create the test module
@@ -96,6 +125,7 @@ def run(deviceStatus, accessStatus):
     testModule.numBuffers = 1
     testModule.dataStatus = deviceStatus
     testModule.nodeDataOutMsgName = "TransmitterMsg"
+    testModule.useAccessWindows = useAccessWindows
     testModule.addAccessMsgToTransmitter('accessSimMsg1')
     testModule.addAccessMsgToTransmitter('accessSimMsg2')
     unitTestSim.AddModelToTask(unitTaskName, testModule)
@@ -131,6 +161,10 @@ def run(deviceStatus, accessStatus):
 
     trueData = 9600. # Module should be on after enough data is accrued
     testArray = [0, 0, 0, expectedValue*trueData, expectedValue*trueData, expectedValue*trueData, expectedValue*trueData] # Should go through three iterations of no data downlinked
+    if predictedWindow:
+        # fraction of each 0.5 s step within the access window from 1.25 s to 2.2 s
+        testArray = [0, 0, 0, 0.5*trueData, trueData, 0.4*trueData, 0]
+        accuracy = 1e-8
 
     testFailCount, testMessages = unitTestSupport.compareDoubleArray(
         testArray, generatedData, accuracy, "dataOutput",
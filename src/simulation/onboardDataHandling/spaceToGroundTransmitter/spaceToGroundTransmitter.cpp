@@ -20,6 +20,7 @@
 #include "spaceToGroundTransmitter.h"
 #include "architecture/messaging/system_messaging.h"
 #include "utilities/bskLogging.h"
+#include "simFswInterfaceMessages/macroDefinitions.h"
 #include <array>
 
 /*! Constructor, which sets the default nodeDataOut to zero.
@@ -29,7 +30,9 @@ SpaceToGroundTransmitter::SpaceToGroundTransmitter(){
     this->nodeBaudRate = 0.0;
     this->packetTransmitted = 0.0;
     this->previousTime = 0.0;
+    this->previousUpdateTime = 0.0;
     this->numBuffers = 0;
+    this->useAccessWindows = false;
     return;
 }
 
@@ -70,6 +73,15 @@ void SpaceToGroundTransmitter::customCrossInit(){
     return;
 }
 
+/*! Resets the time of the previous model evaluation.
+ @return void
+ @param CurrentClock [ns] current simulation time
+ */
+void SpaceToGroundTransmitter::customReset(uint64_t CurrentClock){
+    this->previousUpdateTime = CurrentClock*NANO2SEC;
+    return;
+}
+
 bool SpaceToGroundTransmitter::customReadMessages(){
 
     DataStorageStatusSimMsg nodeMsg;
@@ -130,12 +142,23 @@ bool SpaceToGroundTransmitter::customReadMessages(){
 */
 void SpaceToGroundTransmitter::evaluateDataModel(DataNodeUsageSimMsg *dataUsageSimMsg, double currentTime){
 
-    this->currentTimestep = currentTime - this->previousTime;
+    double accessFraction = 1.0;
+    bool accessAvailable;
+    if (this->useAccessWindows) {
+        //! - scale the downlink by the part of the time step that lies within an access window
+        accessFraction = this->computeAccessFraction(currentTime);
+        accessAvailable = accessFraction > 0.0;
+        this->currentTimestep = currentTime - this->previousUpdateTime;
+        this->previousUpdateTime = currentTime;
+    } else {
+        accessAvailable = std::any_of(this->groundLocationAccessMsgs.begin(), this->groundLocationAccessMsgs.end(), [](AccessSimMsg msg){return msg.hasAccess>0;});
+        this->currentTimestep = currentTime - this->previousTime;
+    }
 
-    dataUsageSimMsg->baudRate = this->nodeBaudRate;
+    dataUsageSimMsg->baudRate = this->nodeBaudRate*accessFraction;
 
     //! - If we have access to any ground location, do the transmission logic
-    if (std::any_of(this->groundLocationAccessMsgs.begin(), this->groundLocationAccessMsgs.end(), [](AccessSimMsg msg){return msg.hasAccess>0;})){
+    if (accessAvailable){
         //! - If we have no transmitted any of the packet, we select a new type of data to downlink
         if (this->packetTransmitted == 0.0) {
 
@@ -155,7 +178,7 @@ void SpaceToGroundTransmitter::evaluateDataModel(DataNodeUsageSimMsg *dataUsageS
 
             // strncpy nodeDataName to the name of the output message
             strncpy(dataUsageSimMsg->dataName, this->nodeDataName, sizeof(dataUsageSimMsg->dataName));
-            this->packetTransmitted += this->nodeBaudRate * (this->currentTimestep);
+            this->packetTransmitted += this->nodeBaudRate * accessFraction * (this->currentTimestep);
 
             // Check to see if maxVal is less than packet size.
             // If so, set the output message baudRate to zero
@@ -167,7 +190,7 @@ void SpaceToGroundTransmitter::evaluateDataModel(DataNodeUsageSimMsg *dataUsageS
         }
         else {
             strncpy(dataUsageSimMsg->dataName, this->nodeDataName, sizeof(dataUsageSimMsg->dataName));
-            this->packetTransmitted += this->nodeBaudRate * (this->currentTimestep);
+            this->packetTransmitted += this->nodeBaudRate * accessFraction * (this->currentTimestep);
             // If the transmitted packet size has exceeded the packet size, set packetTransmitted to zero
             if (this->packetTransmitted <= this->packetSize) {
                 this->packetTransmitted = 0.0;
@@ -182,3 +205,28 @@ void SpaceToGroundTransmitter::evaluateDataModel(DataNodeUsageSimMsg *dataUsageS
         this->packetTransmitted = 0;
     }
 }
+
+/*! Computes the fraction of the time step since the previous evaluation that lies within the access window of any
+ ground location.  Access messages without a predicted window, i.e. with a negative AOS time or a LOS time that is not
+ after the AOS time as for zero initialized messages, fall back to their hasAccess flag.
+ @return double fraction of the time step with access
+ @param currentTime [s] current simulation time
+ */
+double SpaceToGroundTransmitter::computeAccessFraction(double currentTime){
+    double timeStep = currentTime - this->previousUpdateTime;
+    double accessFraction = 0.0;
+    std::vector<AccessSimMsg>::iterator it;
+    for(it = this->groundLocationAccessMsgs.begin(); it != this->groundLocationAccessMsgs.end(); it++){
+        double fraction;
+        if (it->aosTime < 0.0 || it->losTime <= it->aosTime) {
+            fraction = it->hasAccess > 0 ? 1.0 : 0.0;
+        } else if (timeStep <= 0.0) {
+            fraction = (currentTime >= it->aosTime && currentTime <= it->losTime) ? 1.0 : 0.0;
+        } else {
+            double overlap = std::min(currentTime, it->losTime) - std::max(this->previousUpdateTime, it->aosTime);
+            fraction = std::min(std::max(overlap/timeStep, 0.0), 1.0);
+        }
+        accessFraction = std::max(accessFraction, fraction);
+    }
+    return(accessFraction);
+}
@@ -37,6 +37,8 @@ private:
     void evaluateDataModel(DataNodeUsageSimMsg *dataUsageMsg, double currentTime);
     bool customReadMessages();
     void customCrossInit();
+    void customReset(uint64_t CurrentClock);
+    double computeAccessFraction(double currentTime);
 
 public:
     double packetSize; //!< Size of packet to downklink (bytes)
@@ -47,12 +49,14 @@ public:
     std::vector<std::int64_t> groundLocationAccessMsgIds;   //!< class variable
     std::vector<DataStorageStatusSimMsg> storageUnitMsgs;   //!< class variable
     uint64_t hasAccess;                                     //!< class variable
+    bool useAccessWindows;                                  //!< flag to scale the downlink by the fraction of the time step within the AOS and LOS times of the access messages, defaults to false
     BSKLogger bskLogger;                                    //!< class variable
 
 private:
     double packetTransmitted; //!< Amount of packet downlinked (bytes)
     double currentTimestep; //!< Current timestep tracked for data packet integration
     double previousTime; //!< Previous timestep tracked for data packet integration
+    double previousUpdateTime; //!< [s] Time of the previous model evaluation, used with the access windows
     std::vector<dataInstance> storedData; //! Vector of data. Represents the makeup of the data buffer. Created from input messages.
     std::vector<AccessSimMsg> groundLocationAccessMsgs; //!< class variable
 };
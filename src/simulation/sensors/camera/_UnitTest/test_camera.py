@@ -223,6 +223,80 @@ def cameraTest(show_plots, image, gauss, darkCurrent, saltPepper, cosmic, blurSi
     return [testFailCount, ''.join(testMessages)]
 
 
+@pytest.mark.skipif(importErr, reason=reasonErr)
+def test_reproducibility():
+    """
+        **Validation Test Description**
+
+        The noise, hot and dead pixels and cosmic rays are drawn from counter-based random numbers derived from the
+        module ``RNGSeed``. The same image is corrupted twice with the same seed and once with a different seed.
+
+        **Description of Variables Being Tested**
+
+        The two images corrupted with the same seed must be identical, and the image corrupted with the other seed
+        must differ from them.
+        """
+    image = "mars.jpg"
+    imagePath = path + '/' + image
+    outputs = []
+    for run, seed in enumerate([10, 10, 11]):
+        saveDir = path + '/seed' + str(run) + '_'
+        outputs.append(np.array(corruptImage(imagePath, saveDir, seed), dtype=float))
+        try:
+            os.remove(saveDir + '0.000000.png')
+        except FileNotFoundError:
+            pass
+
+    assert np.array_equal(outputs[0], outputs[1]), "Images corrupted with the same seed differ"
+    assert not np.array_equal(outputs[0], outputs[2]), "Images corrupted with different seeds are identical"
+
+
+def corruptImage(imagePath, saveDir, seed):
+    """
+    Corrupts an image with noise, hot and dead pixels and cosmic rays for one time step and returns the saved image.
+
+    :param imagePath: path of the image to corrupt
+    :param saveDir: prefix of the saved image
+    :param seed: random seed of the camera module
+
+    """
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProcessRate = macros.sec2nano(0.5)
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    moduleConfig = camera.Camera()
+    moduleConfig.ModelTag = "cameras"
+    moduleConfig.RNGSeed = seed
+    unitTestSim.AddModelToTask(unitTaskName, moduleConfig)
+    moduleConfig.imageInMsgName = "sample_image"
+    moduleConfig.cameraOutMsgName = "cameraOut"
+    moduleConfig.imageOutMsgName = "out_image"
+    moduleConfig.filename = imagePath
+    moduleConfig.saveImages = True
+    moduleConfig.saveDir = saveDir
+
+    inputMessageData = camera.CameraImageMsg()
+    inputMessageData.timeTag = int(1E9)
+    inputMessageData.cameraID = 1
+    unitTestSupport.setMessage(unitTestSim.TotalSim,
+                               unitProcessName,
+                               moduleConfig.imageInMsgName,
+                               inputMessageData)
+    moduleConfig.cameraIsOn = 1
+
+    moduleConfig.gaussian = 2
+    moduleConfig.saltPepper = 2
+    moduleConfig.cosmicRays = 2
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.TotalSim.SingleStepProcesses()
+
+    return Image.open(saveDir + '0.000000.png')
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
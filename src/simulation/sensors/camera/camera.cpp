@@ -39,6 +39,8 @@ Camera::Camera()
 {
     this->OutputBufferCount = 2;
     this->pointImageOut = NULL;
+    this->rawImageOut = 0;
+    this->CurrentSimNanos = 0;
     
     /*! Default values for the camera.  */
     strcpy(this->parentName, "spacecraft");
@@ -88,9 +90,16 @@ void Camera::CrossInit()
     this->imageInMsgID = SystemMessaging::GetInstance()->subscribeToMessage(this->imageInMsgName,sizeof(CameraImageMsg), this->moduleID);
 }
 
-/*! This is the destructor */
+/*! This is the destructor, it hands the raw frames still referenced by the output messages back to the pool */
 Camera::~Camera()
 {
+    while (!this->framesOut.empty()) {
+        ImageFramePool::GetInstance()->release(this->framesOut.front());
+        this->framesOut.pop_front();
+    }
+    if (this->pointImageOut != NULL) {
+        free(this->pointImageOut);
+    }
     return;
 }
 
@@ -104,6 +113,147 @@ void Camera::Reset(uint64_t CurrentSimNanos)
     return;
 }
 
+/*! Stream identifiers of the camera random draws, so that each corruption uses independent random numbers */
+enum cameraNoiseStream {
+    CAMERA_NOISE_GAUSSIAN = 1,
+    CAMERA_NOISE_SALT_PEPPER = 2,
+    CAMERA_NOISE_COSMIC_RAY = 3
+};
+
+/*! Number of image rows corrupted together by the fused per-pixel pass, small enough to stay in cache */
+#define CAMERA_FILTER_BLOCK_ROWS 16
+
+/*!
+ * Counter-based random number generator.  This is the SplitMix64 finalizer of the key and counter, so each draw
+ * only depends on (key, counter) and the draws can be evaluated in any order, or in parallel, with the same result.
+ * @param key stream key
+ * @param counter index of the draw in the stream
+ * @return uint64_t 64 random bits
+ */
+static inline uint64_t cameraRandomBits(uint64_t key, uint64_t counter)
+{
+    uint64_t z = key + (counter + 1)*0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*!
+ * Maps 32 random bits to a uniform integer in [lower, upper)
+ * @param bits random bits
+ * @param lower smallest value
+ * @param upper one past the largest value
+ * @return int uniform integer
+ */
+static inline int cameraUniformInt(uint32_t bits, int lower, int upper)
+{
+    return lower + (int) (((uint64_t) bits*(uint64_t) (upper - lower)) >> 32);
+}
+
+/*!
+ * Returns the key of a random stream.  Streams seeded with the frame time change every frame, the others are the
+ * same for every frame.  Both only depend on the module RNGSeed.
+ * @param stream stream identifier
+ * @param frameTime [ns] time of the frame, or 0 for a stream that is the same for every frame
+ * @return uint64_t stream key
+ */
+uint64_t Camera::noiseKey(uint64_t stream, uint64_t frameTime)
+{
+    return cameraRandomBits(cameraRandomBits(this->RNGSeed, frameTime), stream);
+}
+
+/*!
+ * Adds rounded Gaussian noise to rows of an 8-bit image in place, saturating the pixel values.  Pixel values that
+ * end up at or below zeroBelow are set to zero.  Each pair of consecutive values uses the two Box-Muller outputs of
+ * one counter-based draw, indexed by the position of the value in the image.
+ * @param image image to modify
+ * @param rowStart first row to modify
+ * @param rowEnd one past the last row to modify
+ * @param key noise stream key
+ * @param mean noise mean
+ * @param stdDev noise standard deviation
+ * @param zeroBelow threshold for the pixel values, -1 to keep all values
+ * @return void
+ */
+void Camera::AddNoiseRows(cv::Mat &image, int rowStart, int rowEnd, uint64_t key, double mean, double stdDev, int zeroBelow)
+{
+    const size_t rowValues = (size_t) image.cols*image.channels();
+    double noise[2];
+    for (int row = rowStart; row < rowEnd; row++) {
+        uchar *pixel = image.ptr<uchar>(row);
+        size_t index = (size_t) row*rowValues;
+        for (size_t k = 0; k < rowValues; k++, index++) {
+            /*! - Draw a new normal pair on even indices, or at the start of the row */
+            if (k == 0 || (index & 1) == 0) {
+                uint64_t bits = cameraRandomBits(key, index >> 1);
+                double u1 = ((double) (bits >> 32) + 0.5)*(1.0/4294967296.0);
+                double u2 = (double) (bits & 0xFFFFFFFFULL)*(1.0/4294967296.0);
+                double r = std::sqrt(-2.0*std::log(u1));
+                noise[0] = r*std::cos(2.0*M_PI*u2);
+                noise[1] = r*std::sin(2.0*M_PI*u2);
+            }
+            int value = pixel[k] + cv::saturate_cast<short>(mean + stdDev*noise[index & 1]);
+            value = cv::saturate_cast<uchar>(value);
+            pixel[k] = value > zeroBelow ? (uchar) value : 0;
+        }
+    }
+}
+
+/*!
+ * Builds the lookup table of the HSV adjustment, applied to an 8-bit HSV image
+ * @return cv::Mat 256 entry lookup table with 3 channels
+ */
+cv::Mat Camera::HSVLookupTable()
+{
+    cv::Mat lut(1, 256, CV_8UC3);
+    // convert radians to degrees and multiply by 2
+    // user assumes range hue range is 0-2pi and not 0-180
+    int input_degrees = (int) (this->hsv[0] * R2D);
+    for (int value = 0; value < 256; value++) {
+        // Hue is in [0, 180), saturation and value are in [0, 255]
+        int h_360 = (value * 2) + input_degrees;
+        h_360 -= 360 * std::floor(h_360 * (1. / 360.));
+        h_360 = h_360/2;
+        if(h_360 == 180){ h_360 = 0; }
+        lut.at<cv::Vec3b>(0, value)[0] = (uchar) h_360;
+        for(int k = 1; k < 3; k++){
+            int adjusted = value * (this->hsv[k]/100. + 1.);
+            // saturate S and V values to [0,255]
+            if(adjusted < 0){ adjusted = 0; }
+            if(adjusted > 255){ adjusted = 255; }
+            lut.at<cv::Vec3b>(0, value)[k] = (uchar) adjusted;
+        }
+    }
+    return lut;
+}
+
+/*!
+ * Builds the lookup table of the dark current offset followed by the BGR adjustment.  Either step can be disabled.
+ * @param darkCurrent scaling factor for dark current, 0 to skip it
+ * @param adjustBGR true to apply the BGR adjustment
+ * @return cv::Mat 256 entry lookup table with 3 channels
+ */
+cv::Mat Camera::ColorLookupTable(double darkCurrent, bool adjustBGR)
+{
+    cv::Mat lut(1, 256, CV_8UC3);
+    /*! - Dark current is Gaussian noise with a mean of 15 times the dark current and no deviation, a constant offset */
+    short offset = darkCurrent > 0 ? cv::saturate_cast<short>(darkCurrent * 15) : 0;
+    for (int value = 0; value < 256; value++) {
+        for(int k = 0; k < 3; k++){
+            int adjusted = cv::saturate_cast<uchar>(value + offset);
+            if (adjustBGR) {
+                // BGR values range [0, 255]
+                adjusted = (int) (adjusted * (this->bgrPercent[k]/100. + 1.));
+                // deal with overflow
+                if(adjusted < 0){ adjusted = 0; }
+                if(adjusted > 255){ adjusted = 255; }
+            }
+            lut.at<cv::Vec3b>(0, value)[k] = (uchar) adjusted;
+        }
+    }
+    return lut;
+}
+
 /*!
  * Adjusts the HSV values of each pixel.
  * Can be used to shift the hue, saturation, and brightness of an image.
@@ -112,34 +262,10 @@ void Camera::Reset(uint64_t CurrentSimNanos)
  * @return void
  */
 void Camera::HSVAdjust(const cv::Mat mSrc, cv::Mat &mDst){
-    cv::Mat hsv;
-    cvtColor(mSrc, hsv, cv::COLOR_BGR2HSV);
-    
-    for (int j = 0; j < mSrc.rows; j++) {
-        for (int i = 0; i < mSrc.cols; i++) {
-            // Saturation is hsv.at<Vec3b>(j, i)[1] range: [0-255]
-            // Value is hsv.at<Vec3b>(j, i)[2] range: [0-255]
-            
-            // convert radians to degrees and multiply by 2
-            // user assumes range hue range is 0-2pi and not 0-180
-            int input_degrees = (int) (this->hsv[0] * R2D);
-            int h_360 = (hsv.at<cv::Vec3b>(j, i)[0] * 2) + input_degrees;
-            h_360 -= 360 * std::floor(h_360 * (1. / 360.));
-            h_360 = h_360/2;
-            if(h_360 == 180){ h_360 = 0; }
-            hsv.at<cv::Vec3b>(j, i)[0] = h_360;
-
-            int values[3];
-            for(int k = 1; k < 3; k++){
-                values[k] = hsv.at<cv::Vec3b>(j, i)[k] * (this->hsv[k]/100. + 1.);
-                // saturate S and V values to [0,255]
-                if(values[k] < 0){ values[k] = 0; }
-                if(values[k] > 255){ values[k] = 255; }
-                hsv.at<cv::Vec3b>(j, i)[k] = values[k];
-            }
-        }
-    }
-    cvtColor(hsv, mDst, cv::COLOR_HSV2BGR);
+    cv::Mat hsvImage;
+    cvtColor(mSrc, hsvImage, cv::COLOR_BGR2HSV);
+    cv::LUT(hsvImage, this->HSVLookupTable(), hsvImage);
+    cvtColor(hsvImage, mDst, cv::COLOR_HSV2BGR);
 }
 
 /*!
@@ -150,30 +276,13 @@ void Camera::HSVAdjust(const cv::Mat mSrc, cv::Mat &mDst){
  * @return void
  */
 void Camera::BGRAdjustPercent(const cv::Mat mSrc, cv::Mat &mDst){
-    cv::Mat mBGR = cv::Mat(mSrc.size(), mSrc.type());
-    mSrc.convertTo(mBGR, mSrc.type());
-    
-    // BGR values range [0, 255]
-    // if value after adjustment is < 0 take 0
-    // if value after is > 255 take 255
-    for (int j = 0; j < mSrc.rows; j++) {
-        for (int i = 0; i < mSrc.cols; i++) {
-            int values[3];
-            for(int k = 0; k < 3; k++){
-                values[k] = (int) (mBGR.at<cv::Vec3b>(j,i)[k] * (this->bgrPercent[k]/100. + 1.));
-                // deal with overflow
-                if(values[k] < 0){ values[k] = 0; }
-                if(values[k] > 255){ values[k] = 255; }
-                mBGR.at<cv::Vec3b>(j,i)[k] = values[k];
-            }
-        }
-    }
-    mBGR.convertTo(mDst, mSrc.type());
+    cv::LUT(mSrc, this->ColorLookupTable(0, true), mDst);
 }
 
 /*!
  * Adds gaussian noise to an image.
- * Can be used to add color noise and dark current.
+ * Can be used to add color noise and dark current.  The noise is drawn from the module RNGSeed and the current
+ * simulation time, so it is reproducible.
  * @param mSrc source image
  * @param mDst destination of modified image
  * @param Mean mean pixel value
@@ -182,20 +291,15 @@ void Camera::BGRAdjustPercent(const cv::Mat mSrc, cv::Mat &mDst){
  */
 void Camera::AddGaussianNoise(const cv::Mat mSrc, cv::Mat &mDst, double Mean, double StdDev)
 {
-    cv::Mat mSrc_16SC;
-    //CV_16SC3 means signed 16 bit shorts three channels
-    cv::Mat mGaussian_noise = cv::Mat(mSrc.size(), CV_16SC3);
-    /*!  Generates random noise in a normal distribution.*/
-    randn(mGaussian_noise, cv::Scalar::all(Mean), cv::Scalar::all(StdDev));
-    
-    mSrc.convertTo(mSrc_16SC, CV_16SC3);
-    /*!  Adds the noise layer to the image layer with a weighted add to prevent overflowing the pixels.*/
-    addWeighted(mSrc_16SC, 1.0, mGaussian_noise, 1.0, 0.0, mSrc_16SC);
-    mSrc_16SC.convertTo(mDst,mSrc.type());
+    if (mDst.data != mSrc.data) {
+        mSrc.copyTo(mDst);
+    }
+    this->AddNoiseRows(mDst, 0, mDst.rows, this->noiseKey(CAMERA_NOISE_GAUSSIAN, this->CurrentSimNanos), Mean, StdDev, -1);
 }
 
 /*!
- * Adds dead and hot pixels to an image.
+ * Adds dead and hot pixels to an image.  The pixels only depend on the module RNGSeed, so they are the same
+ * frame to frame.
  * @param mSrc source image
  * @param mDst destination of modified image
  * @param pa probability of dead pixels
@@ -203,40 +307,23 @@ void Camera::AddGaussianNoise(const cv::Mat mSrc, cv::Mat &mDst, double Mean, do
  * @return void
  */
 void Camera::AddSaltPepper(const cv::Mat mSrc, cv::Mat &mDst, float pa, float pb){
-    /*! These lines will make the hot and dead pixels different every time.*/
-    // uint64 initValue = time(0);
-    // RNG rng(initValue);
-    
-    /*! This line makes the hot and dead pixels the same frame to frame.*/
-    cv::RNG rng;
+    uint64_t key = this->noiseKey(CAMERA_NOISE_SALT_PEPPER, 0);
     
     /*!  Determines the amount of hot/dead pixels based on the input probabilities.*/
     int amount1 = mSrc.rows * mSrc.cols * pa;
     int amount2 = mSrc.rows * mSrc.cols * pb;
+    size_t pixelSize = mSrc.elemSize();
     
-    cv::Mat mSaltPepper = cv::Mat(mSrc.size(), mSrc.type());
-    mSrc.convertTo(mSaltPepper, mSrc.type());
-    
-    cv::Vec3b black;
-    black.val[0] = 0;
-    black.val[1] = 0;
-    black.val[2] = 0;
-    
-    cv::Vec3b white;
-    white.val[0] = 255;
-    white.val[1] = 255;
-    white.val[2] = 255;
-    
-    /*!  Chooses random pixels to be stuck or dead in the amount calculated previously.*/
-    for(int counter = 0; counter < amount1; counter++){
-        mSaltPepper.at<cv::Vec3b>(rng.uniform(0, mSaltPepper.rows), rng.uniform(0, mSaltPepper.cols)) = black;
+    if (mDst.data != mSrc.data) {
+        mSrc.copyTo(mDst);
     }
-    
-    for(int counter = 0; counter < amount2; counter++){
-        mSaltPepper.at<cv::Vec3b>(rng.uniform(0, mSaltPepper.rows), rng.uniform(0, mSaltPepper.cols)) = white;
+    /*!  Chooses random pixels to be stuck or dead in the amount calculated previously.*/
+    for(int counter = 0; counter < amount1 + amount2; counter++){
+        uint64_t bits = cameraRandomBits(key, counter);
+        int row = cameraUniformInt((uint32_t) (bits >> 32), 0, mDst.rows);
+        int col = cameraUniformInt((uint32_t) bits, 0, mDst.cols);
+        memset(mDst.ptr<uchar>(row) + col*pixelSize, counter < amount1 ? 0 : 255, pixelSize);
     }
-    
-    mSaltPepper.convertTo(mDst, mSrc.type());
 }
 
 /*!
@@ -249,26 +336,26 @@ void Camera::AddSaltPepper(const cv::Mat mSrc, cv::Mat &mDst, float pa, float pb
  * @return void
  */
 void Camera::AddCosmicRay(const cv::Mat mSrc, cv::Mat &mDst, float probThreshhold, double randOffset, int maxSize){
-    /*! Uses the current sim time and the random offset to ensure a different ray every time.*/
-    uint64 initValue = CurrentSimNanos;
-    cv::RNG rng(initValue + time(0) + randOffset);
+    /*! Uses the module seed, the current sim time and the random offset to get a different, reproducible, ray every time.*/
+    uint64_t key = this->noiseKey(CAMERA_NOISE_COSMIC_RAY, this->CurrentSimNanos);
+    uint64_t counter = 3*(uint64_t) randOffset;
     
-    float prob = rng.uniform(0.0, 1.0);
+    if (mDst.data != mSrc.data) {
+        mSrc.copyTo(mDst);
+    }
+    float prob = (float) ((cameraRandomBits(key, counter) >> 11)*(1.0/9007199254740992.0));
     if (prob > probThreshhold) {
-        cv::Mat mCosmic = cv::Mat(mSrc.size(), mSrc.type());
-        mSrc.convertTo(mCosmic, mSrc.type());
-    
         /*!  Chooses a random point on the image. Then chooses a second random point within 50 pixels in either direction.*/
-        int x = rng.uniform(0, mCosmic.rows);
-        int y = rng.uniform(0, mCosmic.cols);
-        int deltax = rng.uniform(-maxSize/2, maxSize/2);
-        int deltay = rng.uniform(-maxSize/2, maxSize/2);
+        uint64_t bitsPoint = cameraRandomBits(key, counter + 1);
+        uint64_t bitsDelta = cameraRandomBits(key, counter + 2);
+        int x = cameraUniformInt((uint32_t) (bitsPoint >> 32), 0, mDst.rows);
+        int y = cameraUniformInt((uint32_t) bitsPoint, 0, mDst.cols);
+        int deltax = cameraUniformInt((uint32_t) (bitsDelta >> 32), -maxSize/2, maxSize/2);
+        int deltay = cameraUniformInt((uint32_t) bitsDelta, -maxSize/2, maxSize/2);
         
         cv::Point p1 = cv::Point(x, y);
         cv::Point p2 = cv::Point(x + deltax, y + deltay);
-        line(mCosmic, p1, p2, cv::Scalar(255, 255, 255), 1, cv::LINE_8);
-    
-        mCosmic.convertTo(mDst, mSrc.type());
+        line(mDst, p1, p2, cv::Scalar(255, 255, 255), 1, cv::LINE_8);
     }
 }
 
@@ -281,19 +368,24 @@ void Camera::AddCosmicRay(const cv::Mat mSrc, cv::Mat &mDst, float probThreshhol
  * @return void
  */
 void Camera::AddCosmicRayBurst(const cv::Mat mSrc, cv::Mat &mDst, double num){
-    cv::Mat mCosmic = cv::Mat(mSrc.size(), mSrc.type());
-    mSrc.convertTo(mCosmic, mSrc.type());
+    if (mDst.data != mSrc.data) {
+        mSrc.copyTo(mDst);
+    }
     for(int i = 0; i < std::round(num); i++){
         /*! Threshold defined such that 1 provides a 1/50 chance of getting a ray, and 10 will get about 5 rays per image*/
         /*! Currently length is limited to 50 pixels*/
-        AddCosmicRay(mCosmic, mCosmic, 1/(std::pow(num,2)), i+1, 50);
+        AddCosmicRay(mDst, mDst, 1/(std::pow(num,2)), i+1, 50);
     }
-    mCosmic.convertTo(mDst, mSrc.type());
 }
 
 /*!
  * Applys all of the various pertubations to an image with user specified levels.
  * Each parameter is a double scaling actor. A parameter of 0 will result in the respective perturbation not being applied.
+ * The image is copied once into mDst, which keeps its memory if it already has the right size and type, and all the
+ * corruptions are applied in place.  The per-pixel corruptions (Gaussian noise, dark current, HSV and BGR
+ * adjustments) are fused into a single parallel pass over blocks of rows, split in two when the image is blurred
+ * between the noise and the color corruptions.  All the random draws are counter-based and derived from RNGSeed,
+ * so the corrupted images are reproducible and do not depend on the number of threads.
  * @param mSource source image
  * @param mDst destination of modified image
  * @param gaussian scaling factor for gaussian noise
@@ -305,38 +397,84 @@ void Camera::AddCosmicRayBurst(const cv::Mat mSrc, cv::Mat &mDst, double num){
  */
 void Camera::ApplyFilters(cv::Mat mSource, cv::Mat &mDst, double gaussian, double darkCurrent, double saltPepper, double cosmicRays, double blurparam){
 
-    cv::Mat mFilters(mSource.size(), mSource.type());
-    mSource.convertTo(mFilters, mSource.type());
+    bool addNoise = gaussian > 0;
+    bool adjustHSV = abs(this->hsv[0])+abs(this->hsv[1])+abs(this->hsv[2]) > 0.00001;
+    bool adjustBGR = abs(this->bgrPercent[0])+abs(this->bgrPercent[1])+abs(this->bgrPercent[2]) != 0;
+    bool adjustColor = darkCurrent > 0 || adjustHSV || adjustBGR;
+    bool blurImage = blurparam > 0;
 
-    if (gaussian > 0){
-        float scale = 2;
-        AddGaussianNoise(mFilters, mFilters, 0, gaussian * scale);
-        cv::threshold(mFilters, mFilters, gaussian*6, 255, cv::THRESH_TOZERO);
+    mSource.copyTo(mDst);
+
+    /*! - Precompute the per-pixel color corrections as lookup tables */
+    cv::Mat darkLUT, hsvLUT, colorLUT;
+    if (adjustHSV) {
+        darkLUT = this->ColorLookupTable(darkCurrent, false);
+        hsvLUT = this->HSVLookupTable();
+        colorLUT = this->ColorLookupTable(0, adjustBGR);
+    }
+    else {
+        colorLUT = this->ColorLookupTable(darkCurrent, adjustBGR);
     }
-    if(blurparam > 0){
+    uint64_t gaussianKey = this->noiseKey(CAMERA_NOISE_GAUSSIAN, this->CurrentSimNanos);
+    float scale = 2;
+    double gaussianStd = gaussian * scale;
+    int gaussianThreshold = cvFloor(gaussian*6);
+
+    /*! - Per-pixel pass over blocks of rows, in parallel: Gaussian noise, then dark current, HSV and BGR adjustments.
+     The stripe count is set explicitly, the OpenCV default is one stripe per row */
+    double stripes = std::ceil(mDst.rows/(double) CAMERA_FILTER_BLOCK_ROWS);
+    auto pixelPass = [&](bool noiseStep, bool colorStep) {
+        cv::parallel_for_(cv::Range(0, mDst.rows), [&](const cv::Range &rows) {
+            cv::Mat hsvBlock;
+            for (int rowStart = rows.start; rowStart < rows.end; rowStart += CAMERA_FILTER_BLOCK_ROWS) {
+                int rowEnd = std::min(rowStart + CAMERA_FILTER_BLOCK_ROWS, rows.end);
+                cv::Mat block = mDst.rowRange(rowStart, rowEnd);
+                if (noiseStep) {
+                    this->AddNoiseRows(mDst, rowStart, rowEnd, gaussianKey, 0, gaussianStd, gaussianThreshold);
+                }
+                if (colorStep) {
+                    if (adjustHSV) {
+                        if (darkCurrent > 0) {
+                            cv::LUT(block, darkLUT, block);
+                        }
+                        cvtColor(block, hsvBlock, cv::COLOR_BGR2HSV);
+                        cv::LUT(hsvBlock, hsvLUT, hsvBlock);
+                        cvtColor(hsvBlock, block, cv::COLOR_HSV2BGR);
+                        if (adjustBGR) {
+                            cv::LUT(block, colorLUT, block);
+                        }
+                    }
+                    else {
+                        cv::LUT(block, colorLUT, block);
+                    }
+                }
+            }
+        }, stripes);
+    };
+
+    if (blurImage) {
+        if (addNoise) {
+            pixelPass(true, false);
+        }
         int blurSize = std::round(blurparam);
         if (blurSize%2 == 0){blurSize+=1;}
-        blur(mFilters, mFilters, cv::Size(blurSize, blurSize), cv::Point(-1 , -1));
-    }
-    if(darkCurrent > 0){
-        float scale = 15;
-        AddGaussianNoise(mFilters, mFilters, darkCurrent * scale, 0.0);
-    }
-    if (abs(this->hsv[0])+abs(this->hsv[1])+abs(this->hsv[2]) > 0.00001) {
-        HSVAdjust(mFilters, mFilters);
+        blur(mDst, mDst, cv::Size(blurSize, blurSize), cv::Point(-1 , -1));
+        if (adjustColor) {
+            pixelPass(false, true);
+        }
     }
-    if (abs(this->bgrPercent[0])+abs(this->bgrPercent[1])+abs(this->bgrPercent[2]) != 0) {
-        BGRAdjustPercent(mFilters, mFilters);
+    else if (addNoise || adjustColor) {
+        pixelPass(addNoise, adjustColor);
     }
+
+    /*! - Sparse corruptions */
     if (saltPepper > 0){
-        float scale = 0.00002;
-        AddSaltPepper(mFilters, mFilters, saltPepper * scale, saltPepper * scale);
+        float scaleSP = 0.00002;
+        AddSaltPepper(mDst, mDst, saltPepper * scaleSP, saltPepper * scaleSP);
     }
     if(cosmicRays > 0){
-        AddCosmicRayBurst(mFilters, mFilters, std::round(cosmicRays));
+        AddCosmicRayBurst(mDst, mDst, std::round(cosmicRays));
     }
-    
-    mFilters.convertTo(mDst, mSource.type());
 }
 
 /*! This module reads an OpNav image and extracts circle information from its content using OpenCV's HoughCircle Transform. It performs a greyscale, a bur, and a threshold on the image to facilitate circle-finding. 
@@ -384,39 +522,78 @@ void Camera::UpdateState(uint64_t CurrentSimNanos)
     /* Added for debugging purposes*/
     if (!this->filename.empty()){
         imageCV = imread(this->filename, cv::IMREAD_COLOR);
-        ApplyFilters(imageCV, blurred, this->gaussian, this->darkCurrent, this->saltPepper, this->cosmicRays, this->blurParam);
+        ApplyFilters(imageCV, this->filterBuffer, this->gaussian, this->darkCurrent, this->saltPepper, this->cosmicRays, this->blurParam);
         if (this->saveImages == 1){
-            cv::imwrite(localPath, blurred);
+            cv::imwrite(localPath, this->filterBuffer);
         }
     }
     else if(imageBuffer.valid == 1 && imageBuffer.timeTag >= CurrentSimNanos){
-        /*! - Recast image pointer to CV type*/
-        std::vector<unsigned char> vectorBuffer((char*)imageBuffer.imagePointer, (char*)imageBuffer.imagePointer + imageBuffer.imageBufferLength);
-        imageCV = cv::imdecode(vectorBuffer, cv::IMREAD_COLOR);
-        
-        ApplyFilters(imageCV, blurred, this->gaussian, this->darkCurrent, this->saltPepper, this->cosmicRays, this->blurParam);
-        if (this->saveImages == 1){
-            cv::imwrite(localPath, blurred);
+        /*! - Recast image pointer to CV type. Raw frames are read in place, encoded ones are decoded without a copy*/
+        if (imageBuffer.imageFormat == IMAGE_FORMAT_RAW){
+            imageCV = cv::Mat(imageBuffer.imageHeight, imageBuffer.imageWidth, CV_8UC(imageBuffer.imageType),
+                              imageBuffer.imagePointer, (size_t) imageBuffer.imageStep);
+            /*! - The corruptions work on 3 channel BGR pixels, convert other raw frames the way imdecode does */
+            if (imageCV.channels() == 1){
+                cvtColor(imageCV, imageCV, cv::COLOR_GRAY2BGR);
+            }
+            else if (imageCV.channels() == 4){
+                cvtColor(imageCV, imageCV, cv::COLOR_BGRA2BGR);
+            }
         }
-        /*! If the permanent image buffer is not populated, it will be equal to null*/
-        if (this->pointImageOut != NULL) {
-            free(this->pointImageOut);
-            this->pointImageOut = NULL;
+        else{
+            cv::Mat encodedBuffer(1, imageBuffer.imageBufferLength, CV_8UC1, imageBuffer.imagePointer);
+            imageCV = cv::imdecode(encodedBuffer, cv::IMREAD_COLOR);
         }
-        /*! - Encode the cv mat into a png for the future modules to decode it the same way */
-        std::vector<unsigned char> buf;
-        std::vector<int> compression;
-        compression.push_back(0);
-        cv::imencode(".png", blurred, buf, compression);
+        
         /*! - Output the saved image */
         imageOut.valid = 1;
         imageOut.timeTag = imageBuffer.timeTag;
         imageOut.cameraID = imageBuffer.cameraID;
         imageOut.imageType = imageBuffer.imageType;
-        imageOut.imageBufferLength = (int32_t)buf.size();
-        this->pointImageOut = malloc(imageOut.imageBufferLength*sizeof(char));
-        memcpy(this->pointImageOut, &buf[0], imageOut.imageBufferLength*sizeof(char));
-        imageOut.imagePointer = this->pointImageOut;
+        if (this->rawImageOut == 1){
+            /*! - Apply the corruptions straight into a frame of the shared pool, the downstream modules read it as is */
+            size_t frameBytes = imageCV.total()*imageCV.elemSize();
+            void *frame = ImageFramePool::GetInstance()->acquire(frameBytes);
+            blurred = cv::Mat(imageCV.rows, imageCV.cols, imageCV.type(), frame);
+            ApplyFilters(imageCV, blurred, this->gaussian, this->darkCurrent, this->saltPepper, this->cosmicRays, this->blurParam);
+            if (this->saveImages == 1){
+                cv::imwrite(localPath, blurred);
+            }
+            imageOut.imageFormat = IMAGE_FORMAT_RAW;
+            imageOut.imageType = (int8_t) blurred.channels();
+            imageOut.imageWidth = blurred.cols;
+            imageOut.imageHeight = blurred.rows;
+            imageOut.imageStep = (int32_t) blurred.step;
+            imageOut.imageBufferLength = (int32_t) frameBytes;
+            imageOut.imagePointer = frame;
+            /*! - Keep the frames of the buffered output messages alive, and hand older ones back to the pool */
+            this->framesOut.push_back(frame);
+            while (this->framesOut.size() > this->OutputBufferCount) {
+                ImageFramePool::GetInstance()->release(this->framesOut.front());
+                this->framesOut.pop_front();
+            }
+        }
+        else{
+            ApplyFilters(imageCV, this->filterBuffer, this->gaussian, this->darkCurrent, this->saltPepper, this->cosmicRays, this->blurParam);
+            if (this->saveImages == 1){
+                cv::imwrite(localPath, this->filterBuffer);
+            }
+            /*! If the permanent image buffer is not populated, it will be equal to null*/
+            if (this->pointImageOut != NULL) {
+                free(this->pointImageOut);
+                this->pointImageOut = NULL;
+            }
+            /*! - Encode the cv mat into a png for the future modules to decode it the same way */
+            std::vector<unsigned char> buf;
+            std::vector<int> compression;
+            compression.push_back(0);
+            cv::imencode(".png", this->filterBuffer, buf, compression);
+            imageOut.imageFormat = IMAGE_FORMAT_ENCODED;
+            imageOut.imageBufferLength = (int32_t)buf.size();
+            this->pointImageOut = malloc(imageOut.imageBufferLength*sizeof(char));
+            memcpy(this->pointImageOut, &buf[0], imageOut.imageBufferLength*sizeof(char));
+            imageOut.imagePointer = this->pointImageOut;
+        }
         
         SystemMessaging::GetInstance()->WriteMessage(this->imageOutMsgID, CurrentSimNanos, sizeof(CameraImageMsg), reinterpret_cast<uint8_t *>(&imageOut), this->moduleID);
         
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <math.h>
+#include <deque>
 #include <Eigen/Dense>
 #include "architecture/messaging/system_messaging.h"
 #include "opencv2/opencv.hpp"
@@ -32,6 +33,7 @@
 #include "../simulation/simFswInterfaceMessages/cameraConfigMsg.h"
 #include "../simulation/_GeneralModuleFiles/sys_model.h"
 #include "../simulation/utilities/avsEigenMRP.h"
+#include "architecture/messaging/image_frame_pool.h"
 #include "utilities/bskLogging.h"
 
 /*! @brief visual camera class */
@@ -59,6 +61,7 @@ public:
     std::string saveDir;                //!< The name of the directory to save images
     uint64_t sensorTimeTag;              //!< [ns] Current time tag for sensor out
     int32_t saveImages;                  //!< [-] 1 to save images to file for debugging
+    int32_t rawImageOut;                 //!< [-] 1 to output raw frames from the shared frame pool, 0 (default) to output PNG buffers
     
     /*! Camera parameters */
     char parentName[MAX_MESSAGE_SIZE];  //!< [-] Name of the parent body to which the camera should be attached
@@ -88,6 +91,13 @@ private:
     int32_t cameraOutID;                //!< ID for the outgoing message
     uint64_t CurrentSimNanos;
     void* pointImageOut;      //!< void pointer for image memory passing
+    std::deque<void*> framesOut;        //!< raw frames referenced by the output message buffers, oldest first
+    cv::Mat filterBuffer;               //!< reused buffer holding the corrupted image of the encoded output
+
+    uint64_t noiseKey(uint64_t stream, uint64_t frameTime);
+    void AddNoiseRows(cv::Mat &image, int rowStart, int rowEnd, uint64_t key, double mean, double stdDev, int zeroBelow);
+    cv::Mat HSVLookupTable();
+    cv::Mat ColorLookupTable(double darkCurrent, bool adjustBGR);
 };
 
 /* @} */
@@ -22,6 +22,9 @@
 
 #define MAX_FILENAME_LENGTH 10000
 
+#define IMAGE_FORMAT_ENCODED 0  //!< imagePointer holds an encoded (PNG) image buffer
+#define IMAGE_FORMAT_RAW 1      //!< imagePointer holds raw 8-bit pixels from the shared image frame pool
+
 /*! @brief Structure used to define the image */
 
 #include "simFswInterfaceMessages/macroDefinitions.h"
@@ -34,6 +37,10 @@ typedef struct {
     void* imagePointer;        //!< -- Pointer to the image
     int32_t imageBufferLength; //!< -- Length of the buffer for recasting
     int8_t imageType;         //!< -- Number of channels in each pixel, RGB = 3, RGBA = 4
+    int8_t imageFormat;       //!< -- IMAGE_FORMAT_ENCODED (default) or IMAGE_FORMAT_RAW
+    int32_t imageWidth;       //!< [pix] Width of a raw image, in pixels
+    int32_t imageHeight;      //!< [pix] Height of a raw image, in pixels
+    int32_t imageStep;        //!< [-] Number of bytes in each row of a raw image
 }CameraImageMsg;
 
 
@@ -28,6 +28,8 @@ typedef struct {
     double slantRange;//!< [m] Range from a location to the spacecraft.
     double elevation;//!< [rad] Elevation angle for a given spacecraft.
     double azimuth; //!< [rad] Azimuth angle for a spacecraft.
+    double aosTime; //!< [s] Predicted acquisition of signal time of the current or next access window; -1 if no window is predicted.
+    double losTime; //!< [s] Predicted loss of signal time of the current or next access window; -1 if no window is predicted.
 }AccessSimMsg;
 
 
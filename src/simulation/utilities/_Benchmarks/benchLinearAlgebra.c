@@ -0,0 +1,227 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Micro-benchmark of the linearAlgebra matrix products for the shapes used by
+ * the FSW algorithms (attitude 3x3 math, thruster and reaction wheel mapping,
+ * the UKF sigma point and covariance products and larger blocks).
+ *
+ * Every case is first checked to be bitwise identical to the textbook triple
+ * loop, both for a separate output and for an output that overwrites one of
+ * the inputs, then timed.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchLinearAlgebra [repetition scale]
+ *
+ * The program returns a non-zero exit code if any result differs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "utilities/linearAlgebra.h"
+
+#define BENCH_MAX_DIM 128
+
+typedef enum {
+    BENCH_M_MULT_M,
+    BENCH_MT_MULT_M,
+    BENCH_M_MULT_MT,
+    BENCH_MT_MULT_MT,
+    BENCH_M_MULT_V,
+    BENCH_MT_MULT_V,
+    BENCH_M_TRANSPOSE
+} benchOp;
+
+typedef struct {
+    const char *name;       /* shape description */
+    benchOp op;             /* benchmarked function */
+    size_t n;               /* rows of the first operand as stored */
+    size_t m;               /* columns of the first operand as stored */
+    size_t p;               /* columns of the second operand as stored (or rows for mMultMt) */
+    long reps;              /* timed repetitions before scaling */
+} benchCase;
+
+static double benchA[BENCH_MAX_DIM*BENCH_MAX_DIM];
+static double benchB[BENCH_MAX_DIM*BENCH_MAX_DIM];
+static double benchC[BENCH_MAX_DIM*BENCH_MAX_DIM];
+static double benchRef[BENCH_MAX_DIM*BENCH_MAX_DIM];
+static double benchWork[BENCH_MAX_DIM*BENCH_MAX_DIM];
+
+/* Reference triple loop: C = op(A) op(B) with op(A) rows x inner and op(B) inner x cols */
+static void referenceMult(const double *a, int transA, const double *b, int transB,
+                          size_t rows, size_t inner, size_t cols, double *c)
+{
+    size_t i, j, k;
+    double aik, bkj;
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            c[i*cols + j] = 0.0;
+            for (k = 0; k < inner; k++) {
+                aik = transA ? a[k*rows + i] : a[i*inner + k];
+                bkj = transB ? b[j*inner + k] : b[k*cols + j];
+                c[i*cols + j] += aik * bkj;
+            }
+        }
+    }
+}
+
+/* Runs one call of the benchmarked function, writing the result to c */
+static void runOp(const benchCase *bc, double *a, double *b, double *c)
+{
+    switch (bc->op) {
+        case BENCH_M_MULT_M:
+            mMultM(a, bc->n, bc->m, b, bc->m, bc->p, c);
+            break;
+        case BENCH_MT_MULT_M:
+            mtMultM(a, bc->n, bc->m, b, bc->n, bc->p, c);
+            break;
+        case BENCH_M_MULT_MT:
+            mMultMt(a, bc->n, bc->m, b, bc->p, bc->m, c);
+            break;
+        case BENCH_MT_MULT_MT:
+            mtMultMt(a, bc->n, bc->m, b, bc->p, bc->n, c);
+            break;
+        case BENCH_M_MULT_V:
+            mMultV(a, bc->n, bc->m, b, c);
+            break;
+        case BENCH_MT_MULT_V:
+            mtMultV(a, bc->n, bc->m, b, c);
+            break;
+        case BENCH_M_TRANSPOSE:
+            mTranspose(a, bc->n, bc->m, c);
+            break;
+    }
+}
+
+/* Computes the expected result of one call and returns its number of elements */
+static size_t referenceOp(const benchCase *bc, const double *a, const double *b, double *c)
+{
+    size_t i, j;
+    switch (bc->op) {
+        case BENCH_M_MULT_M:
+            referenceMult(a, 0, b, 0, bc->n, bc->m, bc->p, c);
+            return bc->n*bc->p;
+        case BENCH_MT_MULT_M:
+            referenceMult(a, 1, b, 0, bc->m, bc->n, bc->p, c);
+            return bc->m*bc->p;
+        case BENCH_M_MULT_MT:
+            referenceMult(a, 0, b, 1, bc->n, bc->m, bc->p, c);
+            return bc->n*bc->p;
+        case BENCH_MT_MULT_MT:
+            referenceMult(a, 1, b, 1, bc->m, bc->n, bc->p, c);
+            return bc->m*bc->p;
+        case BENCH_M_MULT_V:
+            referenceMult(a, 0, b, 0, bc->n, bc->m, 1, c);
+            return bc->n;
+        case BENCH_MT_MULT_V:
+            referenceMult(a, 1, b, 0, bc->m, bc->n, 1, c);
+            return bc->m;
+        case BENCH_M_TRANSPOSE:
+            for (i = 0; i < bc->n; i++) {
+                for (j = 0; j < bc->m; j++) {
+                    c[j*bc->n + i] = a[i*bc->m + j];
+                }
+            }
+            return bc->n*bc->m;
+    }
+    return 0;
+}
+
+/* Checks the separate-output and in-place results against the reference, returns the number of failures */
+static int checkCase(const benchCase *bc)
+{
+    size_t numOut = referenceOp(bc, benchA, benchB, benchRef);
+    int failures = 0;
+
+    runOp(bc, benchA, benchB, benchC);
+    if (memcmp(benchC, benchRef, numOut*sizeof(double)) != 0) {
+        printf("MISMATCH %s\n", bc->name);
+        failures++;
+    }
+    /* overwrite the first operand when the result has the same size, as the FSW code often does */
+    if (numOut == bc->n*bc->m) {
+        memcpy(benchWork, benchA, bc->n*bc->m*sizeof(double));
+        runOp(bc, benchWork, benchB, benchWork);
+        if (memcmp(benchWork, benchRef, numOut*sizeof(double)) != 0) {
+            printf("MISMATCH (in place) %s\n", bc->name);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    const benchCase cases[] = {
+        {"mMultM 3x3 * 3x3", BENCH_M_MULT_M, 3, 3, 3, 4000000},
+        {"mtMultM 3x3' * 3x3", BENCH_MT_MULT_M, 3, 3, 3, 4000000},
+        {"mMultMt 3x3 * 3x3'", BENCH_M_MULT_MT, 3, 3, 3, 4000000},
+        {"mMultM 4x4 * 4x4", BENCH_M_MULT_M, 4, 4, 4, 2000000},
+        {"mMultM 6x6 * 6x6", BENCH_M_MULT_M, 6, 6, 6, 1000000},
+        {"mMultMt 6x6 * 6x6'", BENCH_M_MULT_MT, 6, 6, 6, 1000000},
+        {"mtMultMt 6x6' * 6x6'", BENCH_MT_MULT_MT, 6, 6, 6, 1000000},
+        {"mMultM 3x8 * 8x3 (thruster map)", BENCH_M_MULT_M, 3, 8, 3, 2000000},
+        {"mMultMt 3x8 * 3x8' (RW map)", BENCH_M_MULT_MT, 3, 8, 3, 2000000},
+        {"mtMultM 13x6' * 13x6 (UKF sigma)", BENCH_MT_MULT_M, 13, 6, 6, 500000},
+        {"mMultM 9x9 * 9x9", BENCH_M_MULT_M, 9, 9, 9, 300000},
+        {"mMultM 32x32 * 32x32", BENCH_M_MULT_M, 32, 32, 32, 10000},
+        {"mMultM 128x128 * 128x128", BENCH_M_MULT_M, 128, 128, 128, 100},
+        {"mMultMt 128x128 * 128x128'", BENCH_M_MULT_MT, 128, 128, 128, 100},
+        {"mMultV 6x6 * 6", BENCH_M_MULT_V, 6, 6, 1, 4000000},
+        {"mtMultV 3x8' * 3", BENCH_MT_MULT_V, 3, 8, 1, 4000000},
+        {"mTranspose 6x6", BENCH_M_TRANSPOSE, 6, 6, 1, 4000000},
+        {"mTranspose 13x6", BENCH_M_TRANSPOSE, 13, 6, 1, 2000000}
+    };
+    const size_t numCases = sizeof(cases)/sizeof(cases[0]);
+    double scale = 1.0;
+    double sink = 0.0;
+    double seconds;
+    int failures = 0;
+    size_t i;
+    long r, reps;
+    clock_t start;
+
+    if (argc > 1) {
+        scale = atof(argv[1]);
+    }
+    srand(1);
+    for (i = 0; i < BENCH_MAX_DIM*BENCH_MAX_DIM; i++) {
+        benchA[i] = rand()/(double) RAND_MAX - 0.5;
+        benchB[i] = rand()/(double) RAND_MAX - 0.5;
+    }
+
+    printf("%-36s %12s\n", "case", "ns/call");
+    for (i = 0; i < numCases; i++) {
+        failures += checkCase(&cases[i]);
+        reps = (long) (cases[i].reps*scale);
+        if (reps < 1) {
+            reps = 1;
+        }
+        start = clock();
+        for (r = 0; r < reps; r++) {
+            runOp(&cases[i], benchA, benchB, benchC);
+            sink += benchC[0];
+        }
+        seconds = (double) (clock() - start)/CLOCKS_PER_SEC;
+        printf("%-36s %12.1f\n", cases[i].name, seconds/reps*1.0e9);
+    }
+    printf("checksum %g, %d mismatches\n", sink, failures);
+    return failures != 0;
+}
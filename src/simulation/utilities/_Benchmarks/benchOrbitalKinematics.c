@@ -0,0 +1,310 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*
+ * Benchmark of the orbitalMotion and rigidBodyKinematics batch conversions
+ * against a loop over the scalar functions, on random orbits and attitudes
+ * as found in logged states.
+ *
+ * Both are timed, then every case is checked against the scalar results,
+ * or for the anomalies against the Kepler equation.  Build with -DBUILD_BENCHMARKS=ON and run
+ *
+ *     ./benchOrbitalKinematics [number of states]
+ *
+ * The program returns a non-zero exit code if any result differs by more
+ * than the case tolerance.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "utilities/orbitalMotion.h"
+#include "utilities/rigidBodyKinematics.h"
+#include "utilities/astroConstants.h"
+#include "utilities/linearAlgebra.h"
+
+typedef enum {
+    BENCH_M2E,
+    BENCH_N2H,
+    BENCH_ELEM2RV,
+    BENCH_RV2ELEM,
+    BENCH_MRP2EP,
+    BENCH_EP2MRP,
+    BENCH_MRP2C,
+    BENCH_C2MRP,
+    BENCH_EP2C,
+    BENCH_C2EP
+} benchOp;
+
+typedef struct {
+    const char *name;       /* case description */
+    benchOp op;             /* benchmarked conversion */
+    double tolerance;       /* largest accepted difference to the scalar result */
+} benchCase;
+
+static size_t benchN;
+static double *benchAnomaly;        /* mean anomalies */
+static double *benchEccElliptic;    /* elliptic eccentricities */
+static double *benchEccHyperbolic;  /* hyperbolic eccentricities */
+static classicElements *benchElements;
+static double *benchR;              /* n x 3 positions */
+static double *benchV;              /* n x 3 velocities */
+static double *benchMRP;            /* n x 3 MRPs */
+static double *benchEP;             /* n x 4 Euler parameters */
+static double *benchDCM;            /* n x 9 direction cosine matrices */
+static double *benchOut;            /* batch result */
+static double *benchRef;            /* scalar result */
+static classicElements *benchElemOut;
+static classicElements *benchElemRef;
+
+static double randomUniform(double low, double high)
+{
+    return low + (high - low)*rand()/(double) RAND_MAX;
+}
+
+/* Difference of two angles in [0, 2 pi), accounting for the wrap */
+static double angleDiff(double a, double b)
+{
+    double d = fabs(a - b);
+    return d > M_PI ? 2*M_PI - d : d;
+}
+
+/* Runs the batch (batch != 0) or the scalar loop version of a case and returns the number of output doubles */
+static size_t runOp(benchOp op, int batch)
+{
+    size_t k;
+    double *out = batch ? benchOut : benchRef;
+    classicElements *elemOut = batch ? benchElemOut : benchElemRef;
+
+    switch (op) {
+        case BENCH_M2E:
+            if (batch) {
+                M2EBatch(benchAnomaly, benchEccElliptic, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    out[k] = M2E(benchAnomaly[k], benchEccElliptic[k]);
+                }
+            }
+            return benchN;
+        case BENCH_N2H:
+            if (batch) {
+                N2HBatch(benchAnomaly, benchEccHyperbolic, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    out[k] = N2H(benchAnomaly[k], benchEccHyperbolic[k]);
+                }
+            }
+            return benchN;
+        case BENCH_ELEM2RV:
+            if (batch) {
+                elem2rvBatch(MU_EARTH, benchElements, benchN, out, out + 3*benchN);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    elem2rv(MU_EARTH, &benchElements[k], &out[3*k], &out[3*benchN + 3*k]);
+                }
+            }
+            return 6*benchN;
+        case BENCH_RV2ELEM:
+            if (batch) {
+                rv2elemBatch(MU_EARTH, benchR, benchV, benchN, elemOut);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    rv2elem(MU_EARTH, &benchR[3*k], &benchV[3*k], &elemOut[k]);
+                }
+            }
+            return 0;
+        case BENCH_MRP2EP:
+            if (batch) {
+                MRP2EPBatch(benchMRP, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    MRP2EP(&benchMRP[3*k], &out[4*k]);
+                }
+            }
+            return 4*benchN;
+        case BENCH_EP2MRP:
+            if (batch) {
+                EP2MRPBatch(benchEP, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    EP2MRP(&benchEP[4*k], &out[3*k]);
+                }
+            }
+            return 3*benchN;
+        case BENCH_MRP2C:
+            if (batch) {
+                MRP2CBatch(benchMRP, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    MRP2C(&benchMRP[3*k], (double (*)[3]) &out[9*k]);
+                }
+            }
+            return 9*benchN;
+        case BENCH_C2MRP:
+            if (batch) {
+                C2MRPBatch(benchDCM, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    C2MRP((double (*)[3]) &benchDCM[9*k], &out[3*k]);
+                }
+            }
+            return 3*benchN;
+        case BENCH_EP2C:
+            if (batch) {
+                EP2CBatch(benchEP, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    EP2C(&benchEP[4*k], (double (*)[3]) &out[9*k]);
+                }
+            }
+            return 9*benchN;
+        case BENCH_C2EP:
+            if (batch) {
+                C2EPBatch(benchDCM, benchN, out);
+            } else {
+                for (k = 0; k < benchN; k++) {
+                    C2EP((double (*)[3]) &benchDCM[9*k], &out[4*k]);
+                }
+            }
+            return 4*benchN;
+    }
+    return 0;
+}
+
+/* Returns the largest difference of the batch result to the scalar result, relative for lengths.  The anomalies
+ * are checked through the residual of the Kepler equation, as M2E() does not converge for some e close to 1. */
+static double compareOp(benchOp op, size_t numOut)
+{
+    double diff = 0.0;
+    size_t k;
+
+    if (op == BENCH_M2E) {
+        for (k = 0; k < benchN; k++) {
+            diff = fmax(diff, fabs(benchOut[k] - benchEccElliptic[k]*sin(benchOut[k]) - benchAnomaly[k]));
+        }
+        return diff;
+    }
+    if (op == BENCH_N2H) {
+        for (k = 0; k < benchN; k++) {
+            diff = fmax(diff, fabs(benchEccHyperbolic[k]*sinh(benchOut[k]) - benchOut[k] - benchAnomaly[k])
+                              /fmax(1.0, fabs(benchAnomaly[k])));
+        }
+        return diff;
+    }
+    if (op == BENCH_RV2ELEM) {
+        for (k = 0; k < benchN; k++) {
+            classicElements *a = &benchElemOut[k];
+            classicElements *b = &benchElemRef[k];
+            diff = fmax(diff, fabs(a->a - b->a)/fabs(b->a));
+            diff = fmax(diff, fabs(a->e - b->e));
+            diff = fmax(diff, fabs(a->i - b->i));
+            diff = fmax(diff, angleDiff(a->Omega, b->Omega));
+            diff = fmax(diff, angleDiff(a->omega, b->omega));
+            diff = fmax(diff, angleDiff(a->f, b->f));
+            diff = fmax(diff, fabs(a->rPeriap - b->rPeriap)/b->rPeriap);
+        }
+        return diff;
+    }
+    for (k = 0; k < numOut; k++) {
+        double scale = (op == BENCH_ELEM2RV) ? fmax(1.0, fabs(benchRef[k])) : 1.0;
+        diff = fmax(diff, fabs(benchOut[k] - benchRef[k])/scale);
+    }
+    return diff;
+}
+
+int main(int argc, char *argv[])
+{
+    const benchCase cases[] = {
+        {"M2E, 0 <= e < 0.99", BENCH_M2E, 1e-12},
+        {"N2H, 1 < e < 5", BENCH_N2H, 1e-12},
+        {"elem2rv", BENCH_ELEM2RV, 1e-13},
+        {"rv2elem", BENCH_RV2ELEM, 1e-10},
+        {"MRP2EP", BENCH_MRP2EP, 0.0},
+        {"EP2MRP", BENCH_EP2MRP, 0.0},
+        {"MRP2C", BENCH_MRP2C, 0.0},
+        {"C2MRP", BENCH_C2MRP, 0.0},
+        {"EP2C", BENCH_EP2C, 0.0},
+        {"C2EP", BENCH_C2EP, 0.0}
+    };
+    const size_t numCases = sizeof(cases)/sizeof(cases[0]);
+    double scalarSeconds, batchSeconds, diff;
+    int failures = 0;
+    size_t i, k, numOut;
+    clock_t start;
+
+    benchN = argc > 1 ? (size_t) atol(argv[1]) : 1000000;
+    benchAnomaly = malloc(benchN*sizeof(double));
+    benchEccElliptic = malloc(benchN*sizeof(double));
+    benchEccHyperbolic = malloc(benchN*sizeof(double));
+    benchElements = malloc(benchN*sizeof(classicElements));
+    benchElemOut = malloc(benchN*sizeof(classicElements));
+    benchElemRef = malloc(benchN*sizeof(classicElements));
+    benchR = malloc(3*benchN*sizeof(double));
+    benchV = malloc(3*benchN*sizeof(double));
+    benchMRP = malloc(3*benchN*sizeof(double));
+    benchEP = malloc(4*benchN*sizeof(double));
+    benchDCM = malloc(9*benchN*sizeof(double));
+    benchOut = malloc(9*benchN*sizeof(double));
+    benchRef = malloc(9*benchN*sizeof(double));
+
+    srand(1);
+    for (k = 0; k < benchN; k++) {
+        benchAnomaly[k] = randomUniform(-10.0, 10.0);
+        benchEccElliptic[k] = randomUniform(0.0, 0.99);
+        benchEccHyperbolic[k] = randomUniform(1.01, 5.0);
+        memset(&benchElements[k], 0, sizeof(classicElements));
+        benchElements[k].e = randomUniform(0.0, 0.9);
+        benchElements[k].a = randomUniform(7000.0, 42000.0)/(1.0 - benchElements[k].e);
+        benchElements[k].i = randomUniform(0.01, M_PI - 0.01);
+        benchElements[k].Omega = randomUniform(0.0, 2*M_PI);
+        benchElements[k].omega = randomUniform(0.0, 2*M_PI);
+        benchElements[k].f = randomUniform(0.0, 2*M_PI);
+        elem2rv(MU_EARTH, &benchElements[k], &benchR[3*k], &benchV[3*k]);
+        benchMRP[3*k] = randomUniform(-0.6, 0.6);
+        benchMRP[3*k + 1] = randomUniform(-0.6, 0.6);
+        benchMRP[3*k + 2] = randomUniform(-0.6, 0.6);
+        MRP2EP(&benchMRP[3*k], &benchEP[4*k]);
+        if (k % 2) {
+            vScale(-1.0, &benchEP[4*k], 4, &benchEP[4*k]);
+        }
+        MRP2C(&benchMRP[3*k], (double (*)[3]) &benchDCM[9*k]);
+    }
+
+    printf("%zu states\n%-22s %14s %14s %8s %12s\n", benchN, "case", "scalar ns", "batch ns", "speedup",
+           "difference");
+    for (i = 0; i < numCases; i++) {
+        start = clock();
+        numOut = runOp(cases[i].op, 0);
+        scalarSeconds = (double) (clock() - start)/CLOCKS_PER_SEC;
+        start = clock();
+        runOp(cases[i].op, 1);
+        batchSeconds = (double) (clock() - start)/CLOCKS_PER_SEC;
+        diff = compareOp(cases[i].op, numOut);
+        if (!(diff <= cases[i].tolerance)) {
+            printf("MISMATCH %s\n", cases[i].name);
+            failures++;
+        }
+        printf("%-22s %14.1f %14.1f %8.2f %12.3g\n", cases[i].name, scalarSeconds/benchN*1.0e9,
+               batchSeconds/benchN*1.0e9, scalarSeconds/batchSeconds, diff);
+    }
+    printf("%d mismatches\n", failures);
+    return failures != 0;
+}
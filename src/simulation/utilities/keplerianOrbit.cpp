@@ -20,6 +20,50 @@
 #include "keplerianOrbit.h"
 #include "utilities/astroConstants.h"
 #include <utilities/avsEigenSupport.h>
+#include "utilities/bsk_Print.h"
+
+/*! Evaluates the universal functions U_n(chi, alpha) = chi^n c_n(alpha chi^2), n = 0..5, where c_n are the
+ Stumpff functions.  Series are used for |alpha chi^2| < 1 where the closed forms of c_2 to c_5 cancel.
+ @param chi universal anomaly
+ @param alpha inverse of the semi-major axis, 0 for a parabola
+ @param U the universal functions U_0 to U_5
+ */
+static void universalFunctions(double chi, double alpha, double U[6])
+{
+    double z = alpha * chi * chi;
+    double c[6];
+    if(fabs(z) < 1.0) {
+        double fact = 1.0;
+        for(int k = 0; k < 6; k++) {
+            double term = 1.0 / fact;
+            c[k] = 0.0;
+            for(int j = 0; j < 12; j++) {
+                c[k] += term;
+                term *= -z / ((k + 2 * j + 1) * (k + 2 * j + 2));
+            }
+            fact *= k + 1;
+        }
+    } else {
+        if(z > 0) {
+            double s = sqrt(z);
+            c[0] = cos(s);
+            c[1] = sin(s) / s;
+        } else {
+            double s = sqrt(-z);
+            c[0] = cosh(s);
+            c[1] = sinh(s) / s;
+        }
+        c[2] = (1.0 - c[0]) / z;
+        c[3] = (1.0 - c[1]) / z;
+        c[4] = (0.5 - c[2]) / z;
+        c[5] = (1.0 / 6.0 - c[3]) / z;
+    }
+    double chiN = 1.0;
+    for(int k = 0; k < 6; k++) {
+        U[k] = chiN * c[k];
+        chiN *= chi;
+    }
+}
 
 /*! This constructor initialized to an arbitrary orbit */
 KeplerianOrbit::KeplerianOrbit()
@@ -204,5 +248,180 @@ void KeplerianOrbit::set_planet(GravBodyData *plt){
     return;
 }
 
+/*! This method moves the body along the orbit by the time dt.  The new true anomaly is found from the
+ universal variable solution, the other elements are unchanged.
+ @param dt [s] time of flight, may be negative
+ */
+void KeplerianOrbit::propagate(double dt){
+    Eigen::Vector3d r;
+    Eigen::Vector3d v;
+    this->propagateState(dt, NAN, r, v, nullptr);
+    Eigen::Vector3d hHat = this->orbital_angular_momentum_P.normalized();
+    double f = this->true_anomaly + atan2(hHat.dot(this->position_BP_P.cross(r)), this->position_BP_P.dot(r));
+    if(this->eccentricity < 1.0) {
+        f = fmod(f, 2 * M_PI);
+        if(f < 0.0) {
+            f += 2 * M_PI;
+        }
+    } else {
+        /* the swept angle is only known modulo 2 pi, open orbits stay within the asymptotes |f| < pi */
+        f = remainder(f, 2 * M_PI);
+    }
+    this->set_f(f);
+    return;
+}
+
+/*! This method returns the state transition matrix of the two-body motion from the current state to the
+ state a time dt later.  The matrix is the analytic derivative of the universal variable solution.
+ @param dt [s] time of flight, may be negative
+ @return Eigen::MatrixXd 6x6 matrix d[r; v](dt) / d[r; v](0)
+ */
+Eigen::MatrixXd KeplerianOrbit::stateTransitionMatrix(double dt){
+    Eigen::Vector3d r;
+    Eigen::Vector3d v;
+    Eigen::MatrixXd stm(6, 6);
+    this->propagateState(dt, NAN, r, v, &stm);
+    return stm;
+}
 
+/*! This method samples the orbit at many times without changing the orbit.  The times are solved in the
+ given order and each solution starts from the previous one advanced by the time step, at the mean rate of the
+ universal anomaly on closed orbits and at the rate of the previous sample otherwise.  Closely spaced sorted times
+ then converge in a few iterations.
+ @param times [s] times of flight from the current state
+ @return Eigen::MatrixXd Nx6 matrix with the position and velocity vectors [r_BP_P, v_BP_P] at each time
+ */
+Eigen::MatrixXd KeplerianOrbit::sampleStates(Eigen::VectorXd times){
+    Eigen::MatrixXd states(times.size(), 6);
+    Eigen::Vector3d r;
+    Eigen::Vector3d v;
+    double chi = NAN;
+    double r0Norm = this->position_BP_P.norm();
+    double alpha = 2.0 / r0Norm - this->velocity_BP_P.squaredNorm() / this->mu;
+    for(int k = 0; k < times.size(); k++) {
+        if(k > 0) {
+            /* the universal anomaly advances by sqrt(mu) alpha dt per orbit on average, sqrt(mu) dt / r locally */
+            if(alpha * r0Norm > 1e-6) {
+                chi += sqrt(this->mu) * (times[k] - times[k - 1]) * alpha;
+            } else {
+                chi += sqrt(this->mu) * (times[k] - times[k - 1]) / r.norm();
+            }
+        }
+        chi = this->propagateState(times[k], chi, r, v, nullptr);
+        states.block<1, 3>(k, 0) = r.transpose();
+        states.block<1, 3>(k, 3) = v.transpose();
+    }
+    return states;
+}
 
+/*! This method solves the universal Kepler equation sqrt(mu) dt = r0 U1 + sigma0 U2 + U3 for the universal
+ anomaly chi with Laguerre-Conway iterations and evaluates the Lagrange coefficients.  It holds for elliptic,
+ parabolic and hyperbolic orbits.  The state transition matrix is the chain rule of the Lagrange coefficients
+ through r0, sigma0 = r0.v0 / sqrt(mu), alpha = 2 / r0 - v0^2 / mu and chi, using
+ dU_n/dchi = U_(n-1) and dU_n/dalpha = (n U_(n+2) - chi U_(n+1)) / 2.
+ @param dt [s] time of flight from the current state
+ @param chi initial guess of the universal anomaly, NAN to start from the two-body guess, which is also used if
+ the iterations from the given guess do not converge
+ @param r position vector at dt
+ @param v velocity vector at dt
+ @param stm 6x6 state transition matrix at dt, not computed if nullptr
+ @return double universal anomaly at dt
+ */
+double KeplerianOrbit::propagateState(double dt, double chi, Eigen::Vector3d &r, Eigen::Vector3d &v,
+                                      Eigen::MatrixXd *stm){
+    double sqrtMu = sqrt(this->mu);
+    Eigen::Vector3d r0 = this->position_BP_P;
+    Eigen::Vector3d v0 = this->velocity_BP_P;
+    double r0Norm = r0.norm();
+    double sigma0 = r0.dot(v0) / sqrtMu;
+    double alpha = 2.0 / r0Norm - v0.squaredNorm() / this->mu;
+    double U[6];
+    bool warmStart = !std::isnan(chi);
+
+    /* initial guess, the mean motion for ellipses and the hyperbolic asymptote otherwise */
+    if(!warmStart) {
+        chi = sqrtMu * dt / r0Norm;
+        if(alpha * r0Norm > 1e-6) {
+            chi = sqrtMu * dt * alpha;
+        } else if(alpha * r0Norm < -1e-6 && dt != 0.0) {
+            double a = 1.0 / alpha;
+            double s = dt > 0 ? 1.0 : -1.0;
+            double arg = -2.0 * this->mu * alpha * dt
+                / (r0.dot(v0) + s * sqrt(-this->mu * a) * (1.0 - r0Norm * alpha));
+            if(arg > 0.0) {
+                chi = s * sqrt(-a) * log(arg);
+            }
+        }
+    }
+
+    /* Laguerre-Conway iterations, F(chi) = r0 U1 + sigma0 U2 + U3 - sqrt(mu) dt has F' = r > 0 */
+    double rNorm = r0Norm;
+    int iter;
+    for(iter = 0; iter < 50; iter++) {
+        universalFunctions(chi, alpha, U);
+        double F = r0Norm * U[1] + sigma0 * U[2] + U[3] - sqrtMu * dt;
+        rNorm = r0Norm * U[0] + sigma0 * U[1] + U[2];
+        double Fpp = sigma0 * U[0] + (1.0 - alpha * r0Norm) * U[1];
+        double dChi = 5.0 * F / (rNorm + sqrt(fabs(16.0 * rNorm * rNorm - 20.0 * F * Fpp)));
+        chi -= dChi;
+        if(fabs(dChi) <= 1e-13 * fabs(chi)) {
+            break;
+        }
+    }
+    if(iter == 50 && warmStart) {
+        /* a poor initial guess given by the caller is replaced by the two-body guess */
+        return this->propagateState(dt, NAN, r, v, stm);
+    }
+    if(iter == 50) {
+        BSK_PRINT(MSG_WARNING, "KeplerianOrbit: universal Kepler equation did not converge for dt = %g s.", dt);
+    }
+    universalFunctions(chi, alpha, U);
+    rNorm = r0Norm * U[0] + sigma0 * U[1] + U[2];
+
+    /* Lagrange coefficients */
+    double F = 1.0 - U[2] / r0Norm;
+    double G = (r0Norm * U[1] + sigma0 * U[2]) / sqrtMu;
+    double Ft = -sqrtMu * U[1] / (rNorm * r0Norm);
+    double Gt = 1.0 - U[2] / rNorm;
+    r = F * r0 + G * v0;
+    v = Ft * r0 + Gt * v0;
+
+    if(stm != nullptr) {
+        typedef Eigen::Matrix<double, 1, 6> Gradient;
+        Gradient dr0;
+        Gradient dSigma0;
+        Gradient dAlpha;
+        dr0 << r0.transpose() / r0Norm, 0.0, 0.0, 0.0;
+        dSigma0 << v0.transpose() / sqrtMu, r0.transpose() / sqrtMu;
+        dAlpha << -2.0 * r0.transpose() / pow(r0Norm, 3), -2.0 * v0.transpose() / this->mu;
+
+        /* partials of U_1 to U_3 in alpha at constant chi */
+        double U1a = (U[3] - chi * U[2]) / 2.0;
+        double U2a = (2.0 * U[4] - chi * U[3]) / 2.0;
+        double U3a = (3.0 * U[5] - chi * U[4]) / 2.0;
+        double U0a = -chi * U[1] / 2.0;
+
+        /* chi follows from the Kepler equation at constant dt */
+        Gradient dChi = -(U[1] * dr0 + U[2] * dSigma0 + (r0Norm * U1a + sigma0 * U2a + U3a) * dAlpha) / rNorm;
+        Gradient dU0 = -alpha * U[1] * dChi + U0a * dAlpha;
+        Gradient dU1 = U[0] * dChi + U1a * dAlpha;
+        Gradient dU2 = U[1] * dChi + U2a * dAlpha;
+        Gradient dR = U[0] * dr0 + r0Norm * dU0 + U[1] * dSigma0 + sigma0 * dU1 + dU2;
+
+        Gradient dF = -dU2 / r0Norm + U[2] / (r0Norm * r0Norm) * dr0;
+        Gradient dG = (U[1] * dr0 + r0Norm * dU1 + U[2] * dSigma0 + sigma0 * dU2) / sqrtMu;
+        Gradient dFt = -sqrtMu * (dU1 / (rNorm * r0Norm) - U[1] / pow(rNorm * r0Norm, 2) * (r0Norm * dR + rNorm * dr0));
+        Gradient dGt = -dU2 / rNorm + U[2] / (rNorm * rNorm) * dR;
+
+        stm->resize(6, 6);
+        stm->setZero();
+        stm->block<3, 3>(0, 0) = F * Eigen::Matrix3d::Identity();
+        stm->block<3, 3>(0, 3) = G * Eigen::Matrix3d::Identity();
+        stm->block<3, 3>(3, 0) = Ft * Eigen::Matrix3d::Identity();
+        stm->block<3, 3>(3, 3) = Gt * Eigen::Matrix3d::Identity();
+        stm->block<3, 6>(0, 0) += r0 * dF + v0 * dG;
+        stm->block<3, 6>(3, 0) += r0 * dFt + v0 * dGt;
+    }
+
+    return chi;
+}
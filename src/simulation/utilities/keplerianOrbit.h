@@ -67,6 +67,9 @@ public:
     void set_omega(double omega);
     void set_RAAN(double RAAN);
     void set_f(double f);
+    void propagate(double dt);
+    Eigen::MatrixXd stateTransitionMatrix(double dt);
+    Eigen::MatrixXd sampleStates(Eigen::VectorXd times);
     
 private:
     GravBodyData* planet;
@@ -96,5 +99,6 @@ private:
 private:
     void change_orbit();
     void change_f();
+    double propagateState(double dt, double chi, Eigen::Vector3d &r, Eigen::Vector3d &v, Eigen::MatrixXd *stm);
 };
 
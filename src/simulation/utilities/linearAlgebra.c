@@ -21,6 +21,7 @@
 #include "utilities/bsk_Print.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -36,6 +37,182 @@
 #define MXINDEX(dim2, row, col) ((row)*(dim2) + (col))
 #define MOVE_DOUBLE(source, dim, destination) (memmove((void*)(destination), (void*)(source), sizeof(double)*(dim)))
 
+/* Number of result columns from which the matrix products switch to the vectorized kernel */
+#define LINEAR_ALGEBRA_WIDE_COLS 16
+/* Number of rows and columns per cache block in the vectorized matrix product kernel */
+#define LINEAR_ALGEBRA_BLOCK_SIZE 64
+
+/*
+ * Returns 1 if the result array of nResult doubles overlaps the source array of
+ * nSource doubles.  The matrix products only need a temporary result buffer in
+ * that case.
+ */
+static int mxOverlap(const void *result, size_t nResult, const void *source, size_t nSource)
+{
+    uintptr_t r = (uintptr_t)result;
+    uintptr_t s = (uintptr_t)source;
+    return r < s + nSource * sizeof(double) && s < r + nResult * sizeof(double);
+}
+
+/*
+ * Computes the n x p product C = op(A) op(B) where element (i,k) of op(A) is
+ * a[i*aRow + k*aCol] and element (k,j) of op(B) is b[k*bRow + j*bCol].  Every
+ * element of C is accumulated over k in increasing order starting from 0.0,
+ * exactly as in the textbook triple loop, so all kernels give identical
+ * results.  Narrow products are evaluated as dot products in registers.  Wide
+ * products with a non-transposed B run the inner loop along the contiguous rows
+ * of B and C so that it can be vectorized, with the k and j loops blocked so
+ * that the active part of B stays in cache.  c must not overlap a or b.
+ */
+static inline void mxMultKernel(const double *a, size_t aRow, size_t aCol,
+                                const double *b, size_t bRow, size_t bCol,
+                                size_t n, size_t m, size_t p,
+                                double *c)
+{
+    size_t i, j, k;
+    size_t j0, k0, jEnd, kEnd;
+    double aik;
+    double sum;
+
+    if(bCol != 1 || p < LINEAR_ALGEBRA_WIDE_COLS) {
+        for(i = 0; i < n; i++) {
+            for(j = 0; j < p; j++) {
+                sum = 0.0;
+                for(k = 0; k < m; k++) {
+                    sum += a[i * aRow + k * aCol] * b[k * bRow + j * bCol];
+                }
+                c[i * p + j] = sum;
+            }
+        }
+        return;
+    }
+    for(i = 0; i < n * p; i++) {
+        c[i] = 0.0;
+    }
+    for(j0 = 0; j0 < p; j0 += LINEAR_ALGEBRA_BLOCK_SIZE) {
+        jEnd = (j0 + LINEAR_ALGEBRA_BLOCK_SIZE < p) ? j0 + LINEAR_ALGEBRA_BLOCK_SIZE : p;
+        for(k0 = 0; k0 < m; k0 += LINEAR_ALGEBRA_BLOCK_SIZE) {
+            kEnd = (k0 + LINEAR_ALGEBRA_BLOCK_SIZE < m) ? k0 + LINEAR_ALGEBRA_BLOCK_SIZE : m;
+            for(i = 0; i < n; i++) {
+                for(k = k0; k < kEnd; k++) {
+                    aik = a[i * aRow + k * aCol];
+                    for(j = j0; j < jEnd; j++) {
+                        c[i * p + j] += aik * b[k * bRow + j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Generic and fixed-size square products for each combination of transposed
+ * operands.  Passing the transposes as constants gives the kernel unit strides
+ * where possible, and the constant 3x3, 4x4 and 6x6 dimensions that dominate
+ * the FSW algorithms let the compiler fully unroll it.
+ */
+#define MX_MULT_GENERIC(TRANS_A, TRANS_B) \
+    static void mxMultGeneric_##TRANS_A##TRANS_B(const double *a, const double *b, \
+                                                 size_t n, size_t m, size_t p, double *c) \
+    { \
+        mxMultKernel(a, (TRANS_A) ? 1 : m, (TRANS_A) ? n : 1, \
+                     b, (TRANS_B) ? 1 : p, (TRANS_B) ? m : 1, n, m, p, c); \
+    }
+#define MX_MULT_FIXED(N, TRANS_A, TRANS_B) \
+    static void mxMult##N##_##TRANS_A##TRANS_B(const double *a, const double *b, double *c) \
+    { \
+        mxMultKernel(a, (TRANS_A) ? 1 : (N), (TRANS_A) ? (N) : 1, \
+                     b, (TRANS_B) ? 1 : (N), (TRANS_B) ? (N) : 1, (N), (N), (N), c); \
+    }
+MX_MULT_GENERIC(0, 0) MX_MULT_GENERIC(1, 0) MX_MULT_GENERIC(0, 1) MX_MULT_GENERIC(1, 1)
+MX_MULT_FIXED(3, 0, 0) MX_MULT_FIXED(3, 1, 0) MX_MULT_FIXED(3, 0, 1) MX_MULT_FIXED(3, 1, 1)
+MX_MULT_FIXED(4, 0, 0) MX_MULT_FIXED(4, 1, 0) MX_MULT_FIXED(4, 0, 1) MX_MULT_FIXED(4, 1, 1)
+MX_MULT_FIXED(6, 0, 0) MX_MULT_FIXED(6, 1, 0) MX_MULT_FIXED(6, 0, 1) MX_MULT_FIXED(6, 1, 1)
+#define MX_MULT_FIXED_V(N, TRANS_A) \
+    static void mxMultV##N##_##TRANS_A(const double *a, const double *b, double *c) \
+    { \
+        mxMultKernel(a, (TRANS_A) ? 1 : (N), (TRANS_A) ? (N) : 1, b, 1, 1, (N), (N), 1, c); \
+    }
+MX_MULT_FIXED_V(3, 0) MX_MULT_FIXED_V(3, 1)
+MX_MULT_FIXED_V(4, 0) MX_MULT_FIXED_V(4, 1)
+MX_MULT_FIXED_V(6, 0) MX_MULT_FIXED_V(6, 1)
+
+typedef void (*mxMultGenericFunc)(const double *a, const double *b,
+                                  size_t n, size_t m, size_t p, double *c);
+typedef void (*mxMultFixedFunc)(const double *a, const double *b, double *c);
+
+/* Generic kernels indexed by [transA][transB] */
+static const mxMultGenericFunc mxMultGeneric[2][2] = {
+    {mxMultGeneric_00, mxMultGeneric_01}, {mxMultGeneric_10, mxMultGeneric_11}
+};
+
+/* Fixed-size kernels indexed by [size][transA][transB], with size 0, 1, 2 for 3, 4, 6 */
+static const mxMultFixedFunc mxMultFixed[3][2][2] = {
+    {{mxMult3_00, mxMult3_01}, {mxMult3_10, mxMult3_11}},
+    {{mxMult4_00, mxMult4_01}, {mxMult4_10, mxMult4_11}},
+    {{mxMult6_00, mxMult6_01}, {mxMult6_10, mxMult6_11}}
+};
+
+/* Fixed-size square matrix times vector kernels indexed by [size][transA] */
+static const mxMultFixedFunc mxMultFixedV[3][2] = {
+    {mxMultV3_0, mxMultV3_1}, {mxMultV4_0, mxMultV4_1}, {mxMultV6_0, mxMultV6_1}
+};
+
+/*
+ * Evaluates the n x p product C = op(A) op(B) into c.  op(A) is A (stored n x m)
+ * or A^T (A stored m x n) and op(B) is B (stored m x p) or B^T (B stored p x m).
+ * Square 3x3, 4x4 and 6x6 products and products of these matrices with a vector
+ * use the unrolled kernels.  c must not overlap a or b.
+ */
+static void mxMultInto(const double *a, int transA, const double *b, int transB,
+                       size_t n, size_t m, size_t p, double *c)
+{
+    int sizeIdx = -1;
+
+    if(n == m) {
+        sizeIdx = (n == 3) ? 0 : (n == 4) ? 1 : (n == 6) ? 2 : -1;
+    }
+    if(sizeIdx >= 0 && p == n) {
+        mxMultFixed[sizeIdx][transA != 0][transB != 0](a, b, c);
+    } else if(sizeIdx >= 0 && p == 1) {
+        mxMultFixedV[sizeIdx][transA != 0](a, b, c);
+    } else {
+        mxMultGeneric[transA != 0][transB != 0](a, b, n, m, p, c);
+    }
+}
+
+/*
+ * Evaluates the product into a temporary buffer and then copies it to result,
+ * for calls where result overlaps one of the inputs.  This is kept out of
+ * mxMult so that the common non-overlapping call does not reserve the large
+ * stack buffer.
+ */
+static void mxMultAliased(const double *a, int transA, const double *b, int transB,
+                          size_t n, size_t m, size_t p, void *result)
+{
+    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
+
+    mxMultInto(a, transA, b, transB, n, m, p, m_result);
+    MOVE_DOUBLE(m_result, n * p, result);
+}
+
+/*
+ * Writes the n x p product C = op(A) op(B) to result, see mxMultInto.  A
+ * temporary buffer is only used when result overlaps one of the inputs.
+ */
+static void mxMult(const double *a, int transA, const double *b, int transB,
+                   size_t n, size_t m, size_t p, void *result)
+{
+    if (n * p > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
+        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
+
+    if(mxOverlap(result, n * p, a, n * m) || mxOverlap(result, n * p, b, m * p)) {
+        mxMultAliased(a, transA, b, transB, n, m, p, result);
+    } else {
+        mxMultInto(a, transA, b, transB, n, m, p, (double *)result);
+    }
+}
+
 
 void vCopy(double *v, size_t dim,
            double *result)
@@ -126,56 +303,14 @@ void vtMultM(double *v,
              void *mx, size_t dim1, size_t dim2,
              void *result)
 {
-    size_t dim11 = 1;
-    size_t dim12 = dim1;
-    size_t dim22 = dim2;
-    double *m_mx1 = (double *)v;
-    double *m_mx2 = (double *)mx;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim11*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
-    for(i = 0; i < dim11; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim12; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, i, k)] * m_mx2[MXINDEX(dim22, k, j)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim11 * dim22, result);
+    mxMult(v, 0, (double *)mx, 0, 1, dim1, dim2, result);
 }
 
 void vtMultMt(double *v,
               void *mx, size_t dim1, size_t dim2,
               void *result)
 {
-    size_t dim11 = 1;
-    size_t dim12 = dim2;
-    size_t dim22 = dim1;
-    double *m_mx1 = (double *)v;
-    double *m_mx2 = (double *)mx;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim11*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
-    for(i = 0; i < dim11; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim12; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, i, k)] * m_mx2[MXINDEX(dim22, j, k)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim11 * dim22, result);
+    mxMult(v, 0, (double *)mx, 1, 1, dim2, dim1, result);
 }
 
 double vNorm(double *v, size_t dim)
@@ -826,23 +961,43 @@ void mDiag(void *v, size_t dim, void *result)
     }
 }
 
+/*
+ * Transposes through a temporary buffer for in-place or overlapping calls of
+ * mTranspose.
+ */
+static void mTransposeAliased(double *m_mx, size_t dim1, size_t dim2, void *result)
+{
+    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
+    size_t i;
+    size_t j;
+    for(i = 0; i < dim1; i++) {
+        for(j = 0; j < dim2; j++) {
+            m_result[MXINDEX(dim1, j, i)] = m_mx[MXINDEX(dim2, i, j)];
+        }
+    }
+
+    MOVE_DOUBLE(m_result, dim2 * dim1, result);
+}
+
 void mTranspose(void *mx, size_t dim1, size_t dim2,
                 void *result)
 {
     double *m_mx = (double *)mx;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
+    double *m_result = (double *)result;
     if (dim1*dim2 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
         BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
 
     size_t i;
     size_t j;
+    if(mxOverlap(result, dim1 * dim2, mx, dim1 * dim2)) {
+        mTransposeAliased(m_mx, dim1, dim2, result);
+        return;
+    }
     for(i = 0; i < dim1; i++) {
         for(j = 0; j < dim2; j++) {
             m_result[MXINDEX(dim1, j, i)] = m_mx[MXINDEX(dim2, i, j)];
         }
     }
-
-    MOVE_DOUBLE(m_result, dim2 * dim1, result);
 }
 
 void mAdd(void *mx1, size_t dim1, size_t dim2,
@@ -899,172 +1054,58 @@ void mMultM(void *mx1, size_t dim11, size_t dim12,
             void *mx2, size_t dim21, size_t dim22,
             void *result)
 {
-    double *m_mx1 = (double *)mx1;
-    double *m_mx2 = (double *)mx2;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim11*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
     if(dim12 != dim21) {
         BSK_PRINT(MSG_ERROR, "Error: mMultM dimensions don't match.");
         return;
     }
-    for(i = 0; i < dim11; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim12; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, i, k)] * m_mx2[MXINDEX(dim22, k, j)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim11 * dim22, result);
+    mxMult((double *)mx1, 0, (double *)mx2, 0, dim11, dim12, dim22, result);
 }
 
 void mtMultM(void *mx1, size_t dim11, size_t dim12,
              void *mx2, size_t dim21, size_t dim22,
              void *result)
 {
-    double *m_mx1 = (double *)mx1;
-    double *m_mx2 = (double *)mx2;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim12*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
     if(dim11 != dim21) {
         BSK_PRINT(MSG_ERROR, "Error: mtMultM dimensions don't match.");
         return;
     }
-    for(i = 0; i < dim12; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim11; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, k, i)] * m_mx2[MXINDEX(dim22, k, j)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim12 * dim22, result);
+    mxMult((double *)mx1, 1, (double *)mx2, 0, dim12, dim11, dim22, result);
 }
 
 void mMultMt(void *mx1, size_t dim11, size_t dim12,
              void *mx2, size_t dim21, size_t dim22,
              void *result)
 {
-    double *m_mx1 = (double *)mx1;
-    double *m_mx2 = (double *)mx2;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim11*dim21 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
     if(dim12 != dim22) {
         BSK_PRINT(MSG_ERROR, "Error: mMultMt dimensions don't match.");
         return;
     }
-    for(i = 0; i < dim11; i++) {
-        for(j = 0; j < dim21; j++) {
-            m_result[MXINDEX(dim21, i, j)] = 0.0;
-            for(k = 0; k < dim12; k++) {
-                m_result[MXINDEX(dim21, i, j)] += m_mx1[MXINDEX(dim12, i, k)] * m_mx2[MXINDEX(dim22, j, k)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim11 * dim21, result);
+    mxMult((double *)mx1, 0, (double *)mx2, 1, dim11, dim12, dim21, result);
 }
 
 void mtMultMt(void *mx1, size_t dim11, size_t dim12,
               void *mx2, size_t dim21, size_t dim22,
               void *result)
 {
-    double *m_mx1 = (double *)mx1;
-    double *m_mx2 = (double *)mx2;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim12*dim21 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
     if(dim11 != dim22) {
         BSK_PRINT(MSG_ERROR, "Error: mtMultMt dimensions don't match.");
         return;
     }
-    for(i = 0; i < dim12; i++) {
-        for(j = 0; j < dim21; j++) {
-            m_result[MXINDEX(dim21, i, j)] = 0.0;
-            for(k = 0; k < dim11; k++) {
-                m_result[MXINDEX(dim21, i, j)] += m_mx1[MXINDEX(dim12, k, i)] * m_mx2[MXINDEX(dim22, j, k)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim12 * dim21, result);
+    mxMult((double *)mx1, 1, (double *)mx2, 1, dim12, dim11, dim21, result);
 }
 
 void mMultV(void *mx, size_t dim1, size_t dim2,
             void *v,
             void *result)
 {
-    size_t dim11 = dim1;
-    size_t dim12 = dim2;
-    size_t dim22 = 1;
-    double *m_mx1 = (double *)mx;
-    double *m_mx2 = (double *)v;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim11*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
-    for(i = 0; i < dim11; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim12; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, i, k)] * m_mx2[MXINDEX(dim22, k, j)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim11 * dim22, result);
+    mxMult((double *)mx, 0, (double *)v, 0, dim1, dim2, 1, result);
 }
 
 void mtMultV(void *mx, size_t dim1, size_t dim2,
              void *v,
              void *result)
 {
-    size_t dim11 = dim1;
-    size_t dim12 = dim2;
-    size_t dim22 = 1;
-    double *m_mx1 = (double *)mx;
-    double *m_mx2 = (double *)v;
-    double m_result[LINEAR_ALGEBRA_MAX_ARRAY_SIZE];
-    if (dim12*dim22 > LINEAR_ALGEBRA_MAX_ARRAY_SIZE)
-        BSK_PRINT(MSG_ERROR,"Linear Algegra library array dimension input is too large.");
-
-    size_t i;
-    size_t j;
-    size_t k;
-    for(i = 0; i < dim12; i++) {
-        for(j = 0; j < dim22; j++) {
-            m_result[MXINDEX(dim22, i, j)] = 0.0;
-            for(k = 0; k < dim11; k++) {
-                m_result[MXINDEX(dim22, i, j)] += m_mx1[MXINDEX(dim12, k, i)] * m_mx2[MXINDEX(dim22, k, j)];
-            }
-        }
-    }
-
-    MOVE_DOUBLE(m_result, dim12 * dim22, result);
+    mxMult((double *)mx, 1, (double *)v, 0, dim2, dim1, 1, result);
 }
 
 double mTrace(void *mx, size_t dim)
@@ -593,6 +593,321 @@ void rv2elem(double mu, double *rVec, double *vVec, classicElements *elements)
     return;
 }
 
+/* Number of anomalies solved together by M2EBatch() and N2HBatch().  The Halley iterations of a block run until
+ * every anomaly of the block has converged, so that the inner loops have no data dependent branches. */
+#define KEPLER_BATCH_BLOCK 64
+
+/*
+ * Function: M2EBatch
+ * Purpose: Maps n mean elliptic anomaly angles into the corresponding
+ *   eccentric anomaly angles.  The mean anomalies are reduced to
+ *   [-pi, pi], started with the Danby guess M + 0.85 e sign(M) and
+ *   refined with Halley iterations, which converge in 3 to 5 steps
+ *   for 0 <= e < 1.  Anomalies that do not converge in a block are
+ *   solved with M2E().
+ * Inputs:
+ *   M = array of n mean elliptic anomalies (rad)
+ *   e = array of n eccentricities (0 <= e < 1)
+ *   n = number of anomalies
+ * Outputs:
+ *   Ecc = array of n eccentric anomalies (rad), may be the M array
+ */
+void M2EBatch(double *M, double *e, size_t n, double *Ecc)
+{
+    double small = 1e-13;
+    int    max = 20;
+    double turns[KEPLER_BATCH_BLOCK];   /* whole turns removed from M */
+    double Mr[KEPLER_BATCH_BLOCK];      /* mean anomaly reduced to [-pi, pi] */
+    double E1[KEPLER_BATCH_BLOCK];      /* eccentric anomaly iterate */
+    double dE[KEPLER_BATCH_BLOCK];      /* last Halley correction */
+    size_t start;
+    size_t count;
+    size_t k;
+    double dEMax;
+    int    iter;
+    int    invalid = 0;
+
+    for(start = 0; start < n; start += KEPLER_BATCH_BLOCK) {
+        count = n - start < KEPLER_BATCH_BLOCK ? n - start : KEPLER_BATCH_BLOCK;
+        for(k = 0; k < count; k++) {
+            turns[k] = 2 * M_PI * floor((M[start + k] + M_PI) / (2 * M_PI));
+            Mr[k] = M[start + k] - turns[k];
+            E1[k] = Mr[k] + copysign(0.85 * e[start + k], Mr[k]);
+        }
+        for(iter = 0; iter < max; iter++) {
+            dEMax = 0.0;
+            for(k = 0; k < count; k++) {
+                double se = e[start + k] * sin(E1[k]);
+                double ce = e[start + k] * cos(E1[k]);
+                double f0 = E1[k] - se - Mr[k];
+                double f1 = 1 - ce;
+                dE[k] = f0 / (f1 - 0.5 * f0 * se / f1);
+                E1[k] -= dE[k];
+                dEMax = fmax(dEMax, fabs(dE[k]));
+            }
+            if(dEMax <= small) {
+                break;
+            }
+        }
+        for(k = 0; k < count; k++) {
+            if((e[start + k] >= 0) && (e[start + k] < 1)) {
+                if(!(fabs(dE[k]) <= small)) {
+                    E1[k] = M2E(Mr[k], e[start + k]);
+                }
+                Ecc[start + k] = E1[k] + turns[k];
+            } else {
+                Ecc[start + k] = NAN;
+                invalid++;
+            }
+        }
+    }
+    if(invalid > 0) {
+        BSK_PRINT(MSG_ERROR, "M2EBatch() received %d values of e outside of 0 <= e < 1.", invalid);
+    }
+
+    return;
+}
+
+/*
+ * Function: N2HBatch
+ * Purpose: Maps n mean hyperbolic anomaly angles N into the corresponding
+ *   hyperbolic anomaly angles H.  The iterations are started with
+ *   asinh(N / e), which is within 2 of the solution, and refined with
+ *   Halley iterations.  Anomalies that do not converge in a block are
+ *   solved with N2H().
+ * Inputs:
+ *   N = array of n mean hyperbolic anomalies (rad)
+ *   e = array of n eccentricities (e > 1)
+ *   n = number of anomalies
+ * Outputs:
+ *   H = array of n hyperbolic anomalies (rad), may be the N array
+ */
+void N2HBatch(double *N, double *e, size_t n, double *H)
+{
+    double small = 1e-13;
+    int    max = 50;
+    double Nk[KEPLER_BATCH_BLOCK];      /* mean hyperbolic anomaly */
+    double H1[KEPLER_BATCH_BLOCK];      /* hyperbolic anomaly iterate */
+    double dH[KEPLER_BATCH_BLOCK];      /* last Halley correction */
+    size_t start;
+    size_t count;
+    size_t k;
+    double dHMax;
+    int    iter;
+    int    invalid = 0;
+
+    for(start = 0; start < n; start += KEPLER_BATCH_BLOCK) {
+        count = n - start < KEPLER_BATCH_BLOCK ? n - start : KEPLER_BATCH_BLOCK;
+        for(k = 0; k < count; k++) {
+            Nk[k] = N[start + k];
+            H1[k] = asinh(Nk[k] / e[start + k]);
+        }
+        for(iter = 0; iter < max; iter++) {
+            dHMax = 0.0;
+            for(k = 0; k < count; k++) {
+                double sh = e[start + k] * sinh(H1[k]);
+                double ch = e[start + k] * cosh(H1[k]);
+                double f0 = sh - H1[k] - Nk[k];
+                double f1 = ch - 1;
+                dH[k] = f0 / (f1 - 0.5 * f0 * sh / f1);
+                H1[k] -= dH[k];
+                dHMax = fmax(dHMax, fabs(dH[k]));
+            }
+            if(dHMax <= small) {
+                break;
+            }
+        }
+        for(k = 0; k < count; k++) {
+            if(e[start + k] > 1) {
+                if(!(fabs(dH[k]) <= small)) {
+                    H1[k] = N2H(Nk[k], e[start + k]);
+                }
+                H[start + k] = H1[k];
+            } else {
+                H[start + k] = NAN;
+                invalid++;
+            }
+        }
+    }
+    if(invalid > 0) {
+        BSK_PRINT(MSG_ERROR, "N2HBatch() received %d values of e outside of e > 1.", invalid);
+    }
+
+    return;
+}
+
+/*
+ * Function: elem2rvBatch
+ * Purpose: Translates n sets of orbit elements into the inertial
+ *   Cartesian position and velocity vectors, see elem2rv().  The
+ *   general 2D orbit case is evaluated inline with the sines and
+ *   cosines of the angles computed once, the rectilinear and
+ *   parabolic cases are passed to elem2rv().
+ * Inputs:
+ *   mu = gravitational parameter
+ *   elements = array of n orbital elements
+ *   n = number of orbits
+ * Outputs:
+ *   rVec = n x 3 array of position vectors
+ *   vVec = n x 3 array of velocity vectors
+ */
+void elem2rvBatch(double mu, classicElements *elements, size_t n, double *rVec, double *vVec)
+{
+    double eps = 1e-12;
+    size_t k;
+
+    for(k = 0; k < n; k++) {
+        classicElements *el = &elements[k];
+        double *r_k = &rVec[3 * k];
+        double *v_k = &vVec[3 * k];
+        if((fabs(el->e - 1.0) < eps) || !(fabs(el->a) > eps)) {
+            elem2rv(mu, el, r_k, v_k);
+            continue;
+        }
+        double p = el->a * (1 - el->e * el->e);
+        double cf = cos(el->f);
+        double r = p / (1 + el->e * cf);
+        double theta = el->omega + el->f;
+        double h = sqrt(mu * p);
+        double cAN = cos(el->Omega);
+        double sAN = sin(el->Omega);
+        double cth = cos(theta);
+        double sth = sin(theta);
+        double ci = cos(el->i);
+        double si = sin(el->i);
+        double eSAP = el->e * sin(el->omega);
+        double eCAP = el->e * cos(el->omega);
+
+        r_k[0] = r * (cAN * cth - sAN * sth * ci);
+        r_k[1] = r * (sAN * cth + cAN * sth * ci);
+        r_k[2] = r * (sth * si);
+
+        v_k[0] = -mu / h * (cAN * (sth + eSAP) + sAN * (cth + eCAP) * ci);
+        v_k[1] = -mu / h * (sAN * (sth + eSAP) - cAN * (cth + eCAP) * ci);
+        v_k[2] = -mu / h * (-(cth + eCAP) * si);
+    }
+
+    return;
+}
+
+/*
+ * Function: rv2elemBatch
+ * Purpose: Translates n inertial Cartesian position and velocity
+ *   vectors into the corresponding classical orbit elements, see
+ *   rv2elem().  The vector operations are written out so that a
+ *   state is converted without function calls other than the
+ *   square roots and trigonometric functions.
+ * Inputs:
+ *   mu = gravitational parameter
+ *   rVec = n x 3 array of position vectors
+ *   vVec = n x 3 array of velocity vectors
+ *   n = number of states
+ * Outputs:
+ *   elements = array of n orbital elements
+ */
+void rv2elemBatch(double mu, double *rVec, double *vVec, size_t n, classicElements *elements)
+{
+    double eps = 1e-12;
+    size_t k;
+
+    for(k = 0; k < n; k++) {
+        double *rv = &rVec[3 * k];
+        double *vv = &vVec[3 * k];
+        classicElements *el = &elements[k];
+        double r = sqrt(rv[0] * rv[0] + rv[1] * rv[1] + rv[2] * rv[2]);
+        double v = sqrt(vv[0] * vv[0] + vv[1] * vv[1] + vv[2] * vv[2]);
+        double hVec[3];
+        double inHat[3];
+        double ieHat[3];
+        double eVec[3];
+        double rDotV;
+        double h;
+        double nNorm;
+        double p;
+        double c1;
+        double c2;
+        double t[3];
+
+        el->rmag = r;
+
+        /* specific angular momentum */
+        hVec[0] = rv[1] * vv[2] - rv[2] * vv[1];
+        hVec[1] = rv[2] * vv[0] - rv[0] * vv[2];
+        hVec[2] = rv[0] * vv[1] - rv[1] * vv[0];
+        h = sqrt(hVec[0] * hVec[0] + hVec[1] * hVec[1] + hVec[2] * hVec[2]);
+        p = h * h / mu;
+
+        /* line of nodes n3Hat x hVec */
+        nNorm = sqrt(hVec[0] * hVec[0] + hVec[1] * hVec[1]);
+        if(nNorm < eps) {
+            inHat[0] = 1.0;
+            inHat[1] = 0.0;
+        } else {
+            inHat[0] = -hVec[1] / nNorm;
+            inHat[1] = hVec[0] / nNorm;
+        }
+        inHat[2] = 0.0;
+
+        /* eccentricity vector */
+        rDotV = rv[0] * vv[0] + rv[1] * vv[1] + rv[2] * vv[2];
+        c1 = v * v / mu - 1.0 / r;
+        c2 = rDotV / mu;
+        eVec[0] = c1 * rv[0] - c2 * vv[0];
+        eVec[1] = c1 * rv[1] - c2 * vv[1];
+        eVec[2] = c1 * rv[2] - c2 * vv[2];
+        el->e = sqrt(eVec[0] * eVec[0] + eVec[1] * eVec[1] + eVec[2] * eVec[2]);
+        el->rPeriap = p / (1.0 + el->e);
+        if(el->e > eps) {
+            ieHat[0] = eVec[0] / el->e;
+            ieHat[1] = eVec[1] / el->e;
+            ieHat[2] = eVec[2] / el->e;
+        } else {
+            ieHat[0] = inHat[0];
+            ieHat[1] = inHat[1];
+            ieHat[2] = inHat[2];
+        }
+
+        /* semi-major axis */
+        el->alpha = 2.0 / r - v * v / mu;
+        if(fabs(el->alpha) > eps) {
+            el->a = 1.0 / el->alpha;
+            el->rApoap = p / (1.0 - el->e);
+        } else {
+            el->a = 0.0;
+            el->rApoap = 0.0;
+        }
+
+        /* inclination and ascending node */
+        el->i = acos(hVec[2] / h);
+        el->Omega = atan2(inHat[1], inHat[0]);
+        if(el->Omega < 0.0) {
+            el->Omega += 2 * M_PI;
+        }
+
+        /* argument of periapses, (inHat x ieHat) . ihHat */
+        t[0] = inHat[1] * ieHat[2] - inHat[2] * ieHat[1];
+        t[1] = inHat[2] * ieHat[0] - inHat[0] * ieHat[2];
+        t[2] = inHat[0] * ieHat[1] - inHat[1] * ieHat[0];
+        el->omega = atan2((t[0] * hVec[0] + t[1] * hVec[1] + t[2] * hVec[2]) / h,
+                          inHat[0] * ieHat[0] + inHat[1] * ieHat[1] + inHat[2] * ieHat[2]);
+        if(el->omega < 0.0) {
+            el->omega += 2 * M_PI;
+        }
+
+        /* true anomaly, (ieHat x irHat) . ihHat */
+        t[0] = (ieHat[1] * rv[2] - ieHat[2] * rv[1]) / r;
+        t[1] = (ieHat[2] * rv[0] - ieHat[0] * rv[2]) / r;
+        t[2] = (ieHat[0] * rv[1] - ieHat[1] * rv[0]) / r;
+        el->f = atan2((t[0] * hVec[0] + t[1] * hVec[1] + t[2] * hVec[2]) / h,
+                      (ieHat[0] * rv[0] + ieHat[1] * rv[1] + ieHat[2] * rv[2]) / r);
+        if(el->f < 0.0) {
+            el->f += 2 * M_PI;
+        }
+    }
+
+    return;
+}
+
 /*
  * Function: atmosphericDensity
  * Purpose: This program computes the atmospheric density based on altitude
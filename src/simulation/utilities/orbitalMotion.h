@@ -19,6 +19,7 @@
 
 #ifndef _ORBITAL_MOTION_0_H_
 #define _ORBITAL_MOTION_0_H_
+#include <stddef.h>
 #include <utilities/bskLogging.h>
 
 #define N_DEBYE_PARAMETERS 37
@@ -90,6 +91,10 @@ extern "C" {
     double  N2H(double N, double e);
     void    elem2rv(double mu, classicElements *elements, double *rVec, double *vVec);
     void    rv2elem(double mu, double *rVec, double *vVec, classicElements *elements);
+    void    M2EBatch(double *M, double *e, size_t n, double *Ecc);
+    void    N2HBatch(double *N, double *e, size_t n, double *H);
+    void    elem2rvBatch(double mu, classicElements *elements, size_t n, double *rVec, double *vVec);
+    void    rv2elemBatch(double mu, double *rVec, double *vVec, size_t n, classicElements *elements);
     void    clMeanOscMap(double req, double J2, classicElements *elements, classicElements *elements_p, double sgn);
     void    clElem2eqElem(classicElements *elements_cl, equinoctialElements *elements_eq);
 
@@ -4419,3 +4419,125 @@ void Mi(double theta, int a, double C[3][3])
             BSK_PRINT(MSG_ERROR, "Mi() error: incorrect axis %d selected.", a);
     }
 }
+
+/*
+ * The batch conversions below translate n attitude sets stored contiguously,
+ * n x 3 for MRPs, n x 4 for Euler parameters and n x 9 row-major values for
+ * direction cosine matrices, as produced by numpy arrays of logged states.
+ * The MRP and Euler parameter conversions are written out without function
+ * calls or data dependent branches.
+ */
+
+/*
+ * MRP2EPBatch(Q1,N,Q) translates the N MRP vectors Q1
+ * into the N Euler parameter vectors Q.
+ */
+void MRP2EPBatch(double *q1, size_t n, double *q)
+{
+    size_t k;
+    for(k = 0; k < n; k++) {
+        double s2 = q1[3 * k] * q1[3 * k] + q1[3 * k + 1] * q1[3 * k + 1] + q1[3 * k + 2] * q1[3 * k + 2];
+        double ps = 1 + s2;
+        q[4 * k] = (1 - s2) / ps;
+        q[4 * k + 1] = 2 * q1[3 * k] / ps;
+        q[4 * k + 2] = 2 * q1[3 * k + 1] / ps;
+        q[4 * k + 3] = 2 * q1[3 * k + 2] / ps;
+    }
+}
+
+/*
+ * EP2MRPBatch(Q1,N,Q) translates the N Euler parameter vectors Q1
+ * into the N MRP vectors Q.
+ */
+void EP2MRPBatch(double *q1, size_t n, double *q)
+{
+    size_t k;
+    for(k = 0; k < n; k++) {
+        double s = q1[4 * k] >= 0 ? 1.0 : -1.0;
+        double d = 1 + s * q1[4 * k];
+        q[3 * k] = s * q1[4 * k + 1] / d;
+        q[3 * k + 1] = s * q1[4 * k + 2] / d;
+        q[3 * k + 2] = s * q1[4 * k + 3] / d;
+    }
+}
+
+/*
+ * MRP2CBatch(Q,N,C) returns the N direction cosine
+ * matrices C in terms of the N MRP vectors Q.
+ */
+void MRP2CBatch(double *q, size_t n, double *C)
+{
+    size_t k;
+    for(k = 0; k < n; k++) {
+        double q1 = q[3 * k];
+        double q2 = q[3 * k + 1];
+        double q3 = q[3 * k + 2];
+        double d1 = q1 * q1 + q2 * q2 + q3 * q3;
+        double S = 1 - d1;
+        double d = 1. / ((1 + d1) * (1 + d1));
+        double *Ck = &C[9 * k];
+        Ck[0] = (4 * (2 * q1 * q1 - d1) + S * S) * d;
+        Ck[1] = (8 * q1 * q2 + 4 * q3 * S) * d;
+        Ck[2] = (8 * q1 * q3 - 4 * q2 * S) * d;
+        Ck[3] = (8 * q2 * q1 - 4 * q3 * S) * d;
+        Ck[4] = (4 * (2 * q2 * q2 - d1) + S * S) * d;
+        Ck[5] = (8 * q2 * q3 + 4 * q1 * S) * d;
+        Ck[6] = (8 * q3 * q1 + 4 * q2 * S) * d;
+        Ck[7] = (8 * q3 * q2 - 4 * q1 * S) * d;
+        Ck[8] = (4 * (2 * q3 * q3 - d1) + S * S) * d;
+    }
+}
+
+/*
+ * C2MRPBatch(C,N,Q) translates the N direction cosine matrices
+ * C into the corresponding N MRP vectors Q with |Q| <= 1.
+ */
+void C2MRPBatch(double *C, size_t n, double *q)
+{
+    size_t k;
+    double b[4];
+    for(k = 0; k < n; k++) {
+        C2EP((double (*)[3]) &C[9 * k], b);
+        q[3 * k] = b[1] / (1 + b[0]);
+        q[3 * k + 1] = b[2] / (1 + b[0]);
+        q[3 * k + 2] = b[3] / (1 + b[0]);
+    }
+}
+
+/*
+ * EP2CBatch(Q,N,C) returns the N direction cosine matrices C
+ * in terms of the N Euler parameter vectors Q.
+ */
+void EP2CBatch(double *q, size_t n, double *C)
+{
+    size_t k;
+    for(k = 0; k < n; k++) {
+        double q0 = q[4 * k];
+        double q1 = q[4 * k + 1];
+        double q2 = q[4 * k + 2];
+        double q3 = q[4 * k + 3];
+        double *Ck = &C[9 * k];
+        Ck[0] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+        Ck[1] = 2 * (q1 * q2 + q0 * q3);
+        Ck[2] = 2 * (q1 * q3 - q0 * q2);
+        Ck[3] = 2 * (q1 * q2 - q0 * q3);
+        Ck[4] = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+        Ck[5] = 2 * (q2 * q3 + q0 * q1);
+        Ck[6] = 2 * (q1 * q3 + q0 * q2);
+        Ck[7] = 2 * (q2 * q3 - q0 * q1);
+        Ck[8] = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+    }
+}
+
+/*
+ * C2EPBatch(C,N,Q) translates the N direction cosine matrices
+ * C into the corresponding N Euler parameter vectors Q with
+ * Beta_0 >= 0 using the Stanley method, see C2EP().
+ */
+void C2EPBatch(double *C, size_t n, double *b)
+{
+    size_t k;
+    for(k = 0; k < n; k++) {
+        C2EP((double (*)[3]) &C[9 * k], &b[4 * k]);
+    }
+}
@@ -19,6 +19,7 @@
 
 #ifndef _RIGID_BODY_KINEMATICS_0_H_
 #define _RIGID_BODY_KINEMATICS_0_H_
+#include <stddef.h>
 #include <utilities/bskLogging.h>
 
 #ifdef __cplusplus
@@ -253,6 +254,13 @@ extern "C" {
     void   subMRP(double *q1, double *q2, double *q);
     void   subPRV(double *q10, double *q20, double *q);
     void   Mi(double angle, int axis, double C[3][3]);
+
+    void   MRP2EPBatch(double *q1, size_t n, double *q);
+    void   EP2MRPBatch(double *q1, size_t n, double *q);
+    void   MRP2CBatch(double *q, size_t n, double *C);
+    void   C2MRPBatch(double *C, size_t n, double *q);
+    void   EP2CBatch(double *q, size_t n, double *C);
+    void   C2EPBatch(double *C, size_t n, double *b);
     
 #ifdef __cplusplus
 }
@@ -0,0 +1,597 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/*! @file ukfCore.h
+ Fixed-size square-root unscented Kalman filter core.
+
+ This header is instantiated once per filter translation unit.  The filter defines its
+ state and (maximum) measurement dimensions before including it:
+
+     #define UKF_CORE_N_STATES  AKF_N_STATES
+     #define UKF_CORE_N_MEAS    3
+     #include "simulation/utilities/ukfCore.h"
+
+ All scratch storage is sized from these compile-time constants instead of UKF_MAX_DIM,
+ and every state-dimension loop has a constant trip count, so the compiler can unroll
+ and vectorize the sigma-point, QR and Cholesky kernels for each filter.  The arithmetic
+ is performed in the same order as the original per-filter implementations.
+
+ Storage conventions follow the existing filters: matrices are row-major, sigma points
+ are stored as 2N+1 consecutive rows of N states (mean point first, then the N "+" points,
+ then the N "-" points), measurement models as 2N+1 rows of numObs values, and sBar is
+ the lower-triangular square root of the covariance.
+ */
+
+#ifndef _UKF_CORE_H_
+#define _UKF_CORE_H_
+
+#if !defined(UKF_CORE_N_STATES) || !defined(UKF_CORE_N_MEAS)
+#error "UKF_CORE_N_STATES and UKF_CORE_N_MEAS must be defined before including ukfCore.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "utilities/bsk_Print.h"
+
+#define UKF_CORE_N_SIGMA (2*UKF_CORE_N_STATES + 1)
+#define UKF_CORE_QR_COLS (UKF_CORE_N_STATES > UKF_CORE_N_MEAS ? UKF_CORE_N_STATES : UKF_CORE_N_MEAS)
+#define UKF_CORE_QR_ROWS (2*UKF_CORE_N_STATES + UKF_CORE_QR_COLS)
+
+/*! Computes only the R factor of the QR decomposition of the nRow x nCol matrix inMat
+ (modified Gram-Schmidt, identical to ukfQRDJustR) into the nCol x nCol matrix destMat.
+ @return void
+ @param inMat Row-major source matrix
+ @param nRow Number of rows, at most UKF_CORE_QR_ROWS
+ @param nCol Number of columns, at most UKF_CORE_QR_COLS
+ @param destMat Upper-triangular R factor
+ */
+static inline void ukfCoreQRDJustR(const double *inMat, int32_t nRow, int32_t nCol,
+                                   double *destMat)
+{
+    int32_t i, j, k;
+    double qMat[UKF_CORE_QR_ROWS*UKF_CORE_QR_COLS];
+    double sourceMat[UKF_CORE_QR_ROWS*UKF_CORE_QR_COLS];
+    double sum;
+
+    memset(destMat, 0x0, (size_t) (nCol*nCol)*sizeof(double));
+    memcpy(sourceMat, inMat, (size_t) (nRow*nCol)*sizeof(double));
+
+    for (i = 0; i<nCol; i++)
+    {
+        sum = 0.0;
+        for (j = 0; j<nRow; j++)
+        {
+            sum += sourceMat[j*nCol + i] * sourceMat[j*nCol + i];
+        }
+        destMat[i*nCol + i] = sqrt(sum);
+        for (j = 0; j<nRow; j++)
+        {
+            qMat[j*nCol + i] = sourceMat[j*nCol + i] / destMat[i*nCol + i];
+        }
+        for (j = i + 1; j<nCol; j++)
+        {
+            sum = 0.0;
+            for (k = 0; k<nRow; k++)
+            {
+                sum += sourceMat[k*nCol + j] * qMat[k*nCol + i];
+            }
+            destMat[i*nCol + j] = sum;
+            for (k = 0; k<nRow; k++)
+            {
+                sourceMat[k*nCol + j] -= sum*qMat[k*nCol + i];
+            }
+        }
+    }
+}
+
+/*! Rank-one Cholesky update (beta > 0) or down-date (beta < 0) of the lower-triangular
+ matrix rMat by the vector xVec, identical to ukfCholDownDate.
+ @return 0 on success, -1 if the down-date lost positive definiteness
+ @param rMat Lower-triangular source matrix
+ @param xVec Update vector
+ @param beta Update weight
+ @param nDim Matrix dimension, at most UKF_CORE_QR_COLS
+ @param rOut Updated lower-triangular matrix
+ */
+static inline int32_t ukfCoreCholDownDate(const double *rMat, const double *xVec, double beta,
+                                          int32_t nDim, double *rOut)
+{
+    int32_t i, j;
+    double wVec[UKF_CORE_QR_COLS];
+    double rEl2, bParam, gamma;
+
+    memcpy(wVec, xVec, (size_t) nDim*sizeof(double));
+    memset(rOut, 0x0, (size_t) (nDim*nDim)*sizeof(double));
+
+    bParam = 1.0;
+    for (i = 0; i < nDim; i++)
+    {
+        rEl2 = rMat[i*nDim+i] * rMat[i*nDim+i];
+        if (rEl2 + beta/bParam * wVec[i]*wVec[i]<0){
+            BSK_PRINT(MSG_WARNING, "Invalid SQRT in ukfCoreCholDownDate, skipping value.");
+            return -1;}
+        rOut[i*nDim + i] = sqrt(rEl2 + beta/bParam * wVec[i]*wVec[i]);
+        gamma = rEl2*bParam + beta * wVec[i]*wVec[i];
+        for(j=i+1; j<nDim; j++)
+        {
+            wVec[j] = wVec[j] - wVec[i]/rMat[i*nDim + i]*rMat[j*nDim+i];
+            rOut[j*nDim +i] = rOut[i*nDim + i]/rMat[i*nDim + i] *
+                rMat[j*nDim + i];
+            rOut[j*nDim +i] += rOut[i*nDim + i]*beta*wVec[j]*wVec[i]/gamma;
+        }
+        bParam += beta * wVec[i]*wVec[i]/rEl2;
+    }
+    return 0;
+}
+
+/*! Inverse of the lower-triangular matrix sy, identical to ukfLInv.
+ @return 0 on success, -1 on a zero pivot
+ */
+static inline int32_t ukfCoreLInv(const double *sy, int32_t nDim, double *destMat)
+{
+    int32_t i, j, k;
+
+    memset(destMat, 0x0, (size_t) (nDim*nDim)*sizeof(double));
+    for (i = nDim - 1; i >= 0; i--)
+    {
+        if (sy[i*nDim + i] == 0)
+        {
+            BSK_PRINT(MSG_WARNING, "Can't invert zero matrix.");
+            return -1;
+        }
+        destMat[nDim*i + i] = 1.0 / sy[i*nDim + i];
+        for (j = nDim - 1; j >= i + 1; j--)
+        {
+            destMat[nDim*j + i] = 0.0;
+            for (k = i + 1; k <= j; k++)
+            {
+                destMat[j*nDim + i] -= sy[nDim*k + i] * destMat[j*nDim + k];
+            }
+            destMat[j*nDim + i] *= destMat[nDim*i + i];
+        }
+    }
+    return 0;
+}
+
+/*! Inverse of the upper-triangular matrix syT, identical to ukfUInv.
+ @return 0 on success, -1 on a zero pivot
+ */
+static inline int32_t ukfCoreUInv(const double *syT, int32_t nDim, double *destMat)
+{
+    int32_t i, j, k;
+
+    memset(destMat, 0x0, (size_t) (nDim*nDim)*sizeof(double));
+    for (i = nDim - 1; i >= 0; i--)
+    {
+        if (syT[i*nDim + i] == 0)
+        {
+            BSK_PRINT(MSG_WARNING, "Can't invert zero matrix.");
+            return -1;
+        }
+        destMat[nDim*i + i] = 1.0 / syT[i*nDim + i];
+        for (j = nDim - 1; j >= i + 1; j--)
+        {
+            destMat[nDim*i + j] = 0.0;
+            for (k = i + 1; k <= j; k++)
+            {
+                destMat[i*nDim + j] -= syT[nDim*i + k] * destMat[k*nDim + j];
+            }
+            destMat[i*nDim + j] *= destMat[nDim*i + i];
+        }
+    }
+    return 0;
+}
+
+/*! Checks that the sigma point covariance weights can be square-rooted.  The filters reject zero
+ weights in their time updates but not in their measurement updates, hence the rejectZero flag.
+ @return 0 if all of wC[1..2N] are positive (or non-negative if rejectZero is 0), -1 otherwise
+ @param wC Covariance weights
+ @param rejectZero Flag to also reject weights equal to zero
+ */
+static inline int32_t ukfCoreCheckWeights(const double *wC, int32_t rejectZero)
+{
+    int32_t i;
+
+    for (i = 1; i<UKF_CORE_N_SIGMA; i++)
+    {
+        if (wC[i] < 0.0 || (rejectZero && wC[i] == 0.0)) {return -1;}
+    }
+    return 0;
+}
+
+/*! Generates the 2N+1 sigma points around the state using the columns of sBar.
+ @return void
+ @param state Current state estimate
+ @param sBar Lower-triangular covariance square root
+ @param gamma Sigma point spread
+ @param sigmaPoints Sigma points (2N+1 rows of N states)
+ */
+static inline void ukfCoreSigmaPoints(const double *state, const double *sBar, double gamma,
+                                      double *sigmaPoints)
+{
+    int32_t i, j;
+    double *spPlus;
+    double *spMinus;
+
+    memcpy(sigmaPoints, state, UKF_CORE_N_STATES*sizeof(double));
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        spPlus = &sigmaPoints[(1 + i)*UKF_CORE_N_STATES];
+        spMinus = &sigmaPoints[(1 + i + UKF_CORE_N_STATES)*UKF_CORE_N_STATES];
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            spPlus[j] = gamma*sBar[j*UKF_CORE_N_STATES + i] + state[j];
+            spMinus[j] = -gamma*sBar[j*UKF_CORE_N_STATES + i] + state[j];
+        }
+    }
+}
+
+/*! Generates the 2N+1 sigma points as the columns of an N x (2N+1) row-major matrix, so that
+ each state component is contiguous across all sigma points.  This is the layout used by the
+ batched state propagation functions of the filters.  The values are identical to
+ ukfCoreSigmaPoints.
+ @return void
+ @param state Current state estimate
+ @param sBar Lower-triangular covariance square root
+ @param gamma Sigma point spread
+ @param spColumns Sigma points (N rows of 2N+1 sigma point values)
+ */
+static inline void ukfCoreSigmaPointColumns(const double *state, const double *sBar, double gamma,
+                                            double *spColumns)
+{
+    int32_t i, j;
+    double *spRow;
+
+    for (j = 0; j<UKF_CORE_N_STATES; j++)
+    {
+        spRow = &spColumns[j*UKF_CORE_N_SIGMA];
+        spRow[0] = state[j];
+        for (i = 0; i<UKF_CORE_N_STATES; i++)
+        {
+            spRow[1 + i] = gamma*sBar[j*UKF_CORE_N_STATES + i] + state[j];
+            spRow[1 + i + UKF_CORE_N_STATES] = -gamma*sBar[j*UKF_CORE_N_STATES + i] + state[j];
+        }
+    }
+}
+
+/*! Transposes sigma points stored as columns back into the 2N+1 rows of N states used by
+ the rest of the core.
+ @return void
+ @param spColumns Sigma points (N rows of 2N+1 sigma point values)
+ @param sigmaPoints Sigma points (2N+1 rows of N states)
+ */
+static inline void ukfCoreSigmaPointRows(const double *spColumns, double *sigmaPoints)
+{
+    int32_t i, j;
+
+    for (i = 0; i<UKF_CORE_N_SIGMA; i++)
+    {
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            sigmaPoints[i*UKF_CORE_N_STATES + j] = spColumns[j*UKF_CORE_N_SIGMA + i];
+        }
+    }
+}
+
+/*! Weighted mean of the propagated sigma points.  The +/- points are accumulated
+ pairwise, matching the order in which the filters originally summed them.
+ @return void
+ @param sigmaPoints Propagated sigma points
+ @param wM Mean weights
+ @param xBar Weighted mean state
+ */
+static inline void ukfCoreStateMean(const double *sigmaPoints, const double *wM, double *xBar)
+{
+    int32_t i, j, iPlus, iMinus;
+
+    for (j = 0; j<UKF_CORE_N_STATES; j++)
+    {
+        xBar[j] = wM[0]*sigmaPoints[j];
+    }
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        iPlus = 1 + i;
+        iMinus = 1 + i + UKF_CORE_N_STATES;
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            xBar[j] = wM[iPlus]*sigmaPoints[iPlus*UKF_CORE_N_STATES + j] + xBar[j];
+        }
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            xBar[j] = wM[iMinus]*sigmaPoints[iMinus*UKF_CORE_N_STATES + j] + xBar[j];
+        }
+    }
+}
+
+/*! Time update of the covariance square root (equations 20 and 21 of the design document):
+ QR decomposition of the weighted sigma point deviations stacked on the process noise
+ square root, followed by a Cholesky update with the mean sigma point.  The weights
+ are expected to have been validated with ukfCoreCheckWeights.
+ @return 0 on success, -1 on a failed down-date
+ @param sigmaPoints Propagated sigma points
+ @param xBar Weighted mean state
+ @param wC Covariance weights
+ @param sQnoise Process noise square root (N x N)
+ @param sBar Updated lower-triangular covariance square root
+ */
+static inline int32_t ukfCoreStateSqrt(const double *sigmaPoints, const double *xBar,
+                                       const double *wC, const double *sQnoise, double *sBar)
+{
+    int32_t i, j;
+    double AT[(2*UKF_CORE_N_STATES + UKF_CORE_N_STATES)*UKF_CORE_N_STATES];
+    double rAT[UKF_CORE_N_STATES*UKF_CORE_N_STATES];
+    double sBarQR[UKF_CORE_N_STATES*UKF_CORE_N_STATES];
+    double xErr[UKF_CORE_N_STATES];
+    double wSqrt;
+
+    for (i = 0; i<2*UKF_CORE_N_STATES; i++)
+    {
+        wSqrt = sqrt(wC[i+1]);
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            AT[i*UKF_CORE_N_STATES + j] = wSqrt*(sigmaPoints[(i+1)*UKF_CORE_N_STATES + j] - xBar[j]);
+        }
+    }
+    memcpy(&AT[2*UKF_CORE_N_STATES*UKF_CORE_N_STATES], sQnoise,
+           UKF_CORE_N_STATES*UKF_CORE_N_STATES*sizeof(double));
+    ukfCoreQRDJustR(AT, 3*UKF_CORE_N_STATES, UKF_CORE_N_STATES, rAT);
+
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            sBarQR[i*UKF_CORE_N_STATES + j] = rAT[j*UKF_CORE_N_STATES + i];
+        }
+        xErr[i] = sigmaPoints[i] - xBar[i];
+    }
+    return ukfCoreCholDownDate(sBarQR, xErr, wC[0], UKF_CORE_N_STATES, sBar);
+}
+
+/*! Weighted mean of the sigma point measurement models (equation 23).
+ @return void
+ @param yMeas Measurement models (2N+1 rows of numObs)
+ @param wM Mean weights
+ @param numObs Number of observations, at most UKF_CORE_N_MEAS
+ @param yBar Weighted mean measurement
+ */
+static inline void ukfCoreMeasMean(const double *yMeas, const double *wM, int32_t numObs,
+                                   double *yBar)
+{
+    int32_t i, j;
+
+    memset(yBar, 0x0, (size_t) numObs*sizeof(double));
+    for (i = 0; i<UKF_CORE_N_SIGMA; i++)
+    {
+        for (j = 0; j<numObs; j++)
+        {
+            yBar[j] = yBar[j] + wM[i]*yMeas[i*numObs + j];
+        }
+    }
+}
+
+/*! Measurement covariance square root (equations 24 and 25).  The weighted measurement
+ deviations are scaled by noiseSF before being stacked on the measurement noise square root.
+ @return 0 on success, -1 on a failed down-date
+ @param yMeas Measurement models
+ @param yBar Weighted mean measurement
+ @param wC Covariance weights
+ @param qChol Lower-triangular measurement noise square root (numObs x numObs)
+ @param noiseSF Scale factor applied to the sigma point deviations
+ @param numObs Number of observations, at most UKF_CORE_N_MEAS
+ @param sy Lower-triangular measurement covariance square root
+ */
+static inline int32_t ukfCoreMeasSqrt(const double *yMeas, const double *yBar, const double *wC,
+                                      const double *qChol, double noiseSF, int32_t numObs,
+                                      double *sy)
+{
+    int32_t i, j;
+    double AT[(2*UKF_CORE_N_STATES + UKF_CORE_N_MEAS)*UKF_CORE_N_MEAS];
+    double rAT[UKF_CORE_N_MEAS*UKF_CORE_N_MEAS];
+    double syQR[UKF_CORE_N_MEAS*UKF_CORE_N_MEAS];
+    double yErr[UKF_CORE_N_MEAS];
+    double wSqrt;
+
+    for (i = 0; i<2*UKF_CORE_N_STATES; i++)
+    {
+        wSqrt = sqrt(wC[i+1]);
+        for (j = 0; j<numObs; j++)
+        {
+            AT[i*numObs + j] = wSqrt*(yMeas[(i+1)*numObs + j] - yBar[j]);
+        }
+    }
+    if (noiseSF != 1.0)
+    {
+        for (i = 0; i<2*UKF_CORE_N_STATES*numObs; i++)
+        {
+            AT[i] *= noiseSF;
+        }
+    }
+    memcpy(&AT[2*UKF_CORE_N_STATES*numObs], qChol, (size_t) (numObs*numObs)*sizeof(double));
+    ukfCoreQRDJustR(AT, 2*UKF_CORE_N_STATES + numObs, numObs, rAT);
+
+    for (i = 0; i<numObs; i++)
+    {
+        for (j = 0; j<numObs; j++)
+        {
+            syQR[i*numObs + j] = rAT[j*numObs + i];
+        }
+        yErr[i] = yMeas[i] - yBar[i];
+    }
+    return ukfCoreCholDownDate(syQR, yErr, wC[0], numObs, sy);
+}
+
+/*! State/measurement cross covariance Pxy (equation 26).
+ @return void
+ @param sigmaPoints Sigma points
+ @param xBar Weighted mean state
+ @param yMeas Measurement models
+ @param yBar Weighted mean measurement
+ @param wC Covariance weights
+ @param numObs Number of observations, at most UKF_CORE_N_MEAS
+ @param pXY Cross covariance (N x numObs)
+ */
+static inline void ukfCoreCrossCovar(const double *sigmaPoints, const double *xBar,
+                                     const double *yMeas, const double *yBar, const double *wC,
+                                     int32_t numObs, double *pXY)
+{
+    int32_t i, j, k;
+    double xErr[UKF_CORE_N_STATES];
+    double yErr[UKF_CORE_N_MEAS];
+
+    memset(pXY, 0x0, (size_t) (UKF_CORE_N_STATES*numObs)*sizeof(double));
+    for (i = 0; i<UKF_CORE_N_SIGMA; i++)
+    {
+        for (k = 0; k<numObs; k++)
+        {
+            yErr[k] = yMeas[i*numObs + k] - yBar[k];
+        }
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            xErr[j] = wC[i]*(sigmaPoints[i*UKF_CORE_N_STATES + j] - xBar[j]);
+        }
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            for (k = 0; k<numObs; k++)
+            {
+                pXY[j*numObs + k] = pXY[j*numObs + k] + xErr[j]*yErr[k];
+            }
+        }
+    }
+}
+
+/*! Kalman gain, state correction and covariance square root down-dates (equations 27 and 28).
+ @return 0 on success, negative if a triangular inversion or a down-date failed
+ @param pXY Cross covariance
+ @param sy Lower-triangular measurement covariance square root
+ @param obs Observations
+ @param yBar Weighted mean measurement
+ @param numObs Number of observations, at most UKF_CORE_N_MEAS
+ @param state State estimate, corrected in place
+ @param sBar Covariance square root, down-dated in place
+ */
+static inline int32_t ukfCoreMeasUpdate(const double *pXY, const double *sy, const double *obs,
+                                        const double *yBar, int32_t numObs, double *state,
+                                        double *sBar)
+{
+    int32_t i, j, k;
+    int32_t badUpdate = 0;
+    double syT[UKF_CORE_N_MEAS*UKF_CORE_N_MEAS];
+    double syInv[UKF_CORE_N_MEAS*UKF_CORE_N_MEAS];
+    double kTemp[UKF_CORE_N_STATES*UKF_CORE_N_MEAS];
+    double kMat[UKF_CORE_N_STATES*UKF_CORE_N_MEAS];
+    double uCol[UKF_CORE_N_STATES];
+    double yErr[UKF_CORE_N_MEAS];
+    double sBarUp[UKF_CORE_N_STATES*UKF_CORE_N_STATES];
+    double sum;
+
+    for (i = 0; i<numObs; i++)
+    {
+        for (j = 0; j<numObs; j++)
+        {
+            syT[i*numObs + j] = sy[j*numObs + i];
+        }
+    }
+
+    /*! - K = Pxy (Sy^T)^-1 Sy^-1, using triangular back-substitution for both inverses*/
+    badUpdate += ukfCoreUInv(syT, numObs, syInv);
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        for (j = 0; j<numObs; j++)
+        {
+            sum = 0.0;
+            for (k = 0; k<numObs; k++)
+            {
+                sum += pXY[i*numObs + k]*syInv[k*numObs + j];
+            }
+            kTemp[i*numObs + j] = sum;
+        }
+    }
+    badUpdate += ukfCoreLInv(sy, numObs, syInv);
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        for (j = 0; j<numObs; j++)
+        {
+            sum = 0.0;
+            for (k = 0; k<numObs; k++)
+            {
+                sum += kTemp[i*numObs + k]*syInv[k*numObs + j];
+            }
+            kMat[i*numObs + j] = sum;
+        }
+    }
+
+    /*! - Correct the state with the gain-weighted innovation*/
+    for (k = 0; k<numObs; k++)
+    {
+        yErr[k] = obs[k] - yBar[k];
+    }
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        sum = 0.0;
+        for (k = 0; k<numObs; k++)
+        {
+            sum += kMat[i*numObs + k]*yErr[k];
+        }
+        state[i] = state[i] + sum;
+    }
+
+    /*! - Down-date sBar by each column of U = K Sy*/
+    for (j = 0; j<numObs; j++)
+    {
+        for (i = 0; i<UKF_CORE_N_STATES; i++)
+        {
+            sum = 0.0;
+            for (k = 0; k<numObs; k++)
+            {
+                sum += kMat[i*numObs + k]*sy[k*numObs + j];
+            }
+            uCol[i] = sum;
+        }
+        badUpdate += ukfCoreCholDownDate(sBar, uCol, -1.0, UKF_CORE_N_STATES, sBarUp);
+        memcpy(sBar, sBarUp, UKF_CORE_N_STATES*UKF_CORE_N_STATES*sizeof(double));
+    }
+    return badUpdate;
+}
+
+/*! Covariance from its square root, covar = sBar sBar^T.
+ @return void
+ @param sBar Lower-triangular covariance square root
+ @param covar Covariance matrix
+ */
+static inline void ukfCoreCovar(const double *sBar, double *covar)
+{
+    int32_t i, j, k;
+    double sum;
+
+    for (i = 0; i<UKF_CORE_N_STATES; i++)
+    {
+        for (j = 0; j<UKF_CORE_N_STATES; j++)
+        {
+            sum = 0.0;
+            for (k = 0; k<UKF_CORE_N_STATES; k++)
+            {
+                sum += sBar[i*UKF_CORE_N_STATES + k]*sBar[j*UKF_CORE_N_STATES + k];
+            }
+            covar[i*UKF_CORE_N_STATES + j] = sum;
+        }
+    }
+}
+
+#endif
@@ -17,8 +17,8 @@
 
  */
 
-#include "attDetermination/_GeneralModuleFiles/ukfUtilities.h"
-#include "simulation/utilities/linearAlgebra.h"
+#include "ukfUtilities.h"
+#include "linearAlgebra.h"
 #include "utilities/bsk_Print.h"
 #include <math.h>
 
@@ -111,7 +111,7 @@ int32_t ukfUInv(double *sourceMat, int32_t nRow, int32_t nCol, double *destMat)
 	mSetZero(destMat, (size_t) nRow, (size_t) nCol);
 	if (nRow != nCol)
 	{
-		BSK_PRINT(MSG_WARNING, "Can't get a lower-triangular inverse of non-square matrix in ukfLInv.");
+		BSK_PRINT(MSG_WARNING, "Can't get a lower-triangular inverse of non-square matrix in ukfUInv.");
 		return -1;
 	}
 	mat_dim = nRow;
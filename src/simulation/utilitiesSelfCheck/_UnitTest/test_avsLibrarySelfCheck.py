@@ -36,7 +36,8 @@ from Basilisk.utilities import unitTestSupport
                           , "testOrbitalAnomalies"
                           , "testLinearAlgebra"
                           , "testOrbitalHill"
-                          , "testEnvironment"])
+                          , "testEnvironment"
+                          , "testBatchConversions"])
 # provide a unique test method name, starting with test_
 def test_unitDynamicsModes(testName):
     """AVS Library Self Check"""
@@ -79,6 +80,11 @@ def unitAVSLibrarySelfCheck(testName):
         if errorCount:
             testFailCount += errorCount
             testMessages.append("ERROR: Space Environment Library Failed Self Test.\n")
+    if testName == "testBatchConversions":
+        errorCount = avsLibrarySelfCheck.testBatchConversions(1e-10)
+        if errorCount:
+            testFailCount += errorCount
+            testMessages.append("ERROR: Batch Conversions Failed Self Test.\n")
 
     if testFailCount == 0:
         print("PASSED ")
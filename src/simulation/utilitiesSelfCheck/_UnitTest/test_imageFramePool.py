@@ -0,0 +1,63 @@
+''' '''
+'''
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+'''
+
+#
+#   Unit Test for the ImageFramePool Utility
+#   Purpose:  Self-check on the raw image frame pool
+#   Note that all of this test is really in c++. This script is just a pytest access to those tests.
+
+import pytest
+from Basilisk.simulation import imageFramePoolCheck
+
+
+@pytest.mark.parametrize("testName"
+    , ["testImageFramePool"])
+# provide a unique test method name, starting with test_
+def test_unitImageFramePool(testName):
+    """
+    Checks the acquire, retain and release reference counting of the frame pool, that released frames are reused
+    for frames of equal or smaller size without a new allocation, and that a new distinct frame is allocated once
+    every frame of the pool is in use.
+    """
+    # each test method requires a single assert method to be called
+    [testResults, testMessage] = unitImageFramePoolSelfCheck(testName)
+    assert testResults < 1, testMessage
+
+
+def unitImageFramePoolSelfCheck(testName):
+    testMessages = []  # create empty array to store test log messages
+
+    testFailCount = imageFramePoolCheck.testImageFramePool()
+    if testFailCount > 0:
+        testMessages.append("ERROR: ImageFramePool Test.\n")
+
+    # each test method requires a single assert method to be called
+    # this check below just makes sure no sub-test failures were found
+    return [testFailCount, ''.join(testMessages)]
+
+
+#
+# This statement below ensures that the unit test scrip can be run as a
+# stand-along python script
+#
+if __name__ == "__main__":
+    unitImageFramePoolSelfCheck(
+        "testImageFramePool"
+    )
@@ -142,5 +142,96 @@ def test_unitKeplerianOrbit(show_plots=False):
 
     return [testFailCount, ''.join(testMessages)]
 
+@pytest.mark.parametrize("e", [0.01, 0.7, 0.9, 1.5])
+def test_keplerianOrbitPropagation(e):
+    """
+    Unit Test Keplerian Orbit propagation
+
+    This test covers:
+    1) propagate() against the Kepler equation solution of orbitalMotion
+    2) sampleStates() against propagate()
+    3) the state transition matrix being symplectic and inverted by propagating back
+    4) the true anomaly after propagate(), including hyperbolic passes sweeping more than pi
+    5) sampleStates() with steps of several revolutions on closed orbits
+    """
+    earth = gravityEffector.GravBodyData()
+    earth.mu = orbitalMotion.MU_EARTH
+    oe = orbitalMotion.ClassicElements()
+    oe.a = 7000. / (1 - e)
+    oe.e = e
+    oe.i = 0.7
+    oe.Omega = 1.1
+    oe.omega = 2.0
+    oe.f = 0.4
+    orb = keplerianOrbit.KeplerianOrbit()
+    orb.set_planet(earth)
+    orb.set_a(oe.a)
+    orb.set_e(oe.e)
+    orb.set_i(oe.i)
+    orb.set_RAAN(oe.Omega)
+    orb.set_omega(oe.omega)
+    orb.set_f(oe.f)
+
+    times = np.linspace(-4000., 20000., 25)
+    states = np.array(orb.sampleStates(times))
+    for k in range(len(times)):
+        # reference state from the mean anomaly at time t
+        if e < 1.0:
+            M = orbitalMotion.E2M(orbitalMotion.f2E(oe.f, e), e) + np.sqrt(earth.mu / oe.a**3) * times[k]
+            f = orbitalMotion.E2f(orbitalMotion.M2E(M, e), e)
+        else:
+            N = orbitalMotion.H2N(orbitalMotion.f2H(oe.f, e), e) + np.sqrt(-earth.mu / oe.a**3) * times[k]
+            f = orbitalMotion.H2f(orbitalMotion.N2H(N, e), e)
+        oeTrue = copy(oe)
+        oeTrue.f = f
+        rTrue, vTrue = orbitalMotion.elem2rv(earth.mu, oeTrue)
+        assert np.allclose(states[k, 0:3], rTrue, rtol=1e-10, atol=1e-6)
+        assert np.allclose(states[k, 3:6], vTrue, rtol=1e-10, atol=1e-9)
+
+        orbK = keplerianOrbit.KeplerianOrbit(orb)
+        orbK.propagate(times[k])
+        assert np.allclose(np.array(orbK.r_BP_P()).flatten(), states[k, 0:3], rtol=1e-12, atol=1e-8)
+        assert np.allclose(np.array(orbK.v_BP_P()).flatten(), states[k, 3:6], rtol=1e-12, atol=1e-11)
+        if e < 1.0:
+            assert 0.0 <= orbK.f() < 2 * np.pi
+            assert abs(np.remainder(orbK.f() - f + np.pi, 2 * np.pi) - np.pi) < 1e-9
+        else:
+            assert abs(orbK.f() - f) < 1e-9
+
+    if e < 1.0:
+        # coarse steps from periapsis, the previous sample is then a poor guess of the next one
+        orbP = keplerianOrbit.KeplerianOrbit(orb)
+        orbP.set_f(0.0)
+        coarseTimes = np.array([0., orbP.P() / 2, 3 * orbP.P()])
+        coarseStates = np.array(orbP.sampleStates(coarseTimes))
+        for k in range(len(coarseTimes)):
+            orbK = keplerianOrbit.KeplerianOrbit(orbP)
+            orbK.propagate(coarseTimes[k])
+            assert np.allclose(coarseStates[k, 0:3], np.array(orbK.r_BP_P()).flatten(), rtol=1e-10, atol=1e-6)
+            assert np.allclose(coarseStates[k, 3:6], np.array(orbK.v_BP_P()).flatten(), rtol=1e-10, atol=1e-9)
+        assert np.allclose(coarseStates[1, 0:3], -(1 + e) / (1 - e) * coarseStates[0, 0:3], rtol=1e-9)
+
+    if e > 1.0:
+        # a pass from f = -2 to f = +2 sweeps more than pi and must stay within the asymptotes
+        orbH = keplerianOrbit.KeplerianOrbit(orb)
+        orbH.set_f(-2.0)
+        nH = np.sqrt(-earth.mu / oe.a**3)
+        dt = (orbitalMotion.H2N(orbitalMotion.f2H(2.0, e), e) - orbitalMotion.H2N(orbitalMotion.f2H(-2.0, e), e)) / nH
+        orbH.propagate(dt)
+        assert abs(orbH.f() - 2.0) < 1e-9
+        orbH.propagate(-dt)
+        assert abs(orbH.f() + 2.0) < 1e-9
+
+    # the state transition matrix preserves the symplectic form and propagating back inverts it
+    dt = 5000.
+    stm = np.array(orb.stateTransitionMatrix(dt))
+    J = np.block([[np.zeros((3, 3)), np.eye(3)], [-np.eye(3), np.zeros((3, 3))]])
+    assert np.allclose(stm.T.dot(J).dot(stm), J, atol=1e-9)
+    orb.propagate(dt)
+    stmBack = np.array(orb.stateTransitionMatrix(-dt))
+    assert np.allclose(stmBack.dot(stm), np.eye(6), atol=1e-9)
+
+
 if __name__ == "__main__":
-    test_unitKeplerianOrbit()
\ No newline at end of file
+    test_unitKeplerianOrbit()
+    test_keplerianOrbitPropagation(0.7)
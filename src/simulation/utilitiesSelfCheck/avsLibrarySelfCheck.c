@@ -3936,5 +3936,112 @@ int testRigidBodyKinematics(double accuracy)
     }
 
 
+    return errorCount;
+}
+
+int testBatchConversions(double accuracy)
+{
+    int errorCount = 0;
+    int i;
+
+    double M[8] = {-20.0, -3.1, -0.5, 0.0, 0.01, 1.0, 3.1, 40.0};
+    double e[8] = {0.0, 0.1, 0.3, 0.5, 0.999, 0.7, 0.9, 0.95};
+    double eHyp[8] = {1.01, 1.1, 1.5, 2.0, 2.3, 3.0, 5.0, 10.0};
+    double Ecc[8];
+    double H[8];
+    classicElements elements[3];
+    classicElements elementsOut[3];
+    classicElements elementsRef;
+    double r[3][3];
+    double v[3][3];
+    double rRef[3];
+    double vRef[3];
+    double mrp[3][3] = {{0.1, 0.2, 0.3}, {-0.5, 0.4, 0.1}, {0.0, 0.0, 0.0}};
+    double ep[3][4];
+    double mrpOut[3][3];
+    double epOut[3][4];
+    double dcm[3][3][3];
+    double dcmRef[3][3];
+    double v3[4];
+
+    printf("--testBatchConversions, accuracy = %g\n", accuracy);
+
+    M2EBatch(M, e, 8, Ecc);
+    for(i = 0; i < 8; i++) {
+        if(!isEqual(Ecc[i] - e[i] * sin(Ecc[i]), M[i], accuracy)) {
+            printf("M2EBatch(%g, %g) failed with %g\n", M[i], e[i], Ecc[i]);
+            errorCount++;
+        }
+    }
+    N2HBatch(M, eHyp, 8, H);
+    for(i = 0; i < 8; i++) {
+        if(!isEqual(H[i], N2H(M[i], eHyp[i]), accuracy)) {
+            printf("N2HBatch(%g, %g) failed with %g\n", M[i], eHyp[i], H[i]);
+            errorCount++;
+        }
+    }
+
+    for(i = 0; i < 3; i++) {
+        elements[i].a = 8000.0 + 10000.0 * i;
+        elements[i].e = 0.3 * i;
+        elements[i].i = 0.5 * i;
+        elements[i].Omega = 1.0 + i;
+        elements[i].omega = 2.0 - i;
+        elements[i].f = 0.7 * i;
+        elements[i].rPeriap = elements[i].a * (1 - elements[i].e);
+    }
+    elem2rvBatch(MU_EARTH, elements, 3, r[0], v[0]);
+    rv2elemBatch(MU_EARTH, r[0], v[0], 3, elementsOut);
+    for(i = 0; i < 3; i++) {
+        elem2rv(MU_EARTH, &elements[i], rRef, vRef);
+        if(!v3IsEqualRel(r[i], rRef, accuracy) || !v3IsEqualRel(v[i], vRef, accuracy)) {
+            printf("elem2rvBatch() failed for orbit %d\n", i);
+            errorCount++;
+        }
+        rv2elem(MU_EARTH, r[i], v[i], &elementsRef);
+        if(!isEqualRel(elementsOut[i].a, elementsRef.a, accuracy) || !isEqual(elementsOut[i].e, elementsRef.e, accuracy)
+           || !isEqual(elementsOut[i].i, elementsRef.i, accuracy)
+           || !isEqual(elementsOut[i].Omega, elementsRef.Omega, accuracy)
+           || !isEqual(elementsOut[i].omega, elementsRef.omega, accuracy)
+           || !isEqual(elementsOut[i].f, elementsRef.f, accuracy)) {
+            printf("rv2elemBatch() failed for orbit %d\n", i);
+            errorCount++;
+        }
+    }
+
+    MRP2EPBatch(mrp[0], 3, ep[0]);
+    EP2MRPBatch(ep[0], 3, mrpOut[0]);
+    MRP2CBatch(mrp[0], 3, dcm[0][0]);
+    C2EPBatch(dcm[0][0], 3, epOut[0]);
+    for(i = 0; i < 3; i++) {
+        MRP2EP(mrp[i], v3);
+        if(!vIsEqual(ep[i], 4, v3, accuracy) || !vIsEqual(epOut[i], 4, v3, accuracy)) {
+            printf("MRP2EPBatch() or C2EPBatch() failed for attitude %d\n", i);
+            errorCount++;
+        }
+        if(!v3IsEqual(mrpOut[i], mrp[i], accuracy)) {
+            printf("EP2MRPBatch() failed for attitude %d\n", i);
+            errorCount++;
+        }
+        MRP2C(mrp[i], dcmRef);
+        if(!m33IsEqual(dcm[i], dcmRef, accuracy)) {
+            printf("MRP2CBatch() failed for attitude %d\n", i);
+            errorCount++;
+        }
+    }
+    EP2CBatch(ep[0], 3, dcm[0][0]);
+    C2MRPBatch(dcm[0][0], 3, mrpOut[0]);
+    for(i = 0; i < 3; i++) {
+        EP2C(ep[i], dcmRef);
+        if(!m33IsEqual(dcm[i], dcmRef, accuracy)) {
+            printf("EP2CBatch() failed for attitude %d\n", i);
+            errorCount++;
+        }
+        if(!v3IsEqual(mrpOut[i], mrp[i], accuracy)) {
+            printf("C2MRPBatch() failed for attitude %d\n", i);
+            errorCount++;
+        }
+    }
+
     return errorCount;
 }
@@ -33,6 +33,7 @@ int testOrbitalElements(double accuracy);
 int testOrbitalEnvironment(double accuracy);
 int testOrbitalHill(double accuracy);
 int testRigidBodyKinematics(double accuracy);
+int testBatchConversions(double accuracy);
 
 #ifdef __cplusplus
 }
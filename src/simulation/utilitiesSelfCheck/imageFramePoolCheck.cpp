@@ -0,0 +1,107 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "imageFramePoolCheck.h"
+#include "architecture/messaging/image_frame_pool.h"
+
+
+uint64_t testImageFramePool()
+{
+    uint64_t failures = 0;
+    ImageFramePool *pool = ImageFramePool::GetInstance();
+    /* the pool is shared with the rest of the simulation, so its free frames are held first and only the
+       frames added by this check are counted */
+    std::vector<uint8_t *> heldFrames;
+    size_t inUseBefore = pool->getNumFramesInUse();
+    while (pool->getNumFramesInUse() < pool->getNumFrames())
+    {
+        heldFrames.push_back((uint8_t *) pool->acquire(0));
+    }
+    size_t framesBefore = pool->getNumFrames();
+    int notFromPool = 0;
+
+    /* acquire and release */
+    uint8_t *frameA = (uint8_t *) pool->acquire(1000);
+    failures += frameA == NULL ? 1 : 0;
+    failures += pool->getReferenceCount(frameA) != 1 ? 1 : 0;
+    failures += pool->getNumFrames() != framesBefore + 1 ? 1 : 0;
+    failures += pool->getNumFramesInUse() != framesBefore + 1 ? 1 : 0;
+    memset(frameA, 0xAB, 1000);
+    pool->retain(frameA);
+    failures += pool->getReferenceCount(frameA) != 2 ? 1 : 0;
+    pool->release(frameA);
+    failures += pool->getReferenceCount(frameA) != 1 ? 1 : 0;
+    pool->release(frameA);
+    failures += pool->getReferenceCount(frameA) != 0 ? 1 : 0;
+    failures += pool->getNumFramesInUse() != framesBefore ? 1 : 0;
+    /* releasing a free frame again must not make its count negative */
+    pool->release(frameA);
+    failures += pool->getReferenceCount(frameA) != 0 ? 1 : 0;
+
+    /* pointers that do not come from the pool are ignored */
+    pool->retain(&notFromPool);
+    pool->release(&notFromPool);
+    failures += pool->getReferenceCount(&notFromPool) != -1 ? 1 : 0;
+
+    /* a released frame is reused for a frame of equal or smaller size, without a new allocation */
+    size_t framesAfterA = pool->getNumFrames();
+    uint8_t *frameB = (uint8_t *) pool->acquire(1000);
+    failures += frameB != frameA ? 1 : 0;
+    failures += pool->getNumFrames() != framesAfterA ? 1 : 0;
+    pool->release(frameB);
+    uint8_t *frameC = (uint8_t *) pool->acquire(600);
+    failures += frameC != frameA ? 1 : 0;
+    failures += pool->getNumFrames() != framesAfterA ? 1 : 0;
+
+    /* once every frame is in use the pool is exhausted and a new, distinct frame is allocated */
+    failures += pool->getNumFramesInUse() != pool->getNumFrames() ? 1 : 0;
+    size_t framesFull = pool->getNumFrames();
+    uint8_t *frameD = (uint8_t *) pool->acquire(600);
+    failures += frameD == NULL || frameD == frameC ? 1 : 0;
+    failures += pool->getNumFrames() != framesFull + 1 ? 1 : 0;
+    failures += pool->getReferenceCount(frameD) != 1 ? 1 : 0;
+    /* the new frame is writable over its full size without touching the frame still in use */
+    memset(frameD, 0x00, 600);
+    failures += frameC[0] != 0xAB || frameC[599] != 0xAB ? 1 : 0;
+
+    /* a frame larger than any free frame is not served by a smaller one */
+    pool->release(frameC);
+    uint8_t *frameE = (uint8_t *) pool->acquire(2000);
+    failures += frameE == frameC ? 1 : 0;
+    failures += pool->getNumFrames() != framesFull + 2 ? 1 : 0;
+
+    /* the smallest free frame that fits is reused */
+    pool->release(frameE);
+    uint8_t *frameF = (uint8_t *) pool->acquire(800);
+    failures += frameF != frameC ? 1 : 0;
+
+    pool->release(frameD);
+    pool->release(frameF);
+    for (size_t i = 0; i < heldFrames.size(); i++)
+    {
+        pool->release(heldFrames[i]);
+    }
+    failures += pool->getNumFramesInUse() != inUseBefore ? 1 : 0;
+
+    return failures;
+}
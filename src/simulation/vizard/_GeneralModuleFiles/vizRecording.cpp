@@ -0,0 +1,474 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "vizRecording.h"
+
+/*! Append an unsigned integer as a base 128 varint, the encoding of the protobuf size prefixes */
+static void putVarint(std::string &buffer, uint64_t value)
+{
+    while (value >= 0x80) {
+        buffer.push_back((char) ((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((char) value);
+}
+
+/*! Append an unsigned integer as 8 little endian bytes */
+static void putUint64(std::string &buffer, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back((char) ((value >> (8*i)) & 0xFF));
+    }
+}
+
+/*! Read 8 little endian bytes as an unsigned integer */
+static uint64_t getUint64(const char *data)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= ((uint64_t) (uint8_t) data[i]) << (8*i);
+    }
+    return(value);
+}
+
+/*! Read a varint from the buffer at pos, return false if the buffer ends first */
+static bool getVarint(const std::string &buffer, size_t &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < buffer.size(); shift += 7) {
+        uint8_t byte = (uint8_t) buffer[pos++];
+        value |= ((uint64_t) (byte & 0x7F)) << shift;
+        if (!(byte & 0x80)) {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+/*! Read a varint from the stream, return false if the stream ends first */
+static bool getVarint(std::ifstream &stream, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = stream.get();
+        if (byte == EOF) {
+            return(false);
+        }
+        value |= ((uint64_t) (byte & 0x7F)) << shift;
+        if (!(byte & 0x80)) {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+/*! Byte of the previous frame at pos, frames are compared as if the shorter one was padded with zeros */
+static char byteAt(const std::string &frame, size_t pos)
+{
+    return(pos < frame.size() ? frame[pos] : 0);
+}
+
+/*! The constructor */
+VizRecordingWriter::VizRecordingWriter()
+{
+    this->keyframeInterval = 100;
+    this->offset = 0;
+    return;
+}
+
+/*! The destructor writes the index if the recording is still open */
+VizRecordingWriter::~VizRecordingWriter()
+{
+    this->close();
+    return;
+}
+
+/*! This method creates the recording file and writes its magic
+ @return bool true if the file is open
+ @param fileName name of the recording file
+ @param keyframeInterval number of frames from one key frame to the next, 1 to only write key frames
+ */
+bool VizRecordingWriter::open(std::string fileName, uint32_t keyframeInterval)
+{
+    this->close();
+    this->stream.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!this->stream.is_open()) {
+        return(false);
+    }
+    this->stream.write(VIZ_RECORDING_MAGIC, 8);
+    this->offset = 8;
+    this->keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+    this->previousFrame.clear();
+    this->index.clear();
+    return(true);
+}
+
+/*! This method appends a serialized frame, as a key frame or as the changes from the previous frame
+ @return void
+ @param simNanos [ns] simulation time of the frame
+ @param data serialized frame
+ @param size [bytes] size of the serialized frame
+ */
+void VizRecordingWriter::writeFrame(uint64_t simNanos, const char *data, size_t size)
+{
+    if (!this->stream.is_open()) {
+        return;
+    }
+
+    VizRecordingIndexEntry entry;
+    entry.simNanos = simNanos;
+    entry.offset = this->offset;
+    bool keyFrame = this->index.size() % this->keyframeInterval == 0;
+    entry.keyFrame = keyFrame ? this->index.size() : this->index.back().keyFrame;
+
+    this->recordBuffer.clear();
+    this->recordBuffer.push_back(keyFrame ? 0 : 1);
+    putUint64(this->recordBuffer, simNanos);
+    if (keyFrame) {
+        putVarint(this->recordBuffer, size);
+        this->recordBuffer.append(data, size);
+    } else {
+        /* - runs of changed bytes absorb equal runs shorter than 3 bytes, which would cost as much as they save */
+        this->deltaBuffer.clear();
+        putVarint(this->deltaBuffer, size);
+        size_t pos = 0;
+        while (pos < size) {
+            size_t start = pos;
+            while (pos < size && byteAt(this->previousFrame, pos) == data[pos]) {
+                pos++;
+            }
+            size_t changedStart = pos;
+            while (pos < size) {
+                size_t equalEnd = pos;
+                while (equalEnd < size && equalEnd - pos < 3 && byteAt(this->previousFrame, equalEnd) == data[equalEnd]) {
+                    equalEnd++;
+                }
+                if (equalEnd - pos >= 3 || equalEnd == size) {
+                    break;
+                }
+                pos = equalEnd + 1;
+            }
+            putVarint(this->deltaBuffer, changedStart - start);
+            putVarint(this->deltaBuffer, pos - changedStart);
+            this->deltaBuffer.append(data + changedStart, pos - changedStart);
+        }
+        putVarint(this->recordBuffer, this->deltaBuffer.size());
+        this->recordBuffer.append(this->deltaBuffer);
+    }
+    this->previousFrame.assign(data, size);
+
+    this->stream.write(this->recordBuffer.data(), (std::streamsize) this->recordBuffer.size());
+    this->offset += this->recordBuffer.size();
+    this->index.push_back(entry);
+    return;
+}
+
+/*! This method writes the time index at the end of the recording and closes the file
+ @return void
+ */
+void VizRecordingWriter::close()
+{
+    if (!this->stream.is_open()) {
+        return;
+    }
+    /* - the index starts with a type byte that ends the scan of a recording whose index is incomplete */
+    this->recordBuffer.clear();
+    this->recordBuffer.push_back(2);
+    for (size_t idx = 0; idx < this->index.size(); idx++) {
+        putUint64(this->recordBuffer, this->index[idx].simNanos);
+        putUint64(this->recordBuffer, this->index[idx].offset);
+        putUint64(this->recordBuffer, this->index[idx].keyFrame);
+    }
+    putUint64(this->recordBuffer, this->offset);
+    putUint64(this->recordBuffer, this->index.size());
+    this->recordBuffer.append(VIZ_RECORDING_INDEX_MAGIC, 8);
+    this->stream.write(this->recordBuffer.data(), (std::streamsize) this->recordBuffer.size());
+    this->stream.close();
+    this->index.clear();
+    return;
+}
+
+/*! This method checks if the recording file is open
+ @return bool
+ */
+bool VizRecordingWriter::isOpen()
+{
+    return(this->stream.is_open());
+}
+
+/*! The constructor */
+VizRecordingReader::VizRecordingReader()
+{
+    this->frameNumber = -1;
+    return;
+}
+
+/*! The destructor */
+VizRecordingReader::~VizRecordingReader()
+{
+    this->close();
+    return;
+}
+
+/*! This method opens a recording and loads its time index.  A recording without the index, for example from a
+ simulation that did not finish, is indexed by scanning the frame records.
+ @return bool true if the file is a recording
+ @param fileName name of the recording file
+ */
+bool VizRecordingReader::open(std::string fileName)
+{
+    char magic[8];
+
+    this->close();
+    this->stream.open(fileName, std::ios::in | std::ios::binary);
+    if (!this->stream.is_open()) {
+        return(false);
+    }
+    if (!this->stream.read(magic, 8) || memcmp(magic, VIZ_RECORDING_MAGIC, 8) != 0) {
+        this->close();
+        return(false);
+    }
+    if (!this->readIndex() && !this->scanRecords()) {
+        this->close();
+        return(false);
+    }
+    return(true);
+}
+
+/*! This method closes the recording
+ @return void
+ */
+void VizRecordingReader::close()
+{
+    if (this->stream.is_open()) {
+        this->stream.close();
+    }
+    this->index.clear();
+    this->frameNumber = -1;
+    return;
+}
+
+/*! This method returns the number of frames of the recording
+ @return uint64_t
+ */
+uint64_t VizRecordingReader::getNumFrames()
+{
+    return(this->index.size());
+}
+
+/*! This method returns the simulation time of a frame
+ @return uint64_t [ns] frame time, 0 if the frame does not exist
+ @param frame frame number
+ */
+uint64_t VizRecordingReader::getFrameTime(uint64_t frame)
+{
+    return(frame < this->index.size() ? this->index[frame].simNanos : 0);
+}
+
+/*! This method finds the last frame at or before a time with a binary search of the time index
+ @return int64_t frame number, -1 if all frames are later
+ @param simNanos [ns] simulation time
+ */
+int64_t VizRecordingReader::findFrame(uint64_t simNanos)
+{
+    std::vector<VizRecordingIndexEntry>::iterator it;
+    it = std::upper_bound(this->index.begin(), this->index.end(), simNanos,
+                          [](uint64_t time, const VizRecordingIndexEntry &entry){return(time < entry.simNanos);});
+    return((int64_t) (it - this->index.begin()) - 1);
+}
+
+/*! This method decodes a frame from its key frame.  Frames read in increasing order are decoded from the last
+ decoded frame, so that a time window costs one delta per frame.
+ @return bool true if the frame was decoded
+ @param frame frame number
+ @param data serialized frame
+ */
+bool VizRecordingReader::readFrame(uint64_t frame, std::string &data)
+{
+    if (frame >= this->index.size()) {
+        return(false);
+    }
+    uint64_t first = this->index[frame].keyFrame;
+    if (this->frameNumber >= (int64_t) first && this->frameNumber <= (int64_t) frame) {
+        first = (uint64_t) (this->frameNumber + 1);
+    }
+
+    for (uint64_t current = first; current <= frame; current++) {
+        uint8_t type;
+        this->frameNumber = -1;
+        if (!this->readRecord(current, type)) {
+            return(false);
+        }
+        if (type == 0) {
+            this->frameData.swap(this->payload);
+            this->frameNumber = (int64_t) current;
+            continue;
+        }
+
+        /* - apply the runs of changed bytes to the previous frame */
+        size_t pos = 0;
+        uint64_t size;
+        if (!getVarint(this->payload, pos, size)) {
+            return(false);
+        }
+        this->frameData.resize(size, 0);
+        uint64_t framePos = 0;
+        while (pos < this->payload.size()) {
+            uint64_t equalCount, changedCount;
+            if (!getVarint(this->payload, pos, equalCount) || !getVarint(this->payload, pos, changedCount)
+                || framePos + equalCount + changedCount > size || pos + changedCount > this->payload.size()) {
+                return(false);
+            }
+            framePos += equalCount;
+            memcpy(&this->frameData[framePos], &this->payload[pos], changedCount);
+            framePos += changedCount;
+            pos += changedCount;
+        }
+        this->frameNumber = (int64_t) current;
+    }
+    data = this->frameData;
+    return(true);
+}
+
+/*! This method writes the frames of a time window as a stream of size prefixed frames, the file format that
+ Vizard plays.  The Vizard settings are only in the frames in which they were sent, usually the first one.
+ @return int64_t number of frames written, -1 if the file could not be written
+ @param startNanos [ns] time of the first frame of the window
+ @param stopNanos [ns] time of the last frame of the window
+ @param fileName name of the output file
+ */
+int64_t VizRecordingReader::extractWindow(uint64_t startNanos, uint64_t stopNanos, std::string fileName)
+{
+    std::ofstream output(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        return(-1);
+    }
+    std::string frame;
+    std::string sizePrefix;
+    int64_t count = 0;
+    uint64_t first = startNanos > 0 ? (uint64_t) (this->findFrame(startNanos - 1) + 1) : 0;
+    for (uint64_t idx = first; idx < this->index.size(); idx++) {
+        if (this->index[idx].simNanos > stopNanos || !this->readFrame(idx, frame)) {
+            break;
+        }
+        sizePrefix.clear();
+        putVarint(sizePrefix, frame.size());
+        output.write(sizePrefix.data(), (std::streamsize) sizePrefix.size());
+        output.write(frame.data(), (std::streamsize) frame.size());
+        count++;
+    }
+    return(count);
+}
+
+/*! This method loads the time index from the end of the file
+ @return bool true if the index is complete
+ */
+bool VizRecordingReader::readIndex()
+{
+    char footer[24];
+
+    this->stream.clear();
+    this->stream.seekg(0, std::ios::end);
+    uint64_t fileSize = (uint64_t) this->stream.tellg();
+    if (fileSize < 8 + 24) {
+        return(false);
+    }
+    this->stream.seekg((std::streamoff) (fileSize - 24));
+    if (!this->stream.read(footer, 24) || memcmp(footer + 16, VIZ_RECORDING_INDEX_MAGIC, 8) != 0) {
+        return(false);
+    }
+    uint64_t indexOffset = getUint64(footer);
+    uint64_t numFrames = getUint64(footer + 8);
+    if (indexOffset < 8 || indexOffset > fileSize - 24 || (fileSize - 24 - indexOffset) != 1 + numFrames*24) {
+        return(false);
+    }
+
+    std::string entries(1 + numFrames*24, 0);
+    this->stream.seekg((std::streamoff) indexOffset);
+    if (!this->stream.read(&entries[0], (std::streamsize) entries.size()) || entries[0] != 2) {
+        return(false);
+    }
+    this->index.resize(numFrames);
+    for (uint64_t idx = 0; idx < numFrames; idx++) {
+        this->index[idx].simNanos = getUint64(&entries[1 + 24*idx]);
+        this->index[idx].offset = getUint64(&entries[1 + 24*idx + 8]);
+        this->index[idx].keyFrame = getUint64(&entries[1 + 24*idx + 16]);
+    }
+    return(true);
+}
+
+/*! This method rebuilds the time index by reading the record headers, up to the first incomplete record
+ @return bool true if the file holds at least the magic
+ */
+bool VizRecordingReader::scanRecords()
+{
+    char header[9];
+    uint64_t offset = 8;
+
+    this->index.clear();
+    this->stream.clear();
+    this->stream.seekg(0, std::ios::end);
+    uint64_t fileSize = (uint64_t) this->stream.tellg();
+    this->stream.seekg((std::streamoff) offset);
+    while (this->stream.read(header, 9)) {
+        uint64_t size;
+        uint8_t type = (uint8_t) header[0];
+        if (type > 1 || (type == 1 && this->index.empty()) || !getVarint(this->stream, size)) {
+            break;
+        }
+        uint64_t end = (uint64_t) this->stream.tellg() + size;
+        if (end > fileSize) {
+            break;
+        }
+        VizRecordingIndexEntry entry;
+        entry.simNanos = getUint64(header + 1);
+        entry.offset = offset;
+        entry.keyFrame = type == 0 ? this->index.size() : this->index.back().keyFrame;
+        this->index.push_back(entry);
+        offset = end;
+        this->stream.seekg((std::streamoff) offset);
+    }
+    this->stream.clear();
+    return(true);
+}
+
+/*! This method reads the payload of a frame record
+ @return bool true if the record is complete
+ @param frame frame number
+ @param type record type, 0 for a key frame and 1 for a delta frame
+ */
+bool VizRecordingReader::readRecord(uint64_t frame, uint8_t &type)
+{
+    char header[9];
+    uint64_t size;
+
+    this->stream.clear();
+    this->stream.seekg((std::streamoff) this->index[frame].offset);
+    if (!this->stream.read(header, 9) || !getVarint(this->stream, size)) {
+        return(false);
+    }
+    type = (uint8_t) header[0];
+    this->payload.resize(size);
+    if (size > 0 && !this->stream.read(&this->payload[0], (std::streamsize) size)) {
+        return(false);
+    }
+    return(true);
+}
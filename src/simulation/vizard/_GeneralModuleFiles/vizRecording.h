@@ -0,0 +1,97 @@
+/*
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#ifndef VIZ_RECORDING_H
+#define VIZ_RECORDING_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+/*
+ * Indexed Vizard recording.  The file holds the serialized VizMessage frames as records
+ *
+ *     uint8 type, uint64 simNanos, varint payload size, payload
+ *
+ * where a key frame (type 0) stores the frame and a delta frame (type 1) stores the varint frame size followed by
+ * the runs of bytes that differ from the previous frame: pairs of varint equal byte count, varint changed byte
+ * count, changed bytes.  Every keyframeInterval-th frame is a key frame.  The file starts with the 8 byte
+ * VIZ_RECORDING_MAGIC and ends with the time index, the type byte 2 then one uint64 simNanos, uint64 record offset and
+ * uint64 key frame number per frame, followed by the uint64 index offset, the uint64 number of frames and
+ * VIZ_RECORDING_INDEX_MAGIC.
+ * All integers are little endian.  The frames are handled as bytes, the recording does not depend on protobuf.
+ */
+#define VIZ_RECORDING_MAGIC "BSKVIZR1"
+#define VIZ_RECORDING_INDEX_MAGIC "BSKVIZX1"
+
+/*! Time index entry of a recorded frame */
+typedef struct {
+    uint64_t simNanos;          //!< [ns] simulation time of the frame
+    uint64_t offset;            //!< [-] file offset of the frame record
+    uint64_t keyFrame;          //!< [-] number of the key frame the frame is decoded from
+}VizRecordingIndexEntry;
+
+/*! @brief Writes the frames of an indexed Vizard recording */
+class VizRecordingWriter {
+public:
+    VizRecordingWriter();
+    ~VizRecordingWriter();
+    bool open(std::string fileName, uint32_t keyframeInterval);
+    void writeFrame(uint64_t simNanos, const char *data, size_t size);
+    void close();
+    bool isOpen();
+
+private:
+    std::ofstream stream;                           //!< [-] recording file
+    uint32_t keyframeInterval;                      //!< [-] number of frames from one key frame to the next
+    uint64_t offset;                                //!< [-] file offset of the next record
+    std::string previousFrame;                      //!< [-] last frame, the reference of the next delta frame
+    std::string recordBuffer;                       //!< [-] record being written, reused for every frame
+    std::string deltaBuffer;                        //!< [-] delta frame payload, reused for every frame
+    std::vector<VizRecordingIndexEntry> index;      //!< [-] time index written when the recording is closed
+};
+
+/*! @brief Reads frames and time windows of an indexed Vizard recording */
+class VizRecordingReader {
+public:
+    VizRecordingReader();
+    ~VizRecordingReader();
+    bool open(std::string fileName);
+    void close();
+    uint64_t getNumFrames();
+    uint64_t getFrameTime(uint64_t frame);
+    int64_t findFrame(uint64_t simNanos);
+    bool readFrame(uint64_t frame, std::string &data);
+    int64_t extractWindow(uint64_t startNanos, uint64_t stopNanos, std::string fileName);
+
+private:
+    bool readIndex();
+    bool scanRecords();
+    bool readRecord(uint64_t frame, uint8_t &type);
+
+    std::ifstream stream;                           //!< [-] recording file
+    std::vector<VizRecordingIndexEntry> index;      //!< [-] time index of the frames
+    std::string payload;                            //!< [-] payload of the last read record
+    std::string frameData;                          //!< [-] last decoded frame
+    int64_t frameNumber;                            //!< [-] number of the last decoded frame, -1 if none
+};
+
+#endif /* VIZ_RECORDING_H */
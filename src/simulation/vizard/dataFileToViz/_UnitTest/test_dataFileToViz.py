@@ -427,6 +427,87 @@ def run(show_plots, convertPosUnits, attType, checkThruster, checkRW, verbose):
     return [testFailCount, ''.join(testMessages)]
 
 
+@pytest.mark.parametrize("fileType", [0, 1, 2])
+@pytest.mark.parametrize("seekToSimTime", [False, True])
+def test_fileType(show_plots, fileType, seekToSimTime):
+    """
+    **Validation Test Description**
+
+    Reads the same spacecraft states from a text file line by line (``fileType`` 0), from a memory mapped text file
+    (``fileType`` 1) and from a binary file (``fileType`` 2).  With ``seekToSimTime`` the module is reset at 1 second
+    and must start with the data row at 1 second.
+
+    **Description of Variables Being Tested**
+
+    The spacecraft position ``r_BN_N[3]`` of every output message is compared with the position of the data row.
+    """
+    [testResults, testMessage] = runFileType(fileType, seekToSimTime)
+    assert testResults < 1, testMessage
+
+
+def runFileType(fileType, seekToSimTime):
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    testFailCount = 0
+    testMessages = []
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    dtSeconds = 0.1
+    testProcessRate = macros.sec2nano(dtSeconds)
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, testProcessRate))
+
+    # rows of time, position, velocity, MRP and angular velocity, the x position grows by 1 km per row
+    numRows = 30
+    data = np.zeros((numRows, 13))
+    data[:, 0] = np.arange(numRows)*dtSeconds
+    data[:, 1] = 7000.0 + np.arange(numRows)
+    data[:, 4:7] = [-1.95306, 6.3124, 3.64446]
+    data[:, 7:10] = [0.1, 0.2, 0.3]
+    fileName = os.path.join(path, "dataFileType" + str(fileType) + str(seekToSimTime) + (".bin" if fileType == 2 else ".txt"))
+    if fileType == 2:
+        with open(fileName, "wb") as dataFile:
+            dataFile.write(b"BSKDATA1" + np.array([data.shape[1], 0], dtype="<u4").tobytes())
+            dataFile.write(data.astype("<f8").tobytes())
+    else:
+        np.savetxt(fileName, data, delimiter=",", header="time, r, v, sigma, omega")
+
+    testModule = dataFileToViz.DataFileToViz()
+    testModule.ModelTag = "testModule"
+    testModule.dataFileName = fileName
+    testModule.scStateOutMsgNames = dataFileToViz.StringVector(["test1"])
+    testModule.delimiter = ","
+    testModule.fileType = fileType
+    testModule.seekToSimTime = seekToSimTime
+    unitTestSim.AddModelToTask(unitTaskName, testModule)
+    unitTestSim.TotalSim.logThisMessage("test1", testProcessRate)
+
+    unitTestSim.InitializeSimulationAndDiscover()
+    startRow = 0
+    if seekToSimTime:
+        testModule.Reset(macros.sec2nano(1.0))
+        startRow = 10
+    unitTestSim.ConfigureStopTime(macros.sec2nano(1.0))
+    unitTestSim.ExecuteSimulation()
+
+    pos = unitTestSim.pullMessageLogData("test1.r_BN_N", list(range(3)))
+    for i in range(len(pos)):
+        if not unitTestSupport.isVectorEqual(pos[i][1:4], data[startRow + i, 1:4]*1000., 1e-6):
+            testFailCount += 1
+            testMessages.append("FAILED: " + testModule.ModelTag + " Module failed pos check at row "
+                                + str(startRow + i) + " with fileType " + str(fileType) + ".")
+            break
+
+    if os.path.exists(fileName):
+        os.remove(fileName)
+
+    if testFailCount == 0:
+        print("PASSED: " + "dataFileToViz fileType " + str(fileType))
+
+    return [testFailCount, ''.join(testMessages)]
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
@@ -442,4 +523,5 @@ if __name__ == "__main__":
        )
     if os.path.exists(dataFileName):
         os.remove(dataFileName)
+    runFileType(2, True)
 
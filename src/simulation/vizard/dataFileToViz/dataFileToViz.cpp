@@ -22,10 +22,23 @@
 #include "utilities/linearAlgebra.h"
 #include "utilities/rigidBodyKinematics.h"
 #include "utilities/avsEigenSupport.h"
-#include <sstream>
+#include "simFswInterfaceMessages/macroDefinitions.h"
+#include <algorithm>
+#include <ctype.h>
 #include <string>
 #include <string.h>
+#include <stdlib.h>
 #include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 /*! DataFileToViz Constructor
  */
@@ -37,7 +50,16 @@ DataFileToViz::DataFileToViz()
     this->convertPosToMeters = 1000.;       /* convert km to meters */
     this->headerLine = true;
     this->attitudeType = 0;
+    this->fileType = 0;
+    this->seekToSimTime = false;
+    this->convertTimeToSeconds = 1.0;
     this->OutputBufferCount = 2;
+    this->mapData = nullptr;
+    this->mapSize = 0;
+    this->numRows = 0;
+    this->numColumns = 0;
+    this->nextRow = 0;
+    this->rowCursor = 0;
 
     return;
 }
@@ -47,8 +69,8 @@ DataFileToViz::DataFileToViz()
 DataFileToViz::~DataFileToViz()
 {
     /* close the data file if it is open */
-    if(this->fileHandle->is_open()) {
-        this->fileHandle->close();
+    if(this->fileHandle.is_open() || this->mapData) {
+        this->closeFile();
         bskLogger.bskLog(BSK_INFORMATION, "DataFileToViz:\nclosed the file: %s.", this->dataFileName.c_str());
     }
 
@@ -194,13 +216,27 @@ void DataFileToViz::Reset(uint64_t CurrentSimNanos)
     }
 
     /* open the data file*/
-    this->fileHandle = new std::ifstream(this->dataFileName);
-    if (this->fileHandle->fail()) {
-        bskLogger.bskLog(BSK_ERROR, "DataFileToViz: was not able to load the file %s.", this->dataFileName.c_str());
+    this->closeFile();
+    if (this->fileType == 0) {
+        this->fileHandle.open(this->dataFileName);
+        if (this->fileHandle.fail()) {
+            bskLogger.bskLog(BSK_ERROR, "DataFileToViz: was not able to load the file %s.", this->dataFileName.c_str());
+        }
+        if (this->headerLine) {
+            std::string line;
+            getline(this->fileHandle, line);
+        }
+    } else if (this->fileType == 1 || this->fileType == 2) {
+        if (!this->mapFile()) {
+            bskLogger.bskLog(BSK_ERROR, "DataFileToViz: was not able to load the file %s.", this->dataFileName.c_str());
+        }
+    } else {
+        bskLogger.bskLog(BSK_ERROR, "DataFileToViz: unknown fileType encountered: %d", this->fileType);
     }
-    if (this->headerLine) {
-        std::string line;
-        getline(*this->fileHandle, line);
+
+    /* start at the first row at or after the current simulation time */
+    if (this->seekToSimTime) {
+        this->seekTime(CurrentSimNanos*NANO2SEC);
     }
 
     bskLogger.bskLog(BSK_INFORMATION, "DataFileToViz:\nloaded the file: %s.", this->dataFileName.c_str());
@@ -291,19 +327,16 @@ void DataFileToViz::appendRwDir(double dir_B[3])
 void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
 {
     /* ensure that a file was opened */
-    if (this->fileHandle->is_open()) {
+    if (this->fileHandle.is_open() || this->mapData) {
         int thrCounter = 0;
         int rwCounter = 0;
         int scCounter = 0;
 
-        /* read in next line*/
-        std::string line;
-        if (getline(*this->fileHandle, line)) {
-
-            std::istringstream iss(line);
+        /* read in next row */
+        if (this->readRow()) {
 
             /* pull time, this is not used in the BSK msg */
-            pullScalar(&iss);
+            pullScalar();
 
             // create all the state output messages for each spacecraft
             std::vector<int64_t>::iterator it;
@@ -314,12 +347,12 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
                 memset(&scMsg, 0x0, sizeof(SCPlusStatesSimMsg));
 
                 /* get inertial position */
-                pullVector(&iss, scMsg.r_CN_N);
+                pullVector(scMsg.r_CN_N);
                 v3Scale(this->convertPosToMeters, scMsg.r_CN_N, scMsg.r_CN_N);
                 v3Copy(scMsg.r_CN_N, scMsg.r_BN_N);
 
                 /* get inertial velocity */
-                pullVector(&iss, scMsg.v_CN_N);
+                pullVector(scMsg.v_CN_N);
                 v3Scale(this->convertPosToMeters, scMsg.v_CN_N, scMsg.v_CN_N);
                 v3Copy(scMsg.v_CN_N, scMsg.v_BN_N);
 
@@ -327,10 +360,10 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
                 double att[4];
                 if (this->attitudeType != 1) {
                     /* 3D attitude coordinate set */
-                    pullVector(&iss, att);
+                    pullVector(att);
                 } else {
                     /* 4D attitude coordinate set */
-                    pullVector4(&iss, att);
+                    pullVector4(att);
                 }
                 switch (this->attitudeType) {
                     case 0:
@@ -349,7 +382,7 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
                         bskLogger.bskLog(BSK_ERROR, "DataFileToViz: unknown attitudeType encountered: %d", this->attitudeType);
                         break;
                 }
-                pullVector(&iss, scMsg.omega_BN_B);
+                pullVector(scMsg.omega_BN_B);
 
                 /* write spacecraft state message */
                 SystemMessaging::GetInstance()->WriteMessage(*it,
@@ -368,7 +401,7 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
 
                             /* fill out the thruster state message */
                             thrMsg.maxThrust = this->thrForceMaxList[thrCounter];
-                            thrMsg.thrustForce = pullScalar(&iss);
+                            thrMsg.thrustForce = pullScalar();
                             eigenVector3d2CArray(this->thrPosList[thrCounter], thrMsg.thrusterLocation);
                             eigenVector3d2CArray(this->thrDirList[thrCounter], thrMsg.thrusterDirection);
 
@@ -392,9 +425,9 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
                             memset(&rwOutMsg, 0x0, sizeof(RWConfigLogSimMsg));
 
                             /* create RW message */
-                            rwOutMsg.Omega = pullScalar(&iss);
+                            rwOutMsg.Omega = pullScalar();
                             rwOutMsg.Omega_max = this->rwOmegaMaxList[rwCounter];
-                            rwOutMsg.u_current = pullScalar(&iss);
+                            rwOutMsg.u_current = pullScalar();
                             rwOutMsg.u_max = this->rwUMaxList[rwCounter];
                             eigenVector3d2CArray(this->rwPosList[rwCounter], rwOutMsg.rWB_B);
                             eigenVector3d2CArray(this->rwDirList[rwCounter], rwOutMsg.gsHat_B);
@@ -420,35 +453,259 @@ void DataFileToViz::UpdateState(uint64_t CurrentSimNanos)
     return;
 }
 
-/*! pull a 3-d set of double values from the input stream
+/*! pull a 3-d set of double values from the current row
  */
-void DataFileToViz::pullVector(std::istringstream *iss, double vec[3]) {
+void DataFileToViz::pullVector(double vec[3]) {
     double x,y,z;
-    x = pullScalar(iss);
-    y = pullScalar(iss);
-    z = pullScalar(iss);
+    x = pullScalar();
+    y = pullScalar();
+    z = pullScalar();
     v3Set(x, y, z, vec);
 }
 
-/*! pull a 4-d set of double values from the input stream
+/*! pull a 4-d set of double values from the current row
  */
-void DataFileToViz::pullVector4(std::istringstream *iss, double *vec) {
+void DataFileToViz::pullVector4(double *vec) {
     double q0, q1, q2, q3;
-    q0 = pullScalar(iss);
-    q1 = pullScalar(iss);
-    q2 = pullScalar(iss);
-    q3 = pullScalar(iss);
+    q0 = pullScalar();
+    q1 = pullScalar();
+    q2 = pullScalar();
+    q3 = pullScalar();
     v4Set(q0, q1, q2, q3, vec);
 }
 
 
-/*! pull a double from the input stream
+/*! pull a double from the current row
 */
-double DataFileToViz::pullScalar(std::istringstream *iss) {
-    const char delimiterString = *this->delimiter.c_str();
-    std::string item;
+double DataFileToViz::pullScalar() {
+    if (this->rowCursor >= this->rowValues.size()) {
+        bskLogger.bskLog(BSK_ERROR, "DataFileToViz: a row of %s has only %d values.", this->dataFileName.c_str(),
+                         (int) this->rowValues.size());
+        return 0.0;
+    }
+
+    return this->rowValues[this->rowCursor++];
+}
+
+/*! Memory map the data file.  A text file is indexed by line, a binary file is checked against its header.
+ @return bool true if the file is mapped
+ */
+bool DataFileToViz::mapFile()
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(this->dataFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return false;
+    }
+    /* the view keeps the mapping open */
+    this->mapData = (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (this->mapData == nullptr) {
+        return false;
+    }
+    this->mapSize = (uint64_t) fileSize.QuadPart;
+#else
+    int file = open(this->dataFileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    void *data = MAP_FAILED;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0) {
+        data = mmap(nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    close(file);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    madvise(data, (size_t) fileStat.st_size, MADV_SEQUENTIAL);
+    this->mapData = (const char *) data;
+    this->mapSize = (uint64_t) fileStat.st_size;
+#endif
+
+    if (this->fileType == 2) {
+        /* binary rows of numColumns doubles after the header */
+        uint32_t columns = 0;
+        if (this->mapSize >= DATA_FILE_BINARY_HEADER_SIZE) {
+            memcpy(&columns, this->mapData + 8, sizeof(columns));
+        }
+        if (this->mapSize < DATA_FILE_BINARY_HEADER_SIZE || memcmp(this->mapData, DATA_FILE_BINARY_MAGIC, 8) != 0
+            || columns == 0) {
+            bskLogger.bskLog(BSK_ERROR, "DataFileToViz: %s is not a binary data file.", this->dataFileName.c_str());
+            this->closeFile();
+            return false;
+        }
+        this->numColumns = columns;
+        uint64_t rowSize = this->numColumns*sizeof(double);
+        this->numRows = (this->mapSize - DATA_FILE_BINARY_HEADER_SIZE)/rowSize;
+        if ((this->mapSize - DATA_FILE_BINARY_HEADER_SIZE) % rowSize != 0) {
+            bskLogger.bskLog(BSK_WARNING, "DataFileToViz: ignoring the incomplete last row of %s.",
+                             this->dataFileName.c_str());
+        }
+    } else {
+        /* index the lines that hold data, skipping the header line and blank lines */
+        uint64_t offset = 0;
+        bool header = this->headerLine;
+        while (offset < this->mapSize) {
+            const char *line = this->mapData + offset;
+            const char *newline = (const char *) memchr(line, '\n', this->mapSize - offset);
+            uint64_t end = newline ? (uint64_t) (newline - this->mapData) + 1 : this->mapSize;
+            if (header) {
+                header = false;
+            } else if (std::any_of(line, this->mapData + end, [](char c){return(!isspace((unsigned char) c));})) {
+                this->lineStarts.push_back(offset);
+            }
+            offset = end;
+        }
+        this->numRows = this->lineStarts.size();
+    }
 
-    getline(*iss, item, delimiterString);
+    return true;
+}
 
-    return stod(item);
+/*! Close the data file and release the memory map
+ */
+void DataFileToViz::closeFile()
+{
+    if (this->fileHandle.is_open()) {
+        this->fileHandle.close();
+    }
+    this->fileHandle.clear();
+    if (this->mapData) {
+#ifdef _WIN32
+        UnmapViewOfFile(this->mapData);
+#else
+        munmap((void *) this->mapData, (size_t) this->mapSize);
+#endif
+    }
+    this->mapData = nullptr;
+    this->mapSize = 0;
+    this->lineStarts.clear();
+    this->numRows = 0;
+    this->numColumns = 0;
+    this->nextRow = 0;
+}
+
+/*! Read the next row of the data file into rowValues
+ @return bool true if a row was read, false at the end of the file
+ */
+bool DataFileToViz::readRow()
+{
+    if (this->fileType == 0) {
+        /* skip blank lines */
+        this->rowValues.clear();
+        while (this->rowValues.empty()) {
+            if (!getline(this->fileHandle, this->lineBuffer)) {
+                return false;
+            }
+            this->parseRow(this->lineBuffer.c_str());
+        }
+        this->rowCursor = 0;
+        return true;
+    }
+    if (!this->loadRow(this->nextRow)) {
+        return false;
+    }
+    this->nextRow++;
+
+    return true;
+}
+
+/*! Load a row of the memory mapped data file into rowValues
+ @return bool true if the row exists
+ @param row row number, starting at 0 after the header
+ */
+bool DataFileToViz::loadRow(uint64_t row)
+{
+    this->rowValues.clear();
+    this->rowCursor = 0;
+    if (row >= this->numRows) {
+        return false;
+    }
+    if (this->fileType == 2) {
+        const char *rowData = this->mapData + DATA_FILE_BINARY_HEADER_SIZE + row*this->numColumns*sizeof(double);
+        this->rowValues.resize(this->numColumns);
+        memcpy(this->rowValues.data(), rowData, this->numColumns*sizeof(double));
+    } else {
+        /* copy the line, so that parsing stops at its end */
+        uint64_t start = this->lineStarts[row];
+        const char *newline = (const char *) memchr(this->mapData + start, '\n', this->mapSize - start);
+        uint64_t end = newline ? (uint64_t) (newline - this->mapData) : this->mapSize;
+        this->lineBuffer.assign(this->mapData + start, end - start);
+        this->parseRow(this->lineBuffer.c_str());
+    }
+
+    return true;
+}
+
+/*! Parse the delimited values of a text line into rowValues
+ @param line null terminated text line
+ */
+void DataFileToViz::parseRow(const char *line)
+{
+    const char delimiterChar = *this->delimiter.c_str();
+    char *next;
+
+    while (true) {
+        double value = strtod(line, &next);
+        if (next == line) {
+            break;
+        }
+        this->rowValues.push_back(value);
+        line = next;
+        while (*line == ' ' || *line == '\t') {
+            line++;
+        }
+        if (*line == delimiterChar && delimiterChar != '\0') {
+            line++;
+        }
+    }
+}
+
+/*! Position the data file at the first row whose time is at or after the given time.  The memory mapped files are
+ searched through their rows, which requires the time column to increase.
+ @param time [s] time to start at
+ */
+void DataFileToViz::seekTime(double time)
+{
+    /* half a nanosecond tolerance on the time in the file */
+    double threshold = time - 0.5*NANO2SEC;
+
+    if (this->fileType == 0) {
+        if (!this->fileHandle.is_open()) {
+            return;
+        }
+        std::streampos position = this->fileHandle.tellg();
+        while (this->readRow()) {
+            if (this->rowValues[0]*this->convertTimeToSeconds >= threshold) {
+                this->fileHandle.seekg(position);
+                break;
+            }
+            position = this->fileHandle.tellg();
+        }
+        return;
+    }
+
+    uint64_t low = 0;
+    uint64_t high = this->numRows;
+    while (low < high) {
+        uint64_t mid = low + (high - low)/2;
+        this->loadRow(mid);
+        if (!this->rowValues.empty() && this->rowValues[0]*this->convertTimeToSeconds < threshold) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    this->nextRow = low;
 }
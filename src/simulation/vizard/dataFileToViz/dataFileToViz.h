@@ -27,6 +27,10 @@
 #include "../_GeneralModuleFiles/vizStructures.h"
 #include <Eigen/Dense>
 
+/*! Binary data files start with this 8 byte tag, followed by the uint32 number of columns and a uint32 set to zero */
+#define DATA_FILE_BINARY_MAGIC "BSKDATA1"
+#define DATA_FILE_BINARY_HEADER_SIZE 16
+
 
 /*! Defines a data structure for the spacecraft state messages and ID's.
 */
@@ -50,9 +54,15 @@ public:
 
 
 private:
-    void pullVector(std::istringstream *iss, double *);
-    void pullVector4(std::istringstream *iss, double *);
-    double pullScalar(std::istringstream *iss);
+    void pullVector(double *);
+    void pullVector4(double *);
+    double pullScalar();
+    bool mapFile();
+    void closeFile();
+    bool readRow();
+    bool loadRow(uint64_t row);
+    void parseRow(const char *line);
+    void seekTime(double time);
 
 public:
     std::string dataFileName;                   //!< Name of the simulation data file
@@ -62,6 +72,9 @@ public:
     double convertPosToMeters;                  //!< conversion factor to meters
     bool headerLine;                            //!< [bool] flag to mark first line as a header
     int attitudeType;                           //!< 0 - MRP, 1 - EP or quaternions (q0, q1, q2, q3), 2 - (3-2-1) Euler angles
+    int fileType;                               //!< 0 - text read line by line, 1 - memory mapped text with a line index, 2 - memory mapped binary
+    bool seekToSimTime;                         //!< [bool] flag to start at the first row at or after the simulation time on Reset
+    double convertTimeToSeconds;                //!< conversion factor of the data file time to seconds
 
     std::vector <std::vector <ThrClusterMap>> thrMsgDataSC;  //!< (Optional) vector of sets of thruster cluster mapping info
     std::vector <std::vector <std::string>> rwMsgOutNamesSC; //!< (Optional) vector of sets of RW msg names, each entry is per SC
@@ -74,7 +87,16 @@ private:
     std::vector<int64_t>  scStateOutMsgIds;     //!< vector of spacecraft module output message IDs
     std::vector<int64_t>  thrMsgIds;            //!< vector of thruster module output message IDs
     std::vector<int64_t>  rwMsgIds;             //!< vector of RW output message IDs
-    std::ifstream *fileHandle;                  //!< file handle to the simulation data input file
+    std::ifstream fileHandle;                   //!< file handle to the simulation data input file with fileType 0
+    const char *mapData;                        //!< memory mapped data file with fileType 1 or 2, nullptr if not mapped
+    uint64_t mapSize;                           //!< [bytes] size of the memory mapped data file
+    std::vector<uint64_t> lineStarts;           //!< offsets of the data lines of a memory mapped text file
+    uint64_t numRows;                           //!< number of rows of a memory mapped data file
+    uint64_t numColumns;                        //!< number of values per row of a binary data file
+    uint64_t nextRow;                           //!< row of a memory mapped data file read at the next update
+    std::string lineBuffer;                     //!< current text line, reused for every row
+    std::vector<double> rowValues;              //!< values of the current row
+    size_t rowCursor;                           //!< index of the next value pulled from rowValues
     std::vector <Eigen::Vector3d> thrPosList;   //!< [m] vector of thrust positions
     std::vector <Eigen::Vector3d> thrDirList;   //!< [-] vector of thrust unit direction vectors in B-frame components
     std::vector <double> thrForceMaxList;       //!< [-] vector of thrust maximum force values
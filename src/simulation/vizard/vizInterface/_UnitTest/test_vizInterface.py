@@ -0,0 +1,298 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+#
+#   Unit Test Script
+#   Module Name:        vizInterface
+#   Creation Date:      Oct. 19, 2026
+#
+
+
+import os
+import threading
+import time
+import pytest
+
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.simulation import spacecraftPlus
+
+try:
+    from Basilisk.simulation import vizInterface
+    vizFound = True
+except ImportError:
+    vizFound = False
+
+try:
+    import zmq
+    zmqFound = True
+except ImportError:
+    zmqFound = False
+
+path = os.path.dirname(os.path.abspath(__file__))
+
+
+def saveVizFile(fileName, asyncStreaming, streamChangedOnly, indexedRecording=False, comPortNumber=None):
+    """Saves 200 frames of a spacecraft whose state message is written every 10 frames and returns the file, the
+    frames are also streamed live to the given port"""
+    unitTaskName = "unitTask"
+    unitProcessName = "TestProcess"
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProc = unitTestSim.CreateNewProcess(unitProcessName)
+    testProc.addTask(unitTestSim.CreateNewTask(unitTaskName, macros.sec2nano(1.0)))
+    testProc.addTask(unitTestSim.CreateNewTask("scTask", macros.sec2nano(10.0)))
+
+    scObject = spacecraftPlus.SpacecraftPlus()
+    scObject.ModelTag = "spacecraftBody"
+    scObject.hub.r_CN_NInit = [[7000.0e3], [0.0], [0.0]]
+    scObject.hub.v_CN_NInit = [[0.0], [7500.0], [0.0]]
+    scObject.hub.omega_BN_BInit = [[0.01], [0.02], [0.0]]
+    unitTestSim.AddModelToTask("scTask", scObject)
+
+    viz = vizInterface.VizInterface()
+    viz.ModelTag = "vizInterface"
+    scData = vizInterface.VizSpacecraftData()
+    scData.spacecraftName = "bsk-Sat"
+    scData.scPlusInMsgName = scObject.scStateOutMsgName
+    viz.scData.push_back(scData)
+    location = vizInterface.LocationPbMsg()
+    location.stationName = "Boulder"
+    location.parentBodyName = "earth"
+    location.r_GP_P = [6378.0e3, 0.0, 0.0]
+    viz.locations = vizInterface.LocationConfig([location])
+    viz.saveFile = True
+    viz.protoFilename = os.path.join(path, fileName)
+    viz.asyncStreaming = asyncStreaming
+    viz.streamChangedOnly = streamChangedOnly
+    viz.maxQueuedFrames = 2
+    viz.indexedRecording = indexedRecording
+    viz.keyframeInterval = 16
+    if comPortNumber is not None:
+        viz.liveStream = True
+        viz.comAddress = "127.0.0.1"
+        viz.comPortNumber = str(comPortNumber)
+    unitTestSim.AddModelToTask(unitTaskName, viz)
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(200.0))
+    unitTestSim.ExecuteSimulation()
+    viz.flushStream()
+    viz.closeRecording()
+
+    with open(viz.protoFilename, "rb") as vizFile:
+        data = vizFile.read()
+    droppedFrames = viz.droppedFrames
+    del viz
+    os.remove(os.path.join(path, fileName))
+    return data, droppedFrames
+
+
+@pytest.mark.skipif(not vizFound, reason="vizInterface is not built")
+@pytest.mark.parametrize("streamChangedOnly", [False, True])
+def test_vizInterfaceAsync(show_plots, streamChangedOnly):
+    """
+    **Validation Test Description**
+
+    Saves the same simulation to a Vizard file on the simulation thread and with ``asyncStreaming``, which builds the
+    frames in arenas and writes them from a writer thread.  A recording that is only saved to a file is never
+    decimated, so the two files must be identical.  With ``streamChangedOnly`` the spacecraft is only written when
+    its state message is new, so the file must be smaller than the full recording.
+    """
+    [testResults, testMessage] = vizInterfaceAsync(streamChangedOnly)
+    assert testResults < 1, testMessage
+
+
+def vizInterfaceAsync(streamChangedOnly):
+    testFailCount = 0
+    testMessages = []
+
+    syncData, syncDropped = saveVizFile("vizSync.bin", False, streamChangedOnly)
+    asyncData, asyncDropped = saveVizFile("vizAsync.bin", True, streamChangedOnly)
+
+    if len(syncData) == 0 or syncData != asyncData:
+        testFailCount += 1
+        testMessages.append("FAILED: asynchronous Vizard file differs from the synchronous file")
+    if asyncDropped != 0:
+        testFailCount += 1
+        testMessages.append("FAILED: " + str(asyncDropped) + " frames dropped while saving to a file")
+    if streamChangedOnly:
+        fullData, fullDropped = saveVizFile("vizFull.bin", False, False)
+        if len(syncData) >= len(fullData):
+            testFailCount += 1
+            testMessages.append("FAILED: streamChangedOnly file is not smaller than the full file")
+
+    if testFailCount == 0:
+        print("PASSED: vizInterface asynchronous streaming")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+@pytest.mark.skipif(not vizFound, reason="vizInterface is not built")
+@pytest.mark.parametrize("asyncStreaming", [False, True])
+def test_vizInterfaceIndexed(show_plots, asyncStreaming):
+    """
+    **Validation Test Description**
+
+    Saves the same simulation as a plain Vizard file and as an indexed recording, which stores key frames and the
+    changed bytes of the frames in between followed by a time index.  Extracting all the frames of the indexed
+    recording must reproduce the plain file, the recording must be smaller, and a time window must contain the frames
+    found through the index.
+    """
+    [testResults, testMessage] = vizInterfaceIndexed(asyncStreaming)
+    assert testResults < 1, testMessage
+
+
+def vizInterfaceIndexed(asyncStreaming):
+    testFailCount = 0
+    testMessages = []
+
+    plainData, plainDropped = saveVizFile("vizPlain.bin", False, False)
+    indexedData, indexedDropped = saveVizFile("vizIndexed.bin", asyncStreaming, False, True)
+    recordingName = os.path.join(path, "vizRecording.bin")
+    with open(recordingName, "wb") as recordingFile:
+        recordingFile.write(indexedData)
+
+    reader = vizInterface.VizRecordingReader()
+    if not reader.open(recordingName):
+        testFailCount += 1
+        testMessages.append("FAILED: indexed recording index could not be read")
+    if len(indexedData) >= len(plainData):
+        testFailCount += 1
+        testMessages.append("FAILED: indexed recording is not smaller than the plain file")
+
+    windowName = os.path.join(path, "vizWindow.bin")
+    numFrames = reader.getNumFrames()
+    if reader.extractWindow(0, reader.getFrameTime(numFrames - 1), windowName) != numFrames:
+        testFailCount += 1
+        testMessages.append("FAILED: extracted frame count differs from the index")
+    with open(windowName, "rb") as windowFile:
+        if windowFile.read() != plainData:
+            testFailCount += 1
+            testMessages.append("FAILED: extracted recording differs from the plain file")
+
+    startFrame = reader.findFrame(macros.sec2nano(50.0))
+    stopFrame = reader.findFrame(macros.sec2nano(120.0))
+    if reader.getFrameTime(startFrame) > macros.sec2nano(50.0) \
+            or reader.extractWindow(reader.getFrameTime(startFrame), macros.sec2nano(120.0), windowName) \
+            != stopFrame - startFrame + 1:
+        testFailCount += 1
+        testMessages.append("FAILED: extracted time window does not match the index")
+    reader.close()
+    os.remove(windowName)
+    os.remove(recordingName)
+
+    if testFailCount == 0:
+        print("PASSED: vizInterface indexed recording")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+def splitFrames(data):
+    """Splits a Vizard file into its frames, which are prefixed by their varint size"""
+    frames = []
+    idx = 0
+    while idx < len(data):
+        size = 0
+        shift = 0
+        while True:
+            byte = data[idx]
+            idx += 1
+            size |= (byte & 0x7f) << shift
+            shift += 7
+            if byte < 0x80:
+                break
+        frames.append(data[idx:idx + size])
+        idx += size
+    return frames
+
+
+def fakeVizard(socket, frameDelay, liveFrames):
+    """Answers the Vizard handshake and then each frame after frameDelay, until no frame comes for 2 seconds"""
+    socket.recv()
+    socket.send(b"PING")
+    socket.recv()
+    while True:
+        socket.send(b"PONG")
+        if not socket.poll(2000):
+            break
+        liveFrames.append(socket.recv_multipart()[-1])
+        time.sleep(frameDelay)
+
+
+@pytest.mark.skipif(not vizFound or not zmqFound, reason="vizInterface is not built or pyzmq is not installed")
+def test_vizInterfaceLiveDrop(show_plots):
+    """
+    **Validation Test Description**
+
+    Streams a simulation live to a slow Vizard stand-in while saving it to a file with ``asyncStreaming``.  Vizard
+    falls behind, so frames are dropped from the live stream, but the saved file must still hold every frame and be
+    the same as the file saved on the simulation thread.  Every frame received live must be found, in order, in the
+    file, and the received and dropped frames must add up to the saved frames.
+    """
+    [testResults, testMessage] = vizInterfaceLiveDrop()
+    assert testResults < 1, testMessage
+
+
+def vizInterfaceLiveDrop():
+    testFailCount = 0
+    testMessages = []
+
+    context = zmq.Context()
+    socket = context.socket(zmq.REP)
+    port = socket.bind_to_random_port("tcp://127.0.0.1")
+    liveFrames = []
+    vizard = threading.Thread(target=fakeVizard, args=(socket, 0.01, liveFrames))
+    vizard.start()
+    liveData, liveDropped = saveVizFile("vizLive.bin", True, False, comPortNumber=port)
+    vizard.join()
+    socket.close()
+    context.term()
+    syncData, syncDropped = saveVizFile("vizSync.bin", False, False)
+
+    savedFrames = splitFrames(liveData)
+    if liveDropped == 0:
+        testFailCount += 1
+        testMessages.append("FAILED: no live frame dropped while Vizard is slower than the simulation")
+    if len(syncData) == 0 or liveData != syncData:
+        testFailCount += 1
+        testMessages.append("FAILED: file saved while streaming live differs from the synchronous file")
+    if len(liveFrames) + liveDropped != len(savedFrames):
+        testFailCount += 1
+        testMessages.append("FAILED: " + str(len(liveFrames)) + " live and " + str(liveDropped)
+                            + " dropped frames for " + str(len(savedFrames)) + " saved frames")
+    savedIdx = 0
+    for liveFrame in liveFrames:
+        while savedIdx < len(savedFrames) and savedFrames[savedIdx] != liveFrame:
+            savedIdx += 1
+        if savedIdx == len(savedFrames):
+            testFailCount += 1
+            testMessages.append("FAILED: live frames are not the saved frames in order")
+            break
+        savedIdx += 1
+
+    if testFailCount == 0:
+        print("PASSED: vizInterface live stream frame dropping")
+
+    return [testFailCount, ''.join(testMessages)]
+
+
+if __name__ == "__main__":
+    vizInterfaceAsync(True)
+    vizInterfaceIndexed(True)
+    vizInterfaceLiveDrop()
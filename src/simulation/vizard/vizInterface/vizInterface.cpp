@@ -39,6 +39,12 @@ VizInterface::VizInterface()
     this->opNavMode = 0;
     this->saveFile = false;
     this->liveStream = false;
+    this->asyncStreaming = false;
+    this->streamChangedOnly = false;
+    this->maxQueuedFrames = 4;
+    this->droppedFrames = 0;
+    this->indexedRecording = false;
+    this->keyframeInterval = 100;
     this->FrameNumber= -1;
     this->numOutputBuffers = 2;
 
@@ -54,6 +60,12 @@ VizInterface::VizInterface()
     this->comProtocol = "tcp";
     this->comAddress = "localhost";
     this->comPortNumber = "5556";
+
+    this->outputStream = NULL;
+    this->asyncActive = false;
+    this->framesQueued = 0;
+    this->framesWritten = 0;
+    this->stopRequested = false;
     
     return;
 }
@@ -62,6 +74,8 @@ VizInterface::VizInterface()
  */
 VizInterface::~VizInterface()
 {
+    this->stopStreaming();
+    this->recordingWriter.close();
     return;
 }
 
@@ -263,8 +277,16 @@ void VizInterface::CrossInit()
  */
 void VizInterface::Reset(uint64_t CurrentSimNanos)
 {
+    /* - write out the frames of a previous run before the output file is opened again */
+    this->stopStreaming();
+
     this->FrameNumber=-1;
-    if (this->saveFile) {
+    this->recordingWriter.close();
+    if (this->saveFile && this->indexedRecording) {
+        if (!this->recordingWriter.open(this->protoFilename, this->keyframeInterval)) {
+            bskLogger.bskLog(BSK_ERROR, "vizInterface: can't open the recording file %s.", this->protoFilename.c_str());
+        }
+    } else if (this->saveFile) {
 //        if(this->outputStream && this->outputStream->is_open())
 //        {
 //            this->outputStream->close();
@@ -283,6 +305,15 @@ void VizInterface::Reset(uint64_t CurrentSimNanos)
     this->epochMsg.seconds = EPOCH_SEC;
     this->epochMsgID.dataFresh = true;
 
+    /* - the opNav modes need the lock-step with Vizard to receive the images, they stay on the simulation thread */
+    if (this->asyncStreaming && this->opNavMode > 0) {
+        bskLogger.bskLog(BSK_WARNING, "vizInterface: asyncStreaming is not used in opNavMode.");
+    }
+    this->asyncActive = this->asyncStreaming && this->opNavMode == 0 && (this->saveFile || this->liveStream);
+    if (this->asyncActive) {
+        this->startStreaming();
+    }
+
     return;
 }
 
@@ -418,17 +449,19 @@ void VizInterface::ReadBSKMessages()
     return;
 }
 
-/*! The method in which the vizInterface writes a protobuffer with the information from the simulation.
+/*! The method in which the vizInterface fills a protobuffer with the information from the simulation.  The
+ sub-messages are created through the message, so that they are allocated in its arena if it has one.
+ @param message The message to fill
  @param CurrentSimNanos The current sim time in nanoseconds
  */
-void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
+void VizInterface::buildProtobuffer(vizProtobufferMessage::VizMessage *message, uint64_t CurrentSimNanos)
 {
-    vizProtobufferMessage::VizMessage* message = new vizProtobufferMessage::VizMessage;
+    /*! The static locations are sent with the settings if only the changed data is streamed */
+    bool writeLocations = !this->streamChangedOnly || this->settings.dataFresh;
 
     /*! Send the Vizard settings once */
     if (this->settings.dataFresh) {
-        vizProtobufferMessage::VizMessage::VizSettingsPb* vizSettings;
-        vizSettings = new vizProtobufferMessage::VizMessage::VizSettingsPb;
+        vizProtobufferMessage::VizMessage::VizSettingsPb* vizSettings = message->mutable_settings();
 
         // define the viz ambient light setting
         vizSettings->set_ambient(this->settings.ambient);
@@ -645,33 +678,29 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
             }
         }
 
-        message->set_allocated_settings(vizSettings);
-
         this->settings.dataFresh = false;
     }
 
     /*! Write timestamp output msg */
-    vizProtobufferMessage::VizMessage::TimeStamp* time = new vizProtobufferMessage::VizMessage::TimeStamp;
+    vizProtobufferMessage::VizMessage::TimeStamp* time = message->mutable_currenttime();
     time->set_framenumber(this->FrameNumber);
     time->set_simtimeelapsed(CurrentSimNanos);
-    message->set_allocated_currenttime(time);
 
     /*! write epoch msg */
     if (this->epochMsgID.dataFresh) {
-        vizProtobufferMessage::VizMessage::EpochDateTime* epoch = new vizProtobufferMessage::VizMessage::EpochDateTime;
+        vizProtobufferMessage::VizMessage::EpochDateTime* epoch = message->mutable_epoch();
         epoch->set_year(this->epochMsg.year);
         epoch->set_month(this->epochMsg.month);
         epoch->set_day(this->epochMsg.day);
         epoch->set_hours(this->epochMsg.hours);
         epoch->set_minutes(this->epochMsg.minutes);
         epoch->set_seconds(this->epochMsg.seconds);
-        message->set_allocated_epoch(epoch);
         this->epochMsgID.dataFresh = false;
     }
 
     /*! write the Locations protobuffer messages */
     std::vector<LocationPbMsg>::iterator glIt;
-    for (glIt = locations.begin(); glIt != locations.end(); glIt++) {
+    for (glIt = locations.begin(); writeLocations && glIt != locations.end(); glIt++) {
         vizProtobufferMessage::VizMessage::Location* glp = message->add_locations();
         glp->set_stationname(glIt->stationName);
         glp->set_parentbodyname(glIt->parentBodyName);
@@ -698,7 +727,9 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
                 scp->add_velocity(scIt->scPlusMessage.v_BN_N[i]);
                 scp->add_rotation(scIt->scPlusMessage.sigma_BN[i]);
             }
-//            scIt->scPlusInMsgID.dataFresh = false;
+            if (this->streamChangedOnly) {
+                scIt->scPlusInMsgID.dataFresh = false;
+            }
 
             /* Write the SC sprite string */
             scp->set_spacecraftsprite(scIt->spacecraftSprite);
@@ -811,17 +842,36 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
                     spice->add_rotation(this->spiceMessage[k].J20002Pfix[i][j]);
                 }
             }
-//                spiceInMsgID[k].dataFresh = false;
+            if (this->streamChangedOnly) {
+                spiceInMsgID[k].dataFresh = false;
+            }
         }
         k++;
     }
 
+    return;
+}
+
+/*! The method in which the vizInterface writes a protobuffer with the information from the simulation.  With
+ asyncStreaming the frame is only queued for the writer thread.
+ @param CurrentSimNanos The current sim time in nanoseconds
+ */
+void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
+{
+    if (this->asyncActive) {
+        this->queueProtobuffer(CurrentSimNanos);
+        return;
+    }
+
+    vizProtobufferMessage::VizMessage* message = new vizProtobufferMessage::VizMessage;
+    this->buildProtobuffer(message, CurrentSimNanos);
+
     {
         google::protobuf::uint8 varIntBuffer[4];
         uint32_t byteCount = message->ByteSizeLong();
         google::protobuf::uint8 *end = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(byteCount, varIntBuffer);
         unsigned long varIntBytes = (unsigned long) (end - varIntBuffer);
-        if (this->saveFile) {
+        if (this->saveFile && !this->indexedRecording) {
             this->outputStream->write(reinterpret_cast<char* > (varIntBuffer), (int) varIntBytes);
         }
 
@@ -905,6 +955,7 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
                 
                 /*! -- Write out the image information to the Image message */
                 CameraImageMsg imageData;
+                memset(&imageData, 0x0, sizeof(CameraImageMsg));
                 imageData.timeTag = CurrentSimNanos;
                 imageData.valid = 0;
                 imageData.imagePointer = this->bskImagePtr;
@@ -930,7 +981,10 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
             
         }
         /*!  Write protobuffer to file */
-        if (!this->saveFile  || !message->SerializeToOstream(this->outputStream)) {
+        if (this->saveFile && this->indexedRecording) {
+            message->SerializeToString(&this->recordingBuffer);
+            this->recordingWriter.writeFrame(CurrentSimNanos, this->recordingBuffer.data(), this->recordingBuffer.size());
+        } else if (!this->saveFile  || !message->SerializeToOstream(this->outputStream)) {
             return;
         }
     }
@@ -940,6 +994,250 @@ void VizInterface::WriteProtobuffer(uint64_t CurrentSimNanos)
 
 }
 
+/*! This method builds the frame in the arena of the next free slot and hands it to the writer thread.  When all
+ slots wait for the writer, a live stream frame is dropped instead of blocking the simulation, the unsent settings,
+ epoch and changed data go out with the next frame.  With saveFile the dropped frame is still saved.  A frame that is
+ only saved to a file waits for a free slot.
+ @param CurrentSimNanos The current sim time in nanoseconds
+ */
+void VizInterface::queueProtobuffer(uint64_t CurrentSimNanos)
+{
+    FrameSlot *frame;
+    {
+        std::unique_lock<std::mutex> lock(this->streamMutex);
+        if (this->framesQueued - this->framesWritten >= this->frameSlots.size()) {
+            if (this->liveStream) {
+                this->droppedFrames++;
+                if (this->saveFile) {
+                    this->saveDroppedFrame(CurrentSimNanos);
+                }
+                return;
+            }
+            this->frameWritten.wait(lock, [this]{
+                return(this->framesQueued - this->framesWritten < this->frameSlots.size());});
+        }
+        frame = &this->frameSlots[this->framesQueued % this->frameSlots.size()];
+    }
+
+    /*! - the previous message of the slot has been written, its memory is reused for this frame */
+    frame->arena->Reset();
+    frame->message = google::protobuf::Arena::CreateMessage<vizProtobufferMessage::VizMessage>(frame->arena.get());
+    frame->simNanos = CurrentSimNanos;
+    this->buildProtobuffer(frame->message, CurrentSimNanos);
+
+    {
+        std::lock_guard<std::mutex> lock(this->streamMutex);
+        this->framesQueued++;
+    }
+    this->frameQueued.notify_one();
+
+    return;
+}
+
+/*! This method builds a frame dropped from the live stream and serializes it for the writer thread, which saves it
+ after the frames queued before it.  The stream mutex must be held by the caller, so that the writer cannot pass these
+ frames before the dropped frame is handed over.  The data that is only sent once, or only when it changes, is marked
+ fresh again so that the next live frame still carries it.
+ @param CurrentSimNanos The current sim time in nanoseconds
+ */
+void VizInterface::saveDroppedFrame(uint64_t CurrentSimNanos)
+{
+    bool settingsFresh = this->settings.dataFresh;
+    bool epochFresh = this->epochMsgID.dataFresh;
+    std::vector<bool> scFresh;
+    std::vector<bool> spiceFresh;
+    std::vector<VizSpacecraftData>::iterator scIt;
+    for (scIt = this->scData.begin(); scIt != this->scData.end(); scIt++) {
+        scFresh.push_back(scIt->scPlusInMsgID.dataFresh);
+    }
+    for (size_t k = 0; k < this->spiceInMsgID.size(); k++) {
+        spiceFresh.push_back(this->spiceInMsgID[k].dataFresh);
+    }
+
+    vizProtobufferMessage::VizMessage message;
+    SavedFrame savedFrame;
+    this->buildProtobuffer(&message, CurrentSimNanos);
+    savedFrame.afterFrames = this->framesQueued;
+    savedFrame.simNanos = CurrentSimNanos;
+    savedFrame.varIntBytes = this->serializeFrame(&message, savedFrame.data);
+    this->savedFrames.push_back(std::move(savedFrame));
+
+    this->settings.dataFresh = settingsFresh;
+    this->epochMsgID.dataFresh = epochFresh;
+    for (size_t idx = 0; idx < scFresh.size(); idx++) {
+        this->scData[idx].scPlusInMsgID.dataFresh = scFresh[idx];
+    }
+    for (size_t k = 0; k < spiceFresh.size(); k++) {
+        this->spiceInMsgID[k].dataFresh = spiceFresh[k];
+    }
+
+    return;
+}
+
+/*! This method serializes a frame prefixed by its varint size, the same bytes as written by WriteProtobuffer.
+ @return size_t number of bytes of the size prefix
+ @param message The frame to serialize
+ @param buffer The serialized frame
+ */
+size_t VizInterface::serializeFrame(vizProtobufferMessage::VizMessage *message, std::string &buffer)
+{
+    uint32_t byteCount = (uint32_t) message->ByteSizeLong();
+    int varIntBytes = google::protobuf::io::CodedOutputStream::VarintSize32(byteCount);
+    buffer.resize(varIntBytes + byteCount);
+    google::protobuf::uint8 *start = reinterpret_cast<google::protobuf::uint8 *> (&buffer[0]);
+    google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(byteCount, start);
+    message->SerializeWithCachedSizesToArray(start + varIntBytes);
+
+    return((size_t) varIntBytes);
+}
+
+/*! This method writes a serialized frame to the Vizard file or to the indexed recording.  It is only called by the
+ writer thread.
+ @param buffer The frame serialized with its varint size prefix
+ @param varIntBytes Number of bytes of the size prefix
+ @param simNanos The sim time of the frame in nanoseconds
+ */
+void VizInterface::saveFrame(const std::string &buffer, size_t varIntBytes, uint64_t simNanos)
+{
+    if (this->saveFile && this->indexedRecording) {
+        this->recordingWriter.writeFrame(simNanos, buffer.data() + varIntBytes, buffer.size() - varIntBytes);
+    } else if (this->saveFile) {
+        this->outputStream->write(buffer.data(), (std::streamsize) buffer.size());
+    }
+
+    return;
+}
+
+/*! This method serializes a frame and writes it to the file and the Vizard live stream.  It is only called by the
+ writer thread, which owns the ZeroMQ socket while it runs.
+ @param message The frame to write
+ @param simNanos The sim time of the frame in nanoseconds
+ */
+void VizInterface::sendProtobuffer(vizProtobufferMessage::VizMessage *message, uint64_t simNanos)
+{
+    size_t varIntBytes = this->serializeFrame(message, this->streamBuffer);
+    this->saveFrame(this->streamBuffer, varIntBytes, simNanos);
+
+    if (this->liveStream) {
+        /*! - Receive pong, then send the protobuffer raw over the zmq_socket */
+        zmq_msg_t receive_buffer;
+        zmq_msg_init(&receive_buffer);
+        zmq_msg_recv(&receive_buffer, this->requester_socket, 0);
+        zmq_msg_close(&receive_buffer);
+
+        zmq_send(this->requester_socket, "SIM_UPDATE", 10, ZMQ_SNDMORE);
+        zmq_send(this->requester_socket, NULL, 0, ZMQ_SNDMORE);
+        zmq_send(this->requester_socket, NULL, 0, ZMQ_SNDMORE);
+        zmq_send(this->requester_socket, this->streamBuffer.data() + varIntBytes, this->streamBuffer.size() - varIntBytes, 0);
+    }
+
+    return;
+}
+
+/*! The writer thread loop, which writes the queued frames in order until the stop is requested and all frames
+ are written.
+ */
+void VizInterface::streamFrames()
+{
+    std::unique_lock<std::mutex> lock(this->streamMutex);
+    while (true) {
+        this->frameQueued.wait(lock, [this]{return(this->framesWritten != this->framesQueued || this->stopRequested);});
+        if (this->framesWritten == this->framesQueued) {
+            break;
+        }
+        FrameSlot *frame = &this->frameSlots[this->framesWritten % this->frameSlots.size()];
+        lock.unlock();
+        this->sendProtobuffer(frame->message, frame->simNanos);
+        lock.lock();
+        /*! - the frames dropped from the live stream after this frame are saved before the next one */
+        while (!this->savedFrames.empty() && this->savedFrames.front().afterFrames == this->framesWritten + 1) {
+            SavedFrame savedFrame = std::move(this->savedFrames.front());
+            this->savedFrames.pop_front();
+            lock.unlock();
+            this->saveFrame(savedFrame.data, savedFrame.varIntBytes, savedFrame.simNanos);
+            lock.lock();
+        }
+        this->framesWritten++;
+        this->frameWritten.notify_all();
+    }
+
+    return;
+}
+
+/*! This method allocates the frame slots and their arena blocks and starts the writer thread.
+ */
+void VizInterface::startStreaming()
+{
+    size_t numSlots = this->maxQueuedFrames > 0 ? this->maxQueuedFrames : 1;
+    this->frameSlots.resize(numSlots);
+    for (size_t idx = 0; idx < numSlots; idx++) {
+        FrameSlot *frame = &this->frameSlots[idx];
+        if (!frame->arena) {
+            frame->arenaBlock.resize(VIZ_ARENA_BLOCK_SIZE);
+            google::protobuf::ArenaOptions options;
+            options.initial_block = frame->arenaBlock.data();
+            options.initial_block_size = frame->arenaBlock.size();
+            frame->arena.reset(new google::protobuf::Arena(options));
+        }
+        frame->message = NULL;
+    }
+    this->framesQueued = 0;
+    this->framesWritten = 0;
+    this->droppedFrames = 0;
+    this->savedFrames.clear();
+    this->stopRequested = false;
+    this->streamThread = std::thread(&VizInterface::streamFrames, this);
+
+    return;
+}
+
+/*! This method lets the writer thread write the queued frames and waits for it to finish.
+ */
+void VizInterface::stopStreaming()
+{
+    if (!this->streamThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->streamMutex);
+        this->stopRequested = true;
+    }
+    this->frameQueued.notify_one();
+    this->streamThread.join();
+    if (this->saveFile && this->outputStream) {
+        this->outputStream->flush();
+    }
+
+    return;
+}
+
+/*! This method writes the time index of an indexed recording and closes the file, once the queued frames are
+ written.  The frames of later updates are not saved until the next Reset.
+ */
+void VizInterface::closeRecording()
+{
+    this->flushStream();
+    this->recordingWriter.close();
+
+    return;
+}
+
+/*! This method waits until the writer thread has written all queued frames and flushes the output file, so that
+ the file can be read while the simulation is paused.
+ */
+void VizInterface::flushStream()
+{
+    if (this->asyncActive) {
+        std::unique_lock<std::mutex> lock(this->streamMutex);
+        this->frameWritten.wait(lock, [this]{return(this->framesWritten == this->framesQueued);});
+    }
+    if (this->saveFile && this->outputStream) {
+        this->outputStream->flush();
+    }
+
+    return;
+}
+
 /*! Update this module at the task rate
  @param CurrentSimNanos The current sim time
  */
@@ -21,9 +21,15 @@
 
 #include "../utilities/vizProtobuffer/vizMessage.pb.h"
 #include <vector>
+#include <deque>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <zmq.h>
+#include <google/protobuf/arena.h>
 
 #include "_GeneralModuleFiles/sys_model.h"
 #include "architecture/messaging/system_messaging.h"
@@ -41,8 +47,10 @@
 #include "simMessages/epochSimMsg.h"
 #include "utilities/simDefinitions.h"
 #include "../_GeneralModuleFiles/vizStructures.h"
+#include "../_GeneralModuleFiles/vizRecording.h"
 
 #define VIZ_MAX_SIZE 100000
+#define VIZ_ARENA_BLOCK_SIZE 65536
 
 
 
@@ -58,6 +66,8 @@ public:
     void UpdateState(uint64_t CurrentSimNanos);
     void ReadBSKMessages();
     void WriteProtobuffer(uint64_t CurrentSimNanos);
+    void flushStream();
+    void closeRecording();
 
 public:
     std::vector<VizSpacecraftData> scData;      //!< [-] vector of spacecraft data containers
@@ -68,6 +78,16 @@ public:
                                                  communication. (1 - regular opNav, 2 - performance opNav) */
     bool saveFile;                              //!< [Bool] Set True if Vizard should save a file of the data.
     bool liveStream;                            //!< [Bool] Set True if Vizard should receive a live stream of BSK data.
+    bool asyncStreaming;                        /*!< [Bool] Set True to build the frames in arenas and to save or stream
+                                                     them from a writer thread, not used in opNavMode */
+    bool streamChangedOnly;                     /*!< [Bool] Set True to only send the spacecraft and planets with new
+                                                     messages and the locations with the settings */
+    uint32_t maxQueuedFrames;                   //!< [-] Number of frames that can wait for the writer thread, default 4
+    uint64_t droppedFrames;                     /*!< [-] Number of live stream frames dropped while the writer was busy,
+                                                     the dropped frames are still saved with saveFile */
+    bool indexedRecording;                      /*!< [Bool] Set True to save an indexed recording with key and delta
+                                                     frames instead of the stream of frames read by Vizard */
+    uint32_t keyframeInterval;                  //!< [-] Number of frames from one key frame to the next, default 100
     void* bskImagePtr;                          /*!< [RUN] Permanent pointer for the image to be used in BSK
                                                      without relying on ZMQ because ZMQ will free it (whenever, who knows) */
 
@@ -95,6 +115,32 @@ public:
 
 
 private:
+    /*! Frame of the asynchronous streaming, the message is built in the arena and lives until it is written */
+    struct FrameSlot {
+        std::vector<char> arenaBlock;                       //!< [-] initial arena block, reused for every frame
+        std::unique_ptr<google::protobuf::Arena> arena;     //!< [-] arena of the frame message
+        vizProtobufferMessage::VizMessage *message;         //!< [-] frame message, owned by the arena
+        uint64_t simNanos;                                  //!< [ns] time of the frame
+    };
+
+    /*! Frame dropped from the live stream that is still saved, it follows the queued frames in the file */
+    struct SavedFrame {
+        uint64_t afterFrames;                               //!< [-] number of queued frames written to the file before
+        uint64_t simNanos;                                  //!< [ns] time of the frame
+        std::string data;                                   //!< [-] frame serialized with its varint size prefix
+        size_t varIntBytes;                                 //!< [-] number of bytes of the size prefix
+    };
+
+    void buildProtobuffer(vizProtobufferMessage::VizMessage *message, uint64_t CurrentSimNanos);
+    void queueProtobuffer(uint64_t CurrentSimNanos);
+    void sendProtobuffer(vizProtobufferMessage::VizMessage *message, uint64_t simNanos);
+    size_t serializeFrame(vizProtobufferMessage::VizMessage *message, std::string &buffer);
+    void saveFrame(const std::string &buffer, size_t varIntBytes, uint64_t simNanos);
+    void saveDroppedFrame(uint64_t CurrentSimNanos);
+    void streamFrames();
+    void startStreaming();
+    void stopStreaming();
+
     // ZeroMQ State
     void* context;
     void* requester_socket;
@@ -104,8 +150,23 @@ private:
     std::vector<MsgCurrStatus>spiceInMsgID;                 //!< [-] IDs of the incoming planets' spice data
     std::vector <SpicePlanetStateSimMsg> spiceMessage;      //!< [-] Spice messages
     std::ofstream *outputStream;                            //!< [-] Output file stream opened in reset
+    VizRecordingWriter recordingWriter;                     //!< [-] Writer of the indexed recording opened in reset
+    std::string recordingBuffer;                            //!< [-] Serialized frame of the indexed recording
     
     std::map<uint32_t, SpicePlanetStateSimMsg> planetData;  //!< -- Internal vector of planets
+
+    // Asynchronous streaming state
+    bool asyncActive;                                       //!< [-] Flag indicating the writer thread is used
+    std::vector<FrameSlot> frameSlots;                      //!< [-] ring of frames, used in order
+    uint64_t framesQueued;                                  //!< [-] Number of frames handed to the writer thread
+    uint64_t framesWritten;                                 //!< [-] Number of frames written by the writer thread
+    bool stopRequested;                                     //!< [-] Flag asking the writer thread to finish
+    std::string streamBuffer;                               //!< [-] serialized frame, reused by the writer thread
+    std::deque<SavedFrame> savedFrames;                     //!< [-] dropped live frames waiting to be saved in order
+    std::thread streamThread;                               //!< [-] writer thread
+    std::mutex streamMutex;                                 //!< [-] protects the frame counters
+    std::condition_variable frameQueued;                    //!< [-] signals a new frame or the stop request
+    std::condition_variable frameWritten;                   //!< [-] signals a written frame
     
 };
 
@@ -19,6 +19,7 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 %{
    #include "vizInterface.h"
    #include "../_GeneralModuleFiles/vizStructures.h"
+   #include "../_GeneralModuleFiles/vizRecording.h"
 %}
 
 %pythoncode %{
@@ -46,6 +47,8 @@ namespace std {
 
 %include "vizInterface.h"
 %include "../_GeneralModuleFiles/vizStructures.h"
+%ignore VizRecordingReader::readFrame;
+%include "../_GeneralModuleFiles/vizRecording.h"
 %include "simFswInterfaceMessages/cameraConfigMsg.h"
 GEN_SIZEOF(ThrClusterMap);
 
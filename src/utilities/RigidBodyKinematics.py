@@ -4231,3 +4231,121 @@ def v3Tilde(vector):
               ]
 
     return xTilde
+
+
+def MRP2EPBatch(q1):
+    """
+    MRP2EPBatch(Q1)
+
+    	Q = MRP2EPBatch(Q1) translates the N x 3 array of MRP vectors Q1
+    	into the N x 4 array of euler parameter vectors Q.
+    """
+    q1 = np.asarray(q1, dtype=float)
+    qm2 = np.sum(q1 * q1, axis=-1, keepdims=True)
+    ps = 1 + qm2
+    return np.concatenate(((1 - qm2) / ps, 2 * q1 / ps), axis=-1)
+
+
+def EP2MRPBatch(q):
+    """
+    EP2MRPBatch(Q1)
+        Q = EP2MRPBatch(Q1) translates the N x 4 array of euler parameter
+        vectors Q1 into the N x 3 array of MRP vectors Q.
+    """
+    q = np.asarray(q, dtype=float)
+    q = np.where(q[..., :1] < 0, -q, q)
+    return q[..., 1:] / (1 + q[..., :1])
+
+
+def MRP2CBatch(q):
+    """
+    MRP2CBatch
+
+    	C = MRP2CBatch(Q) returns the N x 3 x 3 array of direction cosine
+    	matrices in terms of the N x 3 array of MRP vectors Q.
+    """
+    q = np.asarray(q, dtype=float)
+    q1 = q[..., 0]
+    q2 = q[..., 1]
+    q3 = q[..., 2]
+    d1 = np.sum(q * q, axis=-1)
+    S = 1 - d1
+    d = (1 + d1) * (1 + d1)
+    C = np.empty(q.shape[:-1] + (3, 3))
+    C[..., 0, 0] = 4 * (2 * q1 * q1 - d1) + S * S
+    C[..., 0, 1] = 8 * q1 * q2 + 4 * q3 * S
+    C[..., 0, 2] = 8 * q1 * q3 - 4 * q2 * S
+    C[..., 1, 0] = 8 * q2 * q1 - 4 * q3 * S
+    C[..., 1, 1] = 4 * (2 * q2 * q2 - d1) + S * S
+    C[..., 1, 2] = 8 * q2 * q3 + 4 * q1 * S
+    C[..., 2, 0] = 8 * q3 * q1 + 4 * q2 * S
+    C[..., 2, 1] = 8 * q3 * q2 - 4 * q1 * S
+    C[..., 2, 2] = 4 * (2 * q3 * q3 - d1) + S * S
+    return C / d[..., None, None]
+
+
+def EP2CBatch(q):
+    """
+	EP2CBatch
+
+        C = EP2CBatch(Q) returns the N x 3 x 3 array of direction cosine
+        matrices in terms of the N x 4 array of euler parameter vectors Q.
+	"""
+    q = np.asarray(q, dtype=float)
+    q0 = q[..., 0]
+    q1 = q[..., 1]
+    q2 = q[..., 2]
+    q3 = q[..., 3]
+    C = np.empty(q.shape[:-1] + (3, 3))
+    C[..., 0, 0] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3
+    C[..., 0, 1] = 2 * (q1 * q2 + q0 * q3)
+    C[..., 0, 2] = 2 * (q1 * q3 - q0 * q2)
+    C[..., 1, 0] = 2 * (q1 * q2 - q0 * q3)
+    C[..., 1, 1] = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3
+    C[..., 1, 2] = 2 * (q2 * q3 + q0 * q1)
+    C[..., 2, 0] = 2 * (q1 * q3 + q0 * q2)
+    C[..., 2, 1] = 2 * (q2 * q3 - q0 * q1)
+    C[..., 2, 2] = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3
+    return C
+
+
+def C2EPBatch(C):
+    """
+    C2EPBatch
+        Q = C2EPBatch(C) translates the N x 3 x 3 array of direction cosine
+        matrices C into the N x 4 array of euler parameter vectors Q with
+        Beta_0 >= 0, using the Stanley method of C2EP().  The products
+        4 Beta_i Beta_j are set up for all cases and the row of the largest
+        Beta_i is selected for each matrix.
+    """
+    C = np.asarray(C, dtype=float)
+    tr = np.trace(C, axis1=-2, axis2=-1)
+    b2 = np.stack(((1 + tr) / 4,
+                   (1 + 2 * C[..., 0, 0] - tr) / 4,
+                   (1 + 2 * C[..., 1, 1] - tr) / 4,
+                   (1 + 2 * C[..., 2, 2] - tr) / 4), axis=-1)
+    d12 = C[..., 1, 2] - C[..., 2, 1]
+    d20 = C[..., 2, 0] - C[..., 0, 2]
+    d01 = C[..., 0, 1] - C[..., 1, 0]
+    s01 = C[..., 0, 1] + C[..., 1, 0]
+    s20 = C[..., 2, 0] + C[..., 0, 2]
+    s12 = C[..., 1, 2] + C[..., 2, 1]
+    B = np.stack((np.stack((4 * b2[..., 0], d12, d20, d01), axis=-1),
+                  np.stack((d12, 4 * b2[..., 1], s01, s20), axis=-1),
+                  np.stack((d20, s01, 4 * b2[..., 2], s12), axis=-1),
+                  np.stack((d01, s20, s12, 4 * b2[..., 3]), axis=-1)), axis=-2)
+    case = np.argmax(b2, axis=-1)[..., None]
+    b = np.take_along_axis(B, case[..., None], axis=-2)[..., 0, :]
+    b = b / (4 * np.sqrt(np.take_along_axis(b2, case, axis=-1)))
+    return np.where(b[..., :1] < 0, -b, b)
+
+
+def C2MRPBatch(C):
+    """
+    C2MRPBatch
+
+    	Q = C2MRPBatch(C) translates the N x 3 x 3 array of direction cosine
+    	matrices C into the N x 3 array of MRP vectors Q with :math:`|Q| <= 1`.
+    """
+    b = C2EPBatch(C)
+    return b[..., 1:] / (1 + b[..., :1])
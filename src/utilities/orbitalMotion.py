@@ -720,6 +720,167 @@ def rv2elem(mu, rVec, vVec):
     return elements
 
 
+def M2EBatch(M, e):
+    """
+    Array version of M2E().  The mean anomalies are reduced to [-pi, pi], started
+    with the Danby guess M + 0.85 e sign(M) and refined with Halley iterations on
+    all anomalies at once, which converge in 3 to 5 steps for 0 <= e < 1.
+
+    :param M: array of mean elliptic anomalies (rad)
+    :param e: eccentricity or array of eccentricities (0 <= e < 1)
+    :return: Ecc, array of eccentric anomalies (rad)
+    """
+    M = np.asarray(M, dtype=float)
+    e = np.broadcast_to(np.asarray(e, dtype=float), M.shape)
+    if np.any((e < 0.0) | (e >= 1.0)):
+        raise ValueError('Error: M2EBatch() received e outside of 0 <= e < 1')
+
+    turns = 2.0 * np.pi * np.floor((M + np.pi) / (2.0 * np.pi))
+    Mr = M - turns
+    E1 = Mr + np.copysign(0.85 * e, Mr)
+    for count in range(maxIteration):
+        se = e * np.sin(E1)
+        f0 = E1 - se - Mr
+        f1 = 1.0 - e * np.cos(E1)
+        dE = f0 / (f1 - 0.5 * f0 * se / f1)
+        E1 -= dE
+        if np.max(np.abs(dE), initial=0.0) <= eps:
+            break
+    else:
+        print('Iteration error in M2EBatch()')
+    return E1 + turns
+
+
+def N2HBatch(N, e):
+    """
+    Array version of N2H().  The iterations are started with asinh(N / e) and
+    refined with Halley iterations on all anomalies at once.
+
+    :param N: array of mean hyperbolic anomalies (rad)
+    :param e: eccentricity or array of eccentricities (e > 1)
+    :return: H, array of hyperbolic anomalies (rad)
+    """
+    N = np.asarray(N, dtype=float)
+    e = np.broadcast_to(np.asarray(e, dtype=float), N.shape)
+    if np.any(e <= 1.0):
+        raise ValueError('Error: N2HBatch() received e outside of e > 1')
+
+    H1 = np.arcsinh(N / e)
+    for count in range(maxIteration):
+        sh = e * np.sinh(H1)
+        f0 = sh - H1 - N
+        f1 = e * np.cosh(H1) - 1.0
+        dH = f0 / (f1 - 0.5 * f0 * sh / f1)
+        H1 -= dH
+        if np.max(np.abs(dH), initial=0.0) <= eps:
+            break
+    else:
+        print('Iteration error in N2HBatch()')
+    return H1
+
+
+def elem2rvBatch(mu, elements):
+    """
+    Array version of elem2rv().  The attributes a, e, i, Omega, omega and f of
+    elements are arrays of the same length, or scalars shared by all orbits.
+    An orbit with e = 1 is a parabola with a = -rp, as returned by rv2elemBatch().
+    Rectilinear orbits are not supported.
+
+    :param mu: gravitational parameter
+    :param elements: orbital elements with array attributes
+    :return:   rVec, N x 3 array of position vectors
+    :return:   vVec, N x 3 array of velocity vectors
+    """
+    a, e, inc, AN, AP, f = np.broadcast_arrays(*[np.asarray(x, dtype=float) for x in
+                                                 (elements.a, elements.e, elements.i,
+                                                  elements.Omega, elements.omega, elements.f)])
+
+    if np.any(1.0 + e * np.cos(f) < tolerance):
+        print('WARNING: Radius is near infinite in elem2rvBatch conversion.')
+
+    # Calculate the semilatus rectum and the radius, parabolas are given by a = -rp #
+    p = np.where(np.abs(1.0 - e) < tolerance, -2.0 * a, a * (1.0 - e * e))
+    r = p / (1.0 + e * np.cos(f))
+
+    theta = AP + f
+    cAN = np.cos(AN)
+    sAN = np.sin(AN)
+    cth = np.cos(theta)
+    sth = np.sin(theta)
+    ci = np.cos(inc)
+    si = np.sin(inc)
+    eCAP = e * np.cos(AP)
+    eSAP = e * np.sin(AP)
+
+    rVec = np.stack((r * (cth * cAN - ci * sth * sAN),
+                     r * (cth * sAN + ci * sth * cAN),
+                     r * (sth * si)), axis=-1)
+    muh = mu / np.sqrt(mu * p)
+    vVec = np.stack((-muh * (cAN * (eSAP + sth) + ci * (eCAP + cth) * sAN),
+                     -muh * (sAN * (eSAP + sth) - ci * (eCAP + cth) * cAN),
+                     muh * (eCAP + cth) * si), axis=-1)
+
+    return rVec, vVec
+
+
+def rv2elemBatch(mu, rVec, vVec):
+    """
+    Array version of rv2elem() for N x 3 arrays of position and velocity vectors.
+    The angles are computed with atan2() instead of acos() and follow the
+    conventions of rv2elem(): Omega = 0 for equatorial orbits, omega = 0 for
+    circular orbits, a = -rp for parabolas and f in [-pi, pi] for hyperbolas.
+    Rectilinear orbits are not supported.
+
+    :param mu:  gravitational parameter
+    :param rVec: N x 3 array of position vectors
+    :param vVec: N x 3 array of velocity vectors
+    :return:  orbital elements with array attributes
+    """
+    rVec = np.asarray(rVec, dtype=float)
+    vVec = np.asarray(vVec, dtype=float)
+    elements = ClassicElements()
+
+    # Calculate the specific angular momentum and the line of nodes #
+    hVec = np.cross(rVec, vVec)
+    h = la.norm(hVec, axis=-1)
+    p = h * h / mu
+    ihHat = hVec / h[..., None]
+    nVec = np.stack((-hVec[..., 1], hVec[..., 0], np.zeros_like(h)), axis=-1)
+    n = la.norm(nVec, axis=-1)
+    equatorial = n < 1e-11 * h
+    nVec[equatorial] = [1.0, 0.0, 0.0]
+    inHat = nVec / np.where(equatorial, 1.0, n)[..., None]
+
+    # Orbit eccentricity and energy #
+    r = la.norm(rVec, axis=-1)
+    v = la.norm(vVec, axis=-1)
+    rDotV = np.sum(rVec * vVec, axis=-1)
+    eVec = (v * v / mu - 1.0 / r)[..., None] * rVec - (rDotV / mu)[..., None] * vVec
+    elements.e = la.norm(eVec, axis=-1)
+    circular = elements.e < 1e-11
+    ieHat = np.where(circular[..., None], inHat, eVec / np.where(circular, 1.0, elements.e)[..., None])
+    elements.rmag = r
+    elements.rPeriap = p / (1.0 + elements.e)
+
+    # compute semi-major axis, parabolas are given by a = -rp #
+    elements.alpha = 2.0 / r - v * v / mu
+    parab = np.abs(elements.alpha) <= eps
+    with np.errstate(divide='ignore'):
+        elements.a = np.where(parab, -p / 2.0, 1.0 / elements.alpha)
+        elements.rApoap = np.where(parab, -1.0, p / (1.0 - elements.e))
+
+    # Calculate the angles #
+    elements.i = np.arccos(np.clip(ihHat[..., 2], -1.0, 1.0))
+    elements.Omega = np.mod(np.arctan2(inHat[..., 1], inHat[..., 0]), 2.0 * np.pi)
+    elements.omega = np.mod(np.arctan2(np.sum(np.cross(inHat, ieHat) * ihHat, axis=-1),
+                                       np.sum(inHat * ieHat, axis=-1)), 2.0 * np.pi)
+    elements.f = np.mod(np.arctan2(np.sum(np.cross(ieHat, rVec) * ihHat, axis=-1),
+                                   np.sum(ieHat * rVec, axis=-1)), 2.0 * np.pi)
+    elements.f = np.where((elements.e > 1.0) & (elements.f > np.pi), elements.f - 2.0 * np.pi, elements.f)
+
+    return elements
+
+
 def atmosphericDensity(alt):
     """
     This program computes the atmospheric density based on altitude
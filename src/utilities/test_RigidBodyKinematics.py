@@ -0,0 +1,60 @@
+''' '''
+'''
+ ISC License
+
+ Copyright (c) 2016, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+'''
+
+
+from Basilisk.utilities import RigidBodyKinematics as rbk
+import numpy as np
+
+a_tol = 1e-14  # array tolerance
+
+
+def arrayEqualCheck(v1, v2, methodName):
+    if np.allclose(v1, v2, atol=a_tol):
+        return 0
+    print(methodName + ' failed')
+    return 1
+
+
+def test_RigidBodyKinematicsBatch():
+    e_count = 0
+    rng = np.random.RandomState(1)
+
+    # MRP sets inside and outside of the unit sphere, including the zero attitude
+    sigma = np.concatenate((rng.uniform(-1.0, 1.0, (50, 3)), rng.uniform(-3.0, 3.0, (10, 3)), np.zeros((1, 3))))
+    n = len(sigma)
+
+    beta = rbk.MRP2EPBatch(sigma)
+    e_count += arrayEqualCheck(np.array([rbk.MRP2EP(sigma[k]) for k in range(n)]), beta, 'MRP2EPBatch')
+    e_count += arrayEqualCheck(np.array([rbk.EP2MRP(beta[k]) for k in range(n)]), rbk.EP2MRPBatch(beta),
+                               'EP2MRPBatch')
+    e_count += arrayEqualCheck(np.array([rbk.EP2MRP(-beta[k]) for k in range(n)]), rbk.EP2MRPBatch(-beta),
+                               'EP2MRPBatch negative Beta_0')
+
+    C = rbk.MRP2CBatch(sigma)
+    e_count += arrayEqualCheck(np.array([rbk.MRP2C(sigma[k]) for k in range(n)]), C, 'MRP2CBatch')
+    e_count += arrayEqualCheck(np.array([rbk.EP2C(beta[k]) for k in range(n)]), rbk.EP2CBatch(beta), 'EP2CBatch')
+    e_count += arrayEqualCheck(np.array([rbk.C2EP(C[k]) for k in range(n)]), rbk.C2EPBatch(C), 'C2EPBatch')
+    e_count += arrayEqualCheck(np.array([rbk.C2MRP(C[k]) for k in range(n)]), rbk.C2MRPBatch(C), 'C2MRPBatch')
+
+    assert e_count < 1, str(e_count) + " functions failed in RigidBodyKinematics.py batch test"
+
+
+if __name__ == "__main__":
+    test_RigidBodyKinematicsBatch()
@@ -283,5 +283,55 @@ def test_orbitalMotion(show_plots):
     assert e_count < 1, str(e_count) + " functions failed in orbitalMotion.py script"
 
 
+def test_orbitalMotionBatch():
+    e_count = 0
+    rng = np.random.RandomState(1)
+    mu = orbitalMotion.MU_EARTH
+
+    # Functions M2EBatch and N2HBatch, checked against the scalar solvers and Kepler's equation
+    M = rng.uniform(-20.0, 20.0, 200)
+    e = rng.uniform(0.0, 0.95, 200)
+    Ecc = orbitalMotion.M2EBatch(M, e)
+    EccTrue = np.array([orbitalMotion.M2E(M[k], e[k]) for k in range(len(M))])
+    e_count += arrayEqualCheck(EccTrue, Ecc, 'M2EBatch')
+    Ecc = orbitalMotion.M2EBatch(M, 0.9999)
+    e_count += arrayEqualCheck(M, Ecc - 0.9999 * np.sin(Ecc), 'M2EBatch e = 0.9999')
+    eHyp = rng.uniform(1.01, 5.0, 200)
+    H = orbitalMotion.N2HBatch(M, eHyp)
+    HTrue = np.array([orbitalMotion.N2H(M[k], eHyp[k]) for k in range(len(M))])
+    e_count += arrayEqualCheck(HTrue, H, 'N2HBatch')
+
+    # Functions elem2rvBatch and rv2elemBatch
+    elements = orbitalMotion.ClassicElements()
+    elements.a = np.concatenate((rng.uniform(7000., 40000., 20), -rng.uniform(7000., 40000., 5)))
+    elements.e = np.concatenate((rng.uniform(0.01, 0.9, 20), rng.uniform(1.1, 2.0, 5)))
+    elements.i = rng.uniform(0.1, 3.0, 25)
+    elements.Omega = rng.uniform(0.0, 2 * np.pi, 25)
+    elements.omega = rng.uniform(0.0, 2 * np.pi, 25)
+    elements.f = np.concatenate((rng.uniform(0.0, 2 * np.pi, 20), rng.uniform(-1.0, 1.0, 5)))
+    rVec, vVec = orbitalMotion.elem2rvBatch(mu, elements)
+    elementsOut = orbitalMotion.rv2elemBatch(mu, rVec, vVec)
+    for k in range(25):
+        element = orbitalMotion.ClassicElements()
+        element.a = elements.a[k]
+        element.e = elements.e[k]
+        element.i = elements.i[k]
+        element.Omega = elements.Omega[k]
+        element.omega = elements.omega[k]
+        element.f = elements.f[k]
+        r, v = orbitalMotion.elem2rv(mu, element)
+        e_count += scaleEqualCheck(np.concatenate((r, v)), np.concatenate((rVec[k], vVec[k])),
+                                   'elem2rvBatch')
+        element = orbitalMotion.rv2elem(mu, r, v)
+        e_count += scaleEqualCheck(np.array([element.a, element.e, element.i,
+                                             element.Omega, element.omega, element.f]),
+                                   np.array([elementsOut.a[k], elementsOut.e[k], elementsOut.i[k],
+                                             elementsOut.Omega[k], elementsOut.omega[k], elementsOut.f[k]]),
+                                   'rv2elemBatch')
+
+    assert e_count < 1, str(e_count) + " functions failed in orbitalMotion.py batch test"
+
+
 if __name__ == "__main__":
-    test_orbitalMotion(False)
\ No newline at end of file
+    test_orbitalMotion(False)
+    test_orbitalMotionBatch()
\ No newline at end of file